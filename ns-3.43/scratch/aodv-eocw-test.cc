@@ -5,13 +5,34 @@
  *
  * Usage:
  *   ./ns3 run "scratch/aodv-eocw-test --useFuzzy=true"
+ *   ./ns3 run "scratch/aodv-eocw-test --campaign=aodv-eocw-campaign.grid --output=results.csv"
+ *
+ * Campaign mode:
+ * - The grid file lists "parameter = value value ..." lines, using the command-line
+ *   names of the scenario parameters (and RngRun); "a:b" expands to the integers a to b.
+ *   Lines after a "[name]" header form a scenario: one run per combination of its values,
+ *   together with the lines before the first header, which are common to all scenarios.
+ * - One process is forked per run, with --jobs of them running at a time, so every run
+ *   has its own Simulator and globals.
+ * - Each finished run is appended to the output CSV, with its wall-clock time and the
+ *   peak RSS of its process. The time series of the runs with a window go to the
+ *   "-series" CSV next to it, one line per run and window.
+ * - Runs already in the output file are skipped, so a campaign interrupted by a crash
+ *   or a kill resumes where it stopped.
+ *
+ * Metrics:
+ * - An EocwMetricsCollector accounts PDR, delay, throughput, energy, survival and route
+ *   recoveries while the simulation runs. With --window=10, the metrics of every 10 s
+ *   window are also written to --timeSeries, so a single long run shows how they evolve.
  *
  * Notes:
  * - This version targets ns-3.43 (CMake build).
- * - The energy-depletion callback is set via MakeBoundCallback(...) so the bound Node*
- *   is passed to the handler; we then call your SoftKillNode(node).
+ * - Dead nodes are shut down by a NodeLifecycleManager on each energy source, which
+ *   flushes the wifi queues, brings the IPv4 interfaces down and stops the apps.
  */
 
+#include "ns3/aodv-congestion-estimator.h"
+#include "ns3/aodv-eocw-metrics-collector.h"
 #include "ns3/aodv-helper.h"
 #include "ns3/core-module.h"
 #include "ns3/csma-module.h"
@@ -23,6 +44,7 @@
 #include "ns3/basic-energy-source-helper.h"
 #include "ns3/basic-energy-source.h"
 #include "ns3/energy-source.h"
+#include "ns3/node-lifecycle-manager-helper.h"
 #include "ns3/wifi-radio-energy-model-helper.h"
 #include "ns3/wifi-radio-energy-model.h"
 #include "ns3/netanim-module.h"
@@ -37,7 +59,20 @@
 #include "ns3/wifi-mac-queue.h"
 #include "ns3/qos-utils.h"
 #include "ns3/device-energy-model.h"
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace ns3;
@@ -46,75 +81,49 @@ using namespace ns3::energy;
 NS_LOG_COMPONENT_DEFINE("AodvEocwStressTest");
 
 // --- GLOBAL VARIABLES ---
-std::vector<bool> isNodeDead;
-
-// Forward declarations
-void SoftKillNode(Ptr<Node> node);
+Ptr<aodv::EocwMetricsCollector> metrics; // PDR, delay, energy, survival and routing, over time
 
-// Soft-kill a node safely: flush MAC TX queues, stop apps, and set IPv4 interface down
-void SoftKillNode(Ptr<Node> node)
+// Shutdown step: flush the MAC TX queues, so queued packets won't be transmitted.
+// IMPORTANT: Do NOT call phy->SetOffMode() here. That can produce invalid state transitions if PHY busy.
+void FlushWifiQueues(Ptr<Node> node)
 {
-    if (!node) return;
-    uint32_t id = node->GetId();
-    if (id < isNodeDead.size() && isNodeDead[id]) return;
-
-    // Log to console for debug
-    NS_LOG_UNCOND("!!! NODE " << id << " DIED (Energy Depleted) at " << Simulator::Now().GetSeconds() << "s !!!");
-
-    if (id < isNodeDead.size()) isNodeDead[id] = true;
-
-    // 1. Flush Queues (so queued packets won't be transmitted)
     for (uint32_t i = 0; i < node->GetNDevices(); ++i) {
         Ptr<WifiNetDevice> wifiDev = DynamicCast<WifiNetDevice>(node->GetDevice(i));
-        if (wifiDev) {
-            Ptr<WifiMac> mac = wifiDev->GetMac();
-            if (mac) {
-                Ptr<AdhocWifiMac> adhocMac = DynamicCast<AdhocWifiMac>(mac);
-                if (adhocMac) {
-                    for (auto ac : {AC_BE, AC_BK, AC_VI, AC_VO}) {
-                        Ptr<WifiMacQueue> queue = adhocMac->GetTxopQueue(ac);
-                        if (queue) queue->Flush();
-                    }
-                }
-            }
-            // IMPORTANT: Do NOT call phy->SetOffMode() here. That can produce invalid state transitions if PHY busy.
-        }
-    }
-
-    // 2. Stop Applications immediately
-    for (uint32_t i = 0; i < node->GetNApplications(); ++i) {
-        Ptr<Application> app = node->GetApplication(i);
-        if (app) {
-            app->SetStopTime(Simulator::Now());
+        if (!wifiDev) continue;
+        Ptr<AdhocWifiMac> adhocMac = DynamicCast<AdhocWifiMac>(wifiDev->GetMac());
+        if (!adhocMac) continue;
+        for (auto ac : {AC_BE, AC_BK, AC_VI, AC_VO}) {
+            Ptr<WifiMacQueue> queue = adhocMac->GetTxopQueue(ac);
+            if (queue) queue->Flush();
         }
     }
+}
 
-    // 3. Bring down IPv4 interface to notify routing layer (AODV) of link break
+// Shutdown step: bring down the IPv4 interfaces to notify the routing layer (AODV) of the link break
+void BringIpv4Down(Ptr<Node> node)
+{
     Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-    // Typically interface 1 is the wifi interface in this script; ensure index valid
-    if (ipv4 && ipv4->GetNInterfaces() > 1) {
-        ipv4->SetDown(1);
+    if (!ipv4) return;
+    for (uint32_t i = 1; i < ipv4->GetNInterfaces(); ++i) {
+        ipv4->SetDown(i);
     }
 }
 
-// Bound depletion callback: will be created with MakeBoundCallback(&WifiEnergyDepletionBoundCallback, nodePtr)
-// Signature must match function pointer type used by MakeBoundCallback (i.e., void(Ptr<Node>))
-void WifiEnergyDepletionBoundCallback(Ptr<Node> node)
+// The NodeLifecycleManager shuts the node down, the radio keeps its PHY on
+void IgnoreRadioDepletion()
 {
-    // Call your soft-kill routine safely
-    SoftKillNode(node);
 }
 
-// Callback automatically called when energy value trace fires (optional extra safeguard)
-void EnergyChangeHandler(Ptr<Node> node, double oldValue, double newValue)
+// Trace sink of the NodeLifecycleManagers
+void NodeShutdown(Ptr<Node> node)
 {
-    // trigger soft kill slightly before absolute zero
-    if (newValue <= 0.1) {
-        Simulator::ScheduleNow(&SoftKillNode, node);
-    }
+    // Log to console for debug
+    NS_LOG_UNCOND("!!! NODE " << node->GetId() << " DIED (Energy Depleted) at " << Simulator::Now().GetSeconds() << "s !!!");
+    if (metrics) metrics->NotifyNodeDown(node);
 }
 
-int main(int argc, char* argv[])
+// --- SCENARIO ---
+struct ScenarioConfig
 {
     bool useFuzzy = true;
     uint32_t numNodes = 40;
@@ -126,23 +135,57 @@ int main(int argc, char* argv[])
     double minEnergy = 0.1;
     double maxEnergy = 0.3;
     uint32_t numFlows = 5;
+    bool useCongestionEstimator = false;
+    uint32_t maxPaths = 1;
 
-    CommandLine cmd(__FILE__);
-    cmd.AddValue("useFuzzy", "Use Fuzzy Logic", useFuzzy);
-    cmd.AddValue("numNodes", "Number of Nodes", numNodes);
-    // --- TAMBAHKAN BARIS-BARIS INI ---
-    cmd.AddValue("simTime", "Simulation Time", simTime);
-    cmd.AddValue("speed", "Node Speed", nodeSpeed);
-    cmd.AddValue("energyMin", "Min Energy", minEnergy);
-    cmd.AddValue("energyMax", "Max Energy", maxEnergy);
-    // ---------------------------------
-    cmd.Parse(argc, argv);
+    // Time series: one line per window of this many seconds (0 = none)
+    double window = 0;
+    std::string timeSeries = "aodv-eocw-timeseries.csv";
+};
+
+struct ScenarioResult
+{
+    double pdr = 0;
+    double delay = 0;
+    double survival = 0;
+    double energy = 0;
+    double throughput = 0;
+    uint32_t floods = 0;
+    uint32_t localRecoveries = 0;
+    double recoveryMs = 0;
+};
+
+// Scenario parameters, shared by the command line and the campaign grid
+void AddScenarioValues(CommandLine& cmd, ScenarioConfig& c)
+{
+    cmd.AddValue("useFuzzy", "Use Fuzzy Logic", c.useFuzzy);
+    cmd.AddValue("numNodes", "Number of Nodes", c.numNodes);
+    cmd.AddValue("simTime", "Simulation Time", c.simTime);
+    cmd.AddValue("speed", "Node Speed", c.nodeSpeed);
+    cmd.AddValue("energyMin", "Min Energy", c.minEnergy);
+    cmd.AddValue("energyMax", "Max Energy", c.maxEnergy);
+    cmd.AddValue("congestionEstimator", "Use the smoothed multi-signal congestion estimator", c.useCongestionEstimator);
+    cmd.AddValue("maxPaths", "Number of link-disjoint EOCW paths replied, the best one and its alternates", c.maxPaths);
+    cmd.AddValue("window", "Width in seconds of the windows of the time series, 0 for no time series", c.window);
+    cmd.AddValue("timeSeries", "Output CSV file of the time series", c.timeSeries);
+}
+
+ScenarioResult RunScenario(const ScenarioConfig& c)
+{
+    bool useFuzzy = c.useFuzzy;
+    uint32_t numNodes = c.numNodes;
+    double simTime = c.simTime;
+    double nodeSpeed = c.nodeSpeed;
+    double arenaSize = c.arenaSize;
+    double minEnergy = c.minEnergy;
+    double maxEnergy = c.maxEnergy;
+    uint32_t numFlows = c.numFlows;
+    bool useCongestionEstimator = c.useCongestionEstimator;
+    uint32_t maxPaths = c.maxPaths;
 
     // Timeout pendek agar RREQ sering dikirim ulang (memicu logika EOCW bekerja lebih sering)
     Config::SetDefault("ns3::aodv::RoutingProtocol::ActiveRouteTimeout", TimeValue(Seconds(3.0)));
 
-    isNodeDead.assign(numNodes, false);
-
     NodeContainer nodes;
     nodes.Create(numNodes);
 
@@ -177,10 +220,17 @@ int main(int argc, char* argv[])
     AodvHelper aodv;
     aodv.Set("DestinationOnly", BooleanValue(true));
     aodv.Set("EnableFuzzy", BooleanValue(useFuzzy));
+    aodv.Set("EocwMaxPaths", UintegerValue(maxPaths));
     InternetStackHelper stack;
     stack.SetRoutingHelper(aodv);
     stack.Install(nodes);
 
+    if (useCongestionEstimator) {
+        for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+            nodes.Get(i)->AggregateObject(CreateObject<aodv::WifiCongestionEstimator>());
+        }
+    }
+
     Ipv4AddressHelper address;
     address.SetBase("10.1.1.0", "255.255.255.0");
     Ipv4InterfaceContainer interfaces = address.Assign(devices);
@@ -202,39 +252,27 @@ int main(int argc, char* argv[])
     // 3. Rx Current Sedang
     radioEnergyModelHelper.Set("RxCurrentA", DoubleValue(0.500));
 
+    radioEnergyModelHelper.SetDepletionCallback(MakeCallback(&IgnoreRadioDepletion));
+
     // Install returns a DeviceEnergyModelContainer (one entry per device energy model installed)
     DeviceEnergyModelContainer demContainer = radioEnergyModelHelper.Install(devices, sources);
 
-    // IMPORTANT: override per-model depletion callback using MakeBoundCallback to bind the corresponding node pointer
-    // The mapping is: sources.Get(i) corresponds to nodes.Get(i) if you installed sources with basicSourceHelper.Install(nodes)
-    // We'll iterate by node index and try to set callbacks on all WifiRadioEnergyModel instances attached to that node's source.
-    for (uint32_t nodeIndex = 0; nodeIndex < nodes.GetN(); ++nodeIndex) {
-        Ptr<BasicEnergySource> src = DynamicCast<BasicEnergySource>(sources.Get(nodeIndex));
-        if (!src) continue;
-
-        // Find all WifiRadioEnergyModel device models attached to this source
-        DeviceEnergyModelContainer devModels = src->FindDeviceEnergyModels("ns3::WifiRadioEnergyModel");
-        for (uint32_t k = 0; k < devModels.GetN(); ++k) {
-            Ptr<DeviceEnergyModel> dem = devModels.Get(k);
-            if (!dem) continue;
-
-            Ptr<WifiRadioEnergyModel> wrem = DynamicCast<WifiRadioEnergyModel>(dem);
-            if (!wrem) continue;
-
-            // Bind the node pointer to the depletion callback.
-            // MakeBoundCallback builds a Callback<void> by binding the Ptr<Node> argument.
-            wrem->SetEnergyDepletionCallback(MakeBoundCallback(&WifiEnergyDepletionBoundCallback, nodes.Get(nodeIndex)));
-        }
+    // A dying node is shut down by its NodeLifecycleManager: device, stack and apps at once,
+    // slightly before absolute zero or when the source reports depletion
+    NodeLifecycleManagerHelper lifecycleHelper;
+    lifecycleHelper.Set("ShutdownThreshold", DoubleValue(0.1));
+    lifecycleHelper.AddShutdownCallback(MakeCallback(&FlushWifiQueues));
+    lifecycleHelper.AddShutdownCallback(MakeCallback(&BringIpv4Down));
+    DeviceEnergyModelContainer lifecycle = lifecycleHelper.Install(sources);
+    for (uint32_t i = 0; i < lifecycle.GetN(); ++i) {
+        lifecycle.Get(i)->TraceConnectWithoutContext("Shutdown", MakeCallback(&NodeShutdown));
     }
 
-    // Also optionally set RemainingEnergy trace handlers so we get notifications while running
     for (uint32_t i = 0; i < numNodes; i++) {
         Ptr<BasicEnergySource> s = DynamicCast<BasicEnergySource>(sources.Get(i));
         if (!s) continue;
         // Set energi awal secara random
         s->SetInitialEnergy(energyRng->GetValue());
-        // Pasang callback untuk memantau energi secara real-time (optional)
-        s->TraceConnectWithoutContext("RemainingEnergy", MakeBoundCallback(&EnergyChangeHandler, nodes.Get(i)));
     }
 
     // --- TRAFFIC ---
@@ -273,53 +311,354 @@ int main(int argc, char* argv[])
     FlowMonitorHelper flowmon;
     Ptr<FlowMonitor> monitor = flowmon.InstallAll();
 
+    // Metrics are accounted as the simulation runs, in windows of c.window seconds
+    double window = (c.window > 0) ? c.window : simTime;
+    metrics = CreateObjectWithAttributes<aodv::EocwMetricsCollector>(
+        "Window", TimeValue(Seconds(window)),
+        "Capacity", UintegerValue(static_cast<uint32_t>(std::ceil(simTime / window)) + 1));
+    metrics->Install(monitor);
+    metrics->Install(nodes);
+    metrics->Install(sources);
+
     Simulator::Stop(Seconds(simTime));
     Simulator::Run();
 
-    // Stats Analysis
-    monitor->CheckForLostPackets();
-    std::map<FlowId, FlowMonitor::FlowStats> stats = monitor->GetFlowStats();
-    double totalRx = 0, totalTx = 0, totalDelay = 0, totalThroughput = 0;
-
-    for (auto i = stats.begin(); i != stats.end(); ++i) {
-        totalTx += i->second.txPackets;
-        totalRx += i->second.rxPackets;
-        if (i->second.rxPackets > 0) {
-            totalDelay += i->second.delaySum.GetSeconds();
-            double duration = i->second.timeLastRxPacket.GetSeconds() - i->second.timeFirstTxPacket.GetSeconds();
-            if (duration > 0) totalThroughput += (i->second.rxBytes * 8.0) / duration / 1024.0;
+    metrics->UpdateEnergy();
+    const aodv::EocwMetricsCollector::Window& totals = metrics->GetTotals();
+    ScenarioResult r;
+    r.pdr = (totals.txPackets > 0) ? 100.0 * totals.rxPackets / totals.txPackets : 0.0;
+    r.delay = (totals.rxPackets > 0) ? totals.delaySum.GetSeconds() / totals.rxPackets * 1000.0 : 0.0;
+    r.throughput = metrics->GetThroughput();
+    r.survival = metrics->GetSurvivalRate();
+    // Jika mati, semua energi awal node dianggap habis dikonsumsi (untuk perbandingan yang adil)
+    r.energy = totals.energyConsumed;
+    r.floods = totals.routeDiscoveries;
+    r.localRecoveries = totals.localRecoveries;
+    uint32_t recoveries = totals.localRecoveries + totals.discoveryRecoveries;
+    r.recoveryMs = (recoveries > 0) ? totals.recoveryLatencySum.GetSeconds() / recoveries * 1000.0 : 0.0;
+
+    if (c.window > 0) {
+        std::ofstream series(c.timeSeries);
+        metrics->WriteTimeSeries(series);
+    }
+    metrics = nullptr;
+
+    Simulator::Destroy();
+    return r;
+}
+
+
+// --- CAMPAIGN ---
+struct CampaignRun
+{
+    std::string scenario;
+    std::vector<std::string> args; // "--name=value" assignments
+    std::string key;               // identifies the run in the output file
+};
+
+// Expand "a:b" integer ranges, split the other values on whitespace
+std::vector<std::string> ParseGridValues(const std::string& text)
+{
+    std::vector<std::string> values;
+    std::istringstream in(text);
+    std::string v;
+    while (in >> v) {
+        auto colon = v.find(':');
+        if (colon != std::string::npos) {
+            int64_t first = std::stoll(v.substr(0, colon));
+            int64_t last = std::stoll(v.substr(colon + 1));
+            for (int64_t i = first; i <= last; ++i) values.push_back(std::to_string(i));
+        } else {
+            values.push_back(v);
         }
     }
+    return values;
+}
 
-    double totalConsumed = 0;
-    uint32_t deadCount = 0;
-    for (uint32_t i = 0; i < numNodes; i++) {
-        Ptr<BasicEnergySource> s = DynamicCast<BasicEnergySource>(sources.Get(i));
-        if (!s) continue;
-        double consumed = s->GetInitialEnergy() - s->GetRemainingEnergy();
-        if (i < isNodeDead.size() && isNodeDead[i]) {
-            deadCount++;
-            // Jika mati, anggap semua energi awal telah habis dikonsumsi (untuk perbandingan yang adil)
-            consumed = s->GetInitialEnergy();
+std::vector<CampaignRun> ParseGrid(const std::string& file)
+{
+    typedef std::vector<std::pair<std::string, std::vector<std::string>>> Grid;
+    std::ifstream in(file);
+    NS_ABORT_MSG_IF(!in, "Cannot open campaign grid " << file);
+
+    Grid common;
+    std::vector<std::pair<std::string, Grid>> scenarios;
+    std::string line;
+    uint32_t lineNo = 0;
+    while (std::getline(in, line)) {
+        lineNo++;
+        line = line.substr(0, line.find('#'));
+        auto first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos) continue;
+        line = line.substr(first, line.find_last_not_of(" \t\r") - first + 1);
+        if (line.front() == '[') {
+            NS_ABORT_MSG_IF(line.back() != ']', file << ":" << lineNo << ": bad scenario header");
+            scenarios.emplace_back(line.substr(1, line.size() - 2), Grid());
+            continue;
+        }
+        auto eq = line.find('=');
+        NS_ABORT_MSG_IF(eq == std::string::npos, file << ":" << lineNo << ": expected parameter = values");
+        std::string name = line.substr(0, eq);
+        name = name.substr(0, name.find_last_not_of(" \t") + 1);
+        std::vector<std::string> values = ParseGridValues(line.substr(eq + 1));
+        NS_ABORT_MSG_IF(name.empty() || values.empty(), file << ":" << lineNo << ": expected parameter = values");
+        (scenarios.empty() ? common : scenarios.back().second).emplace_back(name, values);
+    }
+    if (scenarios.empty()) scenarios.emplace_back("default", Grid());
+
+    std::vector<CampaignRun> runs;
+    for (const auto& [scenario, grid] : scenarios) {
+        // A scenario parameter overrides a common one of the same name
+        Grid axes;
+        for (const auto& axis : common) {
+            bool overridden = false;
+            for (const auto& own : grid) overridden |= (own.first == axis.first);
+            if (!overridden) axes.push_back(axis);
         }
-        totalConsumed += consumed;
+        axes.insert(axes.end(), grid.begin(), grid.end());
+
+        // Cartesian product, the last parameter varying fastest
+        std::vector<size_t> index(axes.size(), 0);
+        while (true) {
+            CampaignRun run;
+            run.scenario = scenario;
+            run.key = scenario;
+            for (size_t a = 0; a < axes.size(); ++a) {
+                const std::string& value = axes[a].second[index[a]];
+                run.args.push_back("--" + axes[a].first + "=" + value);
+                run.key += " " + axes[a].first + "=" + value;
+            }
+            runs.push_back(run);
+            size_t a = axes.size();
+            while (a > 0 && ++index[a - 1] == axes[a - 1].second.size()) {
+                index[--a] = 0;
+            }
+            if (a == 0) break;
+        }
+    }
+    return runs;
+}
+
+ScenarioConfig ParseRunConfig(const CampaignRun& run)
+{
+    ScenarioConfig c;
+    CommandLine cmd(__FILE__);
+    AddScenarioValues(cmd, c);
+    std::vector<std::string> args{"aodv-eocw-test"};
+    args.insert(args.end(), run.args.begin(), run.args.end());
+    cmd.Parse(args);
+    return c;
+}
+
+const std::string CAMPAIGN_HEADER = "Run,Scenario,Protocol,Speed,Nodes,SimTime,RngRun,PDR,Delay,SurvivalRate,Energy,"
+                                    "Throughput,Floods,LocalRecoveries,RecoveryMs,WallClockS,PeakRssKB";
+
+// Keep the complete rows of an existing output file, return the runs they hold
+std::set<std::string> LoadFinishedRuns(const std::string& output)
+{
+    std::set<std::string> finished;
+    std::ifstream in(output);
+    if (!in) return finished;
+
+    std::string line;
+    std::vector<std::string> rows;
+    if (std::getline(in, line)) {
+        NS_ABORT_MSG_IF(line != CAMPAIGN_HEADER, output << " is not a campaign output file");
     }
+    size_t columns = std::count(CAMPAIGN_HEADER.begin(), CAMPAIGN_HEADER.end(), ',');
+    while (std::getline(in, line)) {
+        // A row cut short by a crash is dropped, and its run done again
+        if (static_cast<size_t>(std::count(line.begin(), line.end(), ',')) != columns) continue;
+        finished.insert(line.substr(0, line.find(',')));
+        rows.push_back(line);
+    }
+    in.close();
+
+    std::ofstream out(output + ".tmp");
+    out << CAMPAIGN_HEADER << "\n";
+    for (const auto& row : rows) out << row << "\n";
+    out.close();
+    std::rename((output + ".tmp").c_str(), output.c_str());
+    return finished;
+}
+
+// Time series of the runs with a window, one line per (run, window)
+std::string SeriesFileName(const std::string& output)
+{
+    auto dot = output.rfind(".csv");
+    if (dot != std::string::npos && dot + 4 == output.size()) return output.substr(0, dot) + "-series.csv";
+    return output + "-series";
+}
+
+// Keep the time series of the finished runs only
+void FilterSeries(const std::string& series, const std::set<std::string>& finished)
+{
+    std::ifstream in(series);
+    if (!in) return;
+    std::string header;
+    std::getline(in, header);
+    std::ofstream out(series + ".tmp");
+    out << header << "\n";
+    std::string line;
+    while (std::getline(in, line)) {
+        if (finished.count(line.substr(0, line.find(',')))) out << line << "\n";
+    }
+    in.close();
+    out.close();
+    std::rename((series + ".tmp").c_str(), series.c_str());
+}
 
-    double avgPdr = (totalTx > 0) ? (totalRx / totalTx) * 100.0 : 0.0;
-    double avgDelay = (totalRx > 0) ? (totalDelay / totalRx) * 1000.0 : 0.0;
-    double avgThroughput = (stats.size() > 0) ? totalThroughput : 0.0;
-    double survival = ((double)(numNodes - deadCount) / numNodes) * 100.0;
+// Append the time series a run wrote to its own file, prefixed by the run key
+void AppendSeries(const std::string& series, const std::string& part, const std::string& key)
+{
+    std::ifstream in(part);
+    if (!in) return;
+    std::string line;
+    std::getline(in, line);
+    bool created = !std::ifstream(series);
+    std::ofstream out(series, std::ios::app);
+    if (created) out << "Run," << line << "\n";
+    while (std::getline(in, line)) out << key << "," << line << "\n";
+    in.close();
+    std::remove(part.c_str());
+}
+
+int RunCampaign(const std::string& gridFile, const std::string& output, uint32_t jobs)
+{
+    std::vector<CampaignRun> runs = ParseGrid(gridFile);
+    std::set<std::string> finished = LoadFinishedRuns(output);
+    std::string series = SeriesFileName(output);
+    FilterSeries(series, finished);
+    std::vector<const CampaignRun*> pending;
+    for (const auto& run : runs) {
+        // Check the parameters of every run before the first one starts
+        ParseRunConfig(run);
+        if (!finished.count(run.key)) pending.push_back(&run);
+    }
+
+    FILE* out = std::fopen(output.c_str(), "a");
+    NS_ABORT_MSG_IF(!out, "Cannot open " << output);
+    std::fseek(out, 0, SEEK_END);
+    if (std::ftell(out) == 0) {
+        std::fprintf(out, "%s\n", CAMPAIGN_HEADER.c_str());
+        std::fflush(out);
+    }
+    std::cerr << runs.size() << " runs, " << runs.size() - pending.size() << " already done, "
+              << jobs << " jobs" << std::endl;
+
+    struct Worker
+    {
+        const CampaignRun* run;
+        int fd;
+        std::chrono::steady_clock::time_point start;
+    };
+    std::map<pid_t, Worker> workers;
+    size_t next = 0;
+    uint32_t done = 0;
+    uint32_t failed = 0;
+    while (next < pending.size() || !workers.empty()) {
+        while (next < pending.size() && workers.size() < jobs) {
+            const CampaignRun* run = pending[next++];
+            int fds[2];
+            NS_ABORT_MSG_IF(pipe(fds) != 0, "pipe() failed");
+            std::cout.flush();
+            std::cerr.flush();
+            pid_t pid = fork();
+            NS_ABORT_MSG_IF(pid < 0, "fork() failed");
+            if (pid == 0) {
+                close(fds[0]);
+                ScenarioConfig c = ParseRunConfig(*run);
+                c.timeSeries = output + ".part." + std::to_string(getpid());
+                ScenarioResult r = RunScenario(c);
+                std::ostringstream row;
+                row << (c.useFuzzy ? "Modified_Fuzzy" : "Original_Paper") << "," << c.nodeSpeed << ","
+                    << c.numNodes << "," << c.simTime << "," << RngSeedManager::GetRun() << "," << r.pdr << ","
+                    << r.delay << "," << r.survival << "," << r.energy << "," << r.throughput << ","
+                    << r.floods << "," << r.localRecoveries << "," << r.recoveryMs;
+                std::string text = row.str();
+                bool written = write(fds[1], text.data(), text.size()) == static_cast<ssize_t>(text.size());
+                close(fds[1]);
+                // Skip the static destructors shared with the driver
+                _exit(written ? 0 : 1);
+            }
+            close(fds[1]);
+            workers[pid] = {run, fds[0], std::chrono::steady_clock::now()};
+        }
+
+        int status;
+        struct rusage usage;
+        pid_t pid = wait4(-1, &status, 0, &usage);
+        if (pid < 0) break;
+        auto it = workers.find(pid);
+        if (it == workers.end()) continue;
+        Worker worker = it->second;
+        workers.erase(it);
+        double wallClock = std::chrono::duration<double>(std::chrono::steady_clock::now() - worker.start).count();
+
+        std::string text;
+        char buffer[512];
+        ssize_t n;
+        while ((n = read(worker.fd, buffer, sizeof(buffer))) > 0) text.append(buffer, n);
+        close(worker.fd);
+
+        std::string part = output + ".part." + std::to_string(pid);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || text.empty()) {
+            std::remove(part.c_str());
+            failed++;
+            std::cerr << "FAILED " << worker.run->key << " (" << (WIFSIGNALED(status) ? "signal " : "status ")
+                      << (WIFSIGNALED(status) ? WTERMSIG(status) : WEXITSTATUS(status)) << ")" << std::endl;
+            continue;
+        }
+        // The time series first: if the driver dies before the row is written, it is dropped on resume
+        AppendSeries(series, part, worker.run->key);
+        // ru_maxrss is in kilobytes on Linux
+        std::fprintf(out, "%s,%s,%s,%.3f,%ld\n", worker.run->key.c_str(), worker.run->scenario.c_str(), text.c_str(),
+                     wallClock, static_cast<long>(usage.ru_maxrss));
+        std::fflush(out);
+        done++;
+        std::cerr << "[" << done << "/" << pending.size() << "] " << worker.run->key << " " << wallClock << " s" << std::endl;
+    }
+    std::fclose(out);
+
+    if (failed > 0) {
+        std::cerr << failed << " runs failed, run the campaign again to retry them" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    ScenarioConfig c;
+    std::string campaign;
+    std::string output = "aodv-eocw-campaign.csv";
+    uint32_t jobs = std::max(1u, std::thread::hardware_concurrency());
+
+    CommandLine cmd(__FILE__);
+    AddScenarioValues(cmd, c);
+    cmd.AddValue("campaign", "Run the campaign of this parameter grid file instead of a single run", campaign);
+    cmd.AddValue("output", "Output CSV file of the campaign", output);
+    cmd.AddValue("jobs", "Number of campaign runs in parallel", jobs);
+    cmd.Parse(argc, argv);
+
+    if (!campaign.empty()) {
+        return RunCampaign(campaign, output, std::max(1u, jobs));
+    }
+
+    ScenarioResult r = RunScenario(c);
 
     // Output CSV
-    std::cout << (useFuzzy ? "Modified_Fuzzy" : "Original_Paper") << ","
-              << nodeSpeed << ","
-              << numNodes << ","
-              << avgPdr << ","
-              << avgDelay << ","
-              << survival << ","
-              << totalConsumed << ","
-              << avgThroughput << std::endl;
+    std::cout << (c.useFuzzy ? "Modified_Fuzzy" : "Original_Paper") << ","
+              << c.nodeSpeed << ","
+              << c.numNodes << ","
+              << r.pdr << ","
+              << r.delay << ","
+              << r.survival << ","
+              << r.energy << ","
+              << r.throughput << ","
+              << r.floods << ","
+              << r.localRecoveries << ","
+              << r.recoveryMs << std::endl;
 
-    Simulator::Destroy();
     return 0;
 }
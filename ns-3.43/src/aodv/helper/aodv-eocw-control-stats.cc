@@ -0,0 +1,172 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "aodv-eocw-control-stats.h"
+
+#include "ns3/aodv-routing-protocol.h"
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("AodvEocwControlStats");
+
+namespace aodv
+{
+
+NS_OBJECT_ENSURE_REGISTERED(EocwControlStats);
+
+TypeId
+EocwControlStats::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::aodv::EocwControlStats")
+                            .SetParent<Object>()
+                            .SetGroupName("Aodv")
+                            .AddConstructor<EocwControlStats>();
+    return tid;
+}
+
+EocwControlStats::EocwControlStats()
+    : m_rreqReceived(CreateObject<CounterCalculator<>>()),
+      m_rreqSuppressed(CreateObject<CounterCalculator<>>()),
+      m_rreqForwarded(CreateObject<CounterCalculator<>>()),
+      m_rreqCancelled(CreateObject<CounterCalculator<>>()),
+      m_rrepSent(CreateObject<CounterCalculator<>>()),
+      m_forwardDelay(CreateObject<TimeMinMaxAvgTotalCalculator>()),
+      m_candidates(CreateObject<MinMaxAvgTotalCalculator<double>>()),
+      m_latency(CreateObject<TimeMinMaxAvgTotalCalculator>()),
+      m_score(CreateObject<MinMaxAvgTotalCalculator<double>>())
+{
+    m_rreqReceived->SetKey("rreq-received");
+    m_rreqSuppressed->SetKey("rreq-suppressed");
+    m_rreqForwarded->SetKey("rreq-forwarded");
+    m_rreqCancelled->SetKey("rreq-cancelled");
+    m_rrepSent->SetKey("rrep-sent");
+    m_forwardDelay->SetKey("rreq-forward-delay");
+    m_candidates->SetKey("eocw-candidates");
+    m_latency->SetKey("eocw-selection-latency");
+    m_score->SetKey("eocw-score");
+}
+
+void
+EocwControlStats::DoDispose()
+{
+    m_rreqReceived = nullptr;
+    m_rreqSuppressed = nullptr;
+    m_rreqForwarded = nullptr;
+    m_rreqCancelled = nullptr;
+    m_rrepSent = nullptr;
+    m_forwardDelay = nullptr;
+    m_candidates = nullptr;
+    m_latency = nullptr;
+    m_score = nullptr;
+    Object::DoDispose();
+}
+
+void
+EocwControlStats::Install(NodeContainer nodes)
+{
+    for (auto i = nodes.Begin(); i != nodes.End(); ++i)
+    {
+        Ptr<RoutingProtocol> aodv = (*i)->GetObject<RoutingProtocol>();
+        if (!aodv)
+        {
+            continue;
+        }
+        aodv->TraceConnectWithoutContext(
+            "RreqReceived",
+            MakeCallback(&EocwControlStats::NotifyRreqReceived, this));
+        aodv->TraceConnectWithoutContext(
+            "RreqSuppressed",
+            MakeCallback(&EocwControlStats::NotifyRreqSuppressed, this));
+        aodv->TraceConnectWithoutContext(
+            "RreqForwarded",
+            MakeCallback(&EocwControlStats::NotifyRreqForwarded, this));
+        aodv->TraceConnectWithoutContext(
+            "RreqCancelled",
+            MakeCallback(&EocwControlStats::NotifyRreqCancelled, this));
+        aodv->TraceConnectWithoutContext("RrepSent",
+                                         MakeCallback(&EocwControlStats::NotifyRrepSent, this));
+        aodv->TraceConnectWithoutContext(
+            "EocwSelection",
+            MakeCallback(&EocwControlStats::NotifyEocwSelection, this));
+    }
+}
+
+void
+EocwControlStats::SetContext(const std::string& context)
+{
+    m_rreqReceived->SetContext(context);
+    m_rreqSuppressed->SetContext(context);
+    m_rreqForwarded->SetContext(context);
+    m_rreqCancelled->SetContext(context);
+    m_rrepSent->SetContext(context);
+    m_forwardDelay->SetContext(context);
+    m_candidates->SetContext(context);
+    m_latency->SetContext(context);
+    m_score->SetContext(context);
+}
+
+void
+EocwControlStats::AddTo(DataCollector& collector) const
+{
+    collector.AddDataCalculator(m_rreqReceived);
+    collector.AddDataCalculator(m_rreqSuppressed);
+    collector.AddDataCalculator(m_rreqForwarded);
+    collector.AddDataCalculator(m_rreqCancelled);
+    collector.AddDataCalculator(m_rrepSent);
+    collector.AddDataCalculator(m_forwardDelay);
+    collector.AddDataCalculator(m_candidates);
+    collector.AddDataCalculator(m_latency);
+    collector.AddDataCalculator(m_score);
+}
+
+void
+EocwControlStats::NotifyRreqReceived(const RreqHeader& header, Ipv4Address sender)
+{
+    m_rreqReceived->Update();
+}
+
+void
+EocwControlStats::NotifyRreqSuppressed(const RreqHeader& header, double energyScore)
+{
+    NS_LOG_LOGIC("RREQ " << header.GetOrigin() << ":" << header.GetId()
+                         << " suppressed, energy score " << energyScore);
+    m_rreqSuppressed->Update();
+}
+
+void
+EocwControlStats::NotifyRreqForwarded(const RreqHeader& header, Time delay)
+{
+    m_rreqForwarded->Update();
+    m_forwardDelay->Update(delay);
+}
+
+void
+EocwControlStats::NotifyRreqCancelled(Ipv4Address origin, uint32_t id)
+{
+    m_rreqCancelled->Update();
+}
+
+void
+EocwControlStats::NotifyRrepSent(const RrepHeader& header, Ipv4Address nextHop)
+{
+    m_rrepSent->Update();
+}
+
+void
+EocwControlStats::NotifyEocwSelection(Ipv4Address origin,
+                                      uint32_t candidates,
+                                      Time latency,
+                                      double score)
+{
+    m_candidates->Update(candidates);
+    m_latency->Update(latency);
+    m_score->Update(score);
+}
+
+} // namespace aodv
+} // namespace ns3
@@ -0,0 +1,123 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#ifndef AODV_EOCW_CONTROL_STATS_H
+#define AODV_EOCW_CONTROL_STATS_H
+
+#include "ns3/aodv-packet.h"
+#include "ns3/basic-data-calculators.h"
+#include "ns3/data-collector.h"
+#include "ns3/node-container.h"
+#include "ns3/object.h"
+#include "ns3/time-data-calculators.h"
+
+#include <string>
+
+namespace ns3
+{
+namespace aodv
+{
+
+/**
+ * \ingroup aodv
+ * \brief Exports the control plane traces of AODV-EOCW through the stats framework.
+ *
+ * The RreqReceived, RreqSuppressed, RreqForwarded, RreqCancelled, RrepSent and EocwSelection
+ * traces of the routing protocols of the installed nodes feed one data calculator each, or
+ * more for the rebroadcasts and path selections, aggregated over the nodes. The calculators
+ * are registered with a DataCollector by AddTo(), and written with the other data of the run
+ * by any DataOutputInterface:
+ *
+ * - rreq-received, rreq-suppressed, rreq-forwarded, rreq-cancelled, rrep-sent: counters
+ * - rreq-forward-delay: statistics of the forward delays of the rebroadcasts
+ * - eocw-candidates, eocw-selection-latency, eocw-score: statistics over the path selections
+ *   of the number of paths offered, of the time from the first path offered to the
+ *   selection, and of the score of the chosen path
+ *
+ * The per node totals are also kept by the routing protocols themselves, see
+ * RoutingProtocol::GetControlCounters().
+ */
+class EocwControlStats : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    EocwControlStats();
+
+    /**
+     * Subscribe to the control plane traces of the AODV routing protocols of nodes
+     * \param nodes the nodes
+     */
+    void Install(NodeContainer nodes);
+
+    /**
+     * Set the context of the data calculators, e.g. the name of the run
+     * \param context the context
+     */
+    void SetContext(const std::string& context);
+
+    /**
+     * Register the data calculators with a data collector
+     * \param collector the data collector
+     */
+    void AddTo(DataCollector& collector) const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * \param header the RREQ header
+     * \param sender the neighbor the RREQ was received from
+     */
+    void NotifyRreqReceived(const RreqHeader& header, Ipv4Address sender);
+    /**
+     * \param header the RREQ header
+     * \param energyScore the residual energy score of the node
+     */
+    void NotifyRreqSuppressed(const RreqHeader& header, double energyScore);
+    /**
+     * \param header the RREQ header
+     * \param delay the forward delay
+     */
+    void NotifyRreqForwarded(const RreqHeader& header, Time delay);
+    /**
+     * \param origin the RREQ originator
+     * \param id the RREQ ID
+     */
+    void NotifyRreqCancelled(Ipv4Address origin, uint32_t id);
+    /**
+     * \param header the RREP header
+     * \param nextHop the neighbor the RREP is sent to
+     */
+    void NotifyRrepSent(const RrepHeader& header, Ipv4Address nextHop);
+    /**
+     * \param origin the RREQ originator
+     * \param candidates the number of paths offered
+     * \param latency the selection latency
+     * \param score the score of the chosen path
+     */
+    void NotifyEocwSelection(Ipv4Address origin, uint32_t candidates, Time latency, double score);
+
+    Ptr<CounterCalculator<>> m_rreqReceived;            ///< RREQs received
+    Ptr<CounterCalculator<>> m_rreqSuppressed;          ///< RREQs dropped by the energy cut-off
+    Ptr<CounterCalculator<>> m_rreqForwarded;           ///< RREQ rebroadcasts
+    Ptr<CounterCalculator<>> m_rreqCancelled;           ///< Floods whose rebroadcast was cancelled
+    Ptr<CounterCalculator<>> m_rrepSent;                ///< RREPs originated
+    Ptr<TimeMinMaxAvgTotalCalculator> m_forwardDelay;   ///< Forward delays
+    Ptr<MinMaxAvgTotalCalculator<double>> m_candidates; ///< Paths offered per selection
+    Ptr<TimeMinMaxAvgTotalCalculator> m_latency;        ///< Selection latencies
+    Ptr<MinMaxAvgTotalCalculator<double>> m_score;      ///< Chosen path scores
+};
+
+} // namespace aodv
+} // namespace ns3
+
+#endif /* AODV_EOCW_CONTROL_STATS_H */
@@ -0,0 +1,315 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "aodv-eocw-metrics-collector.h"
+
+#include "ns3/aodv-routing-protocol.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("AodvEocwMetricsCollector");
+
+namespace aodv
+{
+
+NS_OBJECT_ENSURE_REGISTERED(EocwMetricsCollector);
+
+TypeId
+EocwMetricsCollector::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::aodv::EocwMetricsCollector")
+            .SetParent<Object>()
+            .SetGroupName("Aodv")
+            .AddConstructor<EocwMetricsCollector>()
+            .AddAttribute("Window",
+                          "Width of the windows of the time series.",
+                          TimeValue(Seconds(10)),
+                          MakeTimeAccessor(&EocwMetricsCollector::m_window),
+                          MakeTimeChecker(TimeStep(1)))
+            .AddAttribute("Capacity",
+                          "Number of windows kept, the oldest ones being overwritten.",
+                          UintegerValue(256),
+                          MakeUintegerAccessor(&EocwMetricsCollector::m_capacity),
+                          MakeUintegerChecker<uint32_t>(1));
+    return tid;
+}
+
+EocwMetricsCollector::EocwMetricsCollector()
+    : m_first(0),
+      m_current(0),
+      m_nodes(0)
+{
+}
+
+void
+EocwMetricsCollector::NotifyConstructionCompleted()
+{
+    m_ring.assign(m_capacity, Window());
+    Object::NotifyConstructionCompleted();
+}
+
+void
+EocwMetricsCollector::DoDispose()
+{
+    m_sources.clear();
+    Object::DoDispose();
+}
+
+void
+EocwMetricsCollector::Install(Ptr<FlowMonitor> monitor)
+{
+    monitor->TraceConnectWithoutContext("FirstTx",
+                                        MakeCallback(&EocwMetricsCollector::NotifyFirstTx, this));
+    monitor->TraceConnectWithoutContext("LastRx",
+                                        MakeCallback(&EocwMetricsCollector::NotifyLastRx, this));
+    monitor->TraceConnectWithoutContext("Drop",
+                                        MakeCallback(&EocwMetricsCollector::NotifyDrop, this));
+}
+
+void
+EocwMetricsCollector::Install(NodeContainer nodes)
+{
+    for (auto i = nodes.Begin(); i != nodes.End(); ++i)
+    {
+        m_nodes++;
+        Ptr<RoutingProtocol> aodv = (*i)->GetObject<RoutingProtocol>();
+        if (!aodv)
+        {
+            continue;
+        }
+        aodv->TraceConnectWithoutContext(
+            "RouteDiscovery",
+            MakeCallback(&EocwMetricsCollector::NotifyRouteDiscovery, this));
+        aodv->TraceConnectWithoutContext(
+            "RouteRecovery",
+            MakeCallback(&EocwMetricsCollector::NotifyRouteRecovery, this));
+    }
+}
+
+void
+EocwMetricsCollector::Install(energy::EnergySourceContainer sources)
+{
+    for (auto i = sources.Begin(); i != sources.End(); ++i)
+    {
+        uint32_t nodeId = (*i)->GetNode()->GetId();
+        (*i)->TraceConnectWithoutContext(
+            "RemainingEnergy",
+            MakeCallback(&EocwMetricsCollector::NotifyRemainingEnergy, this).Bind(nodeId));
+        m_sources.push_back(*i);
+    }
+}
+
+EocwMetricsCollector::Window&
+EocwMetricsCollector::GetCurrentWindow()
+{
+    int64_t w = Simulator::Now().GetTimeStep() / m_window.GetTimeStep();
+    if (w == m_current)
+    {
+        return m_ring[w % m_capacity];
+    }
+    // Start the windows elapsed since the last event, at most a turn of the ring
+    for (int64_t k = std::max(m_current + 1, w - m_capacity + 1); k <= w; ++k)
+    {
+        Window& window = m_ring[k % m_capacity];
+        window = Window();
+        window.nodesDown = m_totals.nodesDown;
+    }
+    m_current = w;
+    m_first = std::max<int64_t>(m_first, w - m_capacity + 1);
+    return m_ring[w % m_capacity];
+}
+
+void
+EocwMetricsCollector::NotifyFirstTx(FlowId flowId, FlowPacketId packetId, uint32_t packetSize)
+{
+    GetCurrentWindow().txPackets++;
+    m_totals.txPackets++;
+    if (flowId >= m_flows.size())
+    {
+        m_flows.resize(flowId + 1);
+    }
+    if (!m_flows[flowId].started)
+    {
+        m_flows[flowId].started = true;
+        m_flows[flowId].firstTx = Simulator::Now();
+    }
+}
+
+void
+EocwMetricsCollector::NotifyLastRx(FlowId flowId,
+                                   FlowPacketId packetId,
+                                   uint32_t packetSize,
+                                   Time delay)
+{
+    Window& window = GetCurrentWindow();
+    window.rxPackets++;
+    window.rxBytes += packetSize;
+    window.delaySum += delay;
+    m_totals.rxPackets++;
+    m_totals.rxBytes += packetSize;
+    m_totals.delaySum += delay;
+    // A packet is received only after its flow was started
+    m_flows[flowId].lastRx = Simulator::Now();
+    m_flows[flowId].rxBytes += packetSize;
+}
+
+void
+EocwMetricsCollector::NotifyDrop(FlowId flowId,
+                                 FlowPacketId packetId,
+                                 uint32_t packetSize,
+                                 uint32_t reasonCode)
+{
+    GetCurrentWindow().dropPackets++;
+    m_totals.dropPackets++;
+}
+
+void
+EocwMetricsCollector::NotifyRemainingEnergy(uint32_t nodeId, double oldValue, double newValue)
+{
+    // Only consumption is accounted, not the initial charge nor harvesting
+    if (newValue >= oldValue || (nodeId < m_down.size() && m_down[nodeId]))
+    {
+        return;
+    }
+    GetCurrentWindow().energyConsumed += oldValue - newValue;
+    m_totals.energyConsumed += oldValue - newValue;
+}
+
+void
+EocwMetricsCollector::NotifyRouteDiscovery(Ipv4Address dst)
+{
+    GetCurrentWindow().routeDiscoveries++;
+    m_totals.routeDiscoveries++;
+}
+
+void
+EocwMetricsCollector::NotifyRouteRecovery(Ipv4Address dst, Time latency, bool local)
+{
+    Window& window = GetCurrentWindow();
+    if (local)
+    {
+        window.localRecoveries++;
+        m_totals.localRecoveries++;
+    }
+    else
+    {
+        window.discoveryRecoveries++;
+        m_totals.discoveryRecoveries++;
+    }
+    window.recoveryLatencySum += latency;
+    m_totals.recoveryLatencySum += latency;
+}
+
+void
+EocwMetricsCollector::NotifyNodeDown(Ptr<Node> node)
+{
+    uint32_t nodeId = node->GetId();
+    if (nodeId >= m_down.size())
+    {
+        m_down.resize(nodeId + 1, false);
+    }
+    if (m_down[nodeId])
+    {
+        return;
+    }
+    double remaining = 0;
+    for (const auto& source : m_sources)
+    {
+        if (source->GetNode() == node)
+        {
+            // Accounts the consumption up to now through the trace, before the node is down
+            remaining += source->GetRemainingEnergy();
+        }
+    }
+    m_down[nodeId] = true;
+    NS_LOG_LOGIC("Node " << nodeId << " down, " << remaining << " J left");
+
+    Window& window = GetCurrentWindow();
+    window.energyConsumed += remaining;
+    m_totals.energyConsumed += remaining;
+    m_totals.nodesDown++;
+    window.nodesDown = m_totals.nodesDown;
+}
+
+void
+EocwMetricsCollector::UpdateEnergy()
+{
+    for (const auto& source : m_sources)
+    {
+        uint32_t nodeId = source->GetNode()->GetId();
+        if (nodeId >= m_down.size() || !m_down[nodeId])
+        {
+            source->GetRemainingEnergy();
+        }
+    }
+}
+
+const EocwMetricsCollector::Window&
+EocwMetricsCollector::GetTotals() const
+{
+    return m_totals;
+}
+
+double
+EocwMetricsCollector::GetThroughput() const
+{
+    double throughput = 0;
+    for (const auto& flow : m_flows)
+    {
+        Time duration = flow.lastRx - flow.firstTx;
+        if (flow.rxBytes > 0 && duration.IsStrictlyPositive())
+        {
+            throughput += flow.rxBytes * 8.0 / duration.GetSeconds() / 1024.0;
+        }
+    }
+    return throughput;
+}
+
+double
+EocwMetricsCollector::GetSurvivalRate() const
+{
+    if (m_nodes == 0)
+    {
+        return 0;
+    }
+    return 100.0 * (m_nodes - m_totals.nodesDown) / m_nodes;
+}
+
+void
+EocwMetricsCollector::WriteTimeSeries(std::ostream& os)
+{
+    // Start the windows up to now, even when nothing happened in the last ones
+    GetCurrentWindow();
+    os << "Time,TxPackets,RxPackets,PDR,DelayMs,ThroughputKbps,Drops,EnergyJ,SurvivalRate,"
+          "Floods,LocalRecoveries,RecoveryMs\n";
+    for (int64_t k = m_first; k <= m_current; ++k)
+    {
+        const Window& window = m_ring[k % m_capacity];
+        uint32_t recoveries = window.localRecoveries + window.discoveryRecoveries;
+        double pdr = window.txPackets > 0 ? 100.0 * window.rxPackets / window.txPackets : 0;
+        double delay =
+            window.rxPackets > 0 ? window.delaySum.GetSeconds() * 1000 / window.rxPackets : 0;
+        double survival =
+            m_nodes > 0 ? 100.0 * (m_nodes - window.nodesDown) / m_nodes : 0;
+        double recovery =
+            recoveries > 0 ? window.recoveryLatencySum.GetSeconds() * 1000 / recoveries : 0;
+        os << ((k + 1) * m_window).GetSeconds() << "," << window.txPackets << ","
+           << window.rxPackets << "," << pdr << "," << delay << ","
+           << window.rxBytes * 8.0 / m_window.GetSeconds() / 1024.0 << "," << window.dropPackets
+           << "," << window.energyConsumed << "," << survival << "," << window.routeDiscoveries
+           << "," << window.localRecoveries << "," << recovery << "\n";
+    }
+}
+
+} // namespace aodv
+} // namespace ns3
@@ -0,0 +1,188 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#ifndef AODV_EOCW_METRICS_COLLECTOR_H
+#define AODV_EOCW_METRICS_COLLECTOR_H
+
+#include "ns3/energy-source-container.h"
+#include "ns3/flow-monitor.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+
+#include <ostream>
+#include <vector>
+
+namespace ns3
+{
+namespace aodv
+{
+
+/**
+ * \ingroup aodv
+ * \brief Collects the metrics of an AODV-EOCW scenario while it runs.
+ *
+ * The collector subscribes to the packet traces of a FlowMonitor, to the remaining energy
+ * of the energy sources and to the route discovery and recovery traces of the AODV routing
+ * protocols. Every event is accounted in the window of Window seconds it falls in. The
+ * windows are kept in a ring buffer of Capacity windows allocated once, the oldest being
+ * overwritten when a run is longer than the ring. Totals over the whole run are kept aside,
+ * so the end of run metrics do not depend on the ring capacity.
+ *
+ * A node is only counted down when the scenario calls NotifyNodeDown(); from then on, all
+ * its initial energy counts as consumed.
+ */
+class EocwMetricsCollector : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    EocwMetricsCollector();
+
+    /// Metrics accounted over a window, or over the whole run
+    struct Window
+    {
+        uint32_t txPackets{0};           ///< Packets entering the monitored flows
+        uint32_t rxPackets{0};           ///< Packets received at their destination
+        uint64_t rxBytes{0};             ///< Bytes received at their destination
+        uint32_t dropPackets{0};         ///< Packets dropped
+        Time delaySum;                   ///< Sum of the delays of the received packets
+        double energyConsumed{0};        ///< Energy consumed, in J
+        uint32_t nodesDown{0};           ///< Nodes down at the end of the window
+        uint32_t routeDiscoveries{0};    ///< RREQ floods originated
+        uint32_t localRecoveries{0};     ///< Broken routes switched to an alternate path
+        uint32_t discoveryRecoveries{0}; ///< Broken routes discovered again
+        Time recoveryLatencySum;         ///< Sum of the route recovery latencies
+    };
+
+    /**
+     * Subscribe to the packet traces of a flow monitor
+     * \param monitor the flow monitor
+     */
+    void Install(Ptr<FlowMonitor> monitor);
+    /**
+     * Subscribe to the route traces of the AODV routing protocols of nodes, and count them
+     * for the survival rate
+     * \param nodes the nodes
+     */
+    void Install(NodeContainer nodes);
+    /**
+     * Subscribe to the remaining energy of energy sources
+     * \param sources the energy sources
+     */
+    void Install(energy::EnergySourceContainer sources);
+
+    /**
+     * Count a node down: its remaining energy is counted as consumed, and its energy source
+     * is no longer followed
+     * \param node the node
+     */
+    void NotifyNodeDown(Ptr<Node> node);
+
+    /// Bring the energy consumed by the nodes still up to date
+    void UpdateEnergy();
+
+    /**
+     * \returns the metrics over the whole run
+     */
+    const Window& GetTotals() const;
+    /**
+     * \returns the sum over the flows of their throughput from their first transmission to
+     * their last reception, in kbit/s (1024 bit/s)
+     */
+    double GetThroughput() const;
+    /**
+     * \returns the percentage of nodes still up
+     */
+    double GetSurvivalRate() const;
+
+    /**
+     * Write the windows still in the ring buffer as CSV, one line per window, with a header
+     * \param os the output stream
+     */
+    void WriteTimeSeries(std::ostream& os);
+
+  protected:
+    void NotifyConstructionCompleted() override;
+    void DoDispose() override;
+
+  private:
+    /// Times of the packets of a flow
+    struct FlowTimes
+    {
+        Time firstTx;        ///< First transmission
+        Time lastRx;         ///< Last reception
+        uint64_t rxBytes{0}; ///< Bytes received
+        bool started{false}; ///< Whether a packet was transmitted
+    };
+
+    /**
+     * \returns the window of the current time, starting the windows elapsed since the last
+     * event
+     */
+    Window& GetCurrentWindow();
+
+    /**
+     * \param flowId flow identification
+     * \param packetId Packet ID
+     * \param packetSize packet size
+     */
+    void NotifyFirstTx(FlowId flowId, FlowPacketId packetId, uint32_t packetSize);
+    /**
+     * \param flowId flow identification
+     * \param packetId Packet ID
+     * \param packetSize packet size
+     * \param delay end-to-end delay of the packet
+     */
+    void NotifyLastRx(FlowId flowId, FlowPacketId packetId, uint32_t packetSize, Time delay);
+    /**
+     * \param flowId flow identification
+     * \param packetId Packet ID
+     * \param packetSize packet size
+     * \param reasonCode drop reason code
+     */
+    void NotifyDrop(FlowId flowId,
+                    FlowPacketId packetId,
+                    uint32_t packetSize,
+                    uint32_t reasonCode);
+    /**
+     * \param nodeId the node of the energy source
+     * \param oldValue the previous remaining energy
+     * \param newValue the remaining energy
+     */
+    void NotifyRemainingEnergy(uint32_t nodeId, double oldValue, double newValue);
+    /**
+     * \param dst the destination of the route discovery
+     */
+    void NotifyRouteDiscovery(Ipv4Address dst);
+    /**
+     * \param dst the destination of the recovered route
+     * \param latency the time the route was broken for
+     * \param local whether the route was switched to an alternate path
+     */
+    void NotifyRouteRecovery(Ipv4Address dst, Time latency, bool local);
+
+    Time m_window;                                    ///< Width of a window
+    uint32_t m_capacity;                              ///< Number of windows of the ring buffer
+    std::vector<Window> m_ring;                       ///< Ring buffer of the windows
+    int64_t m_first;                                  ///< Number of the oldest window in the ring
+    int64_t m_current;                                ///< Number of the current window
+    Window m_totals;                                  ///< Metrics over the whole run
+    std::vector<FlowTimes> m_flows;                   ///< Packet times, by flow id
+    uint32_t m_nodes;                                 ///< Number of nodes
+    std::vector<bool> m_down;                         ///< Whether a node is down, by node id
+    std::vector<Ptr<energy::EnergySource>> m_sources; ///< Energy sources followed
+};
+
+} // namespace aodv
+} // namespace ns3
+
+#endif /* AODV_EOCW_METRICS_COLLECTOR_H */
@@ -13,10 +13,26 @@
 #include "ns3/names.h"
 #include "ns3/node-list.h"
 #include "ns3/ptr.h"
+#include "ns3/simulator.h"
+
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <vector>
 
 namespace ns3
 {
 
+namespace
+{
+
+/// First word of a state file
+constexpr uint32_t STATE_MAGIC = 0x414f4456;
+/// Version of the state file format
+constexpr uint32_t STATE_VERSION = 1;
+
+} // namespace
+
 AodvHelper::AodvHelper()
     : Ipv4RoutingHelper()
 {
@@ -83,4 +99,105 @@ AodvHelper::AssignStreams(NodeContainer c, int64_t stream)
     return (currentStream - stream);
 }
 
+void
+AodvHelper::SaveState(NodeContainer c, std::string filename)
+{
+    std::vector<Ptr<Node>> nodes;
+    // Magic, version and number of nodes, then the ID, size and state of each node
+    uint32_t size = 12;
+    for (auto i = c.Begin(); i != c.End(); ++i)
+    {
+        Ptr<aodv::RoutingProtocol> aodv = (*i)->GetObject<aodv::RoutingProtocol>();
+        if (aodv)
+        {
+            nodes.push_back(*i);
+            size += 8 + aodv->GetSerializedStateSize();
+        }
+    }
+
+    Buffer buffer;
+    buffer.AddAtStart(size);
+    Buffer::Iterator i = buffer.Begin();
+    i.WriteHtonU32(STATE_MAGIC);
+    i.WriteHtonU32(STATE_VERSION);
+    i.WriteHtonU32(nodes.size());
+    for (const auto& node : nodes)
+    {
+        Ptr<aodv::RoutingProtocol> aodv = node->GetObject<aodv::RoutingProtocol>();
+        i.WriteHtonU32(node->GetId());
+        i.WriteHtonU32(aodv->GetSerializedStateSize());
+        aodv->SerializeState(i);
+    }
+    NS_ASSERT(i.GetDistanceFrom(buffer.Begin()) == size);
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        NS_FATAL_ERROR("Can not open AODV state file " << filename);
+    }
+    buffer.CopyData(&file, size);
+}
+
+void
+AodvHelper::SaveStateAt(Time delay, NodeContainer c, std::string filename)
+{
+    Simulator::Schedule(delay, &AodvHelper::SaveState, c, filename);
+}
+
+void
+AodvHelper::RestoreState(NodeContainer c, std::string filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file)
+    {
+        NS_FATAL_ERROR("Can not open AODV state file " << filename);
+    }
+    std::vector<uint8_t> data{std::istreambuf_iterator<char>(file),
+                              std::istreambuf_iterator<char>()};
+    Buffer buffer;
+    buffer.AddAtStart(data.size());
+    buffer.Begin().Write(data.data(), data.size());
+
+    Buffer::Iterator i = buffer.Begin();
+    if (data.size() < 12 || i.ReadNtohU32() != STATE_MAGIC || i.ReadNtohU32() != STATE_VERSION)
+    {
+        NS_FATAL_ERROR("Not an AODV state file: " << filename);
+    }
+    std::map<uint32_t, Ptr<aodv::RoutingProtocol>> nodes;
+    for (auto n = c.Begin(); n != c.End(); ++n)
+    {
+        Ptr<aodv::RoutingProtocol> aodv = (*n)->GetObject<aodv::RoutingProtocol>();
+        if (aodv)
+        {
+            nodes[(*n)->GetId()] = aodv;
+        }
+    }
+    for (uint32_t n = i.ReadNtohU32(); n > 0; --n)
+    {
+        if (i.GetRemainingSize() < 8)
+        {
+            NS_FATAL_ERROR("Truncated AODV state file: " << filename);
+        }
+        uint32_t id = i.ReadNtohU32();
+        uint32_t size = i.ReadNtohU32();
+        if (i.GetRemainingSize() < size)
+        {
+            NS_FATAL_ERROR("Truncated AODV state file: " << filename);
+        }
+        auto node = nodes.find(id);
+        if (node != nodes.end())
+        {
+            // The buffer is shared by the events, not copied
+            uint32_t offset = i.GetDistanceFrom(buffer.Begin());
+            Ptr<aodv::RoutingProtocol> aodv = node->second;
+            Simulator::ScheduleWithContext(id, Seconds(0), [buffer, offset, aodv]() {
+                Buffer::Iterator start = buffer.Begin();
+                start.Next(offset);
+                aodv->DeserializeState(start);
+            });
+        }
+        i.Next(size);
+    }
+}
+
 } // namespace ns3
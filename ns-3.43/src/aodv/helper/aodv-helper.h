@@ -64,6 +64,35 @@ class AodvHelper : public Ipv4RoutingHelper
      */
     int64_t AssignStreams(NodeContainer c, int64_t stream);
 
+    /**
+     * Save the state of AODV on the nodes to a file: their routing tables, neighbors, RREQ
+     * ID caches, sequence numbers and RREQ IDs, see aodv::RoutingProtocol::SerializeState.
+     * Nodes without AODV are left out.
+     *
+     * \param c the nodes
+     * \param filename the name of the file, overwritten
+     */
+    static void SaveState(NodeContainer c, std::string filename);
+    /**
+     * Schedule SaveState() after a delay, e.g. to save the routes found by a warm-up run
+     *
+     * \param delay the delay after which the state is saved
+     * \param c the nodes
+     * \param filename the name of the file, overwritten
+     */
+    static void SaveStateAt(Time delay, NodeContainer c, std::string filename);
+    /**
+     * Restore the state saved by SaveState() on the nodes with the same IDs, so that a run
+     * starts with the routes of a previous one. The file is read at once, and the state of
+     * each node restored at the start of the simulation in the context of the node, with
+     * the times as they were when the state was saved. The interfaces of the nodes must
+     * have the addresses they had then. The ARP caches are not restored.
+     *
+     * \param c the nodes
+     * \param filename the name of the file
+     */
+    static void RestoreState(NodeContainer c, std::string filename);
+
   private:
     /** the factory to create AODV routing object */
     ObjectFactory m_agentFactory;
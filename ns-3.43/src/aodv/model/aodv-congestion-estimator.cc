@@ -0,0 +1,265 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "aodv-congestion-estimator.h"
+
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/qos-utils.h"
+#include "ns3/simulator.h"
+#include "ns3/wifi-mac-queue.h"
+#include "ns3/wifi-mac.h"
+#include "ns3/wifi-mpdu.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-phy-state-helper.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-remote-station-manager.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("AodvCongestionEstimator");
+
+namespace aodv
+{
+
+NS_OBJECT_ENSURE_REGISTERED(CongestionEstimator);
+
+TypeId
+CongestionEstimator::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::aodv::CongestionEstimator").SetParent<Object>().SetGroupName("Aodv");
+    return tid;
+}
+
+NS_OBJECT_ENSURE_REGISTERED(WifiCongestionEstimator);
+
+TypeId
+WifiCongestionEstimator::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::aodv::WifiCongestionEstimator")
+            .SetParent<CongestionEstimator>()
+            .SetGroupName("Aodv")
+            .AddConstructor<WifiCongestionEstimator>()
+            .AddAttribute("TimeConstant",
+                          "Time constant of the queue occupancy and busy fraction averages.",
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(&WifiCongestionEstimator::m_timeConstant),
+                          MakeTimeChecker(TimeStep(1)))
+            .AddAttribute("RetryAlpha",
+                          "Weight of a new transmission attempt in the retransmission rate "
+                          "average.",
+                          DoubleValue(0.1),
+                          MakeDoubleAccessor(&WifiCongestionEstimator::m_retryAlpha),
+                          MakeDoubleChecker<double>(0.0, 1.0))
+            .AddAttribute("QueueWeight",
+                          "Weight of the queue occupancy in the congestion score.",
+                          DoubleValue(0.5),
+                          MakeDoubleAccessor(&WifiCongestionEstimator::m_queueWeight),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("BusyWeight",
+                          "Weight of the busy fraction in the congestion score.",
+                          DoubleValue(0.3),
+                          MakeDoubleAccessor(&WifiCongestionEstimator::m_busyWeight),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("RetryWeight",
+                          "Weight of the retransmission rate in the congestion score.",
+                          DoubleValue(0.2),
+                          MakeDoubleAccessor(&WifiCongestionEstimator::m_retryWeight),
+                          MakeDoubleChecker<double>(0.0));
+    return tid;
+}
+
+WifiCongestionEstimator::WifiCongestionEstimator()
+    : m_queuedPackets(0),
+      m_queueCapacity(0),
+      m_queueAvg(0),
+      m_queueLast(0),
+      m_busyAvg(0),
+      m_retryAvg(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+WifiCongestionEstimator::~WifiCongestionEstimator()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+WifiCongestionEstimator::DoInitialize()
+{
+    NS_LOG_FUNCTION(this);
+    Ptr<Node> node = GetObject<Node>();
+    for (uint32_t i = 0; node && i < node->GetNDevices(); ++i)
+    {
+        Ptr<WifiNetDevice> dev = DynamicCast<WifiNetDevice>(node->GetDevice(i));
+        if (!dev)
+        {
+            continue;
+        }
+        Ptr<WifiMac> mac = dev->GetMac();
+        for (auto ac : {AC_BE_NQOS, AC_BE, AC_BK, AC_VI, AC_VO})
+        {
+            Ptr<WifiMacQueue> queue = mac->GetTxopQueue(ac);
+            if (!queue)
+            {
+                continue;
+            }
+            queue->TraceConnectWithoutContext(
+                "PacketsInQueue",
+                MakeCallback(&WifiCongestionEstimator::NotifyPacketsInQueue, this));
+            m_queuedPackets += queue->GetNPackets();
+            m_queueCapacity += queue->GetMaxSize().GetValue();
+            m_queues.push_back(queue);
+        }
+        m_devices.push_back(dev);
+        mac->TraceConnectWithoutContext("AckedMpdu",
+                                        MakeCallback(&WifiCongestionEstimator::NotifyAcked, this));
+        dev->GetRemoteStationManager()->TraceConnectWithoutContext(
+            "MacTxDataFailed",
+            MakeCallback(&WifiCongestionEstimator::NotifyTxFailed, this));
+        dev->GetPhy()->GetState()->TraceConnectWithoutContext(
+            "State",
+            MakeCallback(&WifiCongestionEstimator::NotifyPhyState, this));
+    }
+    m_queueTime = Simulator::Now();
+    m_busyTime = Simulator::Now();
+    m_queueLast = (m_queueCapacity > 0) ? double(m_queuedPackets) / m_queueCapacity : 0;
+    m_queueAvg = m_queueLast;
+    CongestionEstimator::DoInitialize();
+}
+
+void
+WifiCongestionEstimator::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto& queue : m_queues)
+    {
+        queue->TraceDisconnectWithoutContext(
+            "PacketsInQueue",
+            MakeCallback(&WifiCongestionEstimator::NotifyPacketsInQueue, this));
+    }
+    for (const auto& dev : m_devices)
+    {
+        dev->GetMac()->TraceDisconnectWithoutContext(
+            "AckedMpdu",
+            MakeCallback(&WifiCongestionEstimator::NotifyAcked, this));
+        dev->GetRemoteStationManager()->TraceDisconnectWithoutContext(
+            "MacTxDataFailed",
+            MakeCallback(&WifiCongestionEstimator::NotifyTxFailed, this));
+        dev->GetPhy()->GetState()->TraceDisconnectWithoutContext(
+            "State",
+            MakeCallback(&WifiCongestionEstimator::NotifyPhyState, this));
+    }
+    m_queues.clear();
+    m_devices.clear();
+    CongestionEstimator::DoDispose();
+}
+
+double
+WifiCongestionEstimator::GetCongestionScore() const
+{
+    double sumW = m_queueWeight + m_busyWeight + m_retryWeight;
+    if (sumW == 0)
+    {
+        return 1.0;
+    }
+    double congestion = (m_queueWeight * GetQueueOccupancy() + m_busyWeight * GetBusyFraction() +
+                         m_retryWeight * GetRetryRate()) /
+                        sumW;
+    return std::clamp(1.0 - congestion, 0.0, 1.0);
+}
+
+double
+WifiCongestionEstimator::GetQueueOccupancy() const
+{
+    // The occupancy has been m_queueLast since m_queueTime: decay the average towards it
+    double decay = std::exp(-(Simulator::Now() - m_queueTime).GetSeconds() /
+                            m_timeConstant.GetSeconds());
+    return m_queueLast + (m_queueAvg - m_queueLast) * decay;
+}
+
+double
+WifiCongestionEstimator::GetBusyFraction() const
+{
+    // The PHY state periods are traced when they end: the current one is still open
+    bool busy = std::any_of(m_devices.begin(), m_devices.end(), [](const auto& dev) {
+        Ptr<WifiPhyStateHelper> state = dev->GetPhy()->GetState();
+        return state->IsStateCcaBusy() || state->IsStateRx();
+    });
+    double decay = std::exp(-(Simulator::Now() - m_busyTime).GetSeconds() /
+                            m_timeConstant.GetSeconds());
+    return m_busyAvg * decay + (busy ? 1.0 - decay : 0.0);
+}
+
+double
+WifiCongestionEstimator::GetRetryRate() const
+{
+    return m_retryAvg;
+}
+
+void
+WifiCongestionEstimator::UpdateQueueOccupancy(double occupancy)
+{
+    NS_LOG_FUNCTION(this << occupancy);
+    m_queueAvg = GetQueueOccupancy();
+    m_queueLast = occupancy;
+    m_queueTime = Simulator::Now();
+}
+
+void
+WifiCongestionEstimator::AddPhyPeriod(Time duration, bool busy)
+{
+    NS_LOG_FUNCTION(this << duration << busy);
+    double decay = std::exp(-duration.GetSeconds() / m_timeConstant.GetSeconds());
+    m_busyAvg = m_busyAvg * decay + (busy ? 1.0 - decay : 0.0);
+    m_busyTime = Simulator::Now();
+}
+
+void
+WifiCongestionEstimator::AddTxAttempt(bool acked)
+{
+    NS_LOG_FUNCTION(this << acked);
+    m_retryAvg += m_retryAlpha * ((acked ? 0.0 : 1.0) - m_retryAvg);
+}
+
+void
+WifiCongestionEstimator::NotifyPacketsInQueue(uint32_t oldValue, uint32_t newValue)
+{
+    m_queuedPackets = m_queuedPackets + newValue - oldValue;
+    if (m_queueCapacity > 0)
+    {
+        UpdateQueueOccupancy(std::min(1.0, double(m_queuedPackets) / m_queueCapacity));
+    }
+}
+
+void
+WifiCongestionEstimator::NotifyPhyState(Time start, Time duration, WifiPhyState state)
+{
+    AddPhyPeriod(duration, state == WifiPhyState::CCA_BUSY || state == WifiPhyState::RX);
+}
+
+void
+WifiCongestionEstimator::NotifyAcked(Ptr<const WifiMpdu> mpdu)
+{
+    AddTxAttempt(true);
+}
+
+void
+WifiCongestionEstimator::NotifyTxFailed(Mac48Address address)
+{
+    AddTxAttempt(false);
+}
+
+} // namespace aodv
+} // namespace ns3
@@ -0,0 +1,164 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#ifndef AODV_CONGESTION_ESTIMATOR_H
+#define AODV_CONGESTION_ESTIMATOR_H
+
+#include "ns3/mac48-address.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/wifi-phy-state.h"
+
+#include <vector>
+
+namespace ns3
+{
+
+class WifiMacQueue;
+class WifiMpdu;
+class WifiNetDevice;
+
+namespace aodv
+{
+
+/**
+ * \ingroup aodv
+ * \brief Estimates how congested a node is, for the EOCW congestion degree score.
+ *
+ * An estimator is aggregated to the node; when present, the AODV routing protocol reads its
+ * score instead of sampling the MAC queue itself. Implementations are expected to keep their
+ * estimate up to date from traces so that GetCongestionScore() is O(1).
+ */
+class CongestionEstimator : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \returns the congestion degree score, in [0, 1]: 1 for an idle node, 0 for a
+     * saturated one
+     */
+    virtual double GetCongestionScore() const = 0;
+};
+
+/**
+ * \ingroup aodv
+ * \brief Congestion estimator combining three wifi signals, each smoothed incrementally:
+ *
+ * - the occupancy of the MAC queues of every access category, as an exponentially
+ *   time-weighted moving average (time constant TimeConstant) of the total number of
+ *   queued MPDUs over the total queue capacity;
+ * - the fraction of time the PHY senses the medium busy (CCA_BUSY or RX), with the same
+ *   time constant;
+ * - the MAC retransmission rate, as an exponentially weighted moving average (weight
+ *   RetryAlpha) over transmission attempts, a failed attempt counting as 1 and an
+ *   acknowledged MPDU as 0.
+ *
+ * The score is 1 minus the weighted average of the three. The wifi devices of the node are
+ * hooked when the estimator is initialized, i.e. when the simulation starts.
+ */
+class WifiCongestionEstimator : public CongestionEstimator
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    WifiCongestionEstimator();
+    ~WifiCongestionEstimator() override;
+
+    double GetCongestionScore() const override;
+
+    /**
+     * \returns the smoothed queue occupancy, in [0, 1]
+     */
+    double GetQueueOccupancy() const;
+    /**
+     * The average is aged up to now, the medium being taken as busy since the last PHY
+     * state period if a watched PHY senses it busy now
+     * \returns the smoothed fraction of time the medium is sensed busy, in [0, 1]
+     */
+    double GetBusyFraction() const;
+    /**
+     * \returns the smoothed retransmission rate, in [0, 1]
+     */
+    double GetRetryRate() const;
+
+    /**
+     * Record a new instantaneous queue occupancy
+     * \param occupancy the fraction of the queue capacity in use
+     */
+    void UpdateQueueOccupancy(double occupancy);
+    /**
+     * Record a PHY state period
+     * \param duration the duration of the period
+     * \param busy whether the medium was sensed busy
+     */
+    void AddPhyPeriod(Time duration, bool busy);
+    /**
+     * Record the outcome of a transmission attempt
+     * \param acked whether the MPDU was acknowledged
+     */
+    void AddTxAttempt(bool acked);
+
+  protected:
+    void DoInitialize() override;
+    void DoDispose() override;
+
+  private:
+    /**
+     * Trace sink for the number of packets in one of the watched queues
+     * \param oldValue the previous number of packets
+     * \param newValue the current number of packets
+     */
+    void NotifyPacketsInQueue(uint32_t oldValue, uint32_t newValue);
+    /**
+     * Trace sink for the PHY state periods
+     * \param start the start of the period
+     * \param duration the duration of the period
+     * \param state the PHY state during the period
+     */
+    void NotifyPhyState(Time start, Time duration, WifiPhyState state);
+    /**
+     * Trace sink for acknowledged MPDUs
+     * \param mpdu the MPDU
+     */
+    void NotifyAcked(Ptr<const WifiMpdu> mpdu);
+    /**
+     * Trace sink for failed data transmissions
+     * \param address the receiver address
+     */
+    void NotifyTxFailed(Mac48Address address);
+
+    Time m_timeConstant;  ///< Time constant of the queue and busy averages
+    double m_retryAlpha;  ///< Weight of a new attempt in the retransmission average
+    double m_queueWeight; ///< Weight of the queue occupancy in the score
+    double m_busyWeight;  ///< Weight of the busy fraction in the score
+    double m_retryWeight; ///< Weight of the retransmission rate in the score
+
+    std::vector<Ptr<WifiNetDevice>> m_devices; ///< Watched devices
+    std::vector<Ptr<WifiMacQueue>> m_queues; ///< Watched queues
+    uint32_t m_queuedPackets;                ///< Packets in the watched queues
+    uint32_t m_queueCapacity;                ///< Capacity of the watched queues, in packets
+
+    double m_queueAvg;   ///< Queue occupancy average as of m_queueTime
+    double m_queueLast;  ///< Queue occupancy since m_queueTime
+    Time m_queueTime;    ///< Time of the last queue occupancy change
+    double m_busyAvg;    ///< Busy fraction average as of m_busyTime
+    Time m_busyTime;     ///< End of the last PHY state period
+    double m_retryAvg;   ///< Retransmission rate average
+};
+
+} // namespace aodv
+} // namespace ns3
+
+#endif /* AODV_CONGESTION_ESTIMATOR_H */
@@ -0,0 +1,215 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "aodv-eocw-batch.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+namespace ns3
+{
+namespace aodv
+{
+
+namespace
+{
+
+/// Number of partial sums of a column, enough to fill the widest vector registers
+constexpr std::size_t LANES = 4;
+/// Number of rows whose x ln x are computed before being summed
+constexpr std::size_t BLOCK = 64;
+
+/**
+ * \param bits the bits of the argument, positive and normal
+ * \returns ln x, see EocwFastLog
+ */
+inline double
+FastLog(uint64_t bits)
+{
+    // Integer operations and selects only, on the high word where a 64 bit comparison would
+    // need SSE4.2: the compiler neither speculates floating point operations nor vectorizes
+    // the ones under a branch
+    int32_t hi = static_cast<int32_t>(bits >> 32);
+    // Whether the mantissa is above sqrt(2), to within 2^-20
+    uint64_t high = (hi & 0x000fffff) > 0x6a09e ? 1 : 0;
+    // The biased exponent converted to double through the bits of 2^52 + exponent: SIMD
+    // units lack a 64 bit integer to double conversion before AVX-512
+    double e = std::bit_cast<double>(((bits >> 52) + high) | 0x4330000000000000ULL) -
+               (4503599627370496.0 + 1023.0);
+    double m = std::bit_cast<double>((bits & 0x000fffffffffffffULL) |
+                                     (0x3ff0000000000000ULL - (high << 52)));
+    // ln m = 2 (s + s^3/3 + s^5/5 + ...) with |s| < 0.1716: the first omitted term is
+    // below 5e-13
+    double s = (m - 1.0) / (m + 1.0);
+    double s2 = s * s;
+    double p = 1.0 / 13;
+    p = p * s2 + 1.0 / 11;
+    p = p * s2 + 1.0 / 9;
+    p = p * s2 + 1.0 / 7;
+    p = p * s2 + 1.0 / 5;
+    p = p * s2 + 1.0 / 3;
+    p = p * s2 + 1.0;
+    return e * 0.6931471805599453 + 2.0 * s * p;
+}
+
+/**
+ * \param x the argument
+ * \returns x ln x, or 0 if x is not positive and normal
+ */
+inline double
+XLnX(double x)
+{
+    uint64_t bits = std::bit_cast<uint64_t>(x);
+    // All ones if x is positive and normal: below the normal range x ln x vanishes anyway
+    uint64_t normal = 0 - static_cast<uint64_t>(static_cast<int32_t>(bits >> 32) >= 0x00100000);
+    double l = FastLog((bits & normal) | (0x0010000000000000ULL & ~normal));
+    return std::bit_cast<double>(bits & normal) * l;
+}
+
+/**
+ * Column statistics of the entropy weights
+ * \param x the column
+ * \param m the number of rows
+ * \param sum the sum of the column
+ * \param sumXLnX the sum of x ln x over the column
+ */
+void
+ColumnStats(const double* x, std::size_t m, double& sum, double& sumXLnX)
+{
+    // Independent partial sums: a single accumulator would serialize the additions, which
+    // the compiler may not reorder
+    double s[LANES] = {};
+    double sl[LANES] = {};
+    double xLnX[BLOCK];
+    for (std::size_t begin = 0; begin < m; begin += BLOCK)
+    {
+        std::size_t n = std::min(BLOCK, m - begin);
+        const double* xb = x + begin;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            xLnX[i] = XLnX(xb[i]);
+        }
+        std::size_t i = 0;
+        for (; i + LANES <= n; i += LANES)
+        {
+            for (std::size_t l = 0; l < LANES; ++l)
+            {
+                s[l] += xb[i + l];
+                sl[l] += xLnX[i + l];
+            }
+        }
+        for (std::size_t l = 0; i < n; ++i, ++l)
+        {
+            s[l] += xb[i];
+            sl[l] += xLnX[i];
+        }
+    }
+    sum = (s[0] + s[1]) + (s[2] + s[3]);
+    sumXLnX = (sl[0] + sl[1]) + (sl[2] + sl[3]);
+}
+
+} // namespace
+
+double
+EocwFastLog(double x)
+{
+    return FastLog(std::bit_cast<uint64_t>(x));
+}
+
+EocwWeights
+EocwEvaluateBatch(const double* cd,
+                  const double* re,
+                  const double* rh,
+                  std::size_t m,
+                  const EocwWeights& fuzzy,
+                  double* scores)
+{
+    EocwWeights sum;
+    EocwWeights sumXLnX;
+    ColumnStats(cd, m, sum[0], sumXLnX[0]);
+    ColumnStats(re, m, sum[1], sumXLnX[1]);
+    ColumnStats(rh, m, sum[2], sumXLnX[2]);
+    EocwWeights ewm = EocwEntropyWeights(static_cast<uint32_t>(m), sum, sumXLnX);
+    EocwScoreBatch(cd, re, rh, m, fuzzy, ewm, scores);
+    return ewm;
+}
+
+void
+EocwScoreBatch(const double* cd,
+               const double* re,
+               const double* rh,
+               std::size_t m,
+               const EocwWeights& fuzzy,
+               const EocwWeights& ewm,
+               double* scores)
+{
+    // Same operations as EocwScore, with the weights normalized once
+    double wCd = fuzzy[0] * ewm[0];
+    double wRe = fuzzy[1] * ewm[1];
+    double wRh = fuzzy[2] * ewm[2];
+    double sumW = wCd + wRe + wRh;
+    if (sumW == 0)
+    {
+        std::fill(scores, scores + m, 0.0);
+        return;
+    }
+    double a = wCd / sumW;
+    double b = wRe / sumW;
+    double c = wRh / sumW;
+    for (std::size_t i = 0; i < m; ++i)
+    {
+        scores[i] = (a * cd[i]) + (b * re[i]) + (c * rh[i]);
+    }
+}
+
+void
+EocwCandidateBatch::Add(double cd, double re, double rh)
+{
+    m_cd.push_back(cd);
+    m_re.push_back(re);
+    m_rh.push_back(rh);
+}
+
+void
+EocwCandidateBatch::Reserve(std::size_t m)
+{
+    m_cd.reserve(m);
+    m_re.reserve(m);
+    m_rh.reserve(m);
+}
+
+void
+EocwCandidateBatch::Clear()
+{
+    m_cd.clear();
+    m_re.clear();
+    m_rh.clear();
+}
+
+EocwWeights
+EocwCandidateBatch::Evaluate(const EocwWeights& fuzzy, std::vector<double>& scores) const
+{
+    scores.resize(GetN());
+    return EocwEvaluateBatch(m_cd.data(),
+                             m_re.data(),
+                             m_rh.data(),
+                             GetN(),
+                             fuzzy,
+                             scores.data());
+}
+
+void
+EocwCandidateBatch::Score(const EocwWeights& fuzzy,
+                          const EocwWeights& ewm,
+                          std::vector<double>& scores) const
+{
+    scores.resize(GetN());
+    EocwScoreBatch(m_cd.data(), m_re.data(), m_rh.data(), GetN(), fuzzy, ewm, scores.data());
+}
+
+} // namespace aodv
+} // namespace ns3
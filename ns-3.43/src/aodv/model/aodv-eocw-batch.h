@@ -0,0 +1,134 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#ifndef AODV_EOCW_BATCH_H
+#define AODV_EOCW_BATCH_H
+
+#include "aodv-eocw-weights.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace ns3
+{
+namespace aodv
+{
+
+/**
+ * \ingroup aodv
+ * \brief Natural logarithm, vectorizable approximation.
+ *
+ * The argument is split into its binary exponent e and a mantissa m in [sqrt(1/2), sqrt(2))
+ * with integer and bit operations only, and ln m is evaluated as the series
+ * 2 atanh((m - 1) / (m + 1)) truncated after 7 terms. The function has no branch nor
+ * library call, so loops calling it vectorize, and its absolute error is below 1e-12 for
+ * every positive normal argument.
+ *
+ * \param x the argument, positive and normal
+ * \returns ln x, or a finite meaningless value for any other argument
+ */
+double EocwFastLog(double x);
+
+/**
+ * \ingroup aodv
+ * \brief Evaluate a batch of candidate paths: their entropy weights, then their scores.
+ *
+ * This is the vectorized counterpart of EwmAccumulator::Add over every path followed by
+ * EocwScore of every path. The columns of the decision matrix are passed as separate
+ * arrays, so each pass over a column is a branch-free loop that an optimized build turns
+ * into SIMD instructions of the target. The column sums are computed in several partial sums
+ * and the logarithms with EocwFastLog, so the weights differ from the ones of the
+ * EwmAccumulator by rounding only.
+ *
+ * \param cd the congestion degree scores of the paths
+ * \param re the residual energy scores of the paths
+ * \param rh the hop count scores of the paths
+ * \param m the number of paths
+ * \param fuzzy the fuzzy weights
+ * \param scores the scores of the paths, of size m
+ * \returns the entropy weights of the paths
+ */
+EocwWeights EocwEvaluateBatch(const double* cd,
+                              const double* re,
+                              const double* rh,
+                              std::size_t m,
+                              const EocwWeights& fuzzy,
+                              double* scores);
+
+/**
+ * \ingroup aodv
+ * \brief Score a batch of candidate paths, with the same result as EocwScore on each path.
+ * \param cd the congestion degree scores of the paths
+ * \param re the residual energy scores of the paths
+ * \param rh the hop count scores of the paths
+ * \param m the number of paths
+ * \param fuzzy the fuzzy weights
+ * \param ewm the entropy weights
+ * \param scores the scores of the paths, of size m
+ */
+void EocwScoreBatch(const double* cd,
+                    const double* re,
+                    const double* rh,
+                    std::size_t m,
+                    const EocwWeights& fuzzy,
+                    const EocwWeights& ewm,
+                    double* scores);
+
+/**
+ * \ingroup aodv
+ * \brief Candidate paths of an EOCW route discovery, stored as one array per criterion.
+ */
+class EocwCandidateBatch
+{
+  public:
+    /**
+     * Add a path
+     * \param cd the congestion degree score of the path
+     * \param re the residual energy score of the path
+     * \param rh the hop count score of the path
+     */
+    void Add(double cd, double re, double rh);
+    /**
+     * Reserve room for paths
+     * \param m the number of paths
+     */
+    void Reserve(std::size_t m);
+    /// Forget all paths, keeping the storage
+    void Clear();
+
+    /**
+     * \returns the number of paths added
+     */
+    std::size_t GetN() const
+    {
+        return m_cd.size();
+    }
+
+    /**
+     * Compute the entropy weights of the paths and score them, see EocwEvaluateBatch
+     * \param fuzzy the fuzzy weights
+     * \param scores the scores of the paths, in the order they were added
+     * \returns the entropy weights of the paths
+     */
+    EocwWeights Evaluate(const EocwWeights& fuzzy, std::vector<double>& scores) const;
+    /**
+     * Score the paths with given entropy weights, see EocwScoreBatch
+     * \param fuzzy the fuzzy weights
+     * \param ewm the entropy weights
+     * \param scores the scores of the paths, in the order they were added
+     */
+    void Score(const EocwWeights& fuzzy, const EocwWeights& ewm, std::vector<double>& scores) const;
+
+  private:
+    std::vector<double> m_cd; ///< Congestion degree scores
+    std::vector<double> m_re; ///< Residual energy scores
+    std::vector<double> m_rh; ///< Hop count scores
+};
+
+} // namespace aodv
+} // namespace ns3
+
+#endif /* AODV_EOCW_BATCH_H */
@@ -0,0 +1,74 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "aodv-eocw-fuzzy.h"
+
+#include "ns3/assert.h"
+
+#include <map>
+
+namespace ns3
+{
+namespace aodv
+{
+
+// The rule base is evaluated at compile time where the inputs are known
+static_assert(EocwFuzzyRuleBase::Evaluate(0.5, 0.5)[0] == 0.33, "rule base");
+static_assert(EocwFuzzyRuleBase::Evaluate(1.0, 1.0)[2] == 0.85, "rule base");
+
+EocwFuzzyTable::EocwFuzzyTable(uint32_t resolution)
+    : m_resolution(resolution),
+      m_table((resolution + 1) * (resolution + 1))
+{
+    NS_ASSERT(resolution > 0);
+    for (uint32_t i = 0; i <= resolution; ++i)
+    {
+        for (uint32_t j = 0; j <= resolution; ++j)
+        {
+            m_table[i * (resolution + 1) + j] =
+                EocwFuzzyRuleBase::Evaluate(double(i) / resolution, double(j) / resolution);
+        }
+    }
+}
+
+Ptr<const EocwFuzzyTable>
+EocwFuzzyTable::Get(uint32_t resolution)
+{
+    static std::map<uint32_t, Ptr<const EocwFuzzyTable>> tables;
+    Ptr<const EocwFuzzyTable>& table = tables[resolution];
+    if (!table)
+    {
+        table = Create<EocwFuzzyTable>(resolution);
+    }
+    return table;
+}
+
+EocwWeights
+EocwFuzzyTable::Lookup(double re, double cd) const
+{
+    double x = std::clamp(re, 0.0, 1.0) * m_resolution;
+    double y = std::clamp(cd, 0.0, 1.0) * m_resolution;
+    uint32_t i = std::min(static_cast<uint32_t>(x), m_resolution - 1);
+    uint32_t j = std::min(static_cast<uint32_t>(y), m_resolution - 1);
+    double fx = x - i;
+    double fy = y - j;
+
+    const EocwWeights& w00 = m_table[i * (m_resolution + 1) + j];
+    const EocwWeights& w01 = m_table[i * (m_resolution + 1) + j + 1];
+    const EocwWeights& w10 = m_table[(i + 1) * (m_resolution + 1) + j];
+    const EocwWeights& w11 = m_table[(i + 1) * (m_resolution + 1) + j + 1];
+    EocwWeights w;
+    for (std::size_t k = 0; k < w.size(); ++k)
+    {
+        double w0 = w00[k] + fy * (w01[k] - w00[k]);
+        double w1 = w10[k] + fy * (w11[k] - w10[k]);
+        w[k] = w0 + fx * (w1 - w0);
+    }
+    return w;
+}
+
+} // namespace aodv
+} // namespace ns3
@@ -0,0 +1,164 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#ifndef AODV_EOCW_FUZZY_H
+#define AODV_EOCW_FUZZY_H
+
+#include "aodv-eocw-weights.h"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace ns3
+{
+namespace aodv
+{
+
+/**
+ * \ingroup aodv
+ * \brief Triangular membership function
+ * \param value the crisp input
+ * \param a the left foot of the triangle
+ * \param b the peak of the triangle
+ * \param c the right foot of the triangle
+ * \returns the membership degree of value, in [0, 1]
+ */
+constexpr double
+EocwFuzzyTriangle(double value, double a, double b, double c)
+{
+    if (value <= a || value >= c)
+    {
+        return 0.0;
+    }
+    if (value == b)
+    {
+        return 1.0;
+    }
+    if (value < b)
+    {
+        return (value - a) / (b - a);
+    }
+    return (c - value) / (c - b);
+}
+
+/**
+ * \ingroup aodv
+ * \brief Fuzzy rule base of the modified EOCW: nine rules over (residual energy, congestion
+ * degree), each with a crisp output weight vector (congestion degree, residual energy, hop
+ * count), defuzzified by weighted average.
+ */
+struct EocwFuzzyRuleBase
+{
+    /// Feet and peak of a triangular fuzzy set
+    struct Set
+    {
+        double a; ///< Left foot
+        double b; ///< Peak
+        double c; ///< Right foot
+    };
+
+    /// Fuzzy sets of both inputs: low/busy, medium/normal, high/free
+    static constexpr std::array<Set, 3> SETS{{{-0.1, 0.0, 0.4}, {0.2, 0.5, 0.8}, {0.6, 1.0, 1.1}}};
+
+    /// Rule outputs, indexed by 3 * energy set + congestion set
+    static constexpr std::array<EocwWeights, 9> RULES{{{0.45, 0.50, 0.05},
+                                                        {0.20, 0.70, 0.10},
+                                                        {0.10, 0.80, 0.10},
+                                                        {0.70, 0.20, 0.10},
+                                                        {0.33, 0.34, 0.33},
+                                                        {0.20, 0.20, 0.60},
+                                                        {0.80, 0.10, 0.10},
+                                                        {0.20, 0.10, 0.70},
+                                                        {0.10, 0.05, 0.85}}};
+
+    /**
+     * Evaluate the rule base
+     * \param re the residual energy score
+     * \param cd the congestion degree score
+     * \returns the fuzzy weights
+     */
+    static constexpr EocwWeights Evaluate(double re, double cd)
+    {
+        EocwWeights num{0.0, 0.0, 0.0};
+        double totalFire = 0.0;
+        for (std::size_t i = 0; i < SETS.size(); ++i)
+        {
+            double reDegree = EocwFuzzyTriangle(re, SETS[i].a, SETS[i].b, SETS[i].c);
+            for (std::size_t j = 0; j < SETS.size(); ++j)
+            {
+                double fire =
+                    std::min(reDegree, EocwFuzzyTriangle(cd, SETS[j].a, SETS[j].b, SETS[j].c));
+                const EocwWeights& out = RULES[3 * i + j];
+                num[0] += fire * out[0];
+                num[1] += fire * out[1];
+                num[2] += fire * out[2];
+                totalFire += fire;
+            }
+        }
+        if (totalFire == 0)
+        {
+            return {0.333, 0.333, 0.333};
+        }
+        return {num[0] / totalFire, num[1] / totalFire, num[2] / totalFire};
+    }
+};
+
+/**
+ * \ingroup aodv
+ * \brief The EOCW fuzzy rule base sampled on a regular grid over
+ * [0, 1] x [0, 1] (residual energy, congestion degree).
+ *
+ * A lookup interpolates bilinearly between the four surrounding grid points, so it costs a
+ * constant number of multiply-adds instead of six membership evaluations and nine rules.
+ * Inputs outside [0, 1] are clamped. The interpolation error shrinks roughly linearly with
+ * the resolution (about 0.02 in any weight for a resolution of 64).
+ *
+ * Tables are immutable once built and can be shared between nodes through Get().
+ */
+class EocwFuzzyTable : public SimpleRefCount<EocwFuzzyTable>
+{
+  public:
+    /**
+     * constructor
+     * \param resolution the number of grid cells along each axis
+     */
+    EocwFuzzyTable(uint32_t resolution);
+
+    /**
+     * Get a table shared by every caller asking for the same resolution
+     * \param resolution the number of grid cells along each axis
+     * \returns the table
+     */
+    static Ptr<const EocwFuzzyTable> Get(uint32_t resolution);
+
+    /**
+     * Interpolate the fuzzy weights
+     * \param re the residual energy score
+     * \param cd the congestion degree score
+     * \returns the fuzzy weights
+     */
+    EocwWeights Lookup(double re, double cd) const;
+
+    /**
+     * \returns the number of grid cells along each axis
+     */
+    uint32_t GetResolution() const
+    {
+        return m_resolution;
+    }
+
+  private:
+    uint32_t m_resolution;            ///< Number of grid cells along each axis
+    std::vector<EocwWeights> m_table; ///< Samples, row-major by residual energy
+};
+
+} // namespace aodv
+} // namespace ns3
+
+#endif /* AODV_EOCW_FUZZY_H */
@@ -0,0 +1,117 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "aodv-eocw-path-cache.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("AodvEocwPathCache");
+
+namespace aodv
+{
+
+EocwPathCache::EocwPathCache(uint32_t maxCandidates)
+    : m_maxCandidates(maxCandidates)
+{
+    NS_ASSERT(maxCandidates > 0);
+}
+
+EocwPathCache::Discovery*
+EocwPathCache::Find(Ipv4Address origin, uint32_t id)
+{
+    auto i = m_discoveries.find(Key{origin, id});
+    if (i == m_discoveries.end())
+    {
+        return nullptr;
+    }
+    return &i->second;
+}
+
+EocwPathCache::Discovery&
+EocwPathCache::Insert(Ipv4Address origin, uint32_t id, Ipv4Address destination)
+{
+    auto result = m_discoveries.try_emplace(Key{origin, id});
+    Discovery& discovery = result.first->second;
+    if (result.second)
+    {
+        NS_LOG_LOGIC("New discovery " << origin << ":" << id);
+        discovery.m_destination = destination;
+        discovery.m_start = Simulator::Now();
+        discovery.m_candidates.reserve(m_maxCandidates);
+    }
+    return discovery;
+}
+
+bool
+EocwPathCache::AddCandidate(Discovery& discovery, const EocwPath& path, double score)
+{
+    std::vector<Candidate>& candidates = discovery.m_candidates;
+    discovery.m_arrivals++;
+    discovery.m_ewm.Add(path.pathAvgCongestion,
+                        path.pathMinEnergy,
+                        EocwHopCountScore(path.hopCount));
+    if (candidates.size() >= m_maxCandidates)
+    {
+        if (score <= candidates.back().score)
+        {
+            NS_LOG_LOGIC("Reject candidate with score " << score);
+            return false;
+        }
+        candidates.pop_back();
+    }
+    // Candidates are few, a linear scan from the tail keeps the vector ordered
+    auto pos = candidates.end();
+    while (pos != candidates.begin() && (pos - 1)->score < score)
+    {
+        --pos;
+    }
+    candidates.insert(pos, Candidate{path, score});
+    return true;
+}
+
+bool
+EocwPathCache::Erase(Ipv4Address origin, uint32_t id)
+{
+    auto i = m_discoveries.find(Key{origin, id});
+    if (i == m_discoveries.end())
+    {
+        return false;
+    }
+    i->second.m_selectEvent.Cancel();
+    m_discoveries.erase(i);
+    return true;
+}
+
+void
+EocwPathCache::Clear()
+{
+    for (auto& [key, discovery] : m_discoveries)
+    {
+        discovery.m_selectEvent.Cancel();
+    }
+    m_discoveries.clear();
+}
+
+uint32_t
+EocwPathCache::GetSize() const
+{
+    return m_discoveries.size();
+}
+
+void
+EocwPathCache::SetMaxCandidates(uint32_t maxCandidates)
+{
+    NS_ASSERT(maxCandidates > 0);
+    m_maxCandidates = maxCandidates;
+}
+
+} // namespace aodv
+} // namespace ns3
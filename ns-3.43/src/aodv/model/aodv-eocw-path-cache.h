@@ -0,0 +1,192 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#ifndef AODV_EOCW_PATH_CACHE_H
+#define AODV_EOCW_PATH_CACHE_H
+
+#include "aodv-eocw-weights.h"
+#include "aodv-rtable.h"
+
+#include "ns3/event-id.h"
+#include "ns3/ipv4-address.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+namespace aodv
+{
+
+/**
+ * \ingroup aodv
+ * \brief One candidate path collected by the destination during an EOCW route discovery.
+ */
+struct EocwPath
+{
+    double pathMinEnergy;           ///< Minimum residual energy score along the path
+    double pathAvgCongestion;       ///< Average congestion degree score along the path
+    uint32_t hopCount;              ///< Number of hops along the path
+    RoutingTableEntry reverseRoute; ///< Reverse route used to send the RREP
+
+    /**
+     * constructor
+     * \param energy the minimum residual energy score along the path
+     * \param congestion the average congestion degree score along the path
+     * \param hops the number of hops along the path
+     * \param route the reverse route towards the originator
+     */
+    EocwPath(double energy, double congestion, uint32_t hops, RoutingTableEntry route)
+        : pathMinEnergy(energy),
+          pathAvgCongestion(congestion),
+          hopCount(hops),
+          reverseRoute(route)
+    {
+    }
+};
+
+/**
+ * \ingroup aodv
+ * \brief Per-discovery cache of EOCW candidate paths held by the destination.
+ *
+ * Discoveries are keyed by (originator, RREQ ID), so floods of different originators that
+ * happen to use the same RREQ ID do not collide. Each discovery keeps at most
+ * MaxCandidates paths in a flat vector ordered by score (best first); a path that does not
+ * beat the worst retained candidate is rejected on arrival, so the cost of a duplicate RREQ
+ * is bounded by MaxCandidates regardless of how many copies of the flood reach the
+ * destination.
+ */
+class EocwPathCache
+{
+  public:
+    /// A retained path together with the score it was ranked with
+    struct Candidate
+    {
+        EocwPath path; ///< The candidate path
+        double score;  ///< Score used for ranking
+    };
+
+    /// State of a single route discovery
+    struct Discovery
+    {
+        /// Address of the destination (i.e. this node) the RREQ was looking for
+        Ipv4Address m_destination;
+        /// Retained candidates, best first
+        std::vector<Candidate> m_candidates;
+        /// Number of paths offered for this discovery, retained or not
+        uint32_t m_arrivals{0};
+        /// Time the first path was offered
+        Time m_start;
+        /// Entropy weight statistics over every path offered, retained or not
+        EwmAccumulator m_ewm;
+        /// Whether a RREP has already been sent for this discovery
+        bool m_committed{false};
+        /// Pending path selection event
+        EventId m_selectEvent;
+    };
+
+    /**
+     * constructor
+     * \param maxCandidates the maximum number of candidates retained per discovery
+     */
+    EocwPathCache(uint32_t maxCandidates);
+
+    /**
+     * Lookup the discovery (origin, id)
+     * \param origin the RREQ originator
+     * \param id the RREQ ID
+     * \returns the discovery, or nullptr if it is not cached
+     */
+    Discovery* Find(Ipv4Address origin, uint32_t id);
+    /**
+     * Lookup the discovery (origin, id), create it if it doesn't exist.
+     * \param origin the RREQ originator
+     * \param id the RREQ ID
+     * \param destination the RREQ destination
+     * \returns the discovery
+     */
+    Discovery& Insert(Ipv4Address origin, uint32_t id, Ipv4Address destination);
+    /**
+     * Offer a candidate path to a discovery. The path is retained if fewer than
+     * MaxCandidates paths are held or if it scores strictly better than the worst one,
+     * which is then evicted. Among equal scores the earlier arrival ranks first. The path is
+     * accounted in the entropy weight statistics of the discovery either way.
+     * \param discovery the discovery
+     * \param path the candidate path
+     * \param score the score of the path
+     * \returns true if the path was retained
+     */
+    bool AddCandidate(Discovery& discovery, const EocwPath& path, double score);
+    /**
+     * Remove the discovery (origin, id), cancelling its pending selection event.
+     * \param origin the RREQ originator
+     * \param id the RREQ ID
+     * \returns true if the discovery was cached
+     */
+    bool Erase(Ipv4Address origin, uint32_t id);
+    /// Remove all discoveries, cancelling their pending selection events
+    void Clear();
+    /**
+     * \returns the number of cached discoveries
+     */
+    uint32_t GetSize() const;
+
+    /**
+     * Set the maximum number of candidates retained per discovery. Discoveries already
+     * holding more candidates keep them.
+     * \param maxCandidates the maximum number of candidates
+     */
+    void SetMaxCandidates(uint32_t maxCandidates);
+
+    /**
+     * \returns the maximum number of candidates retained per discovery
+     */
+    uint32_t GetMaxCandidates() const
+    {
+        return m_maxCandidates;
+    }
+
+  private:
+    /// Discovery key: RREQ IDs are only unique in the context of their originator
+    struct Key
+    {
+        Ipv4Address m_origin; ///< RREQ originator
+        uint32_t m_id;        ///< RREQ ID
+
+        /**
+         * \brief Compare keys
+         * \param o the other key
+         * \return true if equal
+         */
+        bool operator==(const Key& o) const
+        {
+            return m_origin == o.m_origin && m_id == o.m_id;
+        }
+    };
+
+    /// Hash of a discovery key
+    struct KeyHash
+    {
+        /**
+         * \param k the key
+         * \return the hash
+         */
+        size_t operator()(const Key& k) const
+        {
+            return std::hash<uint64_t>()((uint64_t(k.m_origin.Get()) << 32) | k.m_id);
+        }
+    };
+
+    /// Cached discoveries
+    std::unordered_map<Key, Discovery, KeyHash> m_discoveries;
+    /// Maximum number of candidates retained per discovery
+    uint32_t m_maxCandidates;
+};
+
+} // namespace aodv
+} // namespace ns3
+
+#endif /* AODV_EOCW_PATH_CACHE_H */
@@ -0,0 +1,111 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "aodv-eocw-weights.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+namespace aodv
+{
+
+double
+EocwHopCountScore(uint32_t hopCount)
+{
+    if (hopCount <= 2)
+    {
+        return 1.0;
+    }
+    if (hopCount <= 4)
+    {
+        return 0.6;
+    }
+    if (hopCount <= 6)
+    {
+        return 0.4;
+    }
+    return 0.1;
+}
+
+double
+EocwScore(const EocwWeights& fuzzy, const EocwWeights& ewm, double cd, double re, double rh)
+{
+    double wCd = fuzzy[0] * ewm[0];
+    double wRe = fuzzy[1] * ewm[1];
+    double wRh = fuzzy[2] * ewm[2];
+    double sumW = wCd + wRe + wRh;
+    if (sumW == 0)
+    {
+        return 0;
+    }
+    return ((wCd / sumW) * cd) + ((wRe / sumW) * re) + ((wRh / sumW) * rh);
+}
+
+EocwWeights
+EocwEntropyWeights(uint32_t m, const EocwWeights& sum, const EocwWeights& sumXLnX)
+{
+    if (m <= 1)
+    {
+        return {0.333, 0.333, 0.333};
+    }
+    double k = 1.0 / std::log(m);
+    EocwWeights d;
+    double sumD = 0.0;
+    for (std::size_t j = 0; j < d.size(); ++j)
+    {
+        double h = 0.0;
+        if (sum[j] != 0)
+        {
+            h = -k * (sumXLnX[j] / sum[j] - std::log(sum[j]));
+        }
+        // Clamp the rounding noise of the single-pass entropy around H = 1
+        d[j] = std::max(0.0, 1.0 - h);
+        sumD += d[j];
+    }
+    if (sumD < 1e-9)
+    {
+        return {1.0 / 3, 1.0 / 3, 1.0 / 3};
+    }
+    for (auto& dj : d)
+    {
+        dj /= sumD;
+    }
+    return d;
+}
+
+void
+EwmAccumulator::Add(double cd, double re, double rh)
+{
+    const EocwWeights x{cd, re, rh};
+    for (std::size_t j = 0; j < x.size(); ++j)
+    {
+        m_sum[j] += x[j];
+        if (x[j] > 0)
+        {
+            m_sumXLnX[j] += x[j] * std::log(x[j]);
+        }
+    }
+    m_n++;
+}
+
+EocwWeights
+EwmAccumulator::GetWeights() const
+{
+    return EocwEntropyWeights(m_n, m_sum, m_sumXLnX);
+}
+
+void
+EwmAccumulator::Clear()
+{
+    m_n = 0;
+    m_sum.fill(0.0);
+    m_sumXLnX.fill(0.0);
+}
+
+} // namespace aodv
+} // namespace ns3
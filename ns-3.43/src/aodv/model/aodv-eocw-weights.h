@@ -0,0 +1,99 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#ifndef AODV_EOCW_WEIGHTS_H
+#define AODV_EOCW_WEIGHTS_H
+
+#include <array>
+#include <stdint.h>
+
+namespace ns3
+{
+namespace aodv
+{
+
+/**
+ * \ingroup aodv
+ * \brief Weights of the three EOCW criteria, in the order
+ * (congestion degree, residual energy, hop count).
+ */
+typedef std::array<double, 3> EocwWeights;
+
+/**
+ * \ingroup aodv
+ * \brief Score of a path's hop count
+ * \param hopCount the number of hops
+ * \returns the hop count score, in [0, 1]
+ */
+double EocwHopCountScore(uint32_t hopCount);
+
+/**
+ * \ingroup aodv
+ * \brief Combine the subjective (fuzzy) and objective (entropy) weights and score a path.
+ * \param fuzzy the fuzzy weights
+ * \param ewm the entropy weights
+ * \param cd the congestion degree score of the path
+ * \param re the residual energy score of the path
+ * \param rh the hop count score of the path
+ * \returns the path score, or 0 if all combined weights are 0
+ */
+double EocwScore(const EocwWeights& fuzzy, const EocwWeights& ewm, double cd, double re, double rh);
+
+/**
+ * \ingroup aodv
+ * \brief Entropy weights of m paths from the column statistics of their decision matrix.
+ * \param m the number of paths
+ * \param sum the column sums S_j
+ * \param sumXLnX the column sums of x_ij ln x_ij, over the x_ij > 0
+ * \returns the entropy weights, uniform if there is less than two paths or no information
+ */
+EocwWeights EocwEntropyWeights(uint32_t m, const EocwWeights& sum, const EocwWeights& sumXLnX);
+
+/**
+ * \ingroup aodv
+ * \brief Entropy Weight Method over a stream of candidate paths.
+ *
+ * The entropy of criterion j over m paths is
+ * H_j = -1/ln(m) * sum_i p_ij ln p_ij with p_ij = x_ij / S_j and S_j = sum_i x_ij.
+ * Since sum_i p_ij ln p_ij = (sum_i x_ij ln x_ij) / S_j - ln S_j, it is enough to keep
+ * S_j and sum_i x_ij ln x_ij per criterion: adding a path costs three logarithms and
+ * reading the weights costs O(1), with no per-selection matrix.
+ */
+class EwmAccumulator
+{
+  public:
+    /**
+     * Add a path
+     * \param cd the congestion degree score of the path
+     * \param re the residual energy score of the path
+     * \param rh the hop count score of the path
+     */
+    void Add(double cd, double re, double rh);
+    /**
+     * \returns the entropy weights of the paths added so far
+     */
+    EocwWeights GetWeights() const;
+    /// Forget all paths
+    void Clear();
+
+    /**
+     * \returns the number of paths added
+     */
+    uint32_t GetN() const
+    {
+        return m_n;
+    }
+
+  private:
+    uint32_t m_n{0};                      ///< Number of paths
+    EocwWeights m_sum{0.0, 0.0, 0.0};     ///< Column sums S_j
+    EocwWeights m_sumXLnX{0.0, 0.0, 0.0}; ///< Column sums of x_ij ln x_ij
+};
+
+} // namespace aodv
+} // namespace ns3
+
+#endif /* AODV_EOCW_WEIGHTS_H */
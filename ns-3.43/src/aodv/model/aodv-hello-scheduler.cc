@@ -0,0 +1,79 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "aodv-hello-scheduler.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("AodvHelloScheduler");
+
+namespace aodv
+{
+
+HelloScheduler::HelloScheduler()
+    : m_minInterval(Seconds(1)),
+      m_maxInterval(Seconds(1)),
+      m_churnThreshold(1),
+      m_speedThreshold(1),
+      m_changes(0),
+      m_time(Seconds(0)),
+      m_interval(Seconds(1))
+{
+}
+
+void
+HelloScheduler::SetIntervals(Time minInterval, Time maxInterval)
+{
+    NS_ASSERT(minInterval.IsStrictlyPositive() && minInterval <= maxInterval);
+    m_minInterval = minInterval;
+    m_maxInterval = maxInterval;
+    m_interval = minInterval;
+}
+
+void
+HelloScheduler::SetThresholds(double churnThreshold, double speedThreshold)
+{
+    NS_ASSERT(churnThreshold > 0 && speedThreshold > 0);
+    m_churnThreshold = churnThreshold;
+    m_speedThreshold = speedThreshold;
+}
+
+Time
+HelloScheduler::NextInterval(uint32_t changes, double speed, double energyScore)
+{
+    Time now = Simulator::Now();
+    double churn = 0;
+    if (now > m_time)
+    {
+        churn = (changes - m_changes) / (now - m_time).GetSeconds();
+    }
+    m_changes = changes;
+    m_time = now;
+
+    double activity =
+        std::max(std::min(1.0, churn / m_churnThreshold), std::min(1.0, speed / m_speedThreshold));
+    double energy = std::clamp(energyScore, 0.0, 1.0);
+    m_interval = m_minInterval + (m_maxInterval - m_minInterval) * (1 - activity * energy);
+    NS_LOG_DEBUG("Churn " << churn << "/s, speed " << speed << " m/s, energy " << energy
+                          << ": next HELLO in " << m_interval.As(Time::S));
+    return m_interval;
+}
+
+Time
+HelloScheduler::GetInterval() const
+{
+    return m_interval;
+}
+
+} // namespace aodv
+} // namespace ns3
@@ -0,0 +1,76 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#ifndef AODV_HELLO_SCHEDULER_H
+#define AODV_HELLO_SCHEDULER_H
+
+#include "ns3/nstime.h"
+
+#include <cstdint>
+
+namespace ns3
+{
+namespace aodv
+{
+
+/**
+ * \ingroup aodv
+ * \brief Adaptive interval between the HELLO messages of a node.
+ *
+ * The interval shrinks towards its minimum as the topology around the node changes, and
+ * grows towards its maximum when the node is idle or low on energy:
+ *
+ *   interval = min + (max - min) (1 - activity * energy)
+ *
+ * where energy is the residual energy score of the node and activity, in [0, 1], is the
+ * larger of the neighbor churn rate over the churn threshold and the speed of the node over
+ * the speed threshold, each capped at 1. The churn rate is the number of neighbors added to
+ * or removed from the neighbor table per second, since the previous interval was computed.
+ */
+class HelloScheduler
+{
+  public:
+    HelloScheduler();
+
+    /**
+     * \param minInterval the interval of a mobile node with full energy
+     * \param maxInterval the interval of an idle node, or of a node with no energy left
+     */
+    void SetIntervals(Time minInterval, Time maxInterval);
+    /**
+     * \param churnThreshold the neighbor churn rate, in changes per second, at which the
+     * activity of the node is full
+     * \param speedThreshold the speed, in m/s, at which the activity of the node is full
+     */
+    void SetThresholds(double churnThreshold, double speedThreshold);
+
+    /**
+     * Compute the interval until the next HELLO message
+     * \param changes the number of changes of the neighbor table since it was created
+     * \param speed the speed of the node, in m/s
+     * \param energyScore the residual energy score of the node, in [0, 1]
+     * \returns the interval
+     */
+    Time NextInterval(uint32_t changes, double speed, double energyScore);
+    /**
+     * \returns the interval last computed, the minimum interval before
+     */
+    Time GetInterval() const;
+
+  private:
+    Time m_minInterval;      ///< Minimum interval
+    Time m_maxInterval;      ///< Maximum interval
+    double m_churnThreshold; ///< Churn rate of full activity, in changes per second
+    double m_speedThreshold; ///< Speed of full activity, in m/s
+    uint32_t m_changes;      ///< Neighbor table changes when the interval was last computed
+    Time m_time;             ///< Time the interval was last computed
+    Time m_interval;         ///< Interval last computed
+};
+
+} // namespace aodv
+} // namespace ns3
+
+#endif /* AODV_HELLO_SCHEDULER_H */
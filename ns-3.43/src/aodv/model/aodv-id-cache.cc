@@ -21,33 +21,229 @@ namespace ns3
 {
 namespace aodv
 {
+
+namespace
+{
+
+/**
+ * \param key the key of an (address, id) pair
+ * \returns the hash of the key
+ */
+inline std::size_t
+HashKey(uint64_t key)
+{
+    // splitmix64 finalizer
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+    return key ^ (key >> 31);
+}
+
+} // namespace
+
+IdCache::IdCache(Time lifetime)
+    : m_slots(16),
+      m_size(0),
+      m_wheel(WHEEL_SIZE),
+      m_wheelSlot(0),
+      m_lifetime(lifetime)
+{
+    SetGranularity();
+}
+
 bool
 IdCache::IsDuplicate(Ipv4Address addr, uint32_t id)
 {
-    Purge();
-    for (auto i = m_idCache.begin(); i != m_idCache.end(); ++i)
+    int64_t now = Simulator::Now().GetTimeStep();
+    // Buckets up to the previous one hold no live pair: only they need to be visited
+    Expire(now, GetWheelSlot(now) - 1);
+    uint64_t key = (uint64_t(addr.Get()) << 32) | id;
+    std::size_t i = Find(key);
+    if (m_slots[i].m_used && m_slots[i].m_expire >= now)
     {
-        if (i->m_context == addr && i->m_id == id)
-        {
-            return true;
-        }
+        return true;
     }
-    UniqueId uniqueId = {addr, id, m_lifetime + Simulator::Now()};
-    m_idCache.push_back(uniqueId);
+    Insert(key, now + m_lifetime.GetTimeStep());
     return false;
 }
 
 void
 IdCache::Purge()
 {
-    m_idCache.erase(remove_if(m_idCache.begin(), m_idCache.end(), IsExpired()), m_idCache.end());
+    int64_t now = Simulator::Now().GetTimeStep();
+    Expire(now, GetWheelSlot(now));
 }
 
 uint32_t
 IdCache::GetSize()
 {
     Purge();
-    return m_idCache.size();
+    return m_size;
+}
+
+void
+IdCache::SetLifetime(Time lifetime)
+{
+    m_lifetime = lifetime;
+    if (m_size == 0)
+    {
+        SetGranularity();
+    }
+}
+
+uint32_t
+IdCache::GetSerializedSize() const
+{
+    int64_t now = Simulator::Now().GetTimeStep();
+    uint32_t n = std::count_if(m_slots.begin(), m_slots.end(), [now](const Slot& slot) {
+        return slot.m_used && slot.m_expire >= now;
+    });
+    return 4 + n * 16;
+}
+
+void
+IdCache::Serialize(Buffer::Iterator& i) const
+{
+    int64_t now = Simulator::Now().GetTimeStep();
+    auto live = [now](const Slot& slot) { return slot.m_used && slot.m_expire >= now; };
+    i.WriteHtonU32(std::count_if(m_slots.begin(), m_slots.end(), live));
+    for (const auto& slot : m_slots)
+    {
+        if (live(slot))
+        {
+            i.WriteHtonU64(slot.m_key);
+            i.WriteHtonU64(slot.m_expire - now);
+        }
+    }
+}
+
+void
+IdCache::Deserialize(Buffer::Iterator& i)
+{
+    int64_t now = Simulator::Now().GetTimeStep();
+    // Expire the buckets up to the previous one, as a duplicate check would
+    Expire(now, GetWheelSlot(now) - 1);
+    for (uint32_t n = i.ReadNtohU32(); n > 0; --n)
+    {
+        uint64_t key = i.ReadNtohU64();
+        auto expire = static_cast<int64_t>(i.ReadNtohU64());
+        Insert(key, now + expire);
+    }
+}
+
+std::size_t
+IdCache::Find(uint64_t key) const
+{
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t i = HashKey(key) & mask;
+    while (m_slots[i].m_used && m_slots[i].m_key != key)
+    {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+void
+IdCache::Insert(uint64_t key, int64_t expire)
+{
+    std::size_t i = Find(key);
+    if (!m_slots[i].m_used)
+    {
+        if (2 * (m_size + 1) > m_slots.size())
+        {
+            Grow();
+            i = Find(key);
+        }
+        m_slots[i].m_key = key;
+        m_slots[i].m_used = true;
+        m_size++;
+    }
+    m_slots[i].m_expire = expire;
+    m_wheel[GetWheelSlot(expire) % WHEEL_SIZE].push_back({key, expire});
+}
+
+void
+IdCache::Erase(uint64_t key)
+{
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t i = Find(key);
+    if (!m_slots[i].m_used)
+    {
+        return;
+    }
+    m_slots[i].m_used = false;
+    m_size--;
+    // Backward shift: move up every following key whose probe sequence crosses the hole
+    for (std::size_t j = (i + 1) & mask; m_slots[j].m_used; j = (j + 1) & mask)
+    {
+        std::size_t home = HashKey(m_slots[j].m_key) & mask;
+        bool reachable = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+        if (!reachable)
+        {
+            m_slots[i] = m_slots[j];
+            m_slots[j].m_used = false;
+            i = j;
+        }
+    }
+}
+
+void
+IdCache::Grow()
+{
+    std::vector<Slot> slots(2 * m_slots.size());
+    m_slots.swap(slots);
+    for (const auto& slot : slots)
+    {
+        if (slot.m_used)
+        {
+            m_slots[Find(slot.m_key)] = slot;
+        }
+    }
+}
+
+int64_t
+IdCache::GetWheelSlot(int64_t tick) const
+{
+    return tick / m_granularity;
+}
+
+void
+IdCache::SetGranularity()
+{
+    // The wheel spans twice the lifetime, so that a pair is found in its bucket on the
+    // first turn after it was added
+    m_granularity = std::max<int64_t>(2 * m_lifetime.GetTimeStep() / WHEEL_SIZE, 1);
+    m_wheelSlot = 0;
+}
+
+void
+IdCache::Expire(int64_t now, int64_t last)
+{
+    if (m_size == 0)
+    {
+        m_wheelSlot = std::max(m_wheelSlot, last);
+        return;
+    }
+    for (int64_t s = std::max(m_wheelSlot, last - WHEEL_SIZE + 1); s <= last; ++s)
+    {
+        std::vector<Timer>& bucket = m_wheel[s % WHEEL_SIZE];
+        for (std::size_t t = 0; t < bucket.size();)
+        {
+            if (bucket[t].m_expire >= now)
+            {
+                ++t;
+                continue;
+            }
+            const Slot& slot = m_slots[Find(bucket[t].m_key)];
+            // The pair may have been added again since this timer was set
+            if (slot.m_used && slot.m_expire == bucket[t].m_expire)
+            {
+                Erase(bucket[t].m_key);
+            }
+            bucket[t] = bucket.back();
+            bucket.pop_back();
+        }
+    }
+    m_wheelSlot = std::max(m_wheelSlot, last);
 }
 
 } // namespace aodv
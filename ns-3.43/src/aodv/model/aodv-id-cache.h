@@ -17,6 +17,7 @@
 #ifndef AODV_ID_CACHE_H
 #define AODV_ID_CACHE_H
 
+#include "ns3/buffer.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/simulator.h"
 
@@ -30,6 +31,13 @@ namespace aodv
  * \ingroup aodv
  *
  * \brief Unique packets identification cache used for simple duplicate detection.
+ *
+ * The (address, id) pairs are kept in an open-addressing hash set with linear probing, so
+ * that a duplicate check does not depend on the number of cached pairs. Expiry is driven by
+ * a timing wheel: every pair is also filed in the bucket of the wheel covering its
+ * expiration time, and a duplicate check only visits the buckets that have elapsed since
+ * the previous one. Pairs expired in the current bucket are recognized by their expiration
+ * time and replaced when added again; Purge() removes them.
  */
 class IdCache
 {
@@ -38,10 +46,7 @@ class IdCache
      * constructor
      * \param lifetime the lifetime for added entries
      */
-    IdCache(Time lifetime)
-        : m_lifetime(lifetime)
-    {
-    }
+    IdCache(Time lifetime);
 
     /**
      * Check that entry (addr, id) exists in cache. Add entry, if it doesn't exist.
@@ -61,10 +66,7 @@ class IdCache
      * Set lifetime for future added entries.
      * \param lifetime the lifetime for entries
      */
-    void SetLifetime(Time lifetime)
-    {
-        m_lifetime = lifetime;
-    }
+    void SetLifetime(Time lifetime);
 
     /**
      * Return lifetime for existing entries in cache
@@ -75,37 +77,84 @@ class IdCache
         return m_lifetime;
     }
 
+    /**
+     * \returns the number of bytes written by Serialize()
+     */
+    uint32_t GetSerializedSize() const;
+    /**
+     * Write the entries that have not expired, with their expiration times relative to now
+     * \param i the buffer iterator, moved past the entries
+     */
+    void Serialize(Buffer::Iterator& i) const;
+    /**
+     * Add the entries written by Serialize(), expiring at the same times relative to now.
+     * \param i the buffer iterator, moved past the entries
+     */
+    void Deserialize(Buffer::Iterator& i);
+
   private:
-    /// Unique packet ID
-    struct UniqueId
+    /// Number of buckets of the timing wheel
+    static constexpr uint32_t WHEEL_SIZE = 64;
+
+    /// Slot of the hash set
+    struct Slot
     {
-        /// ID is supposed to be unique in single address context (e.g. sender address)
-        Ipv4Address m_context;
-        /// The id
-        uint32_t m_id;
-        /// When record will expire
-        Time m_expire;
+        uint64_t m_key{0};    ///< Address in the high 32 bits, id in the low 32 bits
+        int64_t m_expire{0};  ///< When the pair expires, in time steps
+        bool m_used{false};   ///< Whether the slot holds a key
     };
 
-    /**
-     * \brief IsExpired structure
-     */
-    struct IsExpired
+    /// Entry of the timing wheel
+    struct Timer
     {
-        /**
-         * \brief Check if the entry is expired
-         *
-         * \param u UniqueId entry
-         * \return true if expired, false otherwise
-         */
-        bool operator()(const UniqueId& u) const
-        {
-            return (u.m_expire < Simulator::Now());
-        }
+        uint64_t m_key;   ///< Key of the cached pair
+        int64_t m_expire; ///< When the pair expires, in time steps
     };
 
-    /// Already seen IDs
-    std::vector<UniqueId> m_idCache;
+    /**
+     * \param key the key
+     * \returns the index of the slot holding the key, or of the empty slot ending its
+     * probe sequence
+     */
+    std::size_t Find(uint64_t key) const;
+    /**
+     * Add a key, or set its expiration time if it is already there
+     * \param key the key
+     * \param expire when the pair expires, in time steps
+     */
+    void Insert(uint64_t key, int64_t expire);
+    /**
+     * Remove a key from the hash set, shifting back the keys that probed past it
+     * \param key the key
+     */
+    void Erase(uint64_t key);
+    /// Double the capacity of the hash set
+    void Grow();
+    /**
+     * \param tick a time, in time steps
+     * \returns the absolute wheel slot covering it
+     */
+    int64_t GetWheelSlot(int64_t tick) const;
+    /// Set the width of the wheel buckets from the lifetime
+    void SetGranularity();
+    /**
+     * Visit the wheel buckets from the last one visited up to the given one, and remove the
+     * pairs they hold that have expired
+     * \param now the current time, in time steps
+     * \param last the absolute wheel slot of the last bucket to visit
+     */
+    void Expire(int64_t now, int64_t last);
+
+    /// Hash set of the already seen IDs
+    std::vector<Slot> m_slots;
+    /// Number of keys in the hash set
+    uint32_t m_size;
+    /// Timing wheel of the expiration times
+    std::vector<std::vector<Timer>> m_wheel;
+    /// Width of a wheel bucket, in time steps
+    int64_t m_granularity;
+    /// Absolute wheel slot reached by the last purge
+    int64_t m_wheelSlot;
     /// Default lifetime for ID records
     Time m_lifetime;
 };
@@ -16,6 +16,7 @@
 
 #include "aodv-neighbor.h"
 
+#include "ns3/address-utils.h"
 #include "ns3/log.h"
 #include "ns3/wifi-mac-header.h"
 
@@ -29,103 +30,131 @@ NS_LOG_COMPONENT_DEFINE("AodvNeighbors");
 namespace aodv
 {
 Neighbors::Neighbors(Time delay)
-    : m_ntimer(Timer::CANCEL_ON_DESTROY)
+    : m_ntimer(Timer::CANCEL_ON_DESTROY),
+      m_wheel(WHEEL_SIZE),
+      m_wheelSlot(0),
+      m_changes(0)
 {
     m_ntimer.SetDelay(delay);
     m_ntimer.SetFunction(&Neighbors::Purge, this);
     m_txErrorCallback = MakeCallback(&Neighbors::ProcessTxError, this);
+    // The wheel spans four purge intervals, the usual neighbor lifetime being two of them
+    m_granularity = std::max<int64_t>(4 * delay.GetTimeStep() / WHEEL_SIZE, 1);
+}
+
+Neighbors::~Neighbors()
+{
+    for (const auto& arp : m_arp)
+    {
+        arp->TraceDisconnectWithoutContext("Resolved",
+                                           MakeCallback(&Neighbors::NotifyArpResolved, this));
+    }
+}
+
+std::size_t
+Neighbors::MacHash::operator()(const Mac48Address& mac) const
+{
+    uint8_t buffer[6];
+    mac.CopyTo(buffer);
+    uint64_t key = 0;
+    for (uint8_t byte : buffer)
+    {
+        key = (key << 8) | byte;
+    }
+    return std::hash<uint64_t>()(key);
 }
 
 bool
 Neighbors::IsNeighbor(Ipv4Address addr)
 {
     Purge();
-    for (auto i = m_nb.begin(); i != m_nb.end(); ++i)
-    {
-        if (i->m_neighborAddress == addr)
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_nb.find(addr) != m_nb.end();
 }
 
 Time
 Neighbors::GetExpireTime(Ipv4Address addr)
 {
     Purge();
-    for (auto i = m_nb.begin(); i != m_nb.end(); ++i)
+    auto i = m_nb.find(addr);
+    if (i == m_nb.end())
     {
-        if (i->m_neighborAddress == addr)
-        {
-            return (i->m_expireTime - Simulator::Now());
-        }
+        return Seconds(0);
     }
-    return Seconds(0);
+    return (i->second.m_expireTime - Simulator::Now());
 }
 
 void
 Neighbors::Update(Ipv4Address addr, Time expire)
 {
-    for (auto i = m_nb.begin(); i != m_nb.end(); ++i)
+    auto i = m_nb.find(addr);
+    if (i != m_nb.end())
     {
-        if (i->m_neighborAddress == addr)
-        {
-            i->m_expireTime = std::max(expire + Simulator::Now(), i->m_expireTime);
-            if (i->m_hardwareAddress == Mac48Address())
-            {
-                i->m_hardwareAddress = LookupMacAddress(i->m_neighborAddress);
-            }
-            return;
-        }
+        // The wheel timer is moved lazily, when its bucket is visited
+        i->second.m_expireTime = std::max(expire + Simulator::Now(), i->second.m_expireTime);
+        i->second.m_lastHeard = Simulator::Now();
+        return;
     }
 
     NS_LOG_LOGIC("Open link to " << addr);
-    Neighbor neighbor(addr, LookupMacAddress(addr), expire + Simulator::Now());
-    m_nb.push_back(neighbor);
-    Purge();
-}
-
-/**
- * \brief CloseNeighbor structure
- */
-struct CloseNeighbor
-{
-    /**
-     * Check if the entry is expired
-     *
-     * \param nb Neighbors::Neighbor entry
-     * \return true if expired, false otherwise
-     */
-    bool operator()(const Neighbors::Neighbor& nb) const
+    ++m_changes;
+    i = m_nb.emplace(addr, Neighbor(addr, Mac48Address(), expire + Simulator::Now())).first;
+    SetMacAddress(i->second, LookupMacAddress(addr));
+    File(i->second);
+    if (!m_ntimer.IsRunning())
     {
-        return ((nb.m_expireTime < Simulator::Now()) || nb.close);
+        m_ntimer.Schedule();
     }
-};
+}
 
 void
 Neighbors::Purge()
 {
+    int64_t now = Simulator::Now().GetTimeStep();
+    int64_t last = GetWheelSlot(now);
+    std::vector<std::pair<Ipv4Address, Time>> closed;
     if (m_nb.empty())
     {
+        m_wheelSlot = std::max(m_wheelSlot, last);
         return;
     }
-
-    CloseNeighbor pred;
-    if (!m_handleLinkFailure.IsNull())
+    for (int64_t s = std::max(m_wheelSlot, last - WHEEL_SIZE + 1); s <= last; ++s)
     {
-        for (auto j = m_nb.begin(); j != m_nb.end(); ++j)
+        std::vector<WheelEntry>& bucket = m_wheel[s % WHEEL_SIZE];
+        for (std::size_t t = 0; t < bucket.size();)
         {
-            if (pred(*j))
+            if (bucket[t].m_expireTime.GetTimeStep() >= now)
+            {
+                ++t;
+                continue;
+            }
+            auto i = m_nb.find(bucket[t].m_neighborAddress);
+            Time expire = bucket[t].m_expireTime;
+            bucket[t] = bucket.back();
+            bucket.pop_back();
+            // The neighbor may have been removed, or added again, since this timer was set
+            if (i == m_nb.end() || i->second.m_timerExpireTime != expire)
+            {
+                continue;
+            }
+            if (i->second.m_expireTime.GetTimeStep() < now)
+            {
+                closed.emplace_back(i->first, i->second.m_lastHeard);
+                Erase(i);
+            }
+            else
             {
-                NS_LOG_LOGIC("Close link to " << j->m_neighborAddress);
-                m_handleLinkFailure(j->m_neighborAddress);
+                File(i->second);
             }
         }
     }
-    m_nb.erase(std::remove_if(m_nb.begin(), m_nb.end(), pred), m_nb.end());
-    m_ntimer.Cancel();
-    m_ntimer.Schedule();
+    m_wheelSlot = std::max(m_wheelSlot, last);
+
+    // The link failure handler may use the table again: only call it once it is consistent
+    NotifyClosed(closed);
+    if (!m_nb.empty() && !m_ntimer.IsRunning())
+    {
+        m_ntimer.Schedule();
+    }
 }
 
 void
@@ -135,16 +164,71 @@ Neighbors::ScheduleTimer()
     m_ntimer.Schedule();
 }
 
+uint32_t
+Neighbors::GetSerializedSize() const
+{
+    Time now = Simulator::Now();
+    uint32_t n = std::count_if(m_nb.begin(), m_nb.end(), [now](const auto& nb) {
+        return nb.second.m_expireTime >= now;
+    });
+    // Address, MAC address and expire time of each neighbor
+    return 4 + n * 18;
+}
+
+void
+Neighbors::Serialize(Buffer::Iterator& i) const
+{
+    Time now = Simulator::Now();
+    auto live = [now](const auto& nb) { return nb.second.m_expireTime >= now; };
+    i.WriteHtonU32(std::count_if(m_nb.begin(), m_nb.end(), live));
+    for (const auto& nb : m_nb)
+    {
+        if (live(nb))
+        {
+            WriteTo(i, nb.second.m_neighborAddress);
+            WriteTo(i, nb.second.m_hardwareAddress);
+            i.WriteHtonU64((nb.second.m_expireTime - now).GetTimeStep());
+        }
+    }
+}
+
+void
+Neighbors::Deserialize(Buffer::Iterator& i)
+{
+    for (uint32_t n = i.ReadNtohU32(); n > 0; --n)
+    {
+        Ipv4Address addr;
+        Mac48Address mac;
+        ReadFrom(i, addr);
+        ReadFrom(i, mac);
+        Time expire = TimeStep(i.ReadNtohU64());
+        Update(addr, expire);
+        Neighbor& nb = m_nb.find(addr)->second;
+        if (nb.m_hardwareAddress == Mac48Address())
+        {
+            SetMacAddress(nb, mac);
+        }
+    }
+}
+
 void
 Neighbors::AddArpCache(Ptr<ArpCache> a)
 {
     m_arp.push_back(a);
+    a->TraceConnectWithoutContext("Resolved", MakeCallback(&Neighbors::NotifyArpResolved, this));
 }
 
 void
 Neighbors::DelArpCache(Ptr<ArpCache> a)
 {
-    m_arp.erase(std::remove(m_arp.begin(), m_arp.end(), a), m_arp.end());
+    auto i = std::find(m_arp.begin(), m_arp.end(), a);
+    if (i == m_arp.end())
+    {
+        return;
+    }
+    a->TraceDisconnectWithoutContext("Resolved",
+                                     MakeCallback(&Neighbors::NotifyArpResolved, this));
+    m_arp.erase(i);
 }
 
 Mac48Address
@@ -164,17 +248,101 @@ Neighbors::LookupMacAddress(Ipv4Address addr)
 }
 
 void
-Neighbors::ProcessTxError(const WifiMacHeader& hdr)
+Neighbors::SetMacAddress(Neighbor& nb, Mac48Address mac)
 {
-    Mac48Address addr = hdr.GetAddr1();
+    if (nb.m_hardwareAddress == mac)
+    {
+        return;
+    }
+    if (nb.m_hardwareAddress != Mac48Address())
+    {
+        auto range = m_macIndex.equal_range(nb.m_hardwareAddress);
+        for (auto i = range.first; i != range.second; ++i)
+        {
+            if (i->second == nb.m_neighborAddress)
+            {
+                m_macIndex.erase(i);
+                break;
+            }
+        }
+    }
+    nb.m_hardwareAddress = mac;
+    if (mac != Mac48Address())
+    {
+        m_macIndex.emplace(mac, nb.m_neighborAddress);
+    }
+}
 
-    for (auto i = m_nb.begin(); i != m_nb.end(); ++i)
+void
+Neighbors::Erase(std::unordered_map<Ipv4Address, Neighbor, Ipv4AddressHash>::iterator i)
+{
+    SetMacAddress(i->second, Mac48Address());
+    m_nb.erase(i);
+    ++m_changes;
+}
+
+void
+Neighbors::NotifyClosed(const std::vector<std::pair<Ipv4Address, Time>>& closed)
+{
+    for (const auto& [addr, lastHeard] : closed)
     {
-        if (i->m_hardwareAddress == addr)
+        NS_LOG_LOGIC("Close link to " << addr);
+        if (!m_linkBreak.IsNull())
         {
-            i->close = true;
+            m_linkBreak(addr, Simulator::Now() - lastHeard);
         }
+        if (!m_handleLinkFailure.IsNull())
+        {
+            m_handleLinkFailure(addr);
+        }
+    }
+}
+
+int64_t
+Neighbors::GetWheelSlot(int64_t tick) const
+{
+    return tick / m_granularity;
+}
+
+void
+Neighbors::File(Neighbor& nb)
+{
+    // A neighbor expiring beyond the span of the wheel is filed again on the next turns
+    nb.m_timerExpireTime = nb.m_expireTime;
+    m_wheel[GetWheelSlot(nb.m_expireTime.GetTimeStep()) % WHEEL_SIZE].push_back(
+        {nb.m_neighborAddress, nb.m_expireTime});
+}
+
+void
+Neighbors::NotifyArpResolved(Ipv4Address addr, const Address& mac)
+{
+    auto i = m_nb.find(addr);
+    if (i == m_nb.end() || !Mac48Address::IsMatchingType(mac))
+    {
+        return;
+    }
+    NS_LOG_LOGIC("Neighbor " << addr << " resolved to " << mac);
+    SetMacAddress(i->second, Mac48Address::ConvertFrom(mac));
+}
+
+void
+Neighbors::ProcessTxError(const WifiMacHeader& hdr)
+{
+    Mac48Address addr = hdr.GetAddr1();
+
+    std::vector<std::pair<Ipv4Address, Time>> closed;
+    auto range = m_macIndex.equal_range(addr);
+    for (auto i = range.first; i != range.second; ++i)
+    {
+        closed.emplace_back(i->second, Time());
+    }
+    for (auto& [neighbor, lastHeard] : closed)
+    {
+        auto i = m_nb.find(neighbor);
+        lastHeard = i->second.m_lastHeard;
+        Erase(i);
     }
+    NotifyClosed(closed);
     Purge();
 }
 
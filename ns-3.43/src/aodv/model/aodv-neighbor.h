@@ -18,11 +18,14 @@
 #define AODVNEIGHBOR_H
 
 #include "ns3/arp-cache.h"
+#include "ns3/buffer.h"
 #include "ns3/callback.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/simulator.h"
 #include "ns3/timer.h"
 
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace ns3
@@ -38,6 +41,13 @@ class RoutingProtocol;
 /**
  * \ingroup aodv
  * \brief maintain list of active neighbors
+ *
+ * Neighbors are kept in a hash map keyed by address, with an index by MAC address for the
+ * layer 2 TX error notifications. Expiry is driven by a timing wheel: every neighbor is
+ * filed in the bucket covering its expire time, and a purge only visits the buckets that
+ * have elapsed since the previous one. A neighbor whose expire time was extended is filed
+ * again when its bucket is visited. The MAC address of a neighbor is resolved from the ARP
+ * caches when the neighbor is added, and refreshed when an ARP cache resolves its address.
  */
 class Neighbors
 {
@@ -47,6 +57,7 @@ class Neighbors
      * \param delay the delay time for purging the list of neighbors
      */
     Neighbors(Time delay);
+    ~Neighbors();
 
     /// Neighbor description
     struct Neighbor
@@ -57,8 +68,10 @@ class Neighbors
         Mac48Address m_hardwareAddress;
         /// Neighbor expire time
         Time m_expireTime;
-        /// Neighbor close indicator
-        bool close;
+        /// Expire time the neighbor is filed in the timing wheel with
+        Time m_timerExpireTime;
+        /// Time the neighbor was last heard from
+        Time m_lastHeard;
 
         /**
          * \brief Neighbor structure constructor
@@ -71,7 +84,8 @@ class Neighbors
             : m_neighborAddress(ip),
               m_hardwareAddress(mac),
               m_expireTime(t),
-              close(false)
+              m_timerExpireTime(t),
+              m_lastHeard(Simulator::Now())
         {
         }
     };
@@ -89,11 +103,19 @@ class Neighbors
      */
     bool IsNeighbor(Ipv4Address addr);
     /**
-     * Update expire time for entry with address addr, if it exists, else add new entry
+     * Update expire time for entry with address addr, if it exists, else add new entry. The
+     * neighbor is recorded as heard from now.
      * \param addr the IP address to check
      * \param expire the expire time for the address
      */
     void Update(Ipv4Address addr, Time expire);
+    /**
+     * \returns the number of neighbors added to or removed from the list since it was created
+     */
+    uint32_t GetChangeCount() const
+    {
+        return m_changes;
+    }
     /// Remove all expired entries
     void Purge();
     /// Schedule m_ntimer.
@@ -103,8 +125,29 @@ class Neighbors
     void Clear()
     {
         m_nb.clear();
+        m_macIndex.clear();
+        for (auto& bucket : m_wheel)
+        {
+            bucket.clear();
+        }
     }
 
+    /**
+     * \returns the number of bytes written by Serialize()
+     */
+    uint32_t GetSerializedSize() const;
+    /**
+     * Write the neighbors that have not expired, with their expire times relative to now
+     * \param i the buffer iterator, moved past the neighbors
+     */
+    void Serialize(Buffer::Iterator& i) const;
+    /**
+     * Add or update the neighbors written by Serialize(), expiring at the same times relative
+     * to now. A MAC address that the ARP caches do not resolve is restored as it was saved.
+     * \param i the buffer iterator, moved past the neighbors
+     */
+    void Deserialize(Buffer::Iterator& i);
+
     /**
      * Add ARP cache to be used to allow layer 2 notifications processing
      * \param a pointer to the ARP cache to add
@@ -143,17 +186,59 @@ class Neighbors
         return m_handleLinkFailure;
     }
 
+    /**
+     * Set the callback notified of each link break detected, before the link failure
+     * callback, with the time elapsed since the neighbor was last heard from
+     * \param cb the callback function
+     */
+    void SetLinkBreakCallback(Callback<void, Ipv4Address, Time> cb)
+    {
+        m_linkBreak = cb;
+    }
+
   private:
+    /// Number of buckets of the timing wheel
+    static constexpr uint32_t WHEEL_SIZE = 64;
+
+    /// Hash of a MAC address
+    struct MacHash
+    {
+        /**
+         * \param mac the MAC address
+         * \returns the hash of the address
+         */
+        std::size_t operator()(const Mac48Address& mac) const;
+    };
+
+    /// Entry of the timing wheel
+    struct WheelEntry
+    {
+        Ipv4Address m_neighborAddress; ///< Neighbor address
+        Time m_expireTime;             ///< Expire time the neighbor was filed with
+    };
+
     /// link failure callback
     Callback<void, Ipv4Address> m_handleLinkFailure;
+    /// link break callback
+    Callback<void, Ipv4Address, Time> m_linkBreak;
     /// TX error callback
     Callback<void, const WifiMacHeader&> m_txErrorCallback;
     /// Timer for neighbor's list. Schedule Purge().
     Timer m_ntimer;
-    /// vector of entries
-    std::vector<Neighbor> m_nb;
+    /// Neighbors by address
+    std::unordered_map<Ipv4Address, Neighbor, Ipv4AddressHash> m_nb;
+    /// Addresses of the neighbors by MAC address
+    std::unordered_multimap<Mac48Address, Ipv4Address, MacHash> m_macIndex;
+    /// Timing wheel of the expire times
+    std::vector<std::vector<WheelEntry>> m_wheel;
+    /// Width of a wheel bucket, in time steps
+    int64_t m_granularity;
+    /// Absolute wheel slot reached by the last purge
+    int64_t m_wheelSlot;
     /// list of ARP cached to be used for layer 2 notifications processing
     std::vector<Ptr<ArpCache>> m_arp;
+    /// Number of neighbors added or removed
+    uint32_t m_changes;
 
     /**
      * Find MAC address by IP using list of ARP caches
@@ -162,6 +247,38 @@ class Neighbors
      * \returns the MAC address for the IP address
      */
     Mac48Address LookupMacAddress(Ipv4Address addr);
+    /**
+     * Set the MAC address of a neighbor, keeping the MAC address index up to date
+     * \param nb the neighbor
+     * \param mac the MAC address
+     */
+    void SetMacAddress(Neighbor& nb, Mac48Address mac);
+    /**
+     * Remove a neighbor
+     * \param i iterator to the neighbor
+     */
+    void Erase(std::unordered_map<Ipv4Address, Neighbor, Ipv4AddressHash>::iterator i);
+    /**
+     * Notify the link break and link failure callbacks of the links closed
+     * \param closed the neighbors, with the time they were last heard from
+     */
+    void NotifyClosed(const std::vector<std::pair<Ipv4Address, Time>>& closed);
+    /**
+     * \param tick a time, in time steps
+     * \returns the absolute wheel slot covering it
+     */
+    int64_t GetWheelSlot(int64_t tick) const;
+    /**
+     * File a neighbor in the wheel bucket of its expire time
+     * \param nb the neighbor
+     */
+    void File(Neighbor& nb);
+    /**
+     * Process the resolution of an address by an ARP cache
+     * \param addr the IP address
+     * \param mac the MAC address
+     */
+    void NotifyArpResolved(Ipv4Address addr, const Address& mac);
     /**
      * Process layer 2 TX error notification
      * \param hdr header of the packet
@@ -18,11 +18,138 @@
 #include "ns3/address-utils.h"
 #include "ns3/packet.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 namespace ns3
 {
 namespace aodv
 {
 
+namespace
+{
+
+/// Mask of the EOCW metric encoding in the RREQ and RREP flags byte
+constexpr uint8_t EOCW_ENCODING_MASK = 0x03;
+
+/**
+ * \param encoding the encoding of the EOCW path metrics
+ * \returns the number of bytes taken by the metrics
+ */
+uint32_t
+GetEocwMetricsSize(EocwMetricEncoding encoding)
+{
+    switch (encoding)
+    {
+    case EOCW_FLOAT32:
+        return 8;
+    case EOCW_FIXED8:
+        return 2;
+    case EOCW_FIXED12:
+        return 3;
+    }
+    return 0;
+}
+
+/**
+ * Quantize a metric in [0, 1]
+ * \param value the metric
+ * \param bits the number of bits of the fixed-point value
+ * \returns the fixed-point value
+ */
+uint16_t
+EocwQuantize(double value, uint8_t bits)
+{
+    double max = (1 << bits) - 1;
+    return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0, 1.0) * max));
+}
+
+/**
+ * Write the EOCW path metrics, most significant byte first
+ * \param i the buffer iterator
+ * \param encoding the encoding
+ * \param minEnergy the minimum residual energy score
+ * \param avgCongestion the average congestion degree score
+ */
+void
+WriteEocwMetrics(Buffer::Iterator& i,
+                 EocwMetricEncoding encoding,
+                 double minEnergy,
+                 double avgCongestion)
+{
+    switch (encoding)
+    {
+    case EOCW_FLOAT32: {
+        uint32_t bits;
+        float value = static_cast<float>(minEnergy);
+        std::memcpy(&bits, &value, sizeof(bits));
+        i.WriteHtonU32(bits);
+        value = static_cast<float>(avgCongestion);
+        std::memcpy(&bits, &value, sizeof(bits));
+        i.WriteHtonU32(bits);
+        break;
+    }
+    case EOCW_FIXED8:
+        i.WriteU8(EocwQuantize(minEnergy, 8));
+        i.WriteU8(EocwQuantize(avgCongestion, 8));
+        break;
+    case EOCW_FIXED12: {
+        uint16_t energy = EocwQuantize(minEnergy, 12);
+        uint16_t congestion = EocwQuantize(avgCongestion, 12);
+        i.WriteU8(energy >> 4);
+        i.WriteU8(((energy & 0x0f) << 4) | (congestion >> 8));
+        i.WriteU8(congestion & 0xff);
+        break;
+    }
+    }
+}
+
+/**
+ * Read the EOCW path metrics written by WriteEocwMetrics()
+ * \param i the buffer iterator
+ * \param encoding the encoding
+ * \param minEnergy the minimum residual energy score
+ * \param avgCongestion the average congestion degree score
+ */
+void
+ReadEocwMetrics(Buffer::Iterator& i,
+                EocwMetricEncoding encoding,
+                double& minEnergy,
+                double& avgCongestion)
+{
+    switch (encoding)
+    {
+    case EOCW_FLOAT32: {
+        float value;
+        uint32_t bits = i.ReadNtohU32();
+        std::memcpy(&value, &bits, sizeof(value));
+        minEnergy = value;
+        bits = i.ReadNtohU32();
+        std::memcpy(&value, &bits, sizeof(value));
+        avgCongestion = value;
+        break;
+    }
+    case EOCW_FIXED8:
+        minEnergy = i.ReadU8() / 255.0;
+        avgCongestion = i.ReadU8() / 255.0;
+        break;
+    case EOCW_FIXED12: {
+        uint8_t b0 = i.ReadU8();
+        uint8_t b1 = i.ReadU8();
+        uint8_t b2 = i.ReadU8();
+        minEnergy = ((b0 << 4) | (b1 >> 4)) / 4095.0;
+        avgCongestion = (((b1 & 0x0f) << 8) | b2) / 4095.0;
+        break;
+    }
+    default:
+        minEnergy = 0;
+        avgCongestion = 0;
+    }
+}
+
+} // namespace
+
 NS_OBJECT_ENSURE_REGISTERED(TypeHeader);
 
 TypeHeader::TypeHeader(MessageType t)
@@ -140,9 +267,8 @@ RreqHeader::RreqHeader(uint8_t flags,
       m_dstSeqNo(dstSeqNo),
       m_origin(origin),
       m_originSeqNo(originSeqNo),
-      // --- TAMBAHAN EOCW ---
-        m_pathMinEnergy(0.0),
-        m_pathAvgCongestion(0.0)
+      m_pathMinEnergy(0.0),
+      m_pathAvgCongestion(0.0)
 {
 }
 
@@ -167,8 +293,7 @@ RreqHeader::GetInstanceTypeId() const
 uint32_t
 RreqHeader::GetSerializedSize() const
 {
-    // 23 byte asli + 8 byte (untuk 1 double baru)
-    return 23 + 8;
+    return 23 + GetEocwMetricsSize(GetEocwEncoding());
 }
 
 void
@@ -182,15 +307,7 @@ RreqHeader::Serialize(Buffer::Iterator i) const
     i.WriteHtonU32(m_dstSeqNo);
     WriteTo(i, m_origin);
     i.WriteHtonU32(m_originSeqNo);
-    // --- TAMBAHKAN INI ---
-    // Ubah double ke float, lalu ke uint32_t untuk serialisasi
-    float f_minEnergy = (float)m_pathMinEnergy;
-    uint32_t val_minEnergy = *reinterpret_cast<uint32_t*>(&f_minEnergy);
-    i.WriteHtonU32(val_minEnergy);
-
-    float f_avgCongestion = (float)m_pathAvgCongestion;
-    uint32_t val_avgCongestion = *reinterpret_cast<uint32_t*>(&f_avgCongestion);
-    i.WriteHtonU32(val_avgCongestion);
+    WriteEocwMetrics(i, GetEocwEncoding(), m_pathMinEnergy, m_pathAvgCongestion);
 }
 
 uint32_t
@@ -205,13 +322,7 @@ RreqHeader::Deserialize(Buffer::Iterator start)
     m_dstSeqNo = i.ReadNtohU32();
     ReadFrom(i, m_origin);
     m_originSeqNo = i.ReadNtohU32();
-    // --- TAMBAHKAN INI ---
-    // Baca uint32_t, lalu ubah kembali ke float, lalu ke double
-    uint32_t val_minEnergy = i.ReadNtohU32();
-    m_pathMinEnergy = (double)(*reinterpret_cast<float*>(&val_minEnergy));
-
-    uint32_t val_avgCongestion = i.ReadNtohU32();
-    m_pathAvgCongestion = (double)(*reinterpret_cast<float*>(&val_avgCongestion));
+    ReadEocwMetrics(i, GetEocwEncoding(), m_pathMinEnergy, m_pathAvgCongestion);
 
     uint32_t dist = i.GetDistanceFrom(start);
     NS_ASSERT(dist == GetSerializedSize());
@@ -292,6 +403,18 @@ RreqHeader::GetUnknownSeqno() const
     return (m_flags & (1 << 3));
 }
 
+void
+RreqHeader::SetEocwEncoding(EocwMetricEncoding encoding)
+{
+    m_flags = (m_flags & ~EOCW_ENCODING_MASK) | (encoding & EOCW_ENCODING_MASK);
+}
+
+EocwMetricEncoding
+RreqHeader::GetEocwEncoding() const
+{
+    return static_cast<EocwMetricEncoding>(m_flags & EOCW_ENCODING_MASK);
+}
+
 bool
 RreqHeader::operator==(const RreqHeader& o) const
 {
@@ -316,8 +439,8 @@ RrepHeader::RrepHeader(uint8_t prefixSize,
       m_dst(dst),
       m_dstSeqNo(dstSeqNo),
       m_origin(origin),
-        m_pathMinEnergy(0.0),
-        m_pathAvgCongestion(0.0)
+      m_pathMinEnergy(0.0),
+      m_pathAvgCongestion(0.0)
 {
     m_lifeTime = uint32_t(lifeTime.GetMilliSeconds());
 }
@@ -343,8 +466,7 @@ RrepHeader::GetInstanceTypeId() const
 uint32_t
 RrepHeader::GetSerializedSize() const
 {
-    // 19 byte asli + 8 byte (untuk 1 double baru)
-    return 19 + 8;
+    return 19 + GetEocwMetricsSize(GetEocwEncoding());
 }
 
 void
@@ -357,14 +479,7 @@ RrepHeader::Serialize(Buffer::Iterator i) const
     i.WriteHtonU32(m_dstSeqNo);
     WriteTo(i, m_origin);
     i.WriteHtonU32(m_lifeTime);
-    // --- TAMBAHKAN INI ---
-    float f_minEnergy = (float)m_pathMinEnergy;
-    uint32_t val_minEnergy = *reinterpret_cast<uint32_t*>(&f_minEnergy);
-    i.WriteHtonU32(val_minEnergy);
-
-    float f_avgCongestion = (float)m_pathAvgCongestion;
-    uint32_t val_avgCongestion = *reinterpret_cast<uint32_t*>(&f_avgCongestion);
-    i.WriteHtonU32(val_avgCongestion);
+    WriteEocwMetrics(i, GetEocwEncoding(), m_pathMinEnergy, m_pathAvgCongestion);
 }
 
 uint32_t
@@ -379,12 +494,7 @@ RrepHeader::Deserialize(Buffer::Iterator start)
     m_dstSeqNo = i.ReadNtohU32();
     ReadFrom(i, m_origin);
     m_lifeTime = i.ReadNtohU32();
-    // --- TAMBAHKAN INI ---
-    uint32_t val_minEnergy = i.ReadNtohU32();
-    m_pathMinEnergy = (double)(*reinterpret_cast<float*>(&val_minEnergy));
-
-    uint32_t val_avgCongestion = i.ReadNtohU32();
-    m_pathAvgCongestion = (double)(*reinterpret_cast<float*>(&val_avgCongestion));
+    ReadEocwMetrics(i, GetEocwEncoding(), m_pathMinEnergy, m_pathAvgCongestion);
     uint32_t dist = i.GetDistanceFrom(start);
     NS_ASSERT(dist == GetSerializedSize());
     return dist;
@@ -446,6 +556,18 @@ RrepHeader::GetPrefixSize() const
     return m_prefixSize;
 }
 
+void
+RrepHeader::SetEocwEncoding(EocwMetricEncoding encoding)
+{
+    m_flags = (m_flags & ~EOCW_ENCODING_MASK) | (encoding & EOCW_ENCODING_MASK);
+}
+
+EocwMetricEncoding
+RrepHeader::GetEocwEncoding() const
+{
+    return static_cast<EocwMetricEncoding>(m_flags & EOCW_ENCODING_MASK);
+}
+
 bool
 RrepHeader::operator==(const RrepHeader& o) const
 {
@@ -457,7 +579,7 @@ RrepHeader::operator==(const RrepHeader& o) const
 void
 RrepHeader::SetHello(Ipv4Address origin, uint32_t srcSeqNo, Time lifetime)
 {
-    m_flags = 0;
+    m_flags &= EOCW_ENCODING_MASK;
     m_prefixSize = 0;
     m_hopCount = 0;
     m_dst = origin;
@@ -41,6 +41,23 @@ enum MessageType
     AODVTYPE_RREP_ACK = 4 //!< AODVTYPE_RREP_ACK
 };
 
+/**
+ * \ingroup aodv
+ * \brief Encoding of the EOCW path metrics (minimum residual energy score, average
+ * congestion degree score) appended to RREQ and RREP messages.
+ *
+ * The encoding is signalled in the two low-order bits of the flags byte, which RFC 3561
+ * leaves reserved. Both metrics lie in [0, 1]; the fixed-point encodings quantize them
+ * uniformly over that range, with a maximum error of half a step (1/510 for 8 bits,
+ * 1/8190 for 12 bits).
+ */
+enum EocwMetricEncoding
+{
+    EOCW_FLOAT32 = 0, //!< Two IEEE 754 single precision floats, 8 bytes
+    EOCW_FIXED8 = 1,  //!< Two 8-bit fixed-point values, 2 bytes
+    EOCW_FIXED12 = 2, //!< Two 12-bit fixed-point values packed in 3 bytes
+};
+
 /**
  * \ingroup aodv
  * \brief AODV types
@@ -299,6 +316,17 @@ class RreqHeader : public Header
      */
     bool GetUnknownSeqno() const;
 
+    /**
+     * \brief Set the encoding of the EOCW path metrics
+     * \param encoding the encoding
+     */
+    void SetEocwEncoding(EocwMetricEncoding encoding);
+    /**
+     * \brief Get the encoding of the EOCW path metrics
+     * \return the encoding
+     */
+    EocwMetricEncoding GetEocwEncoding() const;
+
     /**
      * \brief Comparison operator
      * \param o RREQ header to compare
@@ -311,7 +339,7 @@ class RreqHeader : public Header
     // --- AKHIR EOCW ---
 
   private:
-    uint8_t m_flags;        ///< |J|R|G|D|U| bit flags, see RFC
+    uint8_t m_flags;        ///< |J|R|G|D|U| bit flags, see RFC, and EOCW metric encoding
     uint8_t m_reserved;     ///< Not used (must be 0)
     uint8_t m_hopCount;     ///< Hop Count
     uint32_t m_requestID;   ///< RREQ ID
@@ -492,6 +520,17 @@ class RrepHeader : public Header
      */
     void SetHello(Ipv4Address src, uint32_t srcSeqNo, Time lifetime);
 
+    /**
+     * \brief Set the encoding of the EOCW path metrics
+     * \param encoding the encoding
+     */
+    void SetEocwEncoding(EocwMetricEncoding encoding);
+    /**
+     * \brief Get the encoding of the EOCW path metrics
+     * \return the encoding
+     */
+    EocwMetricEncoding GetEocwEncoding() const;
+
     /**
      * \brief Comparison operator
      * \param o RREP header to compare
@@ -504,7 +543,7 @@ class RrepHeader : public Header
     // --- AKHIR EOCW ---
 
   private:
-    uint8_t m_flags;      ///< A - acknowledgment required flag
+    uint8_t m_flags;      ///< A - acknowledgment required flag, and EOCW metric encoding
     uint8_t m_prefixSize; ///< Prefix Size
     uint8_t m_hopCount;   ///< Hop Count
     Ipv4Address m_dst;    ///< Destination IP Address
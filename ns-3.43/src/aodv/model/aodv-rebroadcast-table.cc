@@ -0,0 +1,99 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "aodv-rebroadcast-table.h"
+
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("AodvRebroadcastTable");
+
+namespace aodv
+{
+
+RebroadcastTable::RebroadcastTable()
+    : m_suppression(SUPPRESSION_NONE),
+      m_counterThreshold(3)
+{
+}
+
+void
+RebroadcastTable::Insert(Ipv4Address origin, uint32_t id, double score, std::vector<EventId> events)
+{
+    if (events.empty())
+    {
+        return;
+    }
+    Flood& flood = m_floods[Key{origin, id}];
+    flood.m_pending = events.size();
+    flood.m_events = std::move(events);
+    flood.m_score = score;
+}
+
+bool
+RebroadcastTable::HearDuplicate(Ipv4Address origin, uint32_t id, double score)
+{
+    auto i = m_floods.find(Key{origin, id});
+    if (i == m_floods.end())
+    {
+        return false;
+    }
+    Flood& flood = i->second;
+    flood.m_copies++;
+    switch (m_suppression)
+    {
+    case SUPPRESSION_NONE:
+        return false;
+    case SUPPRESSION_COUNTER:
+        if (flood.m_copies < m_counterThreshold)
+        {
+            return false;
+        }
+        break;
+    case SUPPRESSION_SCORE:
+        if (score < flood.m_score)
+        {
+            return false;
+        }
+        break;
+    }
+    NS_LOG_LOGIC("Rebroadcast of " << origin << ":" << id << " cancelled after "
+                                   << flood.m_copies << " copies");
+    for (auto& event : flood.m_events)
+    {
+        event.Cancel();
+    }
+    m_floods.erase(i);
+    return true;
+}
+
+void
+RebroadcastTable::NotifySent(Ipv4Address origin, uint32_t id)
+{
+    auto i = m_floods.find(Key{origin, id});
+    if (i != m_floods.end() && --i->second.m_pending == 0)
+    {
+        m_floods.erase(i);
+    }
+}
+
+void
+RebroadcastTable::Clear()
+{
+    for (auto& [key, flood] : m_floods)
+    {
+        for (auto& event : flood.m_events)
+        {
+            event.Cancel();
+        }
+    }
+    m_floods.clear();
+}
+
+} // namespace aodv
+} // namespace ns3
@@ -0,0 +1,177 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#ifndef AODV_REBROADCAST_TABLE_H
+#define AODV_REBROADCAST_TABLE_H
+
+#include "ns3/event-id.h"
+#include "ns3/ipv4-address.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+namespace aodv
+{
+
+/**
+ * \ingroup aodv
+ * How a node decides that the copies of a RREQ flood it overheard make its own pending
+ * rebroadcast redundant
+ */
+enum RebroadcastSuppression
+{
+    SUPPRESSION_NONE,    ///< Never: every rebroadcast goes out
+    SUPPRESSION_COUNTER, ///< Once a given number of copies of the flood has been heard
+    SUPPRESSION_SCORE,   ///< Once a copy advertising a path scoring at least as well is heard
+};
+
+/**
+ * \ingroup aodv
+ * \brief Pending RREQ rebroadcasts of a node, one per flood.
+ *
+ * A node forwards the first copy of a flood it receives after a forward delay. The table
+ * keeps the events of the rebroadcasts scheduled for each (origin, id) flood until they go
+ * out, so that the duplicates overheard meanwhile, which are not forwarded on their own,
+ * can cancel them:
+ *
+ * - counter-based suppression cancels the rebroadcast once the number of copies heard,
+ *   the first one included, reaches a threshold: enough neighbors already covered the area;
+ * - score-based suppression cancels it as soon as a neighbor advertises a path scoring at
+ *   least as well as the one the node would advertise: the flood offers nothing better
+ *   through this node.
+ */
+class RebroadcastTable
+{
+  public:
+    RebroadcastTable();
+
+    /**
+     * Record the rebroadcasts scheduled for a flood
+     * \param origin the RREQ originator
+     * \param id the RREQ ID
+     * \param score the score of the path the rebroadcasts advertise
+     * \param events the events of the rebroadcasts, one per interface
+     */
+    void Insert(Ipv4Address origin, uint32_t id, double score, std::vector<EventId> events);
+
+    /**
+     * Account a duplicate of a flood, and cancel the pending rebroadcasts if the duplicate
+     * makes them redundant
+     * \param origin the RREQ originator
+     * \param id the RREQ ID
+     * \param score the score of the path the duplicate advertises
+     * \returns true if the rebroadcasts were cancelled
+     */
+    bool HearDuplicate(Ipv4Address origin, uint32_t id, double score);
+
+    /**
+     * Account a rebroadcast of a flood that went out; the flood leaves the table with its
+     * last pending rebroadcast
+     * \param origin the RREQ originator
+     * \param id the RREQ ID
+     */
+    void NotifySent(Ipv4Address origin, uint32_t id);
+
+    /// Cancel all pending rebroadcasts
+    void Clear();
+
+    /**
+     * \returns the number of floods with pending rebroadcasts
+     */
+    uint32_t GetSize() const
+    {
+        return m_floods.size();
+    }
+
+    /**
+     * Set the suppression mode
+     * \param mode the suppression mode
+     */
+    void SetSuppression(RebroadcastSuppression mode)
+    {
+        m_suppression = mode;
+    }
+
+    /**
+     * \returns the suppression mode
+     */
+    RebroadcastSuppression GetSuppression() const
+    {
+        return m_suppression;
+    }
+
+    /**
+     * Set the number of copies heard, the first one included, that cancels a rebroadcast
+     * under counter-based suppression
+     * \param copies the number of copies
+     */
+    void SetCounterThreshold(uint32_t copies)
+    {
+        m_counterThreshold = copies;
+    }
+
+    /**
+     * \returns the number of copies that cancels a rebroadcast
+     */
+    uint32_t GetCounterThreshold() const
+    {
+        return m_counterThreshold;
+    }
+
+  private:
+    /// Pending rebroadcasts of a flood
+    struct Flood
+    {
+        std::vector<EventId> m_events; ///< Rebroadcast events, one per interface
+        uint32_t m_pending{0};         ///< Rebroadcasts not sent yet
+        uint32_t m_copies{1};          ///< Copies heard, the first one included
+        double m_score{0};             ///< Score of the path the rebroadcasts advertise
+    };
+
+    /// Flood key: RREQ IDs are only unique in the context of their originator
+    struct Key
+    {
+        Ipv4Address m_origin; ///< RREQ originator
+        uint32_t m_id;        ///< RREQ ID
+
+        /**
+         * \brief Compare keys
+         * \param o the other key
+         * \return true if equal
+         */
+        bool operator==(const Key& o) const
+        {
+            return m_origin == o.m_origin && m_id == o.m_id;
+        }
+    };
+
+    /// Hash of a flood key
+    struct KeyHash
+    {
+        /**
+         * \param k the key
+         * \return the hash
+         */
+        size_t operator()(const Key& k) const
+        {
+            return std::hash<uint64_t>()((uint64_t(k.m_origin.Get()) << 32) | k.m_id);
+        }
+    };
+
+    /// Floods with pending rebroadcasts
+    std::unordered_map<Key, Flood, KeyHash> m_floods;
+    /// Suppression mode
+    RebroadcastSuppression m_suppression;
+    /// Number of copies that cancels a rebroadcast under counter-based suppression
+    uint32_t m_counterThreshold;
+};
+
+} // namespace aodv
+} // namespace ns3
+
+#endif /* AODV_REBROADCAST_TABLE_H */
@@ -9,11 +9,15 @@
  */
 
 #include "aodv-routing-protocol.h"
+#include "aodv-eocw-batch.h"
 
 #include "ns3/adhoc-wifi-mac.h"
 #include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/log.h"
+#include "ns3/mobility-model.h"
 #include "ns3/pointer.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/string.h"
@@ -97,6 +101,9 @@ RoutingProtocol::RoutingProtocol()
       m_gratuitousReply(true),
       m_enableHello(false),
       m_enableFuzzy(true), // Default True
+      m_fuzzyEvaluation(FUZZY_EXACT),
+      m_fuzzyTableResolution(64),
+      m_eocwMetricEncoding(EOCW_FLOAT32),
       m_routingTable(m_deletePeriod),
       m_queue(m_maxQueueLen, m_maxQueueTime),
       m_requestId(0),
@@ -109,9 +116,31 @@ RoutingProtocol::RoutingProtocol()
       m_htimer(Timer::CANCEL_ON_DESTROY),
       m_rreqRateLimitTimer(Timer::CANCEL_ON_DESTROY),
       m_rerrRateLimitTimer(Timer::CANCEL_ON_DESTROY),
-      m_lastBcastTime(Seconds(0))
+      m_lastBcastTime(Seconds(0)),
+      m_adaptiveHello(false),
+      m_maxHelloInterval(Seconds(5)),
+      m_helloChurnThreshold(0.5),
+      m_helloSpeedThreshold(5),
+      m_helloTxEnergy(0.0075),
+      m_helloTrafficSuppression(false),
+      m_currentHelloInterval(Seconds(1)),
+      m_lastUnicastTime(Seconds(0)),
+      m_helloStartTime(Seconds(0)),
+      m_helloSlots(0),
+      m_helloCount(0),
+      m_helloEnergySaved(0),
+      m_initialEnergy(0),
+      m_energyScore(1.0),
+      m_energyScoreTraced(false),
+      m_energyScoreMaxAge(Seconds(1)),
+      m_congestionScore(1.0),
+      m_eocwPathCache(8),
+      m_eocwCollectionTime(MilliSeconds(20)),
+      m_eocwEarlyCommitMargin(0.0),
+      m_eocwMaxPaths(1)
 {
     m_nb.SetCallback(MakeCallback(&RoutingProtocol::SendRerrWhenBreaksLinkToNextHop, this));
+    m_nb.SetLinkBreakCallback(MakeCallback(&RoutingProtocol::NotifyLinkBreak, this));
 }
 
 TypeId
@@ -147,12 +176,40 @@ RoutingProtocol::GetTypeId()
             .AddAttribute("EnableHello", "Indicates whether a hello messages enable.", BooleanValue(true), MakeBooleanAccessor(&RoutingProtocol::SetHelloEnable, &RoutingProtocol::GetHelloEnable), MakeBooleanChecker())
             .AddAttribute("EnableBroadcast", "Indicates whether a broadcast data packets forwarding enable.", BooleanValue(true), MakeBooleanAccessor(&RoutingProtocol::SetBroadcastEnable, &RoutingProtocol::GetBroadcastEnable), MakeBooleanChecker())
             .AddAttribute("UniformRv", "Access to the underlying UniformRandomVariable", StringValue("ns3::UniformRandomVariable"), MakePointerAccessor(&RoutingProtocol::m_uniformRandomVariable), MakePointerChecker<UniformRandomVariable>())
-            .AddAttribute("EnableFuzzy", "True to use Modified Fuzzy (Smart Delay & Suppression), False for Original Paper (Static Thresholds)", BooleanValue(true), MakeBooleanAccessor(&RoutingProtocol::m_enableFuzzy), MakeBooleanChecker());
+            .AddAttribute("EnableFuzzy", "True to use Modified Fuzzy (Smart Delay & Suppression), False for Original Paper (Static Thresholds)", BooleanValue(true), MakeBooleanAccessor(&RoutingProtocol::m_enableFuzzy), MakeBooleanChecker())
+            .AddAttribute("FuzzyEvaluation", "How the fuzzy weights are evaluated: exactly from the rule base, or by bilinear interpolation in a table sampled from it.", EnumValue(FUZZY_EXACT), MakeEnumAccessor<FuzzyEvaluation>(&RoutingProtocol::m_fuzzyEvaluation), MakeEnumChecker(FUZZY_EXACT, "Exact", FUZZY_TABULATED, "Tabulated"))
+            .AddAttribute("FuzzyTableResolution", "Number of grid cells per axis of the fuzzy weight table used when FuzzyEvaluation is Tabulated.", UintegerValue(64), MakeUintegerAccessor(&RoutingProtocol::m_fuzzyTableResolution), MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("EocwMetricEncoding", "Encoding of the EOCW path metrics in the RREQ, RREP and Hello messages this node originates: two 32-bit floats, or two 8-bit or 12-bit fixed-point values. Forwarded messages keep the encoding chosen by their originator.", EnumValue(EOCW_FLOAT32), MakeEnumAccessor<EocwMetricEncoding>(&RoutingProtocol::m_eocwMetricEncoding), MakeEnumChecker(EOCW_FLOAT32, "Float32", EOCW_FIXED8, "Fixed8", EOCW_FIXED12, "Fixed12"))
+            .AddAttribute("EocwMaxCandidates", "Maximum number of candidate paths the destination keeps per route discovery; worse paths are dropped on arrival.", UintegerValue(8), MakeUintegerAccessor(&RoutingProtocol::SetEocwMaxCandidates, &RoutingProtocol::GetEocwMaxCandidates), MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("EocwCollectionTime", "Time the destination collects candidate paths before answering a RREQ.", TimeValue(MilliSeconds(20)), MakeTimeAccessor(&RoutingProtocol::m_eocwCollectionTime), MakeTimeChecker())
+            .AddAttribute("EocwEarlyCommitMargin", "Answer a RREQ without waiting for EocwCollectionTime as soon as a candidate path scores at least 1 - margin. 0 disables early commit.", DoubleValue(0.0), MakeDoubleAccessor(&RoutingProtocol::m_eocwEarlyCommitMargin), MakeDoubleChecker<double>(0.0, 1.0))
+            .AddAttribute("EocwMaxPaths", "Number of candidate paths through distinct last hops the destination sends a RREP along, best first. Where a further path diverges from the route in use, it is kept as an alternate that replaces the route, without a new route discovery, when the link to its next hop breaks. 1 keeps no alternates.", UintegerValue(1), MakeUintegerAccessor(&RoutingProtocol::m_eocwMaxPaths), MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("RreqSuppression", "How the duplicates of a RREQ flood overheard while its rebroadcast is pending cancel the rebroadcast: never, once RreqSuppressionThreshold copies were heard, or once a copy advertises a path scoring at least as well as the one this node would advertise.", EnumValue(SUPPRESSION_NONE), MakeEnumAccessor<RebroadcastSuppression>(&RoutingProtocol::SetRreqSuppression, &RoutingProtocol::GetRreqSuppression), MakeEnumChecker(SUPPRESSION_NONE, "None", SUPPRESSION_COUNTER, "Counter", SUPPRESSION_SCORE, "Score"))
+            .AddAttribute("RreqSuppressionThreshold", "Number of copies of a RREQ flood heard, the first one included, that cancels the pending rebroadcast when RreqSuppression is Counter.", UintegerValue(3), MakeUintegerAccessor(&RoutingProtocol::SetRreqSuppressionThreshold, &RoutingProtocol::GetRreqSuppressionThreshold), MakeUintegerChecker<uint32_t>(2))
+            .AddAttribute("EocwEnergyScoreMaxAge", "Maximum age of the cached residual energy score. The cache is refreshed by the RemainingEnergy trace of the energy source and the source is queried again only when the cached score is older than this.", TimeValue(Seconds(1)), MakeTimeAccessor(&RoutingProtocol::m_energyScoreMaxAge), MakeTimeChecker())
+            .AddAttribute("AdaptiveHello", "Adapt the interval between HELLO messages to the node: from HelloInterval, for a node whose neighbors change at HelloChurnThreshold or that moves at HelloSpeedThreshold with full energy, to MaxHelloInterval, for an idle node or a node with no energy left. The lifetime advertised in each HELLO covers the interval until the next one.", BooleanValue(false), MakeBooleanAccessor(&RoutingProtocol::m_adaptiveHello), MakeBooleanChecker())
+            .AddAttribute("MaxHelloInterval", "Longest interval between HELLO messages with AdaptiveHello.", TimeValue(Seconds(5)), MakeTimeAccessor(&RoutingProtocol::m_maxHelloInterval), MakeTimeChecker())
+            .AddAttribute("HelloChurnThreshold", "Rate of neighbors added or lost, per second, at which AdaptiveHello uses the shortest interval.", DoubleValue(0.5), MakeDoubleAccessor(&RoutingProtocol::m_helloChurnThreshold), MakeDoubleChecker<double>(std::numeric_limits<double>::min()))
+            .AddAttribute("HelloSpeedThreshold", "Speed of the node, in m/s, at which AdaptiveHello uses the shortest interval.", DoubleValue(5), MakeDoubleAccessor(&RoutingProtocol::m_helloSpeedThreshold), MakeDoubleChecker<double>(std::numeric_limits<double>::min()))
+            .AddAttribute("HelloTrafficSuppression", "Skip a HELLO message while a unicast packet was received from a neighbor within the hello interval: the traffic already proves the links of the node alive to the neighbors it exchanges packets with.", BooleanValue(false), MakeBooleanAccessor(&RoutingProtocol::m_helloTrafficSuppression), MakeBooleanChecker())
+            .AddAttribute("HelloTxEnergy", "Energy spent sending one HELLO message, in J, used by the HelloEnergySaved trace.", DoubleValue(0.0075), MakeDoubleAccessor(&RoutingProtocol::m_helloTxEnergy), MakeDoubleChecker<double>(0))
+            .AddTraceSource("HelloCount", "Number of HELLO messages sent.", MakeTraceSourceAccessor(&RoutingProtocol::m_helloCount), "ns3::TracedValueCallback::Uint32")
+            .AddTraceSource("HelloEnergySaved", "Energy saved, in J, by the HELLO messages not sent with AdaptiveHello or HelloTrafficSuppression, relative to one every HelloInterval.", MakeTraceSourceAccessor(&RoutingProtocol::m_helloEnergySaved), "ns3::TracedValueCallback::Double")
+            .AddTraceSource("LinkBreakDetected", "The link to a neighbor was found broken, with the time elapsed since the neighbor was last heard from.", MakeTraceSourceAccessor(&RoutingProtocol::m_linkBreakTrace), "ns3::aodv::RoutingProtocol::LinkBreakDetectedTracedCallback")
+            .AddTraceSource("RouteDiscovery", "A route discovery flood was originated by this node.", MakeTraceSourceAccessor(&RoutingProtocol::m_routeDiscoveryTrace), "ns3::aodv::RoutingProtocol::RouteDiscoveryTracedCallback")
+            .AddTraceSource("RouteRecovery", "A route broken by a link failure was recovered, locally by an alternate path or by a new route discovery.", MakeTraceSourceAccessor(&RoutingProtocol::m_routeRecoveryTrace), "ns3::aodv::RoutingProtocol::RouteRecoveryTracedCallback")
+            .AddTraceSource("RreqReceived", "A RREQ was received, before the duplicate and energy checks.", MakeTraceSourceAccessor(&RoutingProtocol::m_rreqReceivedTrace), "ns3::aodv::RoutingProtocol::RreqReceivedTracedCallback")
+            .AddTraceSource("RreqSuppressed", "A RREQ was dropped because the residual energy score of this node is below the EOCW cut-off.", MakeTraceSourceAccessor(&RoutingProtocol::m_rreqSuppressedTrace), "ns3::aodv::RoutingProtocol::RreqSuppressedTracedCallback")
+            .AddTraceSource("RreqForwarded", "A RREQ rebroadcast was scheduled on an interface, after the forward delay.", MakeTraceSourceAccessor(&RoutingProtocol::m_rreqForwardedTrace), "ns3::aodv::RoutingProtocol::RreqForwardedTracedCallback")
+            .AddTraceSource("RreqCancelled", "The pending rebroadcast of a RREQ flood was cancelled by the duplicates overheard, see RreqSuppression.", MakeTraceSourceAccessor(&RoutingProtocol::m_rreqCancelledTrace), "ns3::aodv::RoutingProtocol::RreqCancelledTracedCallback")
+            .AddTraceSource("RrepSent", "A RREP was originated by this node, as destination or as intermediate node.", MakeTraceSourceAccessor(&RoutingProtocol::m_rrepSentTrace), "ns3::aodv::RoutingProtocol::RrepSentTracedCallback")
+            .AddTraceSource("EocwSelection", "A path was chosen for an EOCW route discovery this node is the destination of.", MakeTraceSourceAccessor(&RoutingProtocol::m_eocwSelectionTrace), "ns3::aodv::RoutingProtocol::EocwSelectionTracedCallback");
     return tid;
 }
 
 void RoutingProtocol::SetMaxQueueLen(uint32_t len) { m_maxQueueLen = len; m_queue.SetMaxQueueLen(len); }
 void RoutingProtocol::SetMaxQueueTime(Time t) { m_maxQueueTime = t; m_queue.SetQueueTimeout(t); }
+void RoutingProtocol::SetEocwMaxCandidates(uint32_t n) { m_eocwPathCache.SetMaxCandidates(n); }
 
 RoutingProtocol::~RoutingProtocol() {}
 
@@ -163,6 +220,13 @@ void RoutingProtocol::DoDispose()
     m_socketAddresses.clear();
     for (auto iter = m_socketSubnetBroadcastAddresses.begin(); iter != m_socketSubnetBroadcastAddresses.end(); iter++) iter->first->Close();
     m_socketSubnetBroadcastAddresses.clear();
+    m_eocwPathCache.Clear();
+    m_rebroadcasts.Clear();
+    if (m_energyScoreTraced) m_energySource->TraceDisconnectWithoutContext("RemainingEnergy", MakeCallback(&RoutingProtocol::NotifyRemainingEnergy, this));
+    m_energySource = nullptr;
+    if (m_congestionQueue) m_congestionQueue->TraceDisconnectWithoutContext("PacketsInQueue", MakeCallback(&RoutingProtocol::NotifyPacketsInQueue, this));
+    m_congestionQueue = nullptr;
+    m_congestionEstimator = nullptr;
     Ipv4RoutingProtocol::DoDispose();
 }
 
@@ -180,6 +244,31 @@ int64_t RoutingProtocol::AssignStreams(int64_t stream)
     return 1;
 }
 
+uint32_t RoutingProtocol::GetSerializedStateSize() const
+{
+    return 8 + m_routingTable.GetSerializedSize() + m_nb.GetSerializedSize() + m_rreqIdCache.GetSerializedSize();
+}
+
+void RoutingProtocol::SerializeState(Buffer::Iterator& i) const
+{
+    NS_LOG_FUNCTION(this);
+    i.WriteHtonU32(m_seqNo);
+    i.WriteHtonU32(m_requestId);
+    m_routingTable.Serialize(i);
+    m_nb.Serialize(i);
+    m_rreqIdCache.Serialize(i);
+}
+
+void RoutingProtocol::DeserializeState(Buffer::Iterator& i)
+{
+    NS_LOG_FUNCTION(this);
+    m_seqNo = std::max(m_seqNo, i.ReadNtohU32());
+    m_requestId = std::max(m_requestId, i.ReadNtohU32());
+    m_routingTable.Deserialize(i, m_ipv4);
+    m_nb.Deserialize(i);
+    m_rreqIdCache.Deserialize(i);
+}
+
 void RoutingProtocol::Start()
 {
     NS_LOG_FUNCTION(this);
@@ -191,12 +280,17 @@ void RoutingProtocol::Start()
         if (esc && esc->GetN() > 0) {
             m_energySource = esc->Get(0);
             m_initialEnergy = m_energySource->GetInitialEnergy();
+            m_energyScoreTraced = m_energySource->TraceConnectWithoutContext("RemainingEnergy", MakeCallback(&RoutingProtocol::NotifyRemainingEnergy, this));
+            m_energyScore = m_energySource->GetRemainingEnergy() / m_initialEnergy;
+            m_energyScoreTime = Simulator::Now();
         } else {
             m_energySource = nullptr;
             m_initialEnergy = 0;
         }
     }
 
+    if (node) m_congestionEstimator = node->GetObject<CongestionEstimator>();
+
     if (m_enableHello) m_nb.ScheduleTimer();
     m_rreqRateLimitTimer.SetFunction(&RoutingProtocol::RreqRateLimitTimerExpire, this);
     m_rreqRateLimitTimer.Schedule(Seconds(1));
@@ -279,6 +373,7 @@ bool RoutingProtocol::RouteInput(Ptr<const Packet> p, const Ipv4Header& header,
         if (m_routingTable.LookupValidRoute(origin, toOrigin)) {
             UpdateRouteLifeTime(toOrigin.GetNextHop(), m_activeRouteTimeout);
             m_nb.Update(toOrigin.GetNextHop(), m_activeRouteTimeout);
+            m_lastUnicastTime = Simulator::Now();
         }
         if (!lcb.IsNull()) lcb(p, header, iif);
         return true;
@@ -305,6 +400,7 @@ bool RoutingProtocol::Forwarding(Ptr<const Packet> p, const Ipv4Header& header,
             UpdateRouteLifeTime(toOrigin.GetNextHop(), m_activeRouteTimeout);
             m_nb.Update(route->GetGateway(), m_activeRouteTimeout);
             m_nb.Update(toOrigin.GetNextHop(), m_activeRouteTimeout);
+            m_lastUnicastTime = Simulator::Now();
             ucb(route, p, header);
             return true;
         } else {
@@ -359,6 +455,14 @@ void RoutingProtocol::NotifyInterfaceUp(uint32_t i)
     if (wifi) {
         Ptr<WifiMac> mac = wifi->GetMac();
         if (mac) mac->TraceConnectWithoutContext("DroppedMpdu", MakeCallback(&RoutingProtocol::NotifyTxError, this));
+        Ptr<AdhocWifiMac> adhocMac = mac ? mac->GetObject<AdhocWifiMac>() : nullptr;
+        if (adhocMac && !m_congestionQueue) {
+            m_congestionQueue = adhocMac->GetTxopQueue(AC_BE);
+            if (m_congestionQueue) {
+                m_congestionQueue->TraceConnectWithoutContext("PacketsInQueue", MakeCallback(&RoutingProtocol::NotifyPacketsInQueue, this));
+                NotifyPacketsInQueue(0, m_congestionQueue->GetNPackets());
+            }
+        }
     }
 }
 
@@ -373,6 +477,11 @@ void RoutingProtocol::NotifyInterfaceDown(uint32_t i)
         Ptr<WifiMac> mac = wifi->GetMac()->GetObject<AdhocWifiMac>();
         if (mac) {
             mac->TraceDisconnectWithoutContext("DroppedMpdu", MakeCallback(&RoutingProtocol::NotifyTxError, this));
+            if (m_congestionQueue && m_congestionQueue == mac->GetTxopQueue(AC_BE)) {
+                m_congestionQueue->TraceDisconnectWithoutContext("PacketsInQueue", MakeCallback(&RoutingProtocol::NotifyPacketsInQueue, this));
+                m_congestionQueue = nullptr;
+                m_congestionScore = 1.0;
+            }
             m_nb.DelArpCache(l3->GetInterface(i)->GetArpCache());
         }
     }
@@ -457,6 +566,7 @@ void RoutingProtocol::SendRequest(Ipv4Address dst)
 
     RreqHeader rreqHeader;
     rreqHeader.SetDst(dst);
+    rreqHeader.SetEocwEncoding(m_eocwMetricEncoding);
     RoutingTableEntry rt;
     uint16_t ttl = m_ttlStart;
     if (m_routingTable.LookupRoute(dst, rt)) {
@@ -482,6 +592,7 @@ void RoutingProtocol::SendRequest(Ipv4Address dst)
     if (m_destinationOnly) rreqHeader.SetDestinationOnly(true);
     m_seqNo++; rreqHeader.SetOriginSeqno(m_seqNo);
     m_requestId++; rreqHeader.SetId(m_requestId);
+    m_routeDiscoveryTrace(dst);
 
     // EOCW Init
     rreqHeader.m_pathMinEnergy = GetResidualEnergyScore();
@@ -503,6 +614,12 @@ void RoutingProtocol::SendRequest(Ipv4Address dst)
     ScheduleRreqRetry(dst);
 }
 
+void RoutingProtocol::SendRebroadcast(Ptr<Socket> socket, Ptr<Packet> packet, Ipv4Address destination, Ipv4Address origin, uint32_t id)
+{
+    m_rebroadcasts.NotifySent(origin, id);
+    SendTo(socket, packet, destination);
+}
+
 void RoutingProtocol::SendTo(Ptr<Socket> socket, Ptr<Packet> packet, Ipv4Address destination)
 {
     // Safety check: Don't send if interface is down
@@ -595,6 +712,8 @@ void RoutingProtocol::RecvRequest(Ptr<Packet> p, Ipv4Address receiver, Ipv4Addre
 {
     RreqHeader rreqHeader;
     p->RemoveHeader(rreqHeader);
+    m_counters.rreqReceived++;
+    m_rreqReceivedTrace(rreqHeader, src);
 
     RoutingTableEntry toPrev;
     if (m_routingTable.LookupRoute(src, toPrev) && toPrev.IsUnidirectional()) return;
@@ -605,6 +724,8 @@ void RoutingProtocol::RecvRequest(Ptr<Packet> p, Ipv4Address receiver, Ipv4Addre
         double myCurrentEnergy = GetResidualEnergyScore();
         if (!amIDestination && myCurrentEnergy < 0.20) {
             // EOCW Protection: Drop RREQ if energy < 20% and not destination
+            m_counters.rreqSuppressed++;
+            m_rreqSuppressedTrace(rreqHeader, myCurrentEnergy);
             return;
         }
     }
@@ -625,8 +746,18 @@ void RoutingProtocol::RecvRequest(Ptr<Packet> p, Ipv4Address receiver, Ipv4Addre
 
     bool amIDestination = IsMyOwnAddress(rreqHeader.GetDst());
 
-    if (m_rreqIdCache.IsDuplicate(origin, id)) {
-        if (!amIDestination) return; 
+    if (m_rreqIdCache.IsDuplicate(origin, id) && !amIDestination) {
+        // Duplicates are never forwarded: the flood keeps the single rebroadcast scheduled for
+        // its first copy, which the duplicates may make redundant
+        if (m_rebroadcasts.GetSuppression() != SUPPRESSION_NONE) {
+            double score = 0;
+            if (m_rebroadcasts.GetSuppression() == SUPPRESSION_SCORE) score = GetAdvertisedScore(old_pathMinEnergy, old_pathAvgCongestion, old_hop_count, GetFuzzyWeights(myEnergy, myCongestion));
+            if (m_rebroadcasts.HearDuplicate(origin, id, score)) {
+                m_counters.rreqCancelled++;
+                m_rreqCancelledTrace(origin, id);
+            }
+        }
+        return;
     }
 
     // Update Reverse Route to Origin
@@ -668,14 +799,20 @@ void RoutingProtocol::RecvRequest(Ptr<Packet> p, Ipv4Address receiver, Ipv4Addre
     m_nb.Update(src, Time(m_allowedHelloLoss * m_helloInterval));
 
     if (amIDestination) {
+        EocwPathCache::Discovery& discovery = m_eocwPathCache.Insert(origin, id, rreqHeader.GetDst());
+        if (discovery.m_committed) return;
+        if (!discovery.m_selectEvent.IsPending()) {
+            discovery.m_selectEvent = Simulator::Schedule(m_eocwCollectionTime, &RoutingProtocol::SelectBestEocwPath, this, origin, id);
+        }
+        // Rank on arrival with this node's fuzzy weights only; the entropy weights depend on
+        // the whole candidate set, so they are accumulated here and applied to the retained
+        // paths at selection time.
         EocwPath newPath(new_pathMinEnergy, new_pathAvgCongestion, (uint32_t)hop, toOrigin);
-        m_eocwPathCache[id].push_back(newPath);
-        if (m_eocwPathTimers.find(id) == m_eocwPathTimers.end()) {
-            m_eocwPathTimers[id] = Timer(Timer::CANCEL_ON_DESTROY);
-            m_eocwPathTimers[id].SetFunction(&RoutingProtocol::SelectBestEocwPath, this);
-            m_eocwPathTimers[id].SetArguments(id, origin, rreqHeader.GetDst());
-            m_eocwPathTimers[id].SetDelay(MilliSeconds(20));
-            m_eocwPathTimers[id].Schedule();
+        double score = CalculateEocwScore(newPath, GetFuzzyWeights(myEnergy, myCongestion), {1.0, 1.0, 1.0});
+        if (m_eocwPathCache.AddCandidate(discovery, newPath, score) && m_eocwEarlyCommitMargin > 0 && score >= 1.0 - m_eocwEarlyCommitMargin) {
+            SendEocwReply(newPath, origin, discovery.m_destination);
+            discovery.m_committed = true;
+            NotifyEocwSelection(origin, discovery, score);
         }
         return;
     }
@@ -702,6 +839,8 @@ void RoutingProtocol::RecvRequest(Ptr<Packet> p, Ipv4Address receiver, Ipv4Addre
     rreqHeader.SetHopCount(hop);
     rreqHeader.m_pathMinEnergy = new_pathMinEnergy;
     rreqHeader.m_pathAvgCongestion = new_pathAvgCongestion;
+    bool tracked = m_rebroadcasts.GetSuppression() != SUPPRESSION_NONE;
+    std::vector<EventId> rebroadcasts;
 
     for (auto j = m_socketAddresses.begin(); j != m_socketAddresses.end(); ++j) {
         Ptr<Socket> socket = j->first;
@@ -728,7 +867,15 @@ void RoutingProtocol::RecvRequest(Ptr<Packet> p, Ipv4Address receiver, Ipv4Addre
         }
         // ======================================
 
-        Simulator::Schedule(forwardDelay, &RoutingProtocol::SendTo, this, socket, packet, destination);
+        m_counters.rreqForwarded++;
+        m_rreqForwardedTrace(rreqHeader, forwardDelay);
+        if (tracked) rebroadcasts.push_back(Simulator::Schedule(forwardDelay, &RoutingProtocol::SendRebroadcast, this, socket, packet, destination, origin, id));
+        else Simulator::Schedule(forwardDelay, &RoutingProtocol::SendTo, this, socket, packet, destination);
+    }
+    if (tracked) {
+        double score = 0;
+        if (m_rebroadcasts.GetSuppression() == SUPPRESSION_SCORE) score = GetAdvertisedScore(new_pathMinEnergy, new_pathAvgCongestion, hop, GetFuzzyWeights(myEnergy, myCongestion));
+        m_rebroadcasts.Insert(origin, id, score, std::move(rebroadcasts));
     }
 }
 
@@ -736,17 +883,21 @@ void RoutingProtocol::SendReply(const RreqHeader& rreqHeader, const RoutingTable
 {
     if (!rreqHeader.GetUnknownSeqno() && (rreqHeader.GetDstSeqno() == m_seqNo + 1)) m_seqNo++;
     RrepHeader rrepHeader(0, 0, rreqHeader.GetDst(), m_seqNo, toOrigin.GetDestination(), m_myRouteTimeout);
+    rrepHeader.SetEocwEncoding(m_eocwMetricEncoding);
     Ptr<Packet> packet = Create<Packet>();
     SocketIpTtlTag tag; tag.SetTtl(toOrigin.GetHop()); packet->AddPacketTag(tag);
     packet->AddHeader(rrepHeader);
     packet->AddHeader(TypeHeader(AODVTYPE_RREP));
     Ptr<Socket> socket = FindSocketWithInterfaceAddress(toOrigin.GetInterface());
     socket->SendTo(packet, 0, InetSocketAddress(toOrigin.GetNextHop(), AODV_PORT));
+    m_counters.rrepSent++;
+    m_rrepSentTrace(rrepHeader, toOrigin.GetNextHop());
 }
 
 void RoutingProtocol::SendReplyByIntermediateNode(RoutingTableEntry& toDst, RoutingTableEntry& toOrigin, bool gratRep)
 {
     RrepHeader rrepHeader(0, toDst.GetHop(), toDst.GetDestination(), toDst.GetSeqNo(), toOrigin.GetDestination(), toDst.GetLifeTime());
+    rrepHeader.SetEocwEncoding(m_eocwMetricEncoding);
     if (toDst.GetHop() == 1) {
         rrepHeader.SetAckRequired(true);
         RoutingTableEntry toNextHop;
@@ -766,15 +917,20 @@ void RoutingProtocol::SendReplyByIntermediateNode(RoutingTableEntry& toDst, Rout
     packet->AddHeader(TypeHeader(AODVTYPE_RREP));
     Ptr<Socket> socket = FindSocketWithInterfaceAddress(toOrigin.GetInterface());
     socket->SendTo(packet, 0, InetSocketAddress(toOrigin.GetNextHop(), AODV_PORT));
+    m_counters.rrepSent++;
+    m_rrepSentTrace(rrepHeader, toOrigin.GetNextHop());
 
     if (gratRep) {
         RrepHeader gratRepHeader(0, toOrigin.GetHop(), toOrigin.GetDestination(), toOrigin.GetSeqNo(), toDst.GetDestination(), toOrigin.GetLifeTime());
+        gratRepHeader.SetEocwEncoding(m_eocwMetricEncoding);
         Ptr<Packet> packetToDst = Create<Packet>();
         SocketIpTtlTag gratTag; gratTag.SetTtl(toDst.GetHop()); packetToDst->AddPacketTag(gratTag);
         packetToDst->AddHeader(gratRepHeader);
         packetToDst->AddHeader(TypeHeader(AODVTYPE_RREP));
         socket = FindSocketWithInterfaceAddress(toDst.GetInterface());
         socket->SendTo(packetToDst, 0, InetSocketAddress(toDst.GetNextHop(), AODV_PORT));
+        m_counters.rrepSent++;
+        m_rrepSentTrace(gratRepHeader, toDst.GetNextHop());
     }
 }
 
@@ -804,9 +960,22 @@ void RoutingProtocol::RecvReply(Ptr<Packet> p, Ipv4Address receiver, Ipv4Address
     Ptr<NetDevice> dev = m_ipv4->GetNetDevice(m_ipv4->GetInterfaceForAddress(receiver));
     RoutingTableEntry newEntry(dev, dst, true, rrepHeader.GetDstSeqno(), m_ipv4->GetAddress(m_ipv4->GetInterfaceForAddress(receiver), 0), hop, sender, rrepHeader.GetLifeTime());
     
+    bool forMe = IsMyOwnAddress(rrepHeader.GetOrigin());
     RoutingTableEntry toDst;
+    RoutingTableEntry toOrigin;
     if (m_routingTable.LookupRoute(dst, toDst)) {
-        if ((!toDst.GetValidSeqNo()) || ((int32_t(rrepHeader.GetDstSeqno()) - int32_t(toDst.GetSeqNo())) > 0) || (rrepHeader.GetDstSeqno() == toDst.GetSeqNo() && toDst.GetFlag() != VALID) || (rrepHeader.GetDstSeqno() == toDst.GetSeqNo() && hop < toDst.GetHop())) {
+        if (m_eocwMaxPaths > 1 && toDst.GetFlag() == VALID && toDst.GetValidSeqNo() && rrepHeader.GetDstSeqno() == toDst.GetSeqNo()
+            && (forMe || m_routingTable.LookupValidRoute(rrepHeader.GetOrigin(), toOrigin))) {
+            // A further path of the same discovery: keep it as an alternate where it diverges from the route in use. The
+            // origin stops it there; a node on the reverse route forwards it unchanged, leaving the route in use as it is
+            if (sender != toDst.GetNextHop()) {
+                EocwPath path(rrepHeader.m_pathMinEnergy, rrepHeader.m_pathAvgCongestion, hop, newEntry);
+                double score = CalculateEocwScore(path, GetFuzzyWeights(GetResidualEnergyScore(), GetCongestionDegreeScore()), {1.0, 1.0, 1.0});
+                RouteAlternate alternate{dev, newEntry.GetInterface(), sender, hop, Simulator::Now() + rrepHeader.GetLifeTime(), rrepHeader.m_pathMinEnergy, rrepHeader.m_pathAvgCongestion, score};
+                if (toDst.InsertAlternate(alternate, m_eocwMaxPaths - 1)) m_routingTable.Update(toDst);
+            }
+            if (forMe) return;
+        } else if ((!toDst.GetValidSeqNo()) || ((int32_t(rrepHeader.GetDstSeqno()) - int32_t(toDst.GetSeqNo())) > 0) || (rrepHeader.GetDstSeqno() == toDst.GetSeqNo() && toDst.GetFlag() != VALID) || (rrepHeader.GetDstSeqno() == toDst.GetSeqNo() && hop < toDst.GetHop())) {
             newEntry.m_pathMinEnergy = rrepHeader.m_pathMinEnergy;
             newEntry.m_pathAvgCongestion = rrepHeader.m_pathAvgCongestion;
             m_routingTable.Update(newEntry);
@@ -818,7 +987,13 @@ void RoutingProtocol::RecvReply(Ptr<Packet> p, Ipv4Address receiver, Ipv4Address
     }
     if (rrepHeader.GetAckRequired()) { SendReplyAck(sender); rrepHeader.SetAckRequired(false); }
 
-    if (IsMyOwnAddress(rrepHeader.GetOrigin())) {
+    auto routeBreak = m_routeBreaks.find(dst);
+    if (routeBreak != m_routeBreaks.end()) {
+        if (forMe) m_routeRecoveryTrace(dst, Simulator::Now() - routeBreak->second, false);
+        m_routeBreaks.erase(routeBreak);
+    }
+
+    if (forMe) {
         if (toDst.GetFlag() == IN_SEARCH) {
             newEntry.m_pathMinEnergy = rrepHeader.m_pathMinEnergy;
             newEntry.m_pathAvgCongestion = rrepHeader.m_pathAvgCongestion;
@@ -830,7 +1005,6 @@ void RoutingProtocol::RecvReply(Ptr<Packet> p, Ipv4Address receiver, Ipv4Address
         return;
     }
 
-    RoutingTableEntry toOrigin;
     if (!m_routingTable.LookupRoute(rrepHeader.GetOrigin(), toOrigin) || toOrigin.GetFlag() == IN_SEARCH) return;
     toOrigin.SetLifeTime(std::max(m_activeRouteTimeout, toOrigin.GetLifeTime()));
     m_routingTable.Update(toOrigin);
@@ -863,20 +1037,22 @@ void RoutingProtocol::RecvReplyAck(Ipv4Address neighbor)
 
 void RoutingProtocol::ProcessHello(const RrepHeader& rrepHeader, Ipv4Address receiver)
 {
+    // A neighbor with an adaptive hello interval advertises a lifetime covering its next hello
+    Time lifeTime = std::max(Time(m_allowedHelloLoss * m_helloInterval), rrepHeader.GetLifeTime());
     RoutingTableEntry toNeighbor;
     if (!m_routingTable.LookupRoute(rrepHeader.GetDst(), toNeighbor)) {
         Ptr<NetDevice> dev = m_ipv4->GetNetDevice(m_ipv4->GetInterfaceForAddress(receiver));
         RoutingTableEntry newEntry(dev, rrepHeader.GetDst(), true, rrepHeader.GetDstSeqno(), m_ipv4->GetAddress(m_ipv4->GetInterfaceForAddress(receiver), 0), 1, rrepHeader.GetDst(), rrepHeader.GetLifeTime());
         m_routingTable.AddRoute(newEntry);
     } else {
-        toNeighbor.SetLifeTime(std::max(Time(m_allowedHelloLoss * m_helloInterval), toNeighbor.GetLifeTime()));
+        toNeighbor.SetLifeTime(std::max(lifeTime, toNeighbor.GetLifeTime()));
         toNeighbor.SetSeqNo(rrepHeader.GetDstSeqno()); toNeighbor.SetValidSeqNo(true); toNeighbor.SetFlag(VALID);
         toNeighbor.SetOutputDevice(m_ipv4->GetNetDevice(m_ipv4->GetInterfaceForAddress(receiver)));
         toNeighbor.SetInterface(m_ipv4->GetAddress(m_ipv4->GetInterfaceForAddress(receiver), 0));
         toNeighbor.SetHop(1); toNeighbor.SetNextHop(rrepHeader.GetDst());
         m_routingTable.Update(toNeighbor);
     }
-    if (m_enableHello) m_nb.Update(rrepHeader.GetDst(), Time(m_allowedHelloLoss * m_helloInterval));
+    if (m_enableHello) m_nb.Update(rrepHeader.GetDst(), lifeTime);
 }
 
 void RoutingProtocol::RecvError(Ptr<Packet> p, Ipv4Address src)
@@ -892,6 +1068,7 @@ void RoutingProtocol::RecvError(Ptr<Packet> p, Ipv4Address src)
             if (i->first == un.first) unreachable.insert(un);
         }
     }
+    SwitchToAlternates(src, unreachable);
     std::vector<Ipv4Address> precursors;
     for (auto i = unreachable.begin(); i != unreachable.end();) {
         if (!rerrHeader.AddUnDestination(i->first, i->second)) {
@@ -923,13 +1100,20 @@ void RoutingProtocol::RouteRequestTimerExpire(Ipv4Address dst)
 
 void RoutingProtocol::HelloTimerExpire()
 {
+    // The next interval is known before the hello, whose lifetime must cover it
+    m_currentHelloInterval = m_adaptiveHello ? m_helloScheduler.NextInterval(m_nb.GetChangeCount(), GetSpeed(), GetResidualEnergyScore()) : m_helloInterval;
     Time offset = Time(Seconds(0));
-    if (m_lastBcastTime > Time(Seconds(0))) offset = Simulator::Now() - m_lastBcastTime;
-    else SendHello();
+    if (m_lastBcastTime > Time(Seconds(0))) { offset = Simulator::Now() - m_lastBcastTime; m_helloSlots++; }
+    else if (m_helloTrafficSuppression && m_lastUnicastTime > Time(Seconds(0)) && Simulator::Now() - m_lastUnicastTime < m_currentHelloInterval) offset = Simulator::Now() - m_lastUnicastTime;
+    else { SendHello(); m_helloSlots++; }
     m_htimer.Cancel();
-    Time diff = m_helloInterval - offset;
+    Time diff = m_currentHelloInterval - offset;
     m_htimer.Schedule(std::max(Time(Seconds(0)), diff));
     m_lastBcastTime = Time(Seconds(0));
+    if (m_adaptiveHello || m_helloTrafficSuppression) {
+        double skipped = (Simulator::Now() - m_helloStartTime).GetSeconds() / m_helloInterval.GetSeconds() - m_helloSlots;
+        m_helloEnergySaved = std::max<double>(m_helloEnergySaved, skipped * m_helloTxEnergy);
+    }
 }
 
 void RoutingProtocol::RreqRateLimitTimerExpire() { m_rreqCount = 0; m_rreqRateLimitTimer.Schedule(Seconds(1)); }
@@ -940,22 +1124,25 @@ void RoutingProtocol::SendHello()
 {
     for (auto j = m_socketAddresses.begin(); j != m_socketAddresses.end(); ++j) {
         Ptr<Socket> socket = j->first; Ipv4InterfaceAddress iface = j->second;
-        RrepHeader helloHeader(0, 0, iface.GetLocal(), m_seqNo, iface.GetLocal(), Time(m_allowedHelloLoss * m_helloInterval));
+        RrepHeader helloHeader(0, 0, iface.GetLocal(), m_seqNo, iface.GetLocal(), Time(m_allowedHelloLoss * m_currentHelloInterval));
+        helloHeader.SetEocwEncoding(m_eocwMetricEncoding);
         Ptr<Packet> packet = Create<Packet>(); SocketIpTtlTag tag; tag.SetTtl(1); packet->AddPacketTag(tag);
         packet->AddHeader(helloHeader); packet->AddHeader(TypeHeader(AODVTYPE_RREP));
         Ipv4Address destination = (iface.GetMask() == Ipv4Mask::GetOnes()) ? Ipv4Address("255.255.255.255") : iface.GetBroadcast();
         Time jitter = Time(MilliSeconds(m_uniformRandomVariable->GetInteger(0, 10)));
         Simulator::Schedule(jitter, &RoutingProtocol::SendTo, this, socket, packet, destination);
     }
+    m_helloCount++;
 }
 
 void RoutingProtocol::SendPacketFromQueue(Ipv4Address dst, Ptr<Ipv4Route> route)
 {
-    QueueEntry queueEntry;
-    while (m_queue.Dequeue(dst, queueEntry)) {
+    std::vector<QueueEntry> queueEntries;
+    m_queue.DequeueAll(dst, queueEntries);
+    for (const auto& queueEntry : queueEntries) {
         DeferredRouteOutputTag tag;
         Ptr<Packet> p = ConstCast<Packet>(queueEntry.GetPacket());
-        if (p->RemovePacketTag(tag) && tag.GetInterface() != -1 && tag.GetInterface() != m_ipv4->GetInterfaceForDevice(route->GetOutputDevice())) return;
+        if (p->RemovePacketTag(tag) && tag.GetInterface() != -1 && tag.GetInterface() != m_ipv4->GetInterfaceForDevice(route->GetOutputDevice())) continue;
         UnicastForwardCallback ucb = queueEntry.GetUnicastForwardCallback();
         Ipv4Header header = queueEntry.GetIpv4Header();
         header.SetSource(route->GetSource());
@@ -972,8 +1159,10 @@ void RoutingProtocol::SendRerrWhenBreaksLinkToNextHop(Ipv4Address nextHop)
     RoutingTableEntry toNextHop;
     if (!m_routingTable.LookupRoute(nextHop, toNextHop)) return;
     toNextHop.GetPrecursors(precursors);
-    rerrHeader.AddUnDestination(nextHop, toNextHop.GetSeqNo());
     m_routingTable.GetListOfDestinationWithNextHop(nextHop, unreachable);
+    SwitchToAlternates(nextHop, unreachable);
+    bool nextHopSwitched = (unreachable.find(nextHop) == unreachable.end() && toNextHop.GetNextHop() == nextHop && toNextHop.GetFlag() == VALID);
+    if (!nextHopSwitched) rerrHeader.AddUnDestination(nextHop, toNextHop.GetSeqNo());
     for (auto i = unreachable.begin(); i != unreachable.end();) {
         if (!rerrHeader.AddUnDestination(i->first, i->second)) {
             TypeHeader typeHeader(AODVTYPE_RERR); Ptr<Packet> packet = Create<Packet>(); SocketIpTtlTag tag; tag.SetTtl(1);
@@ -988,10 +1177,23 @@ void RoutingProtocol::SendRerrWhenBreaksLinkToNextHop(Ipv4Address nextHop)
         packet->AddPacketTag(tag); packet->AddHeader(rerrHeader); packet->AddHeader(typeHeader);
         SendRerrMessage(packet, precursors);
     }
-    unreachable.insert(std::make_pair(nextHop, toNextHop.GetSeqNo()));
+    if (!nextHopSwitched) unreachable.insert(std::make_pair(nextHop, toNextHop.GetSeqNo()));
     m_routingTable.InvalidateRoutesWithDst(unreachable);
 }
 
+void RoutingProtocol::SwitchToAlternates(Ipv4Address nextHop, std::map<Ipv4Address, uint32_t>& unreachable)
+{
+    std::vector<Ipv4Address> switched;
+    if (m_eocwMaxPaths > 1) m_routingTable.SwitchToAlternates(nextHop, unreachable, switched);
+    for (const auto& dst : switched) {
+        NS_LOG_DEBUG("Route to " << dst << " switched to an alternate path, next hop " << nextHop << " unreachable");
+        m_routeBreaks.erase(dst);
+        m_routeRecoveryTrace(dst, Time(0), true);
+    }
+    Time now = Simulator::Now();
+    for (const auto& [dst, seqNo] : unreachable) m_routeBreaks.emplace(dst, now);
+}
+
 void RoutingProtocol::SendRerrWhenNoRouteToForward(Ipv4Address dst, uint32_t dstSeqNo, Ipv4Address origin)
 {
     if (m_rerrCount == m_rerrRateLimit) return;
@@ -1048,7 +1250,14 @@ Ptr<Socket> RoutingProtocol::FindSubnetBroadcastSocketWithInterfaceAddress(Ipv4I
 
 void RoutingProtocol::DoInitialize()
 {
+    if (m_fuzzyEvaluation == FUZZY_TABULATED) m_fuzzyTable = EocwFuzzyTable::Get(m_fuzzyTableResolution);
     if (m_enableHello) {
+        m_currentHelloInterval = m_helloInterval;
+        if (m_adaptiveHello) {
+            m_helloScheduler.SetIntervals(m_helloInterval, std::max(m_helloInterval, m_maxHelloInterval));
+            m_helloScheduler.SetThresholds(m_helloChurnThreshold, m_helloSpeedThreshold);
+        }
+        m_helloStartTime = Simulator::Now();
         m_htimer.SetFunction(&RoutingProtocol::HelloTimerExpire, this);
         m_htimer.Schedule(MilliSeconds(m_uniformRandomVariable->GetInteger(0, 100)));
     }
@@ -1059,94 +1268,59 @@ void RoutingProtocol::DoInitialize()
 // EOCW / FUZZY IMPLEMENTATION FUNCTIONS
 // ============================================================================
 
-double RoutingProtocol::FuzzyTriangle(double value, double a, double b, double c)
+double RoutingProtocol::GetResidualEnergyScore()
 {
-    if (value <= a || value >= c) return 0.0;
-    if (value == b) return 1.0;
-    if (value < b) return (value - a) / (b - a);
-    return (c - value) / (c - b);
+    if (!m_energySource || m_initialEnergy == 0) return 1.0;
+    // Querying the source forces an energy update, so only do it when the traced score is too old
+    if (!m_energyScoreTraced || Simulator::Now() - m_energyScoreTime > m_energyScoreMaxAge) {
+        m_energyScore = m_energySource->GetRemainingEnergy() / m_initialEnergy;
+        m_energyScoreTime = Simulator::Now();
+    }
+    return m_energyScore;
 }
 
-double RoutingProtocol::GetResidualEnergyScore()
+double RoutingProtocol::GetSpeed() const
 {
-    if (!m_energySource || m_initialEnergy == 0) return 1.0;
-    return m_energySource->GetRemainingEnergy() / m_initialEnergy;
+    Ptr<MobilityModel> mobility = m_ipv4 ? m_ipv4->GetObject<MobilityModel>() : nullptr;
+    return mobility ? mobility->GetVelocity().GetLength() : 0;
+}
+
+void RoutingProtocol::NotifyLinkBreak(Ipv4Address neighbor, Time latency) { m_linkBreakTrace(neighbor, latency); }
+
+void RoutingProtocol::NotifyRemainingEnergy(double oldValue, double newValue)
+{
+    if (m_initialEnergy == 0) return;
+    m_energyScore = newValue / m_initialEnergy;
+    m_energyScoreTime = Simulator::Now();
 }
 
 double RoutingProtocol::GetCongestionDegreeScore()
 {
     if (m_socketAddresses.empty()) return 1.0;
-    for (auto const& [socket, iface] : m_socketAddresses) {
-        if (!m_ipv4) continue;
-        int32_t i = m_ipv4->GetInterfaceForAddress(iface.GetLocal());
-        if (i < 0) continue;
-        Ptr<NetDevice> dev = m_ipv4->GetNetDevice(static_cast<uint32_t>(i));
-        if (!dev) continue;
-        Ptr<WifiNetDevice> wifiDev = dev->GetObject<WifiNetDevice>();
-        if (wifiDev) {
-            Ptr<WifiMac> mac = wifiDev->GetMac();
-            if (!mac) continue;
-            Ptr<AdhocWifiMac> adhocMac = mac->GetObject<AdhocWifiMac>();
-            if (adhocMac) {
-                Ptr<WifiMacQueue> queue = adhocMac->GetTxopQueue(ns3::AC_BE);
-                if (queue) {
-                    double l_all = (double)queue->GetMaxSize().GetValue();
-                    if (l_all == 0) return 1.0;
-                    double l_current = (double)queue->GetCurrentSize().GetValue();
-                    return std::max(0.0, (l_all - l_current) / l_all);
-                }
-            }
-        }
-    }
-    return 1.0;
+    if (m_congestionEstimator) return m_congestionEstimator->GetCongestionScore();
+    return m_congestionScore;
 }
 
-double RoutingProtocol::GetHopCountScore(uint32_t hopCount)
+void RoutingProtocol::NotifyPacketsInQueue(uint32_t oldValue, uint32_t newValue)
 {
-    if (hopCount <= 2) return 1.0;
-    if (hopCount <= 4) return 0.6;
-    if (hopCount <= 6) return 0.4;
-    return 0.1;
+    double l_all = (double)m_congestionQueue->GetMaxSize().GetValue();
+    if (l_all == 0) { m_congestionScore = 1.0; return; }
+    m_congestionScore = std::max(0.0, (l_all - newValue) / l_all);
 }
 
-std::vector<double> RoutingProtocol::GetEwmWeights(const std::vector<EocwPath>& paths)
+double RoutingProtocol::GetHopCountScore(uint32_t hopCount) { return EocwHopCountScore(hopCount); }
+
+double RoutingProtocol::CalculateEocwScore(const EocwPath& path, const EocwWeights& ahp_w, const EocwWeights& ewm_mu)
 {
-    int m = paths.size(); int n = 3;
-    if (m <= 1) return {0.333, 0.333, 0.333};
-    std::vector<std::vector<double>> X(m, std::vector<double>(n));
-    for (int i = 0; i < m; ++i) {
-        X[i][0] = paths[i].pathAvgCongestion; X[i][1] = paths[i].pathMinEnergy; X[i][2] = GetHopCountScore(paths[i].hopCount);
-    }
-    std::vector<double> H(n, 0.0);
-    double k = 1.0 / std::log(m);
-    for (int j = 0; j < n; ++j) {
-        double sumYij = 0.0; for (int i = 0; i < m; ++i) sumYij += X[i][j];
-        if (sumYij == 0) continue;
-        double sumPijLnPij = 0.0;
-        for (int i = 0; i < m; ++i) {
-            double pij = X[i][j] / sumYij;
-            if (pij > 0) sumPijLnPij += pij * std::log(pij);
-        }
-        H[j] = -k * sumPijLnPij;
-    }
-    std::vector<double> d(n); double sumD = 0.0;
-    for (int j = 0; j < n; ++j) { d[j] = 1.0 - H[j]; sumD += d[j]; }
-    std::vector<double> mu(n);
-    if (sumD == 0) { std::fill(mu.begin(), mu.end(), 1.0/n); return mu; }
-    for (int j = 0; j < n; ++j) mu[j] = d[j] / sumD;
-    return mu;
+    return EocwScore(ahp_w, ewm_mu, path.pathAvgCongestion, path.pathMinEnergy, EocwHopCountScore(path.hopCount));
 }
 
-double RoutingProtocol::CalculateEocwScore(const EocwPath& path, const std::vector<double>& ahp_w, const std::vector<double>& ewm_mu)
+double RoutingProtocol::GetAdvertisedScore(double minEnergy, double avgCongestion, uint32_t hops, const EocwWeights& weights) const
 {
-    double s_cd = path.pathAvgCongestion; double s_re = path.pathMinEnergy; double s_rh = GetHopCountScore(path.hopCount);
-    double w_cd = ahp_w[0] * ewm_mu[0]; double w_re = ahp_w[1] * ewm_mu[1]; double w_rh = ahp_w[2] * ewm_mu[2];
-    double sumW = w_cd + w_re + w_rh;
-    if (sumW == 0) return 0;
-    return ((w_cd/sumW) * s_cd) + ((w_re/sumW) * s_re) + ((w_rh/sumW) * s_rh);
+    return EocwScore(weights, {1.0, 1.0, 1.0}, avgCongestion, minEnergy, EocwHopCountScore(hops));
 }
 
-std::vector<double> RoutingProtocol::GetFuzzyWeights(double re, double cd_score)
+EocwWeights RoutingProtocol::GetFuzzyWeights(double re, double cd_score)
 {
     if (!m_enableFuzzy) {
         // === ORIGINAL PAPER / STATIC AHP LOGIC ===
@@ -1159,67 +1333,74 @@ std::vector<double> RoutingProtocol::GetFuzzyWeights(double re, double cd_score)
     }
 
     // === MODIFIED FUZZY LOGIC (9 RULES) ===
-    double re_low = FuzzyTriangle(re, -0.1, 0.0, 0.4);
-    double re_med = FuzzyTriangle(re, 0.2, 0.5, 0.8);
-    double re_high = FuzzyTriangle(re, 0.6, 1.0, 1.1);
-    
-    double cd_busy = FuzzyTriangle(cd_score, -0.1, 0.0, 0.4); 
-    double cd_normal = FuzzyTriangle(cd_score, 0.2, 0.5, 0.8);
-    double cd_free = FuzzyTriangle(cd_score, 0.6, 1.0, 1.1);
-
-    double w_cd_num = 0.0, w_re_num = 0.0, w_hc_num = 0.0, total_fire = 0.0;
-    auto AddRule = [&](double fireStrength, double out_cd, double out_re, double out_hc) {
-        w_cd_num += fireStrength * out_cd; w_re_num += fireStrength * out_re; w_hc_num 
-        += fireStrength * out_hc; total_fire += fireStrength;
-    };
-
-    AddRule(std::min(re_low, cd_busy), 0.45, 0.50, 0.05);
-    AddRule(std::min(re_low, cd_normal), 0.20, 0.70, 0.10);
-    AddRule(std::min(re_low, cd_free), 0.10, 0.80, 0.10);
-    AddRule(std::min(re_med, cd_busy), 0.70, 0.20, 0.10);
-    AddRule(std::min(re_med, cd_normal), 0.33, 0.34, 0.33);
-    AddRule(std::min(re_med, cd_free), 0.20, 0.20, 0.60);
-    AddRule(std::min(re_high, cd_busy), 0.80, 0.10, 0.10);
-    AddRule(std::min(re_high, cd_normal), 0.20, 0.10, 0.70);
-    AddRule(std::min(re_high, cd_free), 0.10, 0.05, 0.85);
-
-    if (total_fire == 0) return {0.333, 0.333, 0.333};
-    return {w_cd_num / total_fire, w_re_num / total_fire, w_hc_num / total_fire};
+    if (m_fuzzyTable) return m_fuzzyTable->Lookup(re, cd_score);
+    return EocwFuzzyRuleBase::Evaluate(re, cd_score);
 }
 
-void RoutingProtocol::SelectBestEocwPath(uint32_t rreqId, Ipv4Address origin, Ipv4Address destination)
+void RoutingProtocol::SelectBestEocwPath(Ipv4Address origin, uint32_t rreqId)
 {
-    auto it = m_eocwPathCache.find(rreqId);
-    if (it == m_eocwPathCache.end() || it->second.empty()) { m_eocwPathTimers.erase(rreqId); return; }
+    EocwPathCache::Discovery* discovery = m_eocwPathCache.Find(origin, rreqId);
+    if (!discovery) return;
+    if (discovery->m_committed || discovery->m_candidates.empty()) { m_eocwPathCache.Erase(origin, rreqId); return; }
 
-    std::vector<EocwPath> paths = it->second;
     double currentEnergy = GetResidualEnergyScore();
     double currentCongestion = GetCongestionDegreeScore();
 
-    std::vector<double> ahp_w = GetFuzzyWeights(currentEnergy, currentCongestion);
-    std::vector<double> ewm_mu = GetEwmWeights(paths);
+    EocwWeights ahp_w = GetFuzzyWeights(currentEnergy, currentCongestion);
+    EocwWeights ewm_mu = discovery->m_ewm.GetWeights();
 
-    double bestScore = -1.0;
-    EocwPath* bestPath = nullptr;
-
-    for (EocwPath& path : paths) {
-        double score = CalculateEocwScore(path, ahp_w, ewm_mu);
-        path.reverseRoute.m_pathScore = score;
-        if (score > bestScore) { bestScore = score; bestPath = &path; }
+    EocwCandidateBatch batch;
+    batch.Reserve(discovery->m_candidates.size());
+    for (const auto& candidate : discovery->m_candidates) {
+        batch.Add(candidate.path.pathAvgCongestion, candidate.path.pathMinEnergy, EocwHopCountScore(candidate.path.hopCount));
     }
-
-    if (bestPath) {
-        m_seqNo++;
-        RrepHeader rrepHeader(0, 0, destination, m_seqNo, origin, m_myRouteTimeout);
-        rrepHeader.m_pathMinEnergy = bestPath->pathMinEnergy;
-        rrepHeader.m_pathAvgCongestion = bestPath->pathAvgCongestion;
-        Ptr<Packet> packet = Create<Packet>();
-        SocketIpTtlTag tag; tag.SetTtl(bestPath->reverseRoute.GetHop()); packet->AddPacketTag(tag);
-        packet->AddHeader(rrepHeader); packet->AddHeader(TypeHeader(AODVTYPE_RREP));
-        Ptr<Socket> socket = FindSocketWithInterfaceAddress(bestPath->reverseRoute.GetInterface());
-        if (socket) socket->SendTo(packet, 0, InetSocketAddress(bestPath->reverseRoute.GetNextHop(), AODV_PORT));
+    std::vector<double> scores;
+    batch.Score(ahp_w, ewm_mu, scores);
+    std::vector<std::pair<double, const EocwPath*>> ranked;
+    for (std::size_t i = 0; i < scores.size(); ++i) {
+        ranked.emplace_back(scores[i], &discovery->m_candidates[i].path);
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    // Reply along the best path, then along the next best ones through other last hops. Only
+    // that last hop is known to differ: the reverse routes may join anywhere further on
+    NotifyEocwSelection(origin, *discovery, ranked.front().first);
+    std::vector<Ipv4Address> lastHops;
+    for (const auto& [score, path] : ranked) {
+        Ipv4Address lastHop = path->reverseRoute.GetNextHop();
+        if (std::find(lastHops.begin(), lastHops.end(), lastHop) != lastHops.end()) continue;
+        SendEocwReply(*path, origin, discovery->m_destination, !lastHops.empty());
+        lastHops.push_back(lastHop);
+        if (lastHops.size() == m_eocwMaxPaths) break;
     }
-    m_eocwPathCache.erase(rreqId); m_eocwPathTimers.erase(rreqId);
+    m_eocwPathCache.Erase(origin, rreqId);
+}
+
+void RoutingProtocol::SendEocwReply(const EocwPath& path, Ipv4Address origin, Ipv4Address destination, bool alternate)
+{
+    if (!alternate) m_seqNo++;
+    RrepHeader rrepHeader(0, 0, destination, m_seqNo, origin, m_myRouteTimeout);
+    rrepHeader.SetEocwEncoding(m_eocwMetricEncoding);
+    rrepHeader.m_pathMinEnergy = path.pathMinEnergy;
+    rrepHeader.m_pathAvgCongestion = path.pathAvgCongestion;
+    Ptr<Packet> packet = Create<Packet>();
+    SocketIpTtlTag tag; tag.SetTtl(path.reverseRoute.GetHop()); packet->AddPacketTag(tag);
+    packet->AddHeader(rrepHeader); packet->AddHeader(TypeHeader(AODVTYPE_RREP));
+    Ptr<Socket> socket = FindSocketWithInterfaceAddress(path.reverseRoute.GetInterface());
+    if (!socket) return;
+    socket->SendTo(packet, 0, InetSocketAddress(path.reverseRoute.GetNextHop(), AODV_PORT));
+    m_counters.rrepSent++;
+    m_rrepSentTrace(rrepHeader, path.reverseRoute.GetNextHop());
+}
+
+void RoutingProtocol::NotifyEocwSelection(Ipv4Address origin, const EocwPathCache::Discovery& discovery, double score)
+{
+    Time latency = Simulator::Now() - discovery.m_start;
+    m_counters.eocwSelections++;
+    m_counters.eocwCandidates += discovery.m_arrivals;
+    m_counters.eocwLatency += latency;
+    m_counters.eocwScore += score;
+    m_eocwSelectionTrace(origin, discovery.m_arrivals, latency, score);
 }
 
 } // namespace aodv
@@ -16,9 +16,14 @@
 #ifndef AODVROUTINGPROTOCOL_H
 #define AODVROUTINGPROTOCOL_H
 
+#include "aodv-congestion-estimator.h"
 #include "aodv-dpd.h"
+#include "aodv-eocw-fuzzy.h"
+#include "aodv-eocw-path-cache.h"
+#include "aodv-hello-scheduler.h"
 #include "aodv-neighbor.h"
 #include "aodv-packet.h"
+#include "aodv-rebroadcast-table.h"
 #include "aodv-rqueue.h"
 #include "aodv-rtable.h"
 
@@ -28,6 +33,8 @@
 #include "ns3/node.h"
 #include "ns3/output-stream-wrapper.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/traced-callback.h"
+#include "ns3/traced-value.h"
 #include "ns3/energy-source.h"      // <-- PERUBAHAN 1
 #include "ns3/wifi-net-device.h"
 #include "ns3/wifi-mac-queue.h"   // <-- PERUBAHAN 2
@@ -42,24 +49,6 @@ namespace ns3
 
     namespace aodv
     {
-        // --- EOCW ---
-        struct EocwPath
-        {
-            double pathMinEnergy;       // Energi minimum sepanjang rute
-            double pathAvgCongestion;   // Rata-rata tingkat kemacetan sepanjang rute
-            uint32_t hopCount;          // Jumlah hop sepanjang rute
-            ns3::aodv::RoutingTableEntry reverseRoute; // Rute balik untuk mengirim RREP
-
-            // Constructor untuk inisialisasi
-            EocwPath(double energy, double congestion, uint32_t hops, ns3::aodv::RoutingTableEntry route)
-                : pathMinEnergy(energy),
-                pathAvgCongestion(congestion),
-                hopCount(hops),
-                reverseRoute(route)
-            {
-            }
-        };
-        // --- AKHIR EOCW ---
     /**
      * \ingroup aodv
      *
@@ -75,6 +64,106 @@ namespace ns3
             static TypeId GetTypeId();
             static const uint32_t AODV_PORT;
 
+            /// How the fuzzy weights are evaluated
+            enum FuzzyEvaluation
+            {
+                FUZZY_EXACT,     ///< Evaluate the rule base on every call
+                FUZZY_TABULATED, ///< Interpolate in a table sampled from the rule base
+            };
+
+            /**
+             * TracedCallback signature for the route discoveries originated by this node.
+             *
+             * \param [in] dst the destination of the RREQ flood
+             */
+            typedef void (*RouteDiscoveryTracedCallback)(Ipv4Address dst);
+
+            /**
+             * TracedCallback signature for the recovery of a route broken by a link failure.
+             *
+             * \param [in] dst the destination of the route
+             * \param [in] latency the time from the link failure to the recovery
+             * \param [in] local true if the route switched to an alternate path, false if it
+             *             was discovered again
+             */
+            typedef void (*RouteRecoveryTracedCallback)(Ipv4Address dst, Time latency, bool local);
+
+            /**
+             * TracedCallback signature for the RREQs received by this node, before any check.
+             *
+             * \param [in] header the RREQ header
+             * \param [in] sender the neighbor the RREQ was received from
+             */
+            typedef void (*RreqReceivedTracedCallback)(const RreqHeader& header, Ipv4Address sender);
+
+            /**
+             * TracedCallback signature for the RREQs dropped by the EOCW energy cut-off.
+             *
+             * \param [in] header the RREQ header
+             * \param [in] energyScore the residual energy score of this node
+             */
+            typedef void (*RreqSuppressedTracedCallback)(const RreqHeader& header, double energyScore);
+
+            /**
+             * TracedCallback signature for the RREQs rebroadcast by this node.
+             *
+             * \param [in] header the RREQ header as rebroadcast
+             * \param [in] delay the forward delay the rebroadcast is scheduled after
+             */
+            typedef void (*RreqForwardedTracedCallback)(const RreqHeader& header, Time delay);
+
+            /**
+             * TracedCallback signature for the pending RREQ rebroadcasts cancelled by the
+             * duplicates of their flood.
+             *
+             * \param [in] origin the RREQ originator
+             * \param [in] id the RREQ ID
+             */
+            typedef void (*RreqCancelledTracedCallback)(Ipv4Address origin, uint32_t id);
+
+            /**
+             * TracedCallback signature for the RREPs originated by this node, as destination or
+             * as intermediate node.
+             *
+             * \param [in] header the RREP header
+             * \param [in] nextHop the neighbor the RREP is sent to
+             */
+            typedef void (*RrepSentTracedCallback)(const RrepHeader& header, Ipv4Address nextHop);
+
+            /**
+             * TracedCallback signature for the path selections of the EOCW route discoveries
+             * this node is the destination of.
+             *
+             * \param [in] origin the RREQ originator
+             * \param [in] candidates the number of paths offered for the discovery
+             * \param [in] latency the time from the first path offered to the selection
+             * \param [in] score the EOCW score of the chosen path
+             */
+            typedef void (*EocwSelectionTracedCallback)(Ipv4Address origin, uint32_t candidates, Time latency, double score);
+
+            /**
+             * TracedCallback signature for the breaks of the links to the neighbors.
+             *
+             * \param [in] neighbor the address of the neighbor
+             * \param [in] latency the time elapsed since the neighbor was last heard from, an
+             * upper bound of the time the break took to be detected
+             */
+            typedef void (*LinkBreakDetectedTracedCallback)(Ipv4Address neighbor, Time latency);
+
+            /// Control plane counters of a node, kept whether the traces are connected or not
+            struct ControlCounters
+            {
+                uint64_t rreqReceived{0};   ///< RREQs received
+                uint64_t rreqSuppressed{0}; ///< RREQs dropped by the energy cut-off
+                uint64_t rreqForwarded{0};  ///< RREQ rebroadcasts scheduled, one per interface
+                uint64_t rreqCancelled{0};  ///< Floods whose pending rebroadcasts were cancelled
+                uint64_t rrepSent{0};       ///< RREPs originated
+                uint64_t eocwSelections{0}; ///< EOCW path selections
+                uint64_t eocwCandidates{0}; ///< Paths offered, summed over the selections
+                Time eocwLatency;           ///< Selection latency, summed over the selections
+                double eocwScore{0};        ///< Chosen path score, summed over the selections
+            };
+
             /// constructor
             RoutingProtocol();
             ~RoutingProtocol() override;
@@ -210,6 +299,66 @@ namespace ns3
                 return m_enableBroadcast;
             }
 
+            /**
+             * Set the maximum number of EOCW candidate paths kept per route discovery
+             * \param n the maximum number of candidates
+             */
+            void SetEocwMaxCandidates(uint32_t n);
+
+            /**
+             * Get the maximum number of EOCW candidate paths kept per route discovery
+             * \returns the maximum number of candidates
+             */
+            uint32_t GetEocwMaxCandidates() const
+            {
+                return m_eocwPathCache.GetMaxCandidates();
+            }
+
+            /**
+             * Set how the duplicates of a RREQ flood suppress the pending rebroadcast
+             * \param mode the suppression mode
+             */
+            void SetRreqSuppression(RebroadcastSuppression mode)
+            {
+                m_rebroadcasts.SetSuppression(mode);
+            }
+
+            /**
+             * Get how the duplicates of a RREQ flood suppress the pending rebroadcast
+             * \returns the suppression mode
+             */
+            RebroadcastSuppression GetRreqSuppression() const
+            {
+                return m_rebroadcasts.GetSuppression();
+            }
+
+            /**
+             * Set the number of copies of a flood that cancels its pending rebroadcast
+             * \param copies the number of copies, the first one included
+             */
+            void SetRreqSuppressionThreshold(uint32_t copies)
+            {
+                m_rebroadcasts.SetCounterThreshold(copies);
+            }
+
+            /**
+             * Get the number of copies of a flood that cancels its pending rebroadcast
+             * \returns the number of copies
+             */
+            uint32_t GetRreqSuppressionThreshold() const
+            {
+                return m_rebroadcasts.GetCounterThreshold();
+            }
+
+            /**
+             * Get the control plane counters of this node
+             * \returns the counters
+             */
+            const ControlCounters& GetControlCounters() const
+            {
+                return m_counters;
+            }
+
             /**
              * Assign a fixed random variable stream number to the random variables
              * used by this model.  Return the number of streams (possibly zero) that
@@ -220,6 +369,27 @@ namespace ns3
              */
             int64_t AssignStreams(int64_t stream);
 
+            /// \name Snapshot of the protocol state
+            //\{
+            /**
+             * \returns the number of bytes written by SerializeState()
+             */
+            uint32_t GetSerializedStateSize() const;
+            /**
+             * Write the routing table, the neighbors and the RREQ ID cache of this node, and
+             * its sequence number and RREQ ID. The times are written relative to now.
+             * \param i the buffer iterator, moved past the state
+             */
+            void SerializeState(Buffer::Iterator& i) const;
+            /**
+             * Restore the state written by SerializeState(), as it was the same time ago.
+             * The sequence number and the RREQ ID only move forward, so that the floods of
+             * this node are not taken for the restored ones. The ARP caches are not restored.
+             * \param i the buffer iterator, moved past the state
+             */
+            void DeserializeState(Buffer::Iterator& i);
+            //\}
+
         protected:
             void DoInitialize() override;
 
@@ -233,10 +403,8 @@ namespace ns3
             void NotifyTxError(WifiMacDropReason reason, Ptr<const WifiMpdu> mpdu);
 
 
-            // Fungsi keanggotaan segitiga (Triangular Membership Function)
-            double FuzzyTriangle(double value, double a, double b, double c);
             // Fungsi utama untuk mendapatkan bobot dinamis
-            std::vector<double> GetFuzzyWeights(double energyScore, double congestionScore);
+            EocwWeights GetFuzzyWeights(double energyScore, double congestionScore);
             // Protocol parameters.
             uint32_t m_rreqRetries; ///< Maximum number of retransmissions of RREQ with TTL = NetDiameter to
             ///< discover a route
@@ -283,6 +451,10 @@ namespace ns3
             bool m_enableHello;      ///< Indicates whether a hello messages enable
             bool m_enableBroadcast;  ///< Indicates whether a a broadcast data packets forwarding 
             bool m_enableFuzzy;
+            FuzzyEvaluation m_fuzzyEvaluation; ///< How the fuzzy weights are evaluated
+            uint32_t m_fuzzyTableResolution;   ///< Grid cells per axis of the fuzzy weight table
+            Ptr<const EocwFuzzyTable> m_fuzzyTable; ///< Fuzzy weight table, if tabulated
+            EocwMetricEncoding m_eocwMetricEncoding; ///< Encoding of the EOCW metrics in originated messages
 
             /// IP protocol
             Ptr<Ipv4> m_ipv4;
@@ -494,6 +666,15 @@ namespace ns3
              * \param destination destination node IP address
              */
             void SendTo(Ptr<Socket> socket, Ptr<Packet> packet, Ipv4Address destination);
+            /**
+             * Send a RREQ rebroadcast tracked by the rebroadcast table
+             * \param socket destination node socket
+             * \param packet packet to send
+             * \param destination destination node IP address
+             * \param origin the RREQ originator
+             * \param id the RREQ ID
+             */
+            void SendRebroadcast(Ptr<Socket> socket, Ptr<Packet> packet, Ipv4Address destination, Ipv4Address origin, uint32_t id);
 
             /// Hello timer
             Timer m_htimer;
@@ -526,6 +707,44 @@ namespace ns3
             Ptr<UniformRandomVariable> m_uniformRandomVariable;
             /// Keep track of the last bcast time
             Time m_lastBcastTime;
+            /// Adapt the hello interval to the churn, speed and energy of the node
+            bool m_adaptiveHello;
+            /// Longest interval between hellos with AdaptiveHello, HelloInterval being the shortest
+            Time m_maxHelloInterval;
+            /// Neighbor churn rate, in changes per second, for the shortest hello interval
+            double m_helloChurnThreshold;
+            /// Speed, in m/s, for the shortest hello interval
+            double m_helloSpeedThreshold;
+            /// Energy spent sending one hello, in J
+            double m_helloTxEnergy;
+            /// Skip the hellos while unicast traffic from the neighbors proves the links alive
+            bool m_helloTrafficSuppression;
+            /// Adaptive hello interval
+            HelloScheduler m_helloScheduler;
+            /// Interval until the next hello
+            Time m_currentHelloInterval;
+            /// Time a unicast packet was last received from a neighbor
+            Time m_lastUnicastTime;
+            /// Time the hello timer was started
+            Time m_helloStartTime;
+            /// Hello intervals covered by a hello or by another broadcast
+            uint32_t m_helloSlots;
+            /// Number of hellos sent
+            TracedValue<uint32_t> m_helloCount;
+            /// Energy saved by the hellos not sent, relative to one every HelloInterval, in J
+            TracedValue<double> m_helloEnergySaved;
+            /// Trace of the link breaks detected
+            TracedCallback<Ipv4Address, Time> m_linkBreakTrace;
+            /**
+             * \returns the speed of the node, 0 without a mobility model
+             */
+            double GetSpeed() const;
+            /**
+             * Fire the LinkBreakDetected trace
+             * \param neighbor the address of the neighbor
+             * \param latency the time elapsed since the neighbor was last heard from
+             */
+            void NotifyLinkBreak(Ipv4Address neighbor, Time latency);
 
             // --- Variabel EOCW ---
             /**
@@ -537,13 +756,89 @@ namespace ns3
              * \brief Menyimpan energi awal node untuk perhitungan skor.
              */
             double m_initialEnergy;
+
+            /// Cached residual energy score, refreshed from the RemainingEnergy trace
+            double m_energyScore;
+            /// Time m_energyScore was last refreshed
+            Time m_energyScoreTime;
+            /// Whether m_energyScore is refreshed by the RemainingEnergy trace of the source
+            bool m_energyScoreTraced;
+            /// Maximum age of the cached residual energy score before it is queried again
+            Time m_energyScoreMaxAge;
+            /// Congestion estimator aggregated to the node, if any
+            Ptr<CongestionEstimator> m_congestionEstimator;
+            /// Queue whose occupancy gives the congestion degree score without an estimator
+            Ptr<WifiMacQueue> m_congestionQueue;
+            /// Cached congestion degree score, refreshed from the PacketsInQueue trace
+            double m_congestionScore;
+
+            /**
+             * Refresh the cached residual energy score
+             * \param oldValue the previous remaining energy, in J
+             * \param newValue the current remaining energy, in J
+             */
+            void NotifyRemainingEnergy(double oldValue, double newValue);
+            /**
+             * Refresh the cached congestion degree score
+             * \param oldValue the previous number of packets in the queue
+             * \param newValue the current number of packets in the queue
+             */
+            void NotifyPacketsInQueue(uint32_t oldValue, uint32_t newValue);
             // --- End of Variabel EOCW ---
             // --- TAMBAHAN EOCW ---
-            /// Peta untuk menyimpan RREQ yang masuk: <RREQ ID, Daftar Path>
-            std::map<uint32_t, std::vector<EocwPath>> m_eocwPathCache;
-
-            /// Timer untuk RREQ: <RREQ ID, Timer>
-            std::map<uint32_t, ns3::Timer> m_eocwPathTimers;
+            /// Candidate paths of the route discoveries this node is the destination of
+            EocwPathCache m_eocwPathCache;
+            /// Pending RREQ rebroadcasts, cancelled by the duplicates of their flood
+            RebroadcastTable m_rebroadcasts;
+            /// Time the destination collects candidate paths before answering a RREQ
+            Time m_eocwCollectionTime;
+            /// Answer a RREQ as soon as a candidate scores at least 1 - margin (0 disables)
+            double m_eocwEarlyCommitMargin;
+            /// Number of paths through distinct last hops the destination replies along (1 keeps no alternates)
+            uint32_t m_eocwMaxPaths;
+            /// Time of the link failure of the broken routes not recovered yet, per destination
+            std::map<Ipv4Address, Time> m_routeBreaks;
+            /// Trace of the route discoveries originated by this node
+            TracedCallback<Ipv4Address> m_routeDiscoveryTrace;
+            /// Trace of the recovery of the routes broken by a link failure
+            TracedCallback<Ipv4Address, Time, bool> m_routeRecoveryTrace;
+            /// Trace of the RREQs received
+            TracedCallback<const RreqHeader&, Ipv4Address> m_rreqReceivedTrace;
+            /// Trace of the RREQs dropped by the energy cut-off
+            TracedCallback<const RreqHeader&, double> m_rreqSuppressedTrace;
+            /// Trace of the RREQ rebroadcasts
+            TracedCallback<const RreqHeader&, Time> m_rreqForwardedTrace;
+            /// Trace of the pending RREQ rebroadcasts cancelled
+            TracedCallback<Ipv4Address, uint32_t> m_rreqCancelledTrace;
+            /// Trace of the RREPs originated
+            TracedCallback<const RrepHeader&, Ipv4Address> m_rrepSentTrace;
+            /// Trace of the EOCW path selections
+            TracedCallback<Ipv4Address, uint32_t, Time, double> m_eocwSelectionTrace;
+            /// Control plane counters
+            ControlCounters m_counters;
+            /**
+             * \param minEnergy the minimum residual energy score along a path
+             * \param avgCongestion the average congestion degree score along the path
+             * \param hops the number of hops along the path
+             * \param weights the fuzzy weights of this node
+             * \returns the EOCW score of the path, as a RREQ advertises it
+             */
+            double GetAdvertisedScore(double minEnergy, double avgCongestion, uint32_t hops, const EocwWeights& weights) const;
+            /**
+             * Account the path selection of an EOCW route discovery
+             * \param origin the RREQ originator
+             * \param discovery the discovery
+             * \param score the score of the chosen path
+             */
+            void NotifyEocwSelection(Ipv4Address origin, const EocwPathCache::Discovery& discovery, double score);
+            /**
+             * Switch the routes through a next hop found unreachable to their alternate paths,
+             * and record the link failure for the ones left without route.
+             * \param nextHop the unreachable next hop
+             * \param unreachable the destinations reached through nextHop; on return, the ones
+             *        whose route did not switch to an alternate
+             */
+            void SwitchToAlternates(Ipv4Address nextHop, std::map<Ipv4Address, uint32_t>& unreachable);
             // --- AKHIR EOCW ---
             // --- TAMBAHAN EOCW: Deklarasi fungsi helper ---
             // /**
@@ -551,22 +846,29 @@ namespace ns3
             // */
             // std::vector<double> GetAhpWeights();
 
-            /**
-            * \brief Menghitung bobot EWM (Entropy Weight Method)
-            */
-            std::vector<double> GetEwmWeights(const std::vector<EocwPath>& paths);
-
             /**
             * \brief Menghitung skor akhir EOCW untuk satu path.
             */
             double CalculateEocwScore(const EocwPath& path,
-                const std::vector<double>& ahp_w,
-                const std::vector<double>& ewm_mu);
+                const EocwWeights& ahp_w,
+                const EocwWeights& ewm_mu);
 
             /**
             * \brief Fungsi timer EOCW. Memilih rute terbaik dari cache.
+            * \param origin the RREQ originator
+            * \param rreqId the RREQ ID
+            */
+            void SelectBestEocwPath(Ipv4Address origin, uint32_t rreqId);
+
+            /**
+            * \brief Send the RREP of an EOCW route discovery along the given path.
+            * \param path the chosen path
+            * \param origin the RREQ originator
+            * \param destination the RREQ destination
+            * \param alternate true for the RREP of an alternate path, which reuses the sequence
+            *        number of the RREP of the best path
             */
-            void SelectBestEocwPath(uint32_t rreqId, Ipv4Address origin, Ipv4Address destination);
+            void SendEocwReply(const EocwPath& path, Ipv4Address origin, Ipv4Address destination, bool alternate = false);
             // --- AKHIR EOCW ---
         };
 
@@ -19,9 +19,6 @@
 #include "ns3/log.h"
 #include "ns3/socket.h"
 
-#include <algorithm>
-#include <functional>
-
 namespace ns3
 {
 
@@ -33,107 +30,165 @@ uint32_t
 RequestQueue::GetSize()
 {
     Purge();
-    return m_queue.size();
+    return m_size;
 }
 
 bool
 RequestQueue::Enqueue(QueueEntry& entry)
 {
     Purge();
-    for (auto i = m_queue.begin(); i != m_queue.end(); ++i)
+    Ipv4Address dst = entry.GetIpv4Header().GetDestination();
+    uint64_t uid = entry.GetPacket()->GetUid();
+    auto range = m_uids.equal_range(uid);
+    for (auto i = range.first; i != range.second; ++i)
     {
-        if ((i->GetPacket()->GetUid() == entry.GetPacket()->GetUid()) &&
-            (i->GetIpv4Header().GetDestination() == entry.GetIpv4Header().GetDestination()))
+        if (m_slots[i->second].m_entry.GetIpv4Header().GetDestination() == dst)
         {
             return false;
         }
     }
     entry.SetExpireTime(m_queueTimeout);
-    if (m_queue.size() == m_maxLen)
+    while (m_size >= m_maxLen && m_oldest != NONE)
+    {
+        // Drop the most aged packet
+        auto bucket = m_buckets.find(m_slots[m_oldest].m_entry.GetIpv4Header().GetDestination());
+        Drop(RemoveHead(bucket), "Drop the most aged packet");
+    }
+
+    uint32_t slot = m_free;
+    if (slot == NONE)
+    {
+        slot = m_slots.size();
+        m_slots.emplace_back();
+    }
+    else
+    {
+        m_free = m_slots[slot].m_next;
+    }
+    m_slots[slot] = {entry, NONE, m_newest, NONE};
+    if (m_newest != NONE)
+    {
+        m_slots[m_newest].m_newer = slot;
+    }
+    else
+    {
+        m_oldest = slot;
+    }
+    m_newest = slot;
+
+    auto [bucket, inserted] = m_buckets.try_emplace(dst, Bucket{slot, slot});
+    if (!inserted)
     {
-        Drop(m_queue.front(), "Drop the most aged packet"); // Drop the most aged packet
-        m_queue.erase(m_queue.begin());
+        m_slots[bucket->second.m_tail].m_next = slot;
+        bucket->second.m_tail = slot;
     }
-    m_queue.push_back(entry);
+    m_uids.emplace(uid, slot);
+    m_size++;
     return true;
 }
 
+QueueEntry
+RequestQueue::RemoveHead(BucketMap::iterator bucket)
+{
+    uint32_t slot = bucket->second.m_head;
+    Slot& s = m_slots[slot];
+    QueueEntry entry = s.m_entry;
+
+    if (s.m_next == NONE)
+    {
+        m_buckets.erase(bucket);
+    }
+    else
+    {
+        bucket->second.m_head = s.m_next;
+    }
+    (s.m_older != NONE ? m_slots[s.m_older].m_newer : m_oldest) = s.m_newer;
+    (s.m_newer != NONE ? m_slots[s.m_newer].m_older : m_newest) = s.m_older;
+    auto range = m_uids.equal_range(entry.GetPacket()->GetUid());
+    for (auto i = range.first; i != range.second; ++i)
+    {
+        if (i->second == slot)
+        {
+            m_uids.erase(i);
+            break;
+        }
+    }
+
+    // Release the packet and callbacks held by the slot
+    s.m_entry = QueueEntry();
+    s.m_next = m_free;
+    m_free = slot;
+    m_size--;
+    return entry;
+}
+
 void
 RequestQueue::DropPacketWithDst(Ipv4Address dst)
 {
     NS_LOG_FUNCTION(this << dst);
     Purge();
-    for (auto i = m_queue.begin(); i != m_queue.end(); ++i)
+    auto bucket = m_buckets.find(dst);
+    if (bucket == m_buckets.end())
     {
-        if (i->GetIpv4Header().GetDestination() == dst)
-        {
-            Drop(*i, "DropPacketWithDst ");
-        }
+        return;
+    }
+    bool last = false;
+    while (!last)
+    {
+        last = (bucket->second.m_head == bucket->second.m_tail);
+        Drop(RemoveHead(bucket), "DropPacketWithDst ");
     }
-    auto new_end = std::remove_if(m_queue.begin(), m_queue.end(), [&](const QueueEntry& en) {
-        return en.GetIpv4Header().GetDestination() == dst;
-    });
-    m_queue.erase(new_end, m_queue.end());
 }
 
 bool
 RequestQueue::Dequeue(Ipv4Address dst, QueueEntry& entry)
 {
     Purge();
-    for (auto i = m_queue.begin(); i != m_queue.end(); ++i)
+    auto bucket = m_buckets.find(dst);
+    if (bucket == m_buckets.end())
     {
-        if (i->GetIpv4Header().GetDestination() == dst)
-        {
-            entry = *i;
-            m_queue.erase(i);
-            return true;
-        }
+        return false;
     }
-    return false;
+    entry = RemoveHead(bucket);
+    return true;
 }
 
-bool
-RequestQueue::Find(Ipv4Address dst)
+uint32_t
+RequestQueue::DequeueAll(Ipv4Address dst, std::vector<QueueEntry>& entries)
 {
-    for (auto i = m_queue.begin(); i != m_queue.end(); ++i)
+    Purge();
+    auto bucket = m_buckets.find(dst);
+    if (bucket == m_buckets.end())
     {
-        if (i->GetIpv4Header().GetDestination() == dst)
-        {
-            return true;
-        }
+        return 0;
+    }
+    uint32_t n = 0;
+    bool last = false;
+    while (!last)
+    {
+        last = (bucket->second.m_head == bucket->second.m_tail);
+        entries.push_back(RemoveHead(bucket));
+        n++;
     }
-    return false;
+    return n;
 }
 
-/**
- * \brief IsExpired structure
- */
-struct IsExpired
+bool
+RequestQueue::Find(Ipv4Address dst)
 {
-    /**
-     * Check if the entry is expired
-     *
-     * \param e QueueEntry entry
-     * \return true if expired, false otherwise
-     */
-    bool operator()(const QueueEntry& e) const
-    {
-        return (e.GetExpireTime() < Seconds(0));
-    }
-};
+    return m_buckets.find(dst) != m_buckets.end();
+}
 
 void
 RequestQueue::Purge()
 {
-    IsExpired pred;
-    for (auto i = m_queue.begin(); i != m_queue.end(); ++i)
+    while (m_oldest != NONE && m_slots[m_oldest].m_entry.GetExpireTime() < Seconds(0))
     {
-        if (pred(*i))
-        {
-            Drop(*i, "Drop outdated packet ");
-        }
+        // The oldest entry is the earliest one of its destination
+        auto bucket = m_buckets.find(m_slots[m_oldest].m_entry.GetIpv4Header().GetDestination());
+        NS_ASSERT(bucket != m_buckets.end() && bucket->second.m_head == m_oldest);
+        Drop(RemoveHead(bucket), "Drop outdated packet ");
     }
-    m_queue.erase(std::remove_if(m_queue.begin(), m_queue.end(), pred), m_queue.end());
 }
 
 void
@@ -19,6 +19,8 @@
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/simulator.h"
 
+#include <limits>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -181,6 +183,13 @@ class QueueEntry
  * \brief AODV route request queue
  *
  * Since AODV is an on demand routing we queue requests while looking for route.
+ *
+ * Entries are kept in a slab of slots linked in two intrusive lists: a FIFO per destination,
+ * found through a hash map, and the queue order across all destinations, from which aged
+ * and expired entries are dropped. The entries of a destination are dequeued, flushed or
+ * dropped without visiting the entries for other destinations, and the duplicate check is a
+ * lookup by packet UID. Entries expire in the order they were queued: after QueueTimeout is
+ * reduced, an entry is dropped once it is the oldest entry and has expired.
  */
 class RequestQueue
 {
@@ -192,7 +201,11 @@ class RequestQueue
      * \param routeToQueueTimeout the route to queue timeout
      */
     RequestQueue(uint32_t maxLen, Time routeToQueueTimeout)
-        : m_maxLen(maxLen),
+        : m_free(NONE),
+          m_oldest(NONE),
+          m_newest(NONE),
+          m_size(0),
+          m_maxLen(maxLen),
           m_queueTimeout(routeToQueueTimeout)
     {
     }
@@ -212,6 +225,14 @@ class RequestQueue
      * \returns true if the entry is dequeued
      */
     bool Dequeue(Ipv4Address dst, QueueEntry& entry);
+    /**
+     * Remove all entries for given destination, the earliest first
+     *
+     * \param dst the destination IP address
+     * \param entries the vector the entries are appended to
+     * \returns the number of entries dequeued
+     */
+    uint32_t DequeueAll(Ipv4Address dst, std::vector<QueueEntry>& entries);
     /**
      * Remove all packets with destination IP address dst
      * \param dst the destination IP address
@@ -267,8 +288,49 @@ class RequestQueue
     }
 
   private:
-    /// The queue
-    std::vector<QueueEntry> m_queue;
+    /// Index of no slot
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    /// Queued entry, linked in the FIFO of its destination and in the queue order
+    struct Slot
+    {
+        QueueEntry m_entry; ///< The entry
+        uint32_t m_next;    ///< Next entry for the same destination, or next free slot
+        uint32_t m_older;   ///< Previous entry in queue order
+        uint32_t m_newer;   ///< Next entry in queue order
+    };
+
+    /// FIFO of the entries for one destination
+    struct Bucket
+    {
+        uint32_t m_head; ///< Earliest entry
+        uint32_t m_tail; ///< Latest entry
+    };
+
+    /// Buckets by destination
+    typedef std::unordered_map<Ipv4Address, Bucket, Ipv4AddressHash> BucketMap;
+
+    /**
+     * Remove the earliest entry of a destination
+     * \param bucket the bucket of the destination, erased when it becomes empty
+     * \returns the entry
+     */
+    QueueEntry RemoveHead(BucketMap::iterator bucket);
+
+    /// Entries and free slots
+    std::vector<Slot> m_slots;
+    /// First free slot
+    uint32_t m_free;
+    /// Entries per destination
+    BucketMap m_buckets;
+    /// Slots of the entries by packet UID, for the duplicate check
+    std::unordered_multimap<uint64_t, uint32_t> m_uids;
+    /// Oldest entry
+    uint32_t m_oldest;
+    /// Newest entry
+    uint32_t m_newest;
+    /// Number of entries
+    uint32_t m_size;
     /// Remove all expired entries
     void Purge();
     /**
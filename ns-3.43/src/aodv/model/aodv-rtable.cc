@@ -16,10 +16,12 @@
 
 #include "aodv-rtable.h"
 
+#include "ns3/address-utils.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 
 #include <algorithm>
+#include <bit>
 #include <iomanip>
 
 namespace ns3
@@ -30,6 +32,77 @@ NS_LOG_COMPONENT_DEFINE("AodvRoutingTable");
 namespace aodv
 {
 
+namespace
+{
+
+/// Serialized size of an entry without its precursors and alternates
+constexpr uint32_t ENTRY_SIZE = 64;
+/// Serialized size of an alternate path
+constexpr uint32_t ALTERNATE_SIZE = 42;
+
+/**
+ * \param entry a routing table entry
+ * \returns whether the entry is saved in a snapshot of the table
+ */
+bool
+IsSerialized(const RoutingTableEntry& entry)
+{
+    // The loopback and broadcast routes are added with the maximum lifetime by the
+    // protocol itself
+    return entry.GetFlag() != IN_SEARCH &&
+           entry.GetLifeTime() < Simulator::GetMaximumSimulationTime() - Simulator::Now();
+}
+
+/**
+ * Look up an interface of a node by its local address
+ * \param ipv4 the IPv4 stack of the node
+ * \param local the local address
+ * \param dev the device of the interface
+ * \param iface the interface address
+ * \returns whether the node has the address
+ */
+bool
+LookupInterface(Ptr<Ipv4> ipv4, Ipv4Address local, Ptr<NetDevice>& dev, Ipv4InterfaceAddress& iface)
+{
+    int32_t interface = ipv4->GetInterfaceForAddress(local);
+    if (interface < 0)
+    {
+        return false;
+    }
+    for (uint32_t j = 0; j < ipv4->GetNAddresses(interface); ++j)
+    {
+        if (ipv4->GetAddress(interface, j).GetLocal() == local)
+        {
+            iface = ipv4->GetAddress(interface, j);
+            break;
+        }
+    }
+    dev = ipv4->GetNetDevice(interface);
+    return true;
+}
+
+/**
+ * \param i the buffer iterator
+ * \param x the value to write, bit for bit
+ */
+void
+WriteDouble(Buffer::Iterator& i, double x)
+{
+    i.WriteHtonU64(std::bit_cast<uint64_t>(x));
+}
+
+/**
+ * \param i the buffer iterator
+ * \returns the value read
+ */
+double
+ReadDouble(Buffer::Iterator& i)
+{
+    return std::bit_cast<double>(i.ReadNtohU64());
+}
+
+} // namespace
+
 /*
  The Routing Table
  */
@@ -155,6 +228,77 @@ RoutingTableEntry::GetPrecursors(std::vector<Ipv4Address>& prec) const
     }
 }
 
+bool
+RoutingTableEntry::InsertAlternate(const RouteAlternate& alternate, uint32_t maxAlternates)
+{
+    NS_LOG_FUNCTION(this << alternate.m_nextHop << alternate.m_pathScore);
+    if (maxAlternates == 0 || alternate.m_nextHop == GetNextHop())
+    {
+        return false;
+    }
+    for (const auto& a : m_alternates)
+    {
+        if (a.m_nextHop == alternate.m_nextHop)
+        {
+            return false;
+        }
+    }
+    auto pos = std::find_if(m_alternates.begin(),
+                            m_alternates.end(),
+                            [&alternate](const RouteAlternate& a) {
+                                return a.m_pathScore < alternate.m_pathScore;
+                            });
+    if (pos == m_alternates.end() && m_alternates.size() >= maxAlternates)
+    {
+        return false;
+    }
+    m_alternates.insert(pos, alternate);
+    if (m_alternates.size() > maxAlternates)
+    {
+        m_alternates.pop_back();
+    }
+    return true;
+}
+
+void
+RoutingTableEntry::DeleteAlternates(Ipv4Address nextHop)
+{
+    NS_LOG_FUNCTION(this << nextHop);
+    m_alternates.erase(std::remove_if(m_alternates.begin(),
+                                      m_alternates.end(),
+                                      [nextHop](const RouteAlternate& a) {
+                                          return a.m_nextHop == nextHop;
+                                      }),
+                       m_alternates.end());
+}
+
+bool
+RoutingTableEntry::SwitchToAlternate()
+{
+    NS_LOG_FUNCTION(this);
+    Time now = Simulator::Now();
+    while (!m_alternates.empty())
+    {
+        RouteAlternate alternate = m_alternates.front();
+        m_alternates.erase(m_alternates.begin());
+        if (alternate.m_expire < now)
+        {
+            continue;
+        }
+        m_ipv4Route->SetGateway(alternate.m_nextHop);
+        m_ipv4Route->SetOutputDevice(alternate.m_dev);
+        m_ipv4Route->SetSource(alternate.m_iface.GetLocal());
+        m_iface = alternate.m_iface;
+        m_hops = alternate.m_hops;
+        m_lifeTime = alternate.m_expire;
+        m_pathMinEnergy = alternate.m_pathMinEnergy;
+        m_pathAvgCongestion = alternate.m_pathAvgCongestion;
+        m_pathScore = alternate.m_pathScore;
+        return true;
+    }
+    return false;
+}
+
 void
 RoutingTableEntry::Invalidate(Time badLinkLifetime)
 {
@@ -166,6 +310,7 @@ RoutingTableEntry::Invalidate(Time badLinkLifetime)
     m_flag = INVALID;
     m_reqCount = 0;
     m_lifeTime = badLinkLifetime + Simulator::Now();
+    m_alternates.clear();
 }
 
 void
@@ -237,7 +382,7 @@ RoutingTable::LookupRoute(Ipv4Address id, RoutingTableEntry& rt)
         NS_LOG_LOGIC("Route to " << id << " not found");
         return false;
     }
-    rt = i->second;
+    rt = i->second.m_entry;
     NS_LOG_LOGIC("Route to " << id << " found");
     return true;
 }
@@ -279,7 +424,11 @@ RoutingTable::AddRoute(RoutingTableEntry& rt)
     {
         rt.SetRreqCnt(0);
     }
-    auto result = m_ipv4AddressEntry.insert(std::make_pair(rt.GetDestination(), rt));
+    auto result = m_ipv4AddressEntry.insert({rt.GetDestination(), {rt, Time::Max()}});
+    if (result.second)
+    {
+        Schedule(result.first->first, result.first->second);
+    }
     return result.second;
 }
 
@@ -293,12 +442,13 @@ RoutingTable::Update(RoutingTableEntry& rt)
         NS_LOG_LOGIC("Route update to " << rt.GetDestination() << " fails; not found");
         return false;
     }
-    i->second = rt;
-    if (i->second.GetFlag() != IN_SEARCH)
+    i->second.m_entry = rt;
+    if (i->second.m_entry.GetFlag() != IN_SEARCH)
     {
         NS_LOG_LOGIC("Route update to " << rt.GetDestination() << " set RreqCnt to 0");
-        i->second.SetRreqCnt(0);
+        i->second.m_entry.SetRreqCnt(0);
     }
+    Schedule(i->first, i->second);
     return true;
 }
 
@@ -312,8 +462,9 @@ RoutingTable::SetEntryState(Ipv4Address id, RouteFlags state)
         NS_LOG_LOGIC("Route set entry state to " << id << " fails; not found");
         return false;
     }
-    i->second.SetFlag(state);
-    i->second.SetRreqCnt(0);
+    i->second.m_entry.SetFlag(state);
+    i->second.m_entry.SetRreqCnt(0);
+    Schedule(i->first, i->second);
     NS_LOG_LOGIC("Route set entry state to " << id << ": new state is " << state);
     return true;
 }
@@ -327,10 +478,11 @@ RoutingTable::GetListOfDestinationWithNextHop(Ipv4Address nextHop,
     unreachable.clear();
     for (auto i = m_ipv4AddressEntry.begin(); i != m_ipv4AddressEntry.end(); ++i)
     {
-        if (i->second.GetNextHop() == nextHop)
+        if (i->second.m_entry.GetNextHop() == nextHop)
         {
-            NS_LOG_LOGIC("Unreachable insert " << i->first << " " << i->second.GetSeqNo());
-            unreachable.insert(std::make_pair(i->first, i->second.GetSeqNo()));
+            NS_LOG_LOGIC("Unreachable insert " << i->first << " "
+                                               << i->second.m_entry.GetSeqNo());
+            unreachable.insert(std::make_pair(i->first, i->second.m_entry.GetSeqNo()));
         }
     }
 }
@@ -340,19 +492,47 @@ RoutingTable::InvalidateRoutesWithDst(const std::map<Ipv4Address, uint32_t>& unr
 {
     NS_LOG_FUNCTION(this);
     Purge();
-    for (auto i = m_ipv4AddressEntry.begin(); i != m_ipv4AddressEntry.end(); ++i)
+    for (auto j = unreachable.begin(); j != unreachable.end(); ++j)
     {
-        for (auto j = unreachable.begin(); j != unreachable.end(); ++j)
+        auto i = m_ipv4AddressEntry.find(j->first);
+        if (i != m_ipv4AddressEntry.end() && i->second.m_entry.GetFlag() == VALID)
         {
-            if ((i->first == j->first) && (i->second.GetFlag() == VALID))
-            {
-                NS_LOG_LOGIC("Invalidate route with destination address " << i->first);
-                i->second.Invalidate(m_badLinkLifetime);
-            }
+            NS_LOG_LOGIC("Invalidate route with destination address " << i->first);
+            i->second.m_entry.Invalidate(m_badLinkLifetime);
+            Schedule(i->first, i->second);
         }
     }
 }
 
+void
+RoutingTable::SwitchToAlternates(Ipv4Address nextHop,
+                                 std::map<Ipv4Address, uint32_t>& unreachable,
+                                 std::vector<Ipv4Address>& switched)
+{
+    NS_LOG_FUNCTION(this << nextHop);
+    Purge();
+    for (auto j = unreachable.begin(); j != unreachable.end();)
+    {
+        auto i = m_ipv4AddressEntry.find(j->first);
+        if (i == m_ipv4AddressEntry.end() || i->second.m_entry.GetFlag() != VALID ||
+            i->second.m_entry.GetNextHop() != nextHop)
+        {
+            ++j;
+            continue;
+        }
+        i->second.m_entry.DeleteAlternates(nextHop);
+        if (!i->second.m_entry.SwitchToAlternate())
+        {
+            ++j;
+            continue;
+        }
+        NS_LOG_LOGIC("Route to " << i->first << " switched to next hop "
+                                 << i->second.m_entry.GetNextHop());
+        switched.push_back(i->first);
+        j = unreachable.erase(j);
+    }
+}
+
 void
 RoutingTable::DeleteAllRoutesFromInterface(Ipv4InterfaceAddress iface)
 {
@@ -363,11 +543,9 @@ RoutingTable::DeleteAllRoutesFromInterface(Ipv4InterfaceAddress iface)
     }
     for (auto i = m_ipv4AddressEntry.begin(); i != m_ipv4AddressEntry.end();)
     {
-        if (i->second.GetInterface() == iface)
+        if (i->second.m_entry.GetInterface() == iface)
         {
-            auto tmp = i;
-            ++i;
-            m_ipv4AddressEntry.erase(tmp);
+            i = m_ipv4AddressEntry.erase(i);
         }
         else
         {
@@ -377,38 +555,49 @@ RoutingTable::DeleteAllRoutesFromInterface(Ipv4InterfaceAddress iface)
 }
 
 void
-RoutingTable::Purge()
+RoutingTable::Schedule(Ipv4Address dst, Record& record)
 {
-    NS_LOG_FUNCTION(this);
-    if (m_ipv4AddressEntry.empty())
+    Time expire = Simulator::Now() + record.m_entry.GetLifeTime();
+    if (expire < record.m_scheduled)
     {
-        return;
+        // The previous heap record, if any, is now stale and is dropped when it fires
+        record.m_scheduled = expire;
+        m_expiry.push({expire, dst});
     }
-    for (auto i = m_ipv4AddressEntry.begin(); i != m_ipv4AddressEntry.end();)
+}
+
+void
+RoutingTable::Purge()
+{
+    NS_LOG_FUNCTION(this);
+    Time now = Simulator::Now();
+    while (!m_expiry.empty() && m_expiry.top().m_time < now)
     {
-        if (i->second.GetLifeTime() < Seconds(0))
+        Expiry expiry = m_expiry.top();
+        m_expiry.pop();
+        auto i = m_ipv4AddressEntry.find(expiry.m_dst);
+        if (i == m_ipv4AddressEntry.end() || i->second.m_scheduled != expiry.m_time)
         {
-            if (i->second.GetFlag() == INVALID)
-            {
-                auto tmp = i;
-                ++i;
-                m_ipv4AddressEntry.erase(tmp);
-            }
-            else if (i->second.GetFlag() == VALID)
-            {
-                NS_LOG_LOGIC("Invalidate route with destination address " << i->first);
-                i->second.Invalidate(m_badLinkLifetime);
-                ++i;
-            }
-            else
-            {
-                ++i;
-            }
+            continue;
         }
-        else
+        RoutingTableEntry& entry = i->second.m_entry;
+        i->second.m_scheduled = Time::Max();
+        if (entry.GetLifeTime() >= Seconds(0))
         {
-            ++i;
+            // The lifetime has been extended since this record was added
+            Schedule(i->first, i->second);
+        }
+        else if (entry.GetFlag() == INVALID)
+        {
+            m_ipv4AddressEntry.erase(i);
+        }
+        else if (entry.GetFlag() == VALID)
+        {
+            NS_LOG_LOGIC("Invalidate route with destination address " << i->first);
+            entry.Invalidate(m_badLinkLifetime);
+            Schedule(i->first, i->second);
         }
+        // An expired IN_SEARCH entry stays until it is updated
     }
 }
 
@@ -458,17 +647,148 @@ RoutingTable::MarkLinkAsUnidirectional(Ipv4Address neighbor, Time blacklistTimeo
         NS_LOG_LOGIC("Mark link unidirectional to  " << neighbor << " fails; not found");
         return false;
     }
-    i->second.SetUnidirectional(true);
-    i->second.SetBlacklistTimeout(blacklistTimeout);
-    i->second.SetRreqCnt(0);
+    i->second.m_entry.SetUnidirectional(true);
+    i->second.m_entry.SetBlacklistTimeout(blacklistTimeout);
+    i->second.m_entry.SetRreqCnt(0);
     NS_LOG_LOGIC("Set link to " << neighbor << " to unidirectional");
     return true;
 }
 
+uint32_t
+RoutingTable::GetSerializedSize() const
+{
+    uint32_t size = 4;
+    for (const auto& [dst, record] : m_ipv4AddressEntry)
+    {
+        if (IsSerialized(record.m_entry))
+        {
+            std::vector<Ipv4Address> precursors;
+            record.m_entry.GetPrecursors(precursors);
+            size += ENTRY_SIZE + 4 * precursors.size() +
+                    ALTERNATE_SIZE * record.m_entry.GetAlternates().size();
+        }
+    }
+    return size;
+}
+
+void
+RoutingTable::Serialize(Buffer::Iterator& i) const
+{
+    Time now = Simulator::Now();
+    i.WriteHtonU32(std::count_if(m_ipv4AddressEntry.begin(),
+                                 m_ipv4AddressEntry.end(),
+                                 [](const auto& e) { return IsSerialized(e.second.m_entry); }));
+    for (const auto& [dst, record] : m_ipv4AddressEntry)
+    {
+        const RoutingTableEntry& rt = record.m_entry;
+        if (!IsSerialized(rt))
+        {
+            continue;
+        }
+        WriteTo(i, dst);
+        WriteTo(i, rt.GetNextHop());
+        WriteTo(i, rt.GetInterface().GetLocal());
+        i.WriteU8(rt.GetFlag());
+        i.WriteU8(rt.GetValidSeqNo());
+        i.WriteHtonU32(rt.GetSeqNo());
+        i.WriteHtonU16(rt.GetHop());
+        i.WriteHtonU64(rt.GetLifeTime().GetTimeStep());
+        i.WriteU8(rt.IsUnidirectional());
+        i.WriteHtonU64(rt.GetBlacklistTimeout().GetTimeStep());
+        WriteDouble(i, rt.m_pathMinEnergy);
+        WriteDouble(i, rt.m_pathAvgCongestion);
+        WriteDouble(i, rt.m_pathScore);
+        std::vector<Ipv4Address> precursors;
+        rt.GetPrecursors(precursors);
+        i.WriteHtonU16(precursors.size());
+        for (const auto& precursor : precursors)
+        {
+            WriteTo(i, precursor);
+        }
+        i.WriteU8(rt.GetAlternates().size());
+        for (const auto& alternate : rt.GetAlternates())
+        {
+            WriteTo(i, alternate.m_iface.GetLocal());
+            WriteTo(i, alternate.m_nextHop);
+            i.WriteHtonU16(alternate.m_hops);
+            i.WriteHtonU64((alternate.m_expire - now).GetTimeStep());
+            WriteDouble(i, alternate.m_pathMinEnergy);
+            WriteDouble(i, alternate.m_pathAvgCongestion);
+            WriteDouble(i, alternate.m_pathScore);
+        }
+    }
+}
+
+void
+RoutingTable::Deserialize(Buffer::Iterator& i, Ptr<Ipv4> ipv4)
+{
+    NS_LOG_FUNCTION(this);
+    Time now = Simulator::Now();
+    for (uint32_t n = i.ReadNtohU32(); n > 0; --n)
+    {
+        Ipv4Address dst;
+        Ipv4Address nextHop;
+        Ipv4Address local;
+        ReadFrom(i, dst);
+        ReadFrom(i, nextHop);
+        ReadFrom(i, local);
+        auto flag = static_cast<RouteFlags>(i.ReadU8());
+        bool validSeqNo = i.ReadU8();
+        uint32_t seqNo = i.ReadNtohU32();
+        uint16_t hops = i.ReadNtohU16();
+        Time lifetime = TimeStep(i.ReadNtohU64());
+        Ptr<NetDevice> dev;
+        Ipv4InterfaceAddress iface;
+        bool found = LookupInterface(ipv4, local, dev, iface);
+        RoutingTableEntry rt(dev, dst, validSeqNo, seqNo, iface, hops, nextHop, lifetime);
+        rt.SetFlag(flag);
+        rt.SetUnidirectional(i.ReadU8());
+        rt.SetBlacklistTimeout(TimeStep(i.ReadNtohU64()));
+        rt.m_pathMinEnergy = ReadDouble(i);
+        rt.m_pathAvgCongestion = ReadDouble(i);
+        rt.m_pathScore = ReadDouble(i);
+        for (uint16_t p = i.ReadNtohU16(); p > 0; --p)
+        {
+            Ipv4Address precursor;
+            ReadFrom(i, precursor);
+            rt.InsertPrecursor(precursor);
+        }
+        uint8_t alternates = i.ReadU8();
+        for (uint8_t a = 0; a < alternates; ++a)
+        {
+            RouteAlternate alternate;
+            ReadFrom(i, local);
+            ReadFrom(i, alternate.m_nextHop);
+            alternate.m_hops = i.ReadNtohU16();
+            alternate.m_expire = now + TimeStep(i.ReadNtohU64());
+            alternate.m_pathMinEnergy = ReadDouble(i);
+            alternate.m_pathAvgCongestion = ReadDouble(i);
+            alternate.m_pathScore = ReadDouble(i);
+            if (LookupInterface(ipv4, local, alternate.m_dev, alternate.m_iface))
+            {
+                rt.InsertAlternate(alternate, alternates);
+            }
+        }
+        if (!found)
+        {
+            NS_LOG_LOGIC("Route to " << dst << " not restored; no interface " << local);
+            continue;
+        }
+        if (!AddRoute(rt))
+        {
+            NS_LOG_LOGIC("Route to " << dst << " not restored; already in the table");
+        }
+    }
+}
+
 void
 RoutingTable::Print(Ptr<OutputStreamWrapper> stream, Time::Unit unit /* = Time::S */) const
 {
-    std::map<Ipv4Address, RoutingTableEntry> table = m_ipv4AddressEntry;
+    std::map<Ipv4Address, RoutingTableEntry> table;
+    for (const auto& [dst, record] : m_ipv4AddressEntry)
+    {
+        table.emplace(dst, record.m_entry);
+    }
     Purge(table);
     std::ostream* os = stream->GetStream();
     // Copy the current ostream state
@@ -16,6 +16,7 @@
 #ifndef AODV_RTABLE_H
 #define AODV_RTABLE_H
 
+#include "ns3/buffer.h"
 #include "ns3/ipv4-route.h"
 #include "ns3/ipv4.h"
 #include "ns3/net-device.h"
@@ -23,9 +24,13 @@
 #include "ns3/timer.h"
 
 #include <cassert>
+#include <functional>
 #include <map>
+#include <queue>
 #include <stdint.h>
 #include <sys/types.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -43,6 +48,26 @@ enum RouteFlags
     IN_SEARCH = 2, //!< IN_SEARCH
 };
 
+/**
+ * \ingroup aodv
+ * \brief Alternate path to the destination of a routing table entry
+ *
+ * A further path learned from the same route discovery as the route in use, through another
+ * next hop. The paths are only known to differ in that first link: they may share any link
+ * further on. An alternate replaces the route when the link to its next hop breaks.
+ */
+struct RouteAlternate
+{
+    Ptr<NetDevice> m_dev;         ///< Output device
+    Ipv4InterfaceAddress m_iface; ///< Output interface address
+    Ipv4Address m_nextHop;        ///< Next hop
+    uint16_t m_hops;              ///< Hop count
+    Time m_expire;                ///< Expiration time of the path
+    double m_pathMinEnergy;       ///< Minimum residual energy score along the path
+    double m_pathAvgCongestion;   ///< Average congestion degree score along the path
+    double m_pathScore;           ///< EOCW score the alternates are ranked with
+};
+
 /**
  * \ingroup aodv
  * \brief Routing table entry
@@ -107,8 +132,41 @@ class RoutingTableEntry
     void GetPrecursors(std::vector<Ipv4Address>& prec) const;
     //\}
 
+    /// \name Alternate paths management
+    //\{
+    /**
+     * Insert an alternate path, keeping the alternates ordered by score (best first). A path
+     * through the next hop of the route or of another alternate is rejected; when the list
+     * is full the worst alternate is dropped.
+     * \param alternate the alternate path
+     * \param maxAlternates the maximum number of alternates
+     * \return true if the path was inserted
+     */
+    bool InsertAlternate(const RouteAlternate& alternate, uint32_t maxAlternates);
+    /**
+     * Delete the alternates through a next hop
+     * \param nextHop the next hop address
+     */
+    void DeleteAlternates(Ipv4Address nextHop);
+    /**
+     * Replace the next hop, hop count and path metrics of the route by the ones of the best
+     * alternate that has not expired, and remove it from the alternates
+     * \return true if the route switched to an alternate
+     */
+    bool SwitchToAlternate();
+    /**
+     * Get the alternate paths
+     * \return the alternates, best first
+     */
+    const std::vector<RouteAlternate>& GetAlternates() const
+    {
+        return m_alternates;
+    }
+    //\}
+
     /**
      * Mark entry as "down" (i.e. disable it)
+     * The alternate paths are dropped with the route.
      * \param badLinkLifetime duration to keep entry marked as invalid
      */
     void Invalidate(Time badLinkLifetime);
@@ -400,6 +458,8 @@ class RoutingTableEntry
 
     /// List of precursors
     std::vector<Ipv4Address> m_precursorList;
+    /// Alternate paths, best first
+    std::vector<RouteAlternate> m_alternates;
     /// When I can send another request
     Time m_routeRequestTimeout;
     /// Number of route requests
@@ -413,6 +473,12 @@ class RoutingTableEntry
 /**
  * \ingroup aodv
  * \brief The Routing table used by AODV protocol
+ *
+ * Entries are kept in a hash map by destination. Their expiration times are kept in a
+ * min-heap, so that purging the table only touches the entries whose lifetime has
+ * expired. A heap record is only added when an entry gets an expiration time earlier than
+ * the one already scheduled for it; when a record fires for an entry whose lifetime has
+ * been extended in the meantime, the entry is rescheduled at its current expiration time.
  */
 class RoutingTable
 {
@@ -502,6 +568,17 @@ class RoutingTable
      * \param unreachable routes to invalidate
      */
     void InvalidateRoutesWithDst(const std::map<Ipv4Address, uint32_t>& unreachable);
+    /**
+     * Switch the valid routes through a next hop found unreachable to their best alternate
+     * path, instead of invalidating them. The switched destinations are removed from
+     * unreachable.
+     * \param nextHop the unreachable next hop
+     * \param unreachable the destinations reached through nextHop
+     * \param switched the destinations whose route switched to an alternate
+     */
+    void SwitchToAlternates(Ipv4Address nextHop,
+                            std::map<Ipv4Address, uint32_t>& unreachable,
+                            std::vector<Ipv4Address>& switched);
     /**
      * Delete all route from interface with address iface
      * \param iface the interface IP address
@@ -512,6 +589,7 @@ class RoutingTable
     void Clear()
     {
         m_ipv4AddressEntry.clear();
+        m_expiry = decltype(m_expiry)();
     }
 
     /// Delete all outdated entries and invalidate valid entry if Lifetime is expired
@@ -530,9 +608,67 @@ class RoutingTable
      */
     void Print(Ptr<OutputStreamWrapper> stream, Time::Unit unit = Time::S) const;
 
+    /// \name Snapshot of the routing table
+    //\{
+    /**
+     * \returns the number of bytes written by Serialize()
+     */
+    uint32_t GetSerializedSize() const;
+    /**
+     * Write the entries, with their precursors and alternate paths. The times are written
+     * relative to now. The entries of a route discovery in progress and the static ones,
+     * which never expire, are left out.
+     * \param i the buffer iterator, moved past the entries
+     */
+    void Serialize(Buffer::Iterator& i) const;
+    /**
+     * Add the entries written by Serialize(), expiring at the same times relative to now.
+     * The interfaces are looked up by their local address: a path through an address
+     * that the node no longer has is dropped, and so is an entry whose destination is
+     * already in the table.
+     * \param i the buffer iterator, moved past the entries
+     * \param ipv4 the IPv4 stack of the node
+     */
+    void Deserialize(Buffer::Iterator& i, Ptr<Ipv4> ipv4);
+    //\}
+
   private:
+    /// Routing table entry and the expiration time scheduled for it
+    struct Record
+    {
+        /// The routing table entry
+        RoutingTableEntry m_entry;
+        /// Time of the heap record of the entry, Time::Max() if none
+        Time m_scheduled;
+    };
+
+    /// Heap record: an entry may expire at this time
+    struct Expiry
+    {
+        Time m_time;         ///< The expiration time
+        Ipv4Address m_dst;   ///< Destination of the entry
+
+        /**
+         * \param o the other record
+         * \returns true if this record fires after the other one
+         */
+        bool operator>(const Expiry& o) const
+        {
+            return m_time > o.m_time;
+        }
+    };
+
+    /**
+     * Make sure the expiration of an entry is scheduled no later than its lifetime
+     * \param dst the destination of the entry
+     * \param record the entry
+     */
+    void Schedule(Ipv4Address dst, Record& record);
+
     /// The routing table
-    std::map<Ipv4Address, RoutingTableEntry> m_ipv4AddressEntry;
+    std::unordered_map<Ipv4Address, Record, Ipv4AddressHash> m_ipv4AddressEntry;
+    /// Expiration times of the entries, earliest first
+    std::priority_queue<Expiry, std::vector<Expiry>, std::greater<>> m_expiry;
     /// Deletion time for invalid routes
     Time m_badLinkLifetime;
     /**
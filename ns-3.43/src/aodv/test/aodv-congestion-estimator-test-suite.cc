@@ -0,0 +1,115 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+#include "ns3/aodv-congestion-estimator.h"
+#include "ns3/double.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <cmath>
+
+namespace ns3
+{
+namespace aodv
+{
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Unit test for the wifi congestion estimator
+ */
+class WifiCongestionEstimatorTest : public TestCase
+{
+  public:
+    WifiCongestionEstimatorTest()
+        : TestCase("Wifi congestion estimator")
+    {
+    }
+
+    void DoRun() override;
+
+  private:
+    /// Check the queue occupancy average one time constant after it went from 0 to 1
+    void CheckQueueOccupancy();
+
+    /// Estimator under test
+    Ptr<WifiCongestionEstimator> m_estimator;
+    /// Busy fraction at the start of the simulation
+    double m_busyFraction;
+};
+
+void
+WifiCongestionEstimatorTest::CheckQueueOccupancy()
+{
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_estimator->GetQueueOccupancy(),
+                              1.0 - std::exp(-1.0),
+                              1e-9,
+                              "Average after one time constant");
+    // A change keeps the average continuous
+    m_estimator->UpdateQueueOccupancy(0.0);
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_estimator->GetQueueOccupancy(),
+                              1.0 - std::exp(-1.0),
+                              1e-9,
+                              "Average at a change");
+    // Without PHY state period since the start, the medium is taken as idle since then
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_estimator->GetBusyFraction(),
+                              m_busyFraction * std::exp(-1.0),
+                              1e-9,
+                              "Busy fraction aged");
+}
+
+void
+WifiCongestionEstimatorTest::DoRun()
+{
+    m_estimator = CreateObject<WifiCongestionEstimator>();
+    m_estimator->SetAttribute("TimeConstant", TimeValue(Seconds(2)));
+    m_estimator->SetAttribute("RetryAlpha", DoubleValue(0.5));
+    m_estimator->Initialize();
+    NS_TEST_EXPECT_MSG_EQ(m_estimator->GetCongestionScore(), 1.0, "Idle node");
+
+    m_estimator->AddPhyPeriod(Seconds(2), true);
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_estimator->GetBusyFraction(),
+                              1.0 - std::exp(-1.0),
+                              1e-9,
+                              "Busy for one time constant");
+    m_estimator->AddPhyPeriod(Seconds(2), false);
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_estimator->GetBusyFraction(),
+                              (1.0 - std::exp(-1.0)) * std::exp(-1.0),
+                              1e-9,
+                              "Then idle for one time constant");
+
+    m_estimator->AddTxAttempt(false);
+    m_estimator->AddTxAttempt(false);
+    m_estimator->AddTxAttempt(true);
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_estimator->GetRetryRate(), 0.375, 1e-12, "Retry rate");
+
+    double expected = 1.0 - (0.3 * m_estimator->GetBusyFraction() + 0.2 * 0.375);
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_estimator->GetCongestionScore(), expected, 1e-12, "Score");
+
+    m_busyFraction = m_estimator->GetBusyFraction();
+    m_estimator->UpdateQueueOccupancy(1.0);
+    Simulator::Schedule(Seconds(2), &WifiCongestionEstimatorTest::CheckQueueOccupancy, this);
+    Simulator::Run();
+    Simulator::Destroy();
+    m_estimator = nullptr;
+}
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Congestion Estimator Test Suite
+ */
+class CongestionEstimatorTestSuite : public TestSuite
+{
+  public:
+    CongestionEstimatorTestSuite()
+        : TestSuite("aodv-routing-congestion-estimator", Type::UNIT)
+    {
+        AddTestCase(new WifiCongestionEstimatorTest, TestCase::Duration::QUICK);
+    }
+} g_congestionEstimatorTestSuite; ///< the test suite
+
+} // namespace aodv
+} // namespace ns3
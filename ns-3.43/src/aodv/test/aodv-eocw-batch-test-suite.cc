@@ -0,0 +1,198 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+#include "ns3/aodv-eocw-batch.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/test.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace ns3
+{
+namespace aodv
+{
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Unit test for the vectorizable logarithm
+ */
+class EocwFastLogTest : public TestCase
+{
+  public:
+    EocwFastLogTest()
+        : TestCase("EOCW fast logarithm")
+    {
+    }
+
+    void DoRun() override;
+};
+
+void
+EocwFastLogTest::DoRun()
+{
+    NS_TEST_EXPECT_MSG_EQ(EocwFastLog(1.0), 0.0, "ln 1");
+    for (double x : {std::numeric_limits<double>::min(),
+                     0.5,
+                     0.7071067811865475,
+                     0.7071067811865476,
+                     1.4142135623730951,
+                     1.4142135623730954,
+                     2.0,
+                     std::numeric_limits<double>::max()})
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL(EocwFastLog(x), std::log(x), 1e-12, "ln " << x);
+    }
+
+    Ptr<UniformRandomVariable> exponent = CreateObject<UniformRandomVariable>();
+    exponent->SetStream(1);
+    Ptr<UniformRandomVariable> mantissa = CreateObject<UniformRandomVariable>();
+    mantissa->SetStream(2);
+    for (uint32_t i = 0; i < 100000; ++i)
+    {
+        // Over the whole normal range
+        int e = static_cast<int>(std::floor(exponent->GetValue(-1022, 1024)));
+        double x = std::ldexp(mantissa->GetValue(1, 2), e);
+        NS_TEST_ASSERT_MSG_EQ_TOL(EocwFastLog(x), std::log(x), 1e-12, "ln " << x);
+    }
+}
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Fuzz test of the batch evaluation against the EwmAccumulator and EocwScore
+ */
+class EocwBatchFuzzTest : public TestCase
+{
+  public:
+    EocwBatchFuzzTest()
+        : TestCase("EOCW batch evaluation against the scalar one")
+    {
+    }
+
+    void DoRun() override;
+
+  private:
+    /**
+     * Evaluate a batch and check it against the scalar evaluation
+     * \param batch the batch
+     * \param fuzzy the fuzzy weights
+     */
+    void Check(const EocwCandidateBatch& batch, const EocwWeights& fuzzy);
+
+    std::vector<double> m_cd; ///< Congestion degree scores of the batch
+    std::vector<double> m_re; ///< Residual energy scores of the batch
+    std::vector<double> m_rh; ///< Hop count scores of the batch
+};
+
+void
+EocwBatchFuzzTest::Check(const EocwCandidateBatch& batch, const EocwWeights& fuzzy)
+{
+    EwmAccumulator acc;
+    for (std::size_t i = 0; i < m_cd.size(); ++i)
+    {
+        acc.Add(m_cd[i], m_re[i], m_rh[i]);
+    }
+    EocwWeights reference = acc.GetWeights();
+
+    std::vector<double> scores;
+    EocwWeights ewm = batch.Evaluate(fuzzy, scores);
+    NS_TEST_ASSERT_MSG_EQ(scores.size(), m_cd.size(), "One score per path");
+    for (std::size_t j = 0; j < ewm.size(); ++j)
+    {
+        NS_TEST_ASSERT_MSG_EQ_TOL(ewm[j],
+                                  reference[j],
+                                  1e-6,
+                                  "Weight " << j << " of " << m_cd.size() << " paths");
+    }
+    for (std::size_t i = 0; i < scores.size(); ++i)
+    {
+        // Scored with the weights of the batch, the scores are the scalar ones
+        NS_TEST_ASSERT_MSG_EQ_TOL(scores[i],
+                                  EocwScore(fuzzy, ewm, m_cd[i], m_re[i], m_rh[i]),
+                                  1e-15,
+                                  "Score of path " << i);
+    }
+}
+
+void
+EocwBatchFuzzTest::DoRun()
+{
+    Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(3);
+    EocwCandidateBatch batch;
+    for (uint32_t trial = 0; trial < 2000; ++trial)
+    {
+        // Mostly a few candidates, as in a discovery, sometimes many
+        uint32_t m = rng->GetInteger(0, trial % 10 == 0 ? 1024 : 20);
+        // Zeros, repeated hop count scores or identical rows in some of the trials
+        uint32_t kind = trial % 4;
+        batch.Clear();
+        m_cd.clear();
+        m_re.clear();
+        m_rh.clear();
+        for (uint32_t i = 0; i < m; ++i)
+        {
+            double cd = rng->GetValue();
+            double re = rng->GetValue();
+            double rh = rng->GetValue();
+            if (kind == 1)
+            {
+                cd = rng->GetValue() < 0.3 ? 0.0 : cd;
+                re = rng->GetValue() < 0.3 ? 0.0 : re;
+            }
+            else if (kind == 2)
+            {
+                rh = EocwHopCountScore(rng->GetInteger(1, 10));
+            }
+            else if (kind == 3 && i > 0)
+            {
+                cd = m_cd[0];
+                re = m_re[0];
+                rh = m_rh[0];
+            }
+            m_cd.push_back(cd);
+            m_re.push_back(re);
+            m_rh.push_back(rh);
+            batch.Add(cd, re, rh);
+        }
+        NS_TEST_ASSERT_MSG_EQ(batch.GetN(), m, "Batch size");
+        EocwWeights fuzzy{rng->GetValue(), rng->GetValue(), rng->GetValue()};
+        Check(batch, fuzzy);
+        if (IsStatusFailure())
+        {
+            return;
+        }
+    }
+
+    // No weight: every score is 0, as with EocwScore
+    std::vector<double> scores;
+    batch.Score({0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}, scores);
+    for (double score : scores)
+    {
+        NS_TEST_EXPECT_MSG_EQ(score, 0.0, "No weight");
+    }
+}
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief EOCW batch evaluation Test Suite
+ */
+class EocwBatchTestSuite : public TestSuite
+{
+  public:
+    EocwBatchTestSuite()
+        : TestSuite("aodv-routing-eocw-batch", Type::UNIT)
+    {
+        AddTestCase(new EocwFastLogTest, TestCase::Duration::QUICK);
+        AddTestCase(new EocwBatchFuzzTest, TestCase::Duration::QUICK);
+    }
+} g_eocwBatchTestSuite; ///< the test suite
+
+} // namespace aodv
+} // namespace ns3
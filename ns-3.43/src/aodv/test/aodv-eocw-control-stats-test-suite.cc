@@ -0,0 +1,236 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+#include "ns3/aodv-eocw-control-stats.h"
+#include "ns3/aodv-helper.h"
+#include "ns3/aodv-routing-protocol.h"
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/double.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/ping-helper.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <map>
+#include <string>
+
+namespace ns3
+{
+namespace aodv
+{
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Data output callback keeping the values written by the data calculators
+ */
+class CaptureDataOutput : public DataOutputCallback
+{
+  public:
+    void OutputStatistic(std::string key,
+                         std::string variable,
+                         const StatisticalSummary* statSum) override
+    {
+        m_values[variable + "-count"] = statSum->getCount();
+        m_values[variable + "-sum"] = statSum->getSum();
+    }
+
+    void OutputSingleton(std::string key, std::string variable, int val) override
+    {
+        m_values[variable] = val;
+    }
+
+    void OutputSingleton(std::string key, std::string variable, uint32_t val) override
+    {
+        m_values[variable] = val;
+    }
+
+    void OutputSingleton(std::string key, std::string variable, double val) override
+    {
+        m_values[variable] = val;
+    }
+
+    void OutputSingleton(std::string key, std::string variable, std::string val) override
+    {
+    }
+
+    void OutputSingleton(std::string key, std::string variable, Time val) override
+    {
+        m_values[variable] = val.GetSeconds();
+    }
+
+    std::map<std::string, double> m_values; ///< Values written, by variable
+};
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Control plane counters and traces of a route discovery along a chain
+ */
+class EocwControlStatsTest : public TestCase
+{
+  public:
+    EocwControlStatsTest()
+        : TestCase("EOCW control plane counters and traces")
+    {
+    }
+
+    /**
+     * Count the RREQs received through a Config path
+     * \param context the trace context
+     * \param header the RREQ header
+     * \param sender the neighbor the RREQ was received from
+     */
+    void RreqReceived(std::string context, const RreqHeader& header, Ipv4Address sender)
+    {
+        m_rreqReceived++;
+    }
+
+    void DoRun() override
+    {
+        RngSeedManager::SetSeed(12345);
+        RngSeedManager::SetRun(7);
+
+        NodeContainer nodes;
+        nodes.Create(3);
+        MobilityHelper mobility;
+        mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                      "DeltaX",
+                                      DoubleValue(120),
+                                      "GridWidth",
+                                      UintegerValue(3));
+        mobility.Install(nodes);
+
+        WifiMacHelper wifiMac;
+        wifiMac.SetType("ns3::AdhocWifiMac");
+        YansWifiPhyHelper wifiPhy;
+        wifiPhy.DisablePreambleDetectionModel();
+        YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default();
+        wifiPhy.SetChannel(wifiChannel.Create());
+        WifiHelper wifi;
+        wifi.SetStandard(WIFI_STANDARD_80211a);
+        wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                     "DataMode",
+                                     StringValue("OfdmRate6Mbps"));
+        NetDeviceContainer devices = wifi.Install(wifiPhy, wifiMac, nodes);
+
+        AodvHelper aodv;
+        // the middle node knows the destination from its hellos: make it forward the RREQ
+        aodv.Set("DestinationOnly", BooleanValue(true));
+        InternetStackHelper internetStack;
+        internetStack.SetRoutingHelper(aodv);
+        internetStack.Install(nodes);
+        Ipv4AddressHelper address;
+        address.SetBase("10.1.1.0", "255.255.255.0");
+        Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+        PingHelper ping(interfaces.GetAddress(2));
+        ping.SetAttribute("Count", UintegerValue(3));
+        ApplicationContainer apps = ping.Install(nodes.Get(0));
+        apps.Start(Seconds(1));
+
+        Ptr<EocwControlStats> stats = CreateObject<EocwControlStats>();
+        stats->Install(nodes);
+        m_rreqReceived = 0;
+        Config::Connect("/NodeList/*/$ns3::aodv::RoutingProtocol/RreqReceived",
+                        MakeCallback(&EocwControlStatsTest::RreqReceived, this));
+
+        Simulator::Stop(Seconds(5));
+        Simulator::Run();
+
+        RoutingProtocol::ControlCounters total;
+        for (uint32_t i = 0; i < nodes.GetN(); ++i)
+        {
+            const auto& counters =
+                nodes.Get(i)->GetObject<RoutingProtocol>()->GetControlCounters();
+            total.rreqReceived += counters.rreqReceived;
+            total.rreqSuppressed += counters.rreqSuppressed;
+            total.rreqForwarded += counters.rreqForwarded;
+            total.rreqCancelled += counters.rreqCancelled;
+            total.rrepSent += counters.rrepSent;
+            total.eocwSelections += counters.eocwSelections;
+            total.eocwCandidates += counters.eocwCandidates;
+            total.eocwLatency += counters.eocwLatency;
+            total.eocwScore += counters.eocwScore;
+        }
+        const auto& middle = nodes.Get(1)->GetObject<RoutingProtocol>()->GetControlCounters();
+        const auto& target = nodes.Get(2)->GetObject<RoutingProtocol>()->GetControlCounters();
+        NS_TEST_ASSERT_MSG_GT(middle.rreqForwarded, 0, "The middle node forwards the RREQ");
+        NS_TEST_ASSERT_MSG_GT(target.eocwSelections, 0, "The destination selects a path");
+        NS_TEST_ASSERT_MSG_GT(target.rrepSent, 0, "The destination answers the RREQ");
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(target.eocwCandidates,
+                                    target.eocwSelections,
+                                    "At least one path is offered per selection");
+        // Without early commit, a path is chosen EocwCollectionTime after the first one arrived
+        NS_TEST_ASSERT_MSG_EQ(target.eocwLatency,
+                              MilliSeconds(20) * target.eocwSelections,
+                              "Selection latency");
+        NS_TEST_ASSERT_MSG_EQ(total.rreqSuppressed, 0, "No energy source, no suppression");
+        NS_TEST_ASSERT_MSG_EQ(m_rreqReceived, total.rreqReceived, "Config::Connect trace");
+
+        DataCollector collector;
+        stats->SetContext("chain");
+        stats->AddTo(collector);
+        CaptureDataOutput output;
+        for (auto i = collector.DataCalculatorBegin(); i != collector.DataCalculatorEnd(); ++i)
+        {
+            (*i)->Output(output);
+        }
+        NS_TEST_ASSERT_MSG_EQ(output.m_values["rreq-received"], total.rreqReceived, "Received");
+        NS_TEST_ASSERT_MSG_EQ(output.m_values["rreq-suppressed"],
+                              total.rreqSuppressed,
+                              "Suppressed");
+        NS_TEST_ASSERT_MSG_EQ(output.m_values["rreq-forwarded"], total.rreqForwarded, "Forwarded");
+        NS_TEST_ASSERT_MSG_EQ(output.m_values["rreq-cancelled"], total.rreqCancelled, "Cancelled");
+        NS_TEST_ASSERT_MSG_EQ(output.m_values["rreq-forward-delay-count"],
+                              total.rreqForwarded,
+                              "Forward delays");
+        NS_TEST_ASSERT_MSG_EQ(output.m_values["rrep-sent"], total.rrepSent, "RREPs sent");
+        NS_TEST_ASSERT_MSG_EQ(output.m_values["eocw-candidates-count"],
+                              total.eocwSelections,
+                              "Selections");
+        NS_TEST_ASSERT_MSG_EQ(output.m_values["eocw-candidates-sum"],
+                              total.eocwCandidates,
+                              "Candidates");
+        NS_TEST_ASSERT_MSG_EQ_TOL(output.m_values["eocw-score-sum"],
+                                  total.eocwScore,
+                                  1e-9,
+                                  "Scores");
+        NS_TEST_ASSERT_MSG_EQ_TOL(output.m_values["eocw-selection-latency-total"],
+                                  total.eocwLatency.GetSeconds(),
+                                  1e-9,
+                                  "Latencies");
+
+        Simulator::Destroy();
+    }
+
+  private:
+    uint64_t m_rreqReceived; ///< RREQs received, counted through Config::Connect
+};
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief EOCW control plane statistics test suite
+ */
+class EocwControlStatsTestSuite : public TestSuite
+{
+  public:
+    EocwControlStatsTestSuite()
+        : TestSuite("aodv-eocw-control-stats", Type::UNIT)
+    {
+        AddTestCase(new EocwControlStatsTest, TestCase::Duration::QUICK);
+    }
+} g_eocwControlStatsTestSuite; ///< the test suite
+
+} // namespace aodv
+} // namespace ns3
@@ -0,0 +1,132 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+#include "ns3/aodv-eocw-fuzzy.h"
+#include "ns3/test.h"
+
+#include <cmath>
+
+namespace ns3
+{
+namespace aodv
+{
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Unit test for the EOCW fuzzy rule base
+ */
+class EocwFuzzyRuleBaseTest : public TestCase
+{
+  public:
+    EocwFuzzyRuleBaseTest()
+        : TestCase("EOCW fuzzy rule base")
+    {
+    }
+
+    void DoRun() override;
+};
+
+void
+EocwFuzzyRuleBaseTest::DoRun()
+{
+    NS_TEST_EXPECT_MSG_EQ(EocwFuzzyTriangle(0.5, 0.2, 0.5, 0.8), 1.0, "Peak");
+    NS_TEST_EXPECT_MSG_EQ_TOL(EocwFuzzyTriangle(0.35, 0.2, 0.5, 0.8), 0.5, 1e-12, "Rising edge");
+    NS_TEST_EXPECT_MSG_EQ(EocwFuzzyTriangle(0.8, 0.2, 0.5, 0.8), 0.0, "Right foot");
+
+    // A single rule fires at the peaks of the fuzzy sets
+    EocwWeights w = EocwFuzzyRuleBase::Evaluate(0.0, 0.0);
+    NS_TEST_EXPECT_MSG_EQ_TOL(w[1], 0.50, 1e-12, "Low energy, busy");
+    w = EocwFuzzyRuleBase::Evaluate(1.0, 0.5);
+    NS_TEST_EXPECT_MSG_EQ_TOL(w[2], 0.70, 1e-12, "High energy, normal");
+
+    // Between two peaks the outputs of both rules are averaged
+    w = EocwFuzzyRuleBase::Evaluate(0.3, 0.0);
+    double low = EocwFuzzyTriangle(0.3, -0.1, 0.0, 0.4);
+    double med = EocwFuzzyTriangle(0.3, 0.2, 0.5, 0.8);
+    NS_TEST_EXPECT_MSG_EQ_TOL(w[0], (low * 0.45 + med * 0.70) / (low + med), 1e-12, "Blend");
+    NS_TEST_EXPECT_MSG_EQ_TOL(w[0] + w[1] + w[2], 1.0, 1e-12, "Normalized");
+}
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Unit test bounding the error of the tabulated fuzzy weights
+ */
+class EocwFuzzyTableTest : public TestCase
+{
+  public:
+    /**
+     * constructor
+     * \param resolution the table resolution
+     * \param maxError the bound on the weight error
+     */
+    EocwFuzzyTableTest(uint32_t resolution, double maxError)
+        : TestCase("EOCW fuzzy table, resolution " + std::to_string(resolution)),
+          m_resolution(resolution),
+          m_maxError(maxError)
+    {
+    }
+
+    void DoRun() override;
+
+  private:
+    uint32_t m_resolution; ///< Table resolution
+    double m_maxError;     ///< Bound on the weight error
+};
+
+void
+EocwFuzzyTableTest::DoRun()
+{
+    Ptr<const EocwFuzzyTable> table = EocwFuzzyTable::Get(m_resolution);
+    NS_TEST_EXPECT_MSG_EQ(table->GetResolution(), m_resolution, "Resolution");
+    NS_TEST_EXPECT_MSG_EQ(table, EocwFuzzyTable::Get(m_resolution), "Shared table");
+
+    // Off-grid samples, including the domain boundaries
+    const uint32_t samples = 997;
+    double maxError = 0;
+    for (uint32_t a = 0; a <= samples; ++a)
+    {
+        for (uint32_t b = 0; b <= samples; ++b)
+        {
+            double re = double(a) / samples;
+            double cd = double(b) / samples;
+            EocwWeights exact = EocwFuzzyRuleBase::Evaluate(re, cd);
+            EocwWeights approx = table->Lookup(re, cd);
+            for (std::size_t k = 0; k < exact.size(); ++k)
+            {
+                maxError = std::max(maxError, std::abs(exact[k] - approx[k]));
+            }
+        }
+    }
+    NS_TEST_EXPECT_MSG_LT(maxError, m_maxError, "Interpolation error");
+
+    // Grid points are exact and inputs are clamped to the domain
+    EocwWeights w = table->Lookup(0.5, 1.0);
+    NS_TEST_EXPECT_MSG_EQ_TOL(w[2], 0.60, 1e-12, "Grid point");
+    w = table->Lookup(1.5, -0.5);
+    NS_TEST_EXPECT_MSG_EQ_TOL(w[0], EocwFuzzyRuleBase::Evaluate(1.0, 0.0)[0], 1e-12, "Clamped");
+}
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief EOCW Fuzzy Test Suite
+ */
+class EocwFuzzyTestSuite : public TestSuite
+{
+  public:
+    EocwFuzzyTestSuite()
+        : TestSuite("aodv-routing-eocw-fuzzy", Type::UNIT)
+    {
+        AddTestCase(new EocwFuzzyRuleBaseTest, TestCase::Duration::QUICK);
+        AddTestCase(new EocwFuzzyTableTest(16, 0.08), TestCase::Duration::QUICK);
+        AddTestCase(new EocwFuzzyTableTest(64, 0.025), TestCase::Duration::QUICK);
+        AddTestCase(new EocwFuzzyTableTest(256, 0.01), TestCase::Duration::QUICK);
+    }
+} g_eocwFuzzyTestSuite; ///< the test suite
+
+} // namespace aodv
+} // namespace ns3
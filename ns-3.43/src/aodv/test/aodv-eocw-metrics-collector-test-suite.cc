@@ -0,0 +1,119 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+#include "ns3/aodv-eocw-metrics-collector.h"
+#include "ns3/basic-energy-source.h"
+#include "ns3/node.h"
+#include "ns3/simple-device-energy-model.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+namespace aodv
+{
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Energy and survival windows of the metrics collector, and its ring buffer
+ */
+class EocwMetricsCollectorTest : public TestCase
+{
+  public:
+    EocwMetricsCollectorTest()
+        : TestCase("EOCW metrics collector windows")
+    {
+    }
+
+    void DoRun() override
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<energy::BasicEnergySource> source = CreateObject<energy::BasicEnergySource>();
+        source->SetInitialEnergy(100);
+        source->SetAttribute("PeriodicEnergyUpdateInterval", TimeValue(Seconds(0.5)));
+        source->SetNode(node);
+        Ptr<energy::SimpleDeviceEnergyModel> model =
+            CreateObject<energy::SimpleDeviceEnergyModel>();
+        model->SetEnergySource(source);
+        model->SetNode(node);
+        source->AppendDeviceEnergyModel(model);
+        // 1 A at the default 3 V supply: 3 J/s
+        model->SetCurrentA(1);
+        source->Initialize();
+        energy::EnergySourceContainer sources;
+        sources.Add(source);
+
+        Ptr<EocwMetricsCollector> collector =
+            CreateObjectWithAttributes<EocwMetricsCollector>("Window",
+                                                             TimeValue(Seconds(1)),
+                                                             "Capacity",
+                                                             UintegerValue(4));
+        collector->Install(NodeContainer(node));
+        collector->Install(sources);
+        Simulator::Schedule(Seconds(4.25), &EocwMetricsCollector::NotifyNodeDown, collector, node);
+        Simulator::Stop(Seconds(6));
+        Simulator::Run();
+        collector->UpdateEnergy();
+
+        std::stringstream series;
+        collector->WriteTimeSeries(series);
+        std::vector<std::vector<std::string>> rows;
+        std::string line;
+        std::getline(series, line);
+        while (std::getline(series, line))
+        {
+            std::stringstream fields(line);
+            std::vector<std::string> row;
+            std::string field;
+            while (std::getline(fields, field, ','))
+            {
+                row.push_back(field);
+            }
+            rows.push_back(row);
+        }
+        // Windows 0 to 2 were overwritten, 3 to 6 are left
+        NS_TEST_ASSERT_MSG_EQ(rows.size(), 4, "Capacity of the ring");
+        NS_TEST_EXPECT_MSG_EQ(rows[0][0], "4", "End of window 3");
+        // The source reports every 0.5 s: window 3 holds the consumption from 2.5 to 3.5 s
+        NS_TEST_EXPECT_MSG_EQ_TOL(std::stod(rows[0][7]), 3, 1e-9, "Energy of window 3");
+        NS_TEST_EXPECT_MSG_EQ(rows[0][8], "100", "Survival of window 3");
+        // Consumption from 3.5 to 4.25 s, then the energy left counts as consumed
+        NS_TEST_EXPECT_MSG_EQ_TOL(std::stod(rows[1][7]), 89.5, 1e-9, "Energy of window 4");
+        NS_TEST_EXPECT_MSG_EQ(rows[1][8], "0", "Survival of window 4");
+        NS_TEST_EXPECT_MSG_EQ(rows[2][7], "0", "No consumption once down");
+        NS_TEST_EXPECT_MSG_EQ(rows[3][8], "0", "Survival of window 6");
+        NS_TEST_EXPECT_MSG_EQ_TOL(collector->GetTotals().energyConsumed,
+                                  100,
+                                  1e-9,
+                                  "All the energy consumed");
+        NS_TEST_EXPECT_MSG_EQ(collector->GetTotals().nodesDown, 1, "Node down");
+        NS_TEST_EXPECT_MSG_EQ(collector->GetSurvivalRate(), 0, "No node left");
+        Simulator::Destroy();
+    }
+};
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief EOCW metrics collector test suite
+ */
+class EocwMetricsCollectorTestSuite : public TestSuite
+{
+  public:
+    EocwMetricsCollectorTestSuite()
+        : TestSuite("aodv-eocw-metrics-collector", Type::UNIT)
+    {
+        AddTestCase(new EocwMetricsCollectorTest, TestCase::Duration::QUICK);
+    }
+} g_eocwMetricsCollectorTestSuite; ///< the test suite
+
+} // namespace aodv
+} // namespace ns3
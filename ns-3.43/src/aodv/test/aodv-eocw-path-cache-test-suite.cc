@@ -0,0 +1,102 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+#include "ns3/aodv-eocw-path-cache.h"
+#include "ns3/test.h"
+
+namespace ns3
+{
+namespace aodv
+{
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Unit test for the EOCW path cache
+ */
+class EocwPathCacheTest : public TestCase
+{
+  public:
+    EocwPathCacheTest()
+        : TestCase("EOCW path cache"),
+          cache(3)
+    {
+    }
+
+    void DoRun() override;
+
+  private:
+    /**
+     * Build a candidate path
+     * \param hops the hop count, used to tell candidates apart
+     * \returns the path
+     */
+    static EocwPath MakePath(uint32_t hops)
+    {
+        return EocwPath(1.0, 1.0, hops, RoutingTableEntry());
+    }
+
+    /// EOCW path cache
+    EocwPathCache cache;
+};
+
+void
+EocwPathCacheTest::DoRun()
+{
+    Ipv4Address origin1("10.0.0.1");
+    Ipv4Address origin2("10.0.0.2");
+    Ipv4Address dst("10.0.0.9");
+
+    NS_TEST_EXPECT_MSG_EQ((cache.Find(origin1, 1) == nullptr), true, "Empty cache");
+    EocwPathCache::Discovery& d1 = cache.Insert(origin1, 1, dst);
+    EocwPathCache::Discovery& d2 = cache.Insert(origin2, 1, dst);
+    NS_TEST_EXPECT_MSG_EQ(cache.GetSize(), 2, "Same RREQ ID from two originators");
+    NS_TEST_EXPECT_MSG_EQ((&cache.Insert(origin1, 1, dst) == &d1), true, "Existing discovery");
+    NS_TEST_EXPECT_MSG_EQ((cache.Find(origin2, 1) == &d2), true, "Lookup");
+    NS_TEST_EXPECT_MSG_EQ(d1.m_destination, dst, "Destination");
+
+    NS_TEST_EXPECT_MSG_EQ(cache.AddCandidate(d1, MakePath(1), 0.5), true, "Room left");
+    NS_TEST_EXPECT_MSG_EQ(cache.AddCandidate(d1, MakePath(2), 0.7), true, "Room left");
+    NS_TEST_EXPECT_MSG_EQ(cache.AddCandidate(d1, MakePath(3), 0.5), true, "Room left");
+    NS_TEST_EXPECT_MSG_EQ(cache.AddCandidate(d1, MakePath(4), 0.5), false, "Not better");
+    NS_TEST_EXPECT_MSG_EQ(cache.AddCandidate(d1, MakePath(5), 0.6), true, "Evicts the worst");
+    NS_TEST_EXPECT_MSG_EQ(d1.m_arrivals, 5, "All arrivals counted");
+    NS_TEST_EXPECT_MSG_EQ(d1.m_candidates.size(), 3, "Bounded");
+    NS_TEST_EXPECT_MSG_EQ(d1.m_candidates[0].path.hopCount, 2, "Best first");
+    NS_TEST_EXPECT_MSG_EQ(d1.m_candidates[1].path.hopCount, 5, "Ordered by score");
+    NS_TEST_EXPECT_MSG_EQ(d1.m_candidates[2].path.hopCount, 1, "Earlier arrival wins a tie");
+    NS_TEST_EXPECT_MSG_EQ(d2.m_candidates.empty(), true, "Discoveries are independent");
+
+    cache.SetMaxCandidates(1);
+    NS_TEST_EXPECT_MSG_EQ(cache.AddCandidate(d2, MakePath(1), 0.1), true, "Room left");
+    NS_TEST_EXPECT_MSG_EQ(cache.AddCandidate(d2, MakePath(2), 0.2), true, "Better");
+    NS_TEST_EXPECT_MSG_EQ(d2.m_candidates.size(), 1, "Bounded");
+    NS_TEST_EXPECT_MSG_EQ(d2.m_candidates[0].path.hopCount, 2, "Best kept");
+
+    NS_TEST_EXPECT_MSG_EQ(cache.Erase(origin1, 1), true, "Erase");
+    NS_TEST_EXPECT_MSG_EQ(cache.Erase(origin1, 1), false, "Already erased");
+    NS_TEST_EXPECT_MSG_EQ((cache.Find(origin2, 1) == &d2), true, "Other discovery untouched");
+    cache.Clear();
+    NS_TEST_EXPECT_MSG_EQ(cache.GetSize(), 0, "Clear");
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief EOCW Path Cache Test Suite
+ */
+class EocwPathCacheTestSuite : public TestSuite
+{
+  public:
+    EocwPathCacheTestSuite()
+        : TestSuite("aodv-routing-eocw-path-cache", Type::UNIT)
+    {
+        AddTestCase(new EocwPathCacheTest, TestCase::Duration::QUICK);
+    }
+} g_eocwPathCacheTestSuite; ///< the test suite
+
+} // namespace aodv
+} // namespace ns3
@@ -0,0 +1,82 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+#include "ns3/aodv-eocw-weights.h"
+#include "ns3/test.h"
+
+namespace ns3
+{
+namespace aodv
+{
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Unit test for the streaming Entropy Weight Method
+ */
+class EwmAccumulatorTest : public TestCase
+{
+  public:
+    EwmAccumulatorTest()
+        : TestCase("EWM accumulator")
+    {
+    }
+
+    void DoRun() override;
+};
+
+void
+EwmAccumulatorTest::DoRun()
+{
+    EwmAccumulator acc;
+    EocwWeights w = acc.GetWeights();
+    NS_TEST_EXPECT_MSG_EQ_TOL(w[0], 0.333, 1e-12, "No path");
+
+    acc.Add(0.9, 0.5, 1.0);
+    w = acc.GetWeights();
+    NS_TEST_EXPECT_MSG_EQ_TOL(w[2], 0.333, 1e-12, "Single path");
+
+    acc.Add(0.4, 0.8, 0.6);
+    acc.Add(0.7, 0.2, 0.1);
+    NS_TEST_EXPECT_MSG_EQ(acc.GetN(), 3, "Three paths");
+    // Reference values from the textbook two-pass computation over the decision matrix
+    w = acc.GetWeights();
+    NS_TEST_EXPECT_MSG_EQ_TOL(w[0], 0.11599333551618904, 1e-12, "Congestion weight");
+    NS_TEST_EXPECT_MSG_EQ_TOL(w[1], 0.29834239191265427, 1e-12, "Energy weight");
+    NS_TEST_EXPECT_MSG_EQ_TOL(w[2], 0.5856642725711567, 1e-12, "Hop count weight");
+
+    // Identical paths carry no information: every criterion has maximal entropy
+    acc.Clear();
+    acc.Add(0.5, 0.5, 0.5);
+    acc.Add(0.5, 0.5, 0.5);
+    w = acc.GetWeights();
+    NS_TEST_EXPECT_MSG_EQ_TOL(w[0], 1.0 / 3, 1e-9, "Uniform weights");
+    NS_TEST_EXPECT_MSG_EQ_TOL(w[1], 1.0 / 3, 1e-9, "Uniform weights");
+
+    EocwWeights fuzzy{0.2, 0.3, 0.5};
+    EocwWeights ewm{1.0, 1.0, 1.0};
+    NS_TEST_EXPECT_MSG_EQ_TOL(EocwScore(fuzzy, ewm, 1.0, 0.5, 0.0), 0.35, 1e-12, "Score");
+    NS_TEST_EXPECT_MSG_EQ(EocwScore(fuzzy, {0.0, 0.0, 0.0}, 1.0, 1.0, 1.0), 0.0, "No weight");
+    NS_TEST_EXPECT_MSG_EQ(EocwHopCountScore(2), 1.0, "Short path");
+    NS_TEST_EXPECT_MSG_EQ(EocwHopCountScore(7), 0.1, "Long path");
+}
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief EOCW Weights Test Suite
+ */
+class EocwWeightsTestSuite : public TestSuite
+{
+  public:
+    EocwWeightsTestSuite()
+        : TestSuite("aodv-routing-eocw-weights", Type::UNIT)
+    {
+        AddTestCase(new EwmAccumulatorTest, TestCase::Duration::QUICK);
+    }
+} g_eocwWeightsTestSuite; ///< the test suite
+
+} // namespace aodv
+} // namespace ns3
@@ -0,0 +1,298 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+#include "ns3/aodv-helper.h"
+#include "ns3/aodv-hello-scheduler.h"
+#include "ns3/aodv-neighbor.h"
+#include "ns3/aodv-routing-protocol.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/mobility-model.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+#include "ns3/yans-wifi-helper.h"
+
+namespace ns3
+{
+namespace aodv
+{
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Interval of the HelloScheduler
+ */
+class HelloSchedulerTest : public TestCase
+{
+  public:
+    HelloSchedulerTest()
+        : TestCase("Adaptive hello interval")
+    {
+    }
+
+    void DoRun() override
+    {
+        HelloScheduler scheduler;
+        scheduler.SetIntervals(Seconds(1), Seconds(5));
+        scheduler.SetThresholds(0.5, 5);
+        NS_TEST_EXPECT_MSG_EQ(scheduler.GetInterval(), Seconds(1), "Shortest interval first");
+
+        // the scheduler reads the churn since its previous call
+        Simulator::Schedule(Seconds(2), [&]() {
+            NS_TEST_EXPECT_MSG_EQ(scheduler.NextInterval(0, 0, 1),
+                                  Seconds(5),
+                                  "Idle node: longest interval");
+        });
+        Simulator::Schedule(Seconds(4), [&]() {
+            NS_TEST_EXPECT_MSG_EQ(scheduler.NextInterval(0, 10, 1),
+                                  Seconds(1),
+                                  "Fast node with full energy: shortest interval");
+        });
+        Simulator::Schedule(Seconds(6), [&]() {
+            NS_TEST_EXPECT_MSG_EQ(scheduler.NextInterval(0, 2.5, 1),
+                                  Seconds(3),
+                                  "Half the speed threshold: half way");
+        });
+        Simulator::Schedule(Seconds(8), [&]() {
+            NS_TEST_EXPECT_MSG_EQ(scheduler.NextInterval(0, 10, 0.5),
+                                  Seconds(3),
+                                  "Half the energy: half way");
+        });
+        Simulator::Schedule(Seconds(10), [&]() {
+            NS_TEST_EXPECT_MSG_EQ(scheduler.NextInterval(2, 0, 1),
+                                  Seconds(1),
+                                  "2 changes in 2 s: full churn");
+        });
+        Simulator::Schedule(Seconds(14), [&]() {
+            NS_TEST_EXPECT_MSG_EQ(scheduler.NextInterval(3, 0, 1),
+                                  Seconds(3),
+                                  "1 change in 4 s: half the churn threshold");
+        });
+        Simulator::Schedule(Seconds(16), [&]() {
+            NS_TEST_EXPECT_MSG_EQ(scheduler.NextInterval(3, 10, 0),
+                                  Seconds(5),
+                                  "No energy left: longest interval");
+        });
+        Simulator::Run();
+        Simulator::Destroy();
+    }
+};
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Neighbor changes and link break detection
+ */
+class NeighborsLinkBreakTest : public TestCase
+{
+  public:
+    NeighborsLinkBreakTest()
+        : TestCase("Neighbor changes and link break latency")
+    {
+    }
+
+    /**
+     * Link break callback
+     * \param neighbor the neighbor
+     * \param latency the time since the neighbor was last heard from
+     */
+    void LinkBreak(Ipv4Address neighbor, Time latency)
+    {
+        m_neighbor = neighbor;
+        m_latency = latency;
+        m_breaks++;
+    }
+
+    void DoRun() override
+    {
+        Neighbors nb(Seconds(1));
+        nb.SetLinkBreakCallback(MakeCallback(&NeighborsLinkBreakTest::LinkBreak, this));
+        Ipv4Address a("1.1.1.1");
+        m_breaks = 0;
+
+        Simulator::Schedule(Seconds(1), &Neighbors::Update, &nb, a, Seconds(2));
+        Simulator::Schedule(Seconds(2), &Neighbors::Update, &nb, a, Seconds(2));
+        Simulator::Schedule(Seconds(2.5), [&]() {
+            NS_TEST_EXPECT_MSG_EQ(nb.GetChangeCount(), 1, "Neighbor added once");
+        });
+        Simulator::Schedule(Seconds(4.5), &Neighbors::Purge, &nb);
+        Simulator::Run();
+
+        NS_TEST_EXPECT_MSG_EQ(m_breaks, 1, "Link break detected");
+        NS_TEST_EXPECT_MSG_EQ(m_neighbor, a, "Neighbor");
+        NS_TEST_EXPECT_MSG_EQ(m_latency, Seconds(2.5), "Since the neighbor was last heard from");
+        NS_TEST_EXPECT_MSG_EQ(nb.GetChangeCount(), 2, "Neighbor added and removed");
+        Simulator::Destroy();
+    }
+
+    Ipv4Address m_neighbor; ///< Neighbor of the last link break
+    Time m_latency;         ///< Latency of the last link break
+    uint32_t m_breaks;      ///< Number of link breaks
+};
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief HELLO messages of two idle neighbors, with and without AdaptiveHello
+ */
+class AdaptiveHelloTest : public TestCase
+{
+  public:
+    AdaptiveHelloTest()
+        : TestCase("Adaptive hello interval between idle neighbors")
+    {
+    }
+
+    /**
+     * HelloCount trace sink
+     * \param oldValue the previous number of hellos
+     * \param newValue the number of hellos
+     */
+    void HelloCount(uint32_t oldValue, uint32_t newValue)
+    {
+        m_hellos = newValue;
+    }
+
+    /**
+     * HelloEnergySaved trace sink
+     * \param oldValue the previous energy saved
+     * \param newValue the energy saved
+     */
+    void HelloEnergySaved(double oldValue, double newValue)
+    {
+        m_saved = newValue;
+    }
+
+    /**
+     * LinkBreakDetected trace sink
+     * \param neighbor the neighbor
+     * \param latency the time since the neighbor was last heard from
+     */
+    void LinkBreak(Ipv4Address neighbor, Time latency)
+    {
+        m_latency = latency;
+        m_breaks++;
+    }
+
+    /**
+     * Run two neighbors for 30 s, then move the second one out of range for 20 s
+     * \param adaptive whether AdaptiveHello is enabled
+     */
+    void Run(bool adaptive)
+    {
+        RngSeedManager::SetSeed(12345);
+        RngSeedManager::SetRun(7);
+        m_hellos = 0;
+        m_saved = 0;
+        m_breaks = 0;
+
+        NodeContainer nodes;
+        nodes.Create(2);
+        MobilityHelper mobility;
+        mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                      "DeltaX",
+                                      DoubleValue(100),
+                                      "GridWidth",
+                                      UintegerValue(2));
+        mobility.Install(nodes);
+
+        WifiMacHelper wifiMac;
+        wifiMac.SetType("ns3::AdhocWifiMac");
+        YansWifiPhyHelper wifiPhy;
+        wifiPhy.DisablePreambleDetectionModel();
+        YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default();
+        wifiPhy.SetChannel(wifiChannel.Create());
+        WifiHelper wifi;
+        wifi.SetStandard(WIFI_STANDARD_80211a);
+        wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                     "DataMode",
+                                     StringValue("OfdmRate6Mbps"));
+        NetDeviceContainer devices = wifi.Install(wifiPhy, wifiMac, nodes);
+
+        AodvHelper aodv;
+        aodv.Set("AdaptiveHello", BooleanValue(adaptive));
+        aodv.Set("MaxHelloInterval", TimeValue(Seconds(5)));
+        InternetStackHelper internetStack;
+        internetStack.SetRoutingHelper(aodv);
+        internetStack.Install(nodes);
+        Ipv4AddressHelper address;
+        address.SetBase("10.1.1.0", "255.255.255.0");
+        address.Assign(devices);
+
+        Ptr<RoutingProtocol> routing = nodes.Get(0)->GetObject<RoutingProtocol>();
+        routing->TraceConnectWithoutContext("HelloCount",
+                                            MakeCallback(&AdaptiveHelloTest::HelloCount, this));
+        routing->TraceConnectWithoutContext(
+            "HelloEnergySaved",
+            MakeCallback(&AdaptiveHelloTest::HelloEnergySaved, this));
+        routing->TraceConnectWithoutContext("LinkBreakDetected",
+                                            MakeCallback(&AdaptiveHelloTest::LinkBreak, this));
+        Ptr<MobilityModel> moving = nodes.Get(1)->GetObject<MobilityModel>();
+        Simulator::Schedule(Seconds(30), [this, moving]() {
+            m_hellosBeforeMove = m_hellos;
+            m_savedBeforeMove = m_saved;
+            m_breaksBeforeMove = m_breaks;
+            moving->SetPosition(Vector(2000, 0, 0));
+        });
+        Simulator::Stop(Seconds(50));
+        Simulator::Run();
+        Simulator::Destroy();
+    }
+
+    void DoRun() override
+    {
+        Run(false);
+        uint32_t baseline = m_hellosBeforeMove;
+        NS_TEST_EXPECT_MSG_GT(baseline, 25, "A hello about every second");
+        NS_TEST_EXPECT_MSG_EQ(m_savedBeforeMove, 0, "Nothing saved without adaptive hellos");
+        NS_TEST_EXPECT_MSG_EQ(m_breaksBeforeMove, 0, "Link up");
+        NS_TEST_EXPECT_MSG_EQ(m_breaks, 1, "Link break detected");
+        // two hellos lost, detected by a purge of the neighbors within a second
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(m_latency, Seconds(3), "Link break latency");
+
+        Run(true);
+        NS_TEST_EXPECT_MSG_LT(m_hellosBeforeMove, baseline / 3, "An idle node sends fewer hellos");
+        NS_TEST_EXPECT_MSG_GT(m_savedBeforeMove,
+                              (baseline / 2) * 0.0075,
+                              "Energy saved on the hellos not sent");
+        NS_TEST_EXPECT_MSG_EQ(m_breaksBeforeMove, 0, "Link kept up by the advertised lifetime");
+        NS_TEST_EXPECT_MSG_EQ(m_breaks, 1, "Link break detected");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(m_latency, Seconds(11), "Link break latency");
+    }
+
+    uint32_t m_hellos;           ///< Hellos sent by the first node
+    double m_saved;              ///< Energy saved by the first node
+    Time m_latency;              ///< Latency of the last link break
+    uint32_t m_breaks;           ///< Number of link breaks
+    uint32_t m_hellosBeforeMove; ///< Hellos sent before the second node moves
+    double m_savedBeforeMove;    ///< Energy saved before the second node moves
+    uint32_t m_breaksBeforeMove; ///< Link breaks before the second node moves
+};
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief AODV hello Test Suite
+ */
+class AodvHelloTestSuite : public TestSuite
+{
+  public:
+    AodvHelloTestSuite()
+        : TestSuite("aodv-hello", Type::UNIT)
+    {
+        AddTestCase(new HelloSchedulerTest, TestCase::Duration::QUICK);
+        AddTestCase(new NeighborsLinkBreakTest, TestCase::Duration::QUICK);
+        AddTestCase(new AdaptiveHelloTest, TestCase::Duration::QUICK);
+    }
+} g_aodvHelloTestSuite; ///< the test suite
+
+} // namespace aodv
+} // namespace ns3
@@ -98,6 +98,90 @@ IdCacheTest::CheckTimeout3()
     NS_TEST_EXPECT_MSG_EQ(cache.GetSize(), 0, "All records expire");
 }
 
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Unit test for id cache with many entries, expiring across turns of the timing wheel
+ */
+class IdCacheWheelTest : public TestCase
+{
+  public:
+    IdCacheWheelTest()
+        : TestCase("Id Cache timing wheel"),
+          cache(MilliSeconds(100))
+    {
+    }
+
+    void DoRun() override;
+
+  private:
+    /**
+     * Add a batch of entries and check that all of them are known
+     * \param batch the batch number
+     */
+    void AddBatch(uint32_t batch);
+    /// Check the cache after the last batch
+    void CheckEnd();
+
+    /// ID cache
+    IdCache cache;
+};
+
+void
+IdCacheWheelTest::DoRun()
+{
+    // 1000 entries every 10 ms with a 100 ms lifetime, for several turns of the wheel
+    for (uint32_t batch = 0; batch < 100; batch++)
+    {
+        Simulator::Schedule(MilliSeconds(10 * batch), &IdCacheWheelTest::AddBatch, this, batch);
+    }
+    Simulator::Schedule(MilliSeconds(2000), &IdCacheWheelTest::CheckEnd, this);
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+void
+IdCacheWheelTest::AddBatch(uint32_t batch)
+{
+    bool added = true;
+    bool known = true;
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        added &= !cache.IsDuplicate(Ipv4Address(i % 50 + 1), batch * 1000 + i);
+    }
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        known &= cache.IsDuplicate(Ipv4Address(i % 50 + 1), batch * 1000 + i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(added, true, "New entries are not duplicates");
+    NS_TEST_EXPECT_MSG_EQ(known, true, "Added entries are duplicates");
+    if (batch >= 10)
+    {
+        // Entries of batch - 10 expire exactly now, the ones before are gone
+        NS_TEST_EXPECT_MSG_EQ(cache.IsDuplicate(Ipv4Address(1), (batch - 10) * 1000),
+                              true,
+                              "Entry expiring now is still known");
+        uint32_t readded = (batch > 50 && batch <= 60) ? 1 : 0;
+        NS_TEST_EXPECT_MSG_EQ(cache.GetSize(), 11000 + readded, "Entries of the last 100 ms");
+    }
+    if (batch == 50)
+    {
+        NS_TEST_EXPECT_MSG_EQ(cache.IsDuplicate(Ipv4Address(1), 39000),
+                              false,
+                              "Expired entry is added again");
+        NS_TEST_EXPECT_MSG_EQ(cache.GetSize(), 11001, "Re-added entry");
+    }
+}
+
+void
+IdCacheWheelTest::CheckEnd()
+{
+    NS_TEST_EXPECT_MSG_EQ(cache.GetSize(), 0, "All records expire");
+    cache.SetLifetime(Seconds(5));
+    NS_TEST_EXPECT_MSG_EQ(cache.IsDuplicate(Ipv4Address("1.2.3.4"), 1), false, "New entry");
+    NS_TEST_EXPECT_MSG_EQ(cache.IsDuplicate(Ipv4Address("1.2.3.4"), 1), true, "Known entry");
+}
+
 /**
  * \ingroup aodv-test
  *
@@ -110,6 +194,7 @@ class IdCacheTestSuite : public TestSuite
         : TestSuite("aodv-routing-id-cache", Type::UNIT)
     {
         AddTestCase(new IdCacheTest, TestCase::Duration::QUICK);
+        AddTestCase(new IdCacheWheelTest, TestCase::Duration::QUICK);
     }
 } g_idCacheTestSuite; ///< the test suite
 
@@ -0,0 +1,128 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+#include "ns3/aodv-rebroadcast-table.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+namespace ns3
+{
+namespace aodv
+{
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Unit test for the pending RREQ rebroadcasts
+ */
+class RebroadcastTableTest : public TestCase
+{
+  public:
+    RebroadcastTableTest()
+        : TestCase("Pending RREQ rebroadcasts"),
+          m_sent(0)
+    {
+    }
+
+    void DoRun() override;
+
+  private:
+    /**
+     * Schedule a rebroadcast of a flood, tracked by the table
+     * \param origin the RREQ originator
+     * \param id the RREQ ID
+     * \param delay the forward delay
+     * \returns the event of the rebroadcast
+     */
+    EventId Schedule(Ipv4Address origin, uint32_t id, Time delay)
+    {
+        return Simulator::Schedule(delay, &RebroadcastTableTest::Send, this, origin, id);
+    }
+
+    /**
+     * Send a rebroadcast
+     * \param origin the RREQ originator
+     * \param id the RREQ ID
+     */
+    void Send(Ipv4Address origin, uint32_t id)
+    {
+        m_table.NotifySent(origin, id);
+        m_sent++;
+    }
+
+    /// Pending rebroadcasts
+    RebroadcastTable m_table;
+    /// Rebroadcasts sent
+    uint32_t m_sent;
+};
+
+void
+RebroadcastTableTest::DoRun()
+{
+    Ipv4Address origin1("10.0.0.1");
+    Ipv4Address origin2("10.0.0.2");
+
+    // Without suppression, the duplicates are counted and nothing is cancelled
+    m_table.Insert(origin1, 1, 0.5, {Schedule(origin1, 1, MilliSeconds(10))});
+    NS_TEST_EXPECT_MSG_EQ(m_table.GetSize(), 1, "Pending");
+    NS_TEST_EXPECT_MSG_EQ(m_table.HearDuplicate(origin1, 1, 0.9), false, "No suppression");
+    NS_TEST_EXPECT_MSG_EQ(m_table.HearDuplicate(origin1, 1, 0.9), false, "No suppression");
+    NS_TEST_EXPECT_MSG_EQ(m_table.HearDuplicate(origin1, 2, 0.9), false, "No such flood");
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_sent, 1, "Rebroadcast sent");
+    NS_TEST_EXPECT_MSG_EQ(m_table.GetSize(), 0, "The flood leaves with its last rebroadcast");
+    NS_TEST_EXPECT_MSG_EQ(m_table.HearDuplicate(origin1, 1, 0.9), false, "Already sent");
+
+    // Counter-based: the third copy, the first one included, cancels both interfaces
+    m_sent = 0;
+    m_table.SetSuppression(SUPPRESSION_COUNTER);
+    m_table.SetCounterThreshold(3);
+    m_table.Insert(origin1,
+                   3,
+                   0,
+                   {Schedule(origin1, 3, MilliSeconds(10)), Schedule(origin1, 3, MilliSeconds(20))});
+    m_table.Insert(origin2, 3, 0, {Schedule(origin2, 3, MilliSeconds(10))});
+    NS_TEST_EXPECT_MSG_EQ(m_table.GetSize(), 2, "IDs are per originator");
+    NS_TEST_EXPECT_MSG_EQ(m_table.HearDuplicate(origin1, 3, 0), false, "Second copy");
+    NS_TEST_EXPECT_MSG_EQ(m_table.HearDuplicate(origin1, 3, 0), true, "Third copy");
+    NS_TEST_EXPECT_MSG_EQ(m_table.GetSize(), 1, "Cancelled flood removed");
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_sent, 1, "Only the other flood is rebroadcast");
+
+    // Score-based: only a copy scoring at least as well cancels
+    m_sent = 0;
+    m_table.SetSuppression(SUPPRESSION_SCORE);
+    m_table.Insert(origin1, 4, 0.6, {Schedule(origin1, 4, MilliSeconds(10))});
+    NS_TEST_EXPECT_MSG_EQ(m_table.HearDuplicate(origin1, 4, 0.3), false, "Worse path");
+    NS_TEST_EXPECT_MSG_EQ(m_table.HearDuplicate(origin1, 4, 0.59), false, "Worse path");
+    NS_TEST_EXPECT_MSG_EQ(m_table.HearDuplicate(origin1, 4, 0.6), true, "As good");
+    m_table.Insert(origin1, 5, 0.6, {Schedule(origin1, 5, MilliSeconds(10))});
+    m_table.Clear();
+    NS_TEST_EXPECT_MSG_EQ(m_table.GetSize(), 0, "Clear");
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_sent, 0, "Clear cancels the pending rebroadcasts");
+
+    m_table.Insert(origin1, 6, 0.6, {});
+    NS_TEST_EXPECT_MSG_EQ(m_table.GetSize(), 0, "Nothing scheduled, nothing tracked");
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Pending RREQ rebroadcasts test suite
+ */
+class RebroadcastTableTestSuite : public TestSuite
+{
+  public:
+    RebroadcastTableTestSuite()
+        : TestSuite("aodv-routing-rebroadcast-table", Type::UNIT)
+    {
+        AddTestCase(new RebroadcastTableTest, TestCase::Duration::QUICK);
+    }
+} g_rebroadcastTableTestSuite; ///< the test suite
+
+} // namespace aodv
+} // namespace ns3
@@ -0,0 +1,362 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+#include "ns3/aodv-helper.h"
+#include "ns3/aodv-id-cache.h"
+#include "ns3/aodv-neighbor.h"
+#include "ns3/aodv-routing-protocol.h"
+#include "ns3/aodv-rtable.h"
+#include "ns3/double.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/ping-helper.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+#include "ns3/yans-wifi-helper.h"
+
+namespace ns3
+{
+namespace aodv
+{
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Snapshot of the RREQ ID cache and of the neighbors, restored later
+ */
+class IdCacheNeighborsSnapshotTest : public TestCase
+{
+  public:
+    IdCacheNeighborsSnapshotTest()
+        : TestCase("Snapshot of the RREQ ID cache and of the neighbors")
+    {
+    }
+
+    void DoRun() override;
+};
+
+void
+IdCacheNeighborsSnapshotTest::DoRun()
+{
+    IdCache cache(Seconds(10));
+    IdCache restoredCache(Seconds(10));
+    Neighbors nb(Seconds(1));
+    Neighbors restoredNb(Seconds(1));
+    Ipv4Address a("1.1.1.1");
+    Ipv4Address b("2.2.2.2");
+    Buffer buffer;
+
+    Simulator::Schedule(Seconds(1), [&]() {
+        cache.IsDuplicate(a, 1);
+        nb.Update(a, Seconds(5));
+    });
+    Simulator::Schedule(Seconds(3), [&]() {
+        cache.IsDuplicate(b, 2);
+        nb.Update(b, Seconds(1));
+    });
+    Simulator::Schedule(Seconds(5), [&]() {
+        // The neighbor b expired at 4 s and is left out
+        uint32_t size = cache.GetSerializedSize() + nb.GetSerializedSize();
+        NS_TEST_EXPECT_MSG_EQ(size, 4 + 2 * 16 + 4 + 18, "Serialized size");
+        buffer.AddAtStart(size);
+        Buffer::Iterator i = buffer.Begin();
+        cache.Serialize(i);
+        nb.Serialize(i);
+        NS_TEST_EXPECT_MSG_EQ(i.GetDistanceFrom(buffer.Begin()), size, "Bytes written");
+    });
+    Simulator::Schedule(Seconds(7), [&]() {
+        // Restored 2 s later: the pairs expire at 13 s and 15 s, the neighbor at 8 s
+        Buffer::Iterator i = buffer.Begin();
+        restoredCache.Deserialize(i);
+        restoredNb.Deserialize(i);
+        NS_TEST_EXPECT_MSG_EQ(i.IsEnd(), true, "Bytes read");
+        NS_TEST_EXPECT_MSG_EQ(restoredCache.GetSize(), 2, "Pairs restored");
+        NS_TEST_EXPECT_MSG_EQ(restoredNb.GetExpireTime(a), Seconds(1), "Neighbor lifetime");
+        NS_TEST_EXPECT_MSG_EQ(restoredNb.IsNeighbor(b), false, "Expired neighbor");
+    });
+    Simulator::Schedule(Seconds(12), [&]() {
+        NS_TEST_EXPECT_MSG_EQ(restoredCache.IsDuplicate(a, 1), true, "Pair restored");
+        NS_TEST_EXPECT_MSG_EQ(restoredCache.IsDuplicate(b, 2), true, "Pair restored");
+        NS_TEST_EXPECT_MSG_EQ(restoredNb.IsNeighbor(a), false, "Neighbor expired");
+    });
+    Simulator::Schedule(Seconds(14), [&]() {
+        NS_TEST_EXPECT_MSG_EQ(restoredCache.IsDuplicate(a, 1), false, "Pair expired");
+        NS_TEST_EXPECT_MSG_EQ(restoredCache.IsDuplicate(b, 2), true, "Pair restored");
+    });
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Snapshot of a routing table, restored later on the same node
+ */
+class RoutingTableSnapshotTest : public TestCase
+{
+  public:
+    RoutingTableSnapshotTest()
+        : TestCase("Snapshot of a routing table")
+    {
+    }
+
+    void DoRun() override;
+};
+
+void
+RoutingTableSnapshotTest::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice>();
+    dev->SetAddress(Mac48Address::Allocate());
+    node->AddDevice(dev);
+    InternetStackHelper internet;
+    internet.Install(node);
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    address.Assign(NetDeviceContainer(dev));
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    Ipv4InterfaceAddress iface = ipv4->GetAddress(1, 0);
+
+    RoutingTable table(Seconds(5));
+    RoutingTable restored(Seconds(5));
+    Ipv4Address dst("10.1.1.9");
+    Ipv4Address nextHop("10.1.1.2");
+    Ipv4Address alternateHop("10.1.1.3");
+    Buffer buffer;
+
+    // Added at the start, as the protocol adds its broadcast routes
+    RoutingTableEntry forever(dev,
+                              iface.GetBroadcast(),
+                              true,
+                              0,
+                              iface,
+                              1,
+                              iface.GetBroadcast(),
+                              Simulator::GetMaximumSimulationTime());
+    table.AddRoute(forever);
+
+    Simulator::Schedule(Seconds(1), [&]() {
+        RoutingTableEntry rt(dev, dst, true, 42, iface, 3, nextHop, Seconds(10));
+        rt.InsertPrecursor(Ipv4Address("10.1.1.4"));
+        rt.m_pathMinEnergy = 0.25;
+        rt.m_pathAvgCongestion = 0.5;
+        rt.m_pathScore = 1.0 / 3;
+        RouteAlternate alternate{dev, iface, alternateHop, 4, Seconds(8), 0.125, 0.75, 0.3};
+        rt.InsertAlternate(alternate, 2);
+        table.AddRoute(rt);
+        // Left out: a route discovery in progress
+        RoutingTableEntry search(dev, Ipv4Address("10.1.1.10"), false, 0, iface, 1, nextHop);
+        search.SetFlag(IN_SEARCH);
+        table.AddRoute(search);
+        // Dropped on restore: the interface is gone
+        RoutingTableEntry gone(dev,
+                               Ipv4Address("10.2.2.9"),
+                               true,
+                               0,
+                               Ipv4InterfaceAddress("10.2.2.1", "255.255.255.0"),
+                               1,
+                               Ipv4Address("10.2.2.9"),
+                               Seconds(10));
+        table.AddRoute(gone);
+    });
+    Simulator::Schedule(Seconds(3), [&]() {
+        uint32_t size = table.GetSerializedSize();
+        NS_TEST_EXPECT_MSG_EQ(size, 4 + 2 * 64 + 4 + 42, "Serialized size");
+        buffer.AddAtStart(size);
+        Buffer::Iterator i = buffer.Begin();
+        table.Serialize(i);
+        NS_TEST_EXPECT_MSG_EQ(i.GetDistanceFrom(buffer.Begin()), size, "Bytes written");
+    });
+    Simulator::Schedule(Seconds(4), [&]() {
+        Buffer::Iterator i = buffer.Begin();
+        restored.Deserialize(i, ipv4);
+        NS_TEST_EXPECT_MSG_EQ(i.IsEnd(), true, "Bytes read");
+
+        RoutingTableEntry rt;
+        NS_TEST_ASSERT_MSG_EQ(restored.LookupValidRoute(dst, rt), true, "Route restored");
+        NS_TEST_EXPECT_MSG_EQ(rt.GetNextHop(), nextHop, "Next hop");
+        NS_TEST_EXPECT_MSG_EQ(rt.GetOutputDevice(), dev, "Output device");
+        NS_TEST_EXPECT_MSG_EQ(rt.GetInterface(), iface, "Interface");
+        NS_TEST_EXPECT_MSG_EQ(rt.GetValidSeqNo(), true, "Valid sequence number");
+        NS_TEST_EXPECT_MSG_EQ(rt.GetSeqNo(), 42, "Sequence number");
+        NS_TEST_EXPECT_MSG_EQ(rt.GetHop(), 3, "Hop count");
+        NS_TEST_EXPECT_MSG_EQ(rt.GetLifeTime(), Seconds(8), "Lifetime relative to the snapshot");
+        NS_TEST_EXPECT_MSG_EQ(rt.LookupPrecursor(Ipv4Address("10.1.1.4")), true, "Precursor");
+        NS_TEST_EXPECT_MSG_EQ(rt.m_pathMinEnergy, 0.25, "Minimum energy of the path");
+        NS_TEST_EXPECT_MSG_EQ(rt.m_pathAvgCongestion, 0.5, "Congestion of the path");
+        NS_TEST_EXPECT_MSG_EQ(rt.m_pathScore, 1.0 / 3, "Score of the path");
+        NS_TEST_ASSERT_MSG_EQ(rt.GetAlternates().size(), 1, "Alternate restored");
+        const RouteAlternate& alternate = rt.GetAlternates().front();
+        NS_TEST_EXPECT_MSG_EQ(alternate.m_nextHop, alternateHop, "Alternate next hop");
+        NS_TEST_EXPECT_MSG_EQ(alternate.m_dev, dev, "Alternate output device");
+        NS_TEST_EXPECT_MSG_EQ(alternate.m_hops, 4, "Alternate hop count");
+        NS_TEST_EXPECT_MSG_EQ(alternate.m_expire, Seconds(9), "Alternate expiration");
+        NS_TEST_EXPECT_MSG_EQ(alternate.m_pathScore, 0.3, "Alternate score");
+
+        NS_TEST_EXPECT_MSG_EQ(restored.LookupRoute(Ipv4Address("10.1.1.10"), rt),
+                              false,
+                              "Route discovery left out");
+        NS_TEST_EXPECT_MSG_EQ(restored.LookupRoute(iface.GetBroadcast(), rt),
+                              false,
+                              "Static route left out");
+        NS_TEST_EXPECT_MSG_EQ(restored.LookupRoute(Ipv4Address("10.2.2.9"), rt),
+                              false,
+                              "Route without interface dropped");
+    });
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Routes found by a first run, saved to a file and used by a second run
+ */
+class AodvHelperStateFileTest : public TestCase
+{
+  public:
+    AodvHelperStateFileTest()
+        : TestCase("AODV state saved to a file and restored")
+    {
+    }
+
+    void DoRun() override;
+
+  private:
+    /**
+     * Run a chain of three nodes, pinging from one end to the other
+     * \param pingAt the time of the first ping
+     * \param pings the number of pings
+     * \param stop the end of the simulation
+     * \param save whether to save the state of the nodes, 1 s before the end
+     * \param restore whether to restore the state of the nodes
+     * \returns the number of RREQs received by the nodes
+     */
+    uint32_t Run(Time pingAt, uint32_t pings, Time stop, bool save, bool restore);
+
+    /**
+     * Ping round-trip time trace sink
+     * \param seq the sequence number of the ping
+     * \param rtt the round-trip time
+     */
+    void Rtt(uint16_t seq, Time rtt)
+    {
+        m_replies++;
+    }
+
+    std::string m_filename; ///< The state file
+    uint32_t m_replies;     ///< Ping replies received
+};
+
+uint32_t
+AodvHelperStateFileTest::Run(Time pingAt, uint32_t pings, Time stop, bool save, bool restore)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    m_replies = 0;
+
+    NodeContainer nodes;
+    nodes.Create(3);
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                  "DeltaX",
+                                  DoubleValue(120),
+                                  "GridWidth",
+                                  UintegerValue(3));
+    mobility.Install(nodes);
+
+    WifiMacHelper wifiMac;
+    wifiMac.SetType("ns3::AdhocWifiMac");
+    YansWifiPhyHelper wifiPhy;
+    wifiPhy.DisablePreambleDetectionModel();
+    YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default();
+    wifiPhy.SetChannel(wifiChannel.Create());
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate6Mbps"));
+    NetDeviceContainer devices = wifi.Install(wifiPhy, wifiMac, nodes);
+
+    AodvHelper aodv;
+    InternetStackHelper internetStack;
+    internetStack.SetRoutingHelper(aodv);
+    internetStack.Install(nodes);
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+    PingHelper ping(interfaces.GetAddress(2));
+    ping.SetAttribute("Count", UintegerValue(pings));
+    ApplicationContainer apps = ping.Install(nodes.Get(0));
+    apps.Start(pingAt);
+    apps.Get(0)->TraceConnectWithoutContext("Rtt",
+                                            MakeCallback(&AodvHelperStateFileTest::Rtt, this));
+
+    if (save)
+    {
+        AodvHelper::SaveStateAt(stop - Seconds(1), nodes, m_filename);
+    }
+    if (restore)
+    {
+        AodvHelper::RestoreState(nodes, m_filename);
+    }
+    Simulator::Stop(stop);
+    Simulator::Run();
+
+    uint32_t rreqs = 0;
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        rreqs += nodes.Get(i)->GetObject<RoutingProtocol>()->GetControlCounters().rreqReceived;
+    }
+    Simulator::Destroy();
+    return rreqs;
+}
+
+void
+AodvHelperStateFileTest::DoRun()
+{
+    m_filename = CreateTempDirFilename("aodv-state.bin");
+
+    // Warm-up run: the route is discovered, and saved while it is in use
+    NS_TEST_EXPECT_MSG_GT(Run(Seconds(1), 3, Seconds(5), true, false), 0, "Route discovered");
+    NS_TEST_EXPECT_MSG_EQ(m_replies, 3, "Pings answered");
+
+    // Without the state, the first ping needs a route discovery
+    NS_TEST_EXPECT_MSG_GT(Run(Seconds(0.5), 1, Seconds(1.5), false, false),
+                          0,
+                          "Route discovered");
+    NS_TEST_EXPECT_MSG_EQ(m_replies, 1, "Ping answered");
+
+    // With it, the route is known from the start
+    NS_TEST_EXPECT_MSG_EQ(Run(Seconds(0.5), 1, Seconds(1.5), false, true), 0, "No discovery");
+    NS_TEST_EXPECT_MSG_EQ(m_replies, 1, "Ping answered");
+}
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief AODV snapshot Test Suite
+ */
+class AodvSnapshotTestSuite : public TestSuite
+{
+  public:
+    AodvSnapshotTestSuite()
+        : TestSuite("aodv-snapshot", Type::UNIT)
+    {
+        AddTestCase(new IdCacheNeighborsSnapshotTest, TestCase::Duration::QUICK);
+        AddTestCase(new RoutingTableSnapshotTest, TestCase::Duration::QUICK);
+        AddTestCase(new AodvHelperStateFileTest, TestCase::Duration::QUICK);
+    }
+} g_aodvSnapshotTestSuite; ///< the test suite
+
+} // namespace aodv
+} // namespace ns3
@@ -9,8 +9,10 @@
 #include "ns3/aodv-packet.h"
 #include "ns3/aodv-rqueue.h"
 #include "ns3/aodv-rtable.h"
+#include "ns3/arp-cache.h"
 #include "ns3/ipv4-route.h"
 #include "ns3/test.h"
+#include "ns3/wifi-mac-header.h"
 
 namespace ns3
 {
@@ -122,6 +124,88 @@ NeighborTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Neighbors expiry by the timing wheel and link failures by MAC address
+ */
+class NeighborWheelTest : public TestCase
+{
+  public:
+    NeighborWheelTest()
+        : TestCase("Neighbor timing wheel"),
+          m_neighbors(Seconds(1))
+    {
+    }
+
+    void DoRun() override
+    {
+        m_neighbors.SetCallback(MakeCallback(&NeighborWheelTest::LinkFailure, this));
+        Ptr<ArpCache> arp = CreateObject<ArpCache>();
+        m_neighbors.AddArpCache(arp);
+        m_neighbors.Update(Ipv4Address("10.0.0.1"), Seconds(2));
+        m_neighbors.Update(Ipv4Address("10.0.0.2"), Seconds(2));
+        m_neighbors.Update(Ipv4Address("10.0.0.3"), Seconds(30));
+
+        // The MAC address of 10.0.0.1 is resolved after it became a neighbor
+        ArpCache::Entry* entry = arp->Add(Ipv4Address("10.0.0.1"));
+        entry->SetMacAddress(Mac48Address("00:00:00:00:00:01"));
+        entry->MarkPermanent();
+        WifiMacHeader hdr;
+        hdr.SetAddr1(Mac48Address("00:00:00:00:00:01"));
+        m_neighbors.GetTxErrorCallback()(hdr);
+        NS_TEST_EXPECT_MSG_EQ(m_neighbors.IsNeighbor(Ipv4Address("10.0.0.1")),
+                              false,
+                              "Closed by the TX error");
+        NS_TEST_EXPECT_MSG_EQ(m_neighbors.IsNeighbor(Ipv4Address("10.0.0.2")),
+                              true,
+                              "Other MAC address");
+        NS_TEST_EXPECT_MSG_EQ(m_failures.size(), 1, "Link failure reported");
+
+        Simulator::Schedule(Seconds(1.5), [this]() {
+            m_neighbors.Update(Ipv4Address("10.0.0.2"), Seconds(2));
+        });
+        Simulator::Schedule(Seconds(3), [this]() {
+            NS_TEST_EXPECT_MSG_EQ(m_neighbors.IsNeighbor(Ipv4Address("10.0.0.2")),
+                                  true,
+                                  "Expiry extended");
+            NS_TEST_EXPECT_MSG_EQ(m_failures.size(), 1, "No new link failure");
+        });
+        Simulator::Schedule(Seconds(4), [this]() {
+            NS_TEST_EXPECT_MSG_EQ(m_neighbors.IsNeighbor(Ipv4Address("10.0.0.2")),
+                                  false,
+                                  "Expired");
+            NS_TEST_EXPECT_MSG_EQ(m_failures.size(), 2, "Link failure reported");
+            NS_TEST_EXPECT_MSG_EQ(m_failures.back(), Ipv4Address("10.0.0.2"), "Expired link");
+        });
+        Simulator::Schedule(Seconds(20), [this]() {
+            NS_TEST_EXPECT_MSG_EQ(m_neighbors.IsNeighbor(Ipv4Address("10.0.0.3")),
+                                  true,
+                                  "Expiry beyond the span of the wheel");
+        });
+        Simulator::Run();
+        // The purge timer stopped with the last neighbor
+        NS_TEST_EXPECT_MSG_EQ(m_failures.size(), 3, "All links expired");
+        NS_TEST_EXPECT_MSG_EQ(m_failures.back(), Ipv4Address("10.0.0.3"), "Expired link");
+        NS_TEST_EXPECT_MSG_EQ((Simulator::Now() < Seconds(32)), true, "Expired in time");
+        m_neighbors.DelArpCache(arp);
+        Simulator::Destroy();
+    }
+
+  private:
+    /**
+     * Link failure handler
+     * \param addr the IPv4 address of the neighbor
+     */
+    void LinkFailure(Ipv4Address addr)
+    {
+        m_failures.push_back(addr);
+    }
+
+    Neighbors m_neighbors;               ///< The neighbors
+    std::vector<Ipv4Address> m_failures; ///< Reported link failures
+};
+
 /**
  * \ingroup aodv-test
  *
@@ -203,7 +287,7 @@ struct RreqHeaderTest : public TestCase
         p->AddHeader(h);
         RreqHeader h2;
         uint32_t bytes = p->RemoveHeader(h2);
-        NS_TEST_EXPECT_MSG_EQ(bytes, 23, "RREP is 23 bytes long");
+        NS_TEST_EXPECT_MSG_EQ(bytes, 31, "RREQ is 23 bytes long plus 8 bytes of EOCW metrics");
         NS_TEST_EXPECT_MSG_EQ(h, h2, "Round trip serialization works");
     }
 };
@@ -260,11 +344,102 @@ struct RrepHeaderTest : public TestCase
         p->AddHeader(h);
         RrepHeader h2;
         uint32_t bytes = p->RemoveHeader(h2);
-        NS_TEST_EXPECT_MSG_EQ(bytes, 19, "RREP is 19 bytes long");
+        NS_TEST_EXPECT_MSG_EQ(bytes, 27, "RREP is 19 bytes long plus 8 bytes of EOCW metrics");
         NS_TEST_EXPECT_MSG_EQ(h, h2, "Round trip serialization works");
     }
 };
 
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Unit test for the encodings of the EOCW path metrics in RREQ and RREP
+ */
+struct EocwMetricEncodingTest : public TestCase
+{
+    EocwMetricEncodingTest()
+        : TestCase("AODV EOCW metric encoding")
+    {
+    }
+
+    void DoRun() override
+    {
+        struct Case
+        {
+            EocwMetricEncoding encoding; ///< encoding
+            uint32_t size;               ///< size of the metrics, in bytes
+            double tolerance;            ///< maximum quantization error
+        };
+
+        for (const auto& c : {Case{EOCW_FLOAT32, 8, 1e-7},
+                              Case{EOCW_FIXED8, 2, 0.5 / 255},
+                              Case{EOCW_FIXED12, 3, 0.5 / 4095}})
+        {
+            RreqHeader rreq(/*flags*/ 0,
+                            /*reserved*/ 0,
+                            /*hopCount*/ 3,
+                            /*requestID*/ 7,
+                            /*dst*/ Ipv4Address("1.2.3.4"),
+                            /*dstSeqNo*/ 40,
+                            /*origin*/ Ipv4Address("4.3.2.1"),
+                            /*originSeqNo*/ 10);
+            rreq.SetGratuitousRrep(true);
+            rreq.SetUnknownSeqno(true);
+            rreq.SetEocwEncoding(c.encoding);
+            rreq.m_pathMinEnergy = 0.3141;
+            rreq.m_pathAvgCongestion = 0.9876;
+            NS_TEST_EXPECT_MSG_EQ(rreq.GetEocwEncoding(), c.encoding, "Encoding is kept");
+            NS_TEST_EXPECT_MSG_EQ(rreq.GetGratuitousRrep(), true, "Flags are not clobbered");
+
+            Ptr<Packet> p = Create<Packet>();
+            p->AddHeader(rreq);
+            RreqHeader rreq2;
+            NS_TEST_EXPECT_MSG_EQ(p->RemoveHeader(rreq2), 23 + c.size, "RREQ size");
+            NS_TEST_EXPECT_MSG_EQ(rreq, rreq2, "Round trip serialization works");
+            NS_TEST_EXPECT_MSG_EQ(rreq2.GetUnknownSeqno(), true, "Flags survive");
+            NS_TEST_EXPECT_MSG_EQ_TOL(rreq2.m_pathMinEnergy, 0.3141, c.tolerance, "Energy");
+            NS_TEST_EXPECT_MSG_EQ_TOL(rreq2.m_pathAvgCongestion, 0.9876, c.tolerance, "Congestion");
+
+            RrepHeader rrep(/*prefixSize*/ 0,
+                            /*hopCount*/ 2,
+                            /*dst*/ Ipv4Address("1.2.3.4"),
+                            /*dstSeqNo*/ 2,
+                            /*origin*/ Ipv4Address("4.3.2.1"),
+                            /*lifetime*/ Seconds(3));
+            rrep.SetAckRequired(true);
+            rrep.SetEocwEncoding(c.encoding);
+            rrep.m_pathMinEnergy = 1.5; // out of range values are clamped by fixed point
+            rrep.m_pathAvgCongestion = 0.0;
+            p = Create<Packet>();
+            p->AddHeader(rrep);
+            RrepHeader rrep2;
+            NS_TEST_EXPECT_MSG_EQ(p->RemoveHeader(rrep2), 19 + c.size, "RREP size");
+            NS_TEST_EXPECT_MSG_EQ(rrep, rrep2, "Round trip serialization works");
+            NS_TEST_EXPECT_MSG_EQ(rrep2.GetAckRequired(), true, "Flags survive");
+            double energy = (c.encoding == EOCW_FLOAT32) ? 1.5 : 1.0;
+            NS_TEST_EXPECT_MSG_EQ_TOL(rrep2.m_pathMinEnergy, energy, c.tolerance, "Energy");
+            NS_TEST_EXPECT_MSG_EQ(rrep2.m_pathAvgCongestion, 0.0, "Congestion");
+
+            rrep.SetHello(Ipv4Address("10.0.0.2"), 9, Seconds(15));
+            NS_TEST_EXPECT_MSG_EQ(rrep.GetEocwEncoding(), c.encoding, "Hello keeps the encoding");
+            NS_TEST_EXPECT_MSG_EQ(rrep.GetAckRequired(), false, "Hello clears the flags");
+        }
+
+        // The 12-bit values are packed most significant bits first
+        RrepHeader rrep;
+        rrep.SetEocwEncoding(EOCW_FIXED12);
+        rrep.m_pathMinEnergy = 0xabc / 4095.0;
+        rrep.m_pathAvgCongestion = 0x123 / 4095.0;
+        Ptr<Packet> p = Create<Packet>();
+        p->AddHeader(rrep);
+        uint8_t buf[22];
+        p->CopyData(buf, sizeof(buf));
+        NS_TEST_EXPECT_MSG_EQ(buf[0], EOCW_FIXED12, "Encoding in the flags byte");
+        NS_TEST_EXPECT_MSG_EQ(buf[19], 0xab, "Byte 0 of the metrics");
+        NS_TEST_EXPECT_MSG_EQ(buf[20], 0xc1, "Byte 1 of the metrics");
+        NS_TEST_EXPECT_MSG_EQ(buf[21], 0x23, "Byte 2 of the metrics");
+    }
+};
+
 /**
  * \ingroup aodv-test
  *
@@ -539,6 +714,109 @@ AodvRqueueTest::CheckTimeout()
     NS_TEST_EXPECT_MSG_EQ(q.GetSize(), 0, "Must be empty now");
 }
 
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Unit test for the per destination buckets of the RequestQueue
+ */
+class AodvRqueueBucketTest : public TestCase
+{
+  public:
+    AodvRqueueBucketTest()
+        : TestCase("Rqueue buckets"),
+          m_queue(4, Seconds(10)),
+          m_dropped(0)
+    {
+    }
+
+    void DoRun() override
+    {
+        // Interleave the packets of two destinations
+        std::vector<Ptr<const Packet>> packets;
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            packets.push_back(Enqueue(i % 2 ? "2.2.2.2" : "1.1.1.1", Seconds(10)));
+        }
+        NS_TEST_EXPECT_MSG_EQ(m_queue.GetSize(), 4, "Full");
+        // The most aged packet, of 1.1.1.1, is dropped
+        packets.push_back(Enqueue("2.2.2.2", Seconds(10)));
+        NS_TEST_EXPECT_MSG_EQ(m_dropped, 1, "Most aged packet dropped");
+        NS_TEST_EXPECT_MSG_EQ(m_queue.GetSize(), 4, "Still full");
+
+        std::vector<QueueEntry> entries;
+        NS_TEST_EXPECT_MSG_EQ(m_queue.DequeueAll(Ipv4Address("2.2.2.2"), entries), 3, "Batch");
+        NS_TEST_EXPECT_MSG_EQ(entries.size(), 3, "Batch");
+        bool fifo = entries.size() == 3 && entries[0].GetPacket() == packets[1] &&
+                    entries[1].GetPacket() == packets[3] && entries[2].GetPacket() == packets[4];
+        NS_TEST_EXPECT_MSG_EQ(fifo, true, "Earliest first");
+        NS_TEST_EXPECT_MSG_EQ(m_queue.Find(Ipv4Address("2.2.2.2")), false, "Flushed");
+        NS_TEST_EXPECT_MSG_EQ(m_queue.DequeueAll(Ipv4Address("2.2.2.2"), entries), 0, "Empty");
+        NS_TEST_EXPECT_MSG_EQ(m_queue.GetSize(), 1, "1.1.1.1 left");
+
+        // Slots are reused, and the entries expire in queue order
+        Simulator::Schedule(Seconds(5), &AodvRqueueBucketTest::Enqueue, this, "3.3.3.3", Seconds(10));
+        Simulator::Schedule(Seconds(11), &AodvRqueueBucketTest::CheckSize, this, 1);
+        Simulator::Schedule(Seconds(16), &AodvRqueueBucketTest::CheckSize, this, 0);
+        Simulator::Run();
+        Simulator::Destroy();
+        NS_TEST_EXPECT_MSG_EQ(m_dropped, 3, "Expired packets dropped");
+    }
+
+  private:
+    /**
+     * Enqueue a new packet
+     * \param dst the destination
+     * \param timeout the queue timeout
+     * \returns the packet
+     */
+    Ptr<const Packet> Enqueue(const char* dst, Time timeout)
+    {
+        Ptr<const Packet> packet = Create<Packet>();
+        Ipv4Header h;
+        h.SetDestination(Ipv4Address(dst));
+        QueueEntry entry(packet,
+                         h,
+                         MakeCallback(&AodvRqueueBucketTest::Unicast, this),
+                         MakeCallback(&AodvRqueueBucketTest::Error, this));
+        m_queue.SetQueueTimeout(timeout);
+        m_queue.Enqueue(entry);
+        return packet;
+    }
+
+    /**
+     * Check the queue size
+     * \param size the expected size
+     */
+    void CheckSize(uint32_t size)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_queue.GetSize(), size, "Size at " << Simulator::Now().As(Time::S));
+    }
+
+    /**
+     * Unicast test function
+     * \param route the IPv4 route
+     * \param packet the packet
+     * \param header the IPv4 header
+     */
+    void Unicast(Ptr<Ipv4Route> route, Ptr<const Packet> packet, const Ipv4Header& header)
+    {
+    }
+
+    /**
+     * Error test function, counting the dropped packets
+     * \param p The packet
+     * \param h The header
+     * \param e the socket error
+     */
+    void Error(Ptr<const Packet> p, const Ipv4Header& h, Socket::SocketErrno e)
+    {
+        m_dropped++;
+    }
+
+    RequestQueue m_queue; ///< Request queue
+    uint32_t m_dropped;   ///< Number of dropped packets
+};
+
 /**
  * \ingroup aodv-test
  *
@@ -719,6 +997,200 @@ struct AodvRtableTest : public TestCase
     }
 };
 
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Unit test for the expiration of routing table entries
+ */
+class AodvRtableExpiryTest : public TestCase
+{
+  public:
+    AodvRtableExpiryTest()
+        : TestCase("Rtable expiry"),
+          m_rtable(Seconds(1))
+    {
+    }
+
+    void DoRun() override
+    {
+        Ipv4InterfaceAddress iface;
+        for (const auto& [dst, lifetime, flag] : {std::tuple{"1.1.1.1", 1, VALID},
+                                                  std::tuple{"2.2.2.2", 3, VALID},
+                                                  std::tuple{"3.3.3.3", 1, IN_SEARCH}})
+        {
+            RoutingTableEntry rt(/*output device*/ nullptr,
+                                 /*dst*/ Ipv4Address(dst),
+                                 /*validSeqNo*/ true,
+                                 /*seqNo*/ 1,
+                                 /*interface*/ iface,
+                                 /*hop*/ 2,
+                                 /*next hop*/ Ipv4Address("10.0.0.1"),
+                                 /*lifetime*/ Seconds(lifetime));
+            rt.SetFlag(flag);
+            m_rtable.AddRoute(rt);
+        }
+        Simulator::Schedule(MilliSeconds(500), &AodvRtableExpiryTest::Extend, this);
+        Simulator::Schedule(MilliSeconds(1500),
+                            &AodvRtableExpiryTest::Check,
+                            this,
+                            "1.1.1.1",
+                            true,
+                            VALID);
+        Simulator::Schedule(MilliSeconds(2000),
+                            &AodvRtableExpiryTest::Check,
+                            this,
+                            "3.3.3.3",
+                            true,
+                            IN_SEARCH);
+        Simulator::Schedule(MilliSeconds(2600),
+                            &AodvRtableExpiryTest::Check,
+                            this,
+                            "1.1.1.1",
+                            true,
+                            INVALID);
+        Simulator::Schedule(MilliSeconds(2600),
+                            &AodvRtableExpiryTest::Check,
+                            this,
+                            "2.2.2.2",
+                            true,
+                            VALID);
+        Simulator::Schedule(MilliSeconds(3700),
+                            &AodvRtableExpiryTest::Check,
+                            this,
+                            "1.1.1.1",
+                            false,
+                            INVALID);
+        Simulator::Schedule(MilliSeconds(3700),
+                            &AodvRtableExpiryTest::Check,
+                            this,
+                            "2.2.2.2",
+                            true,
+                            INVALID);
+        Simulator::Schedule(MilliSeconds(5000),
+                            &AodvRtableExpiryTest::Check,
+                            this,
+                            "2.2.2.2",
+                            false,
+                            INVALID);
+        Simulator::Run();
+        Simulator::Destroy();
+    }
+
+  private:
+    /// Extend the lifetime of 1.1.1.1 and give it a precursor
+    void Extend()
+    {
+        RoutingTableEntry rt;
+        NS_TEST_EXPECT_MSG_EQ(m_rtable.LookupRoute(Ipv4Address("1.1.1.1"), rt), true, "Found");
+        rt.SetLifeTime(Seconds(2));
+        rt.InsertPrecursor(Ipv4Address("10.0.0.9"));
+        NS_TEST_EXPECT_MSG_EQ(m_rtable.Update(rt), true, "Updated");
+    }
+
+    /**
+     * Check an entry
+     * \param dst the destination
+     * \param found whether the entry is expected in the table
+     * \param flag the expected flag of the entry
+     */
+    void Check(const char* dst, bool found, RouteFlags flag)
+    {
+        RoutingTableEntry rt;
+        NS_TEST_EXPECT_MSG_EQ(m_rtable.LookupRoute(Ipv4Address(dst), rt),
+                              found,
+                              "Presence of " << dst << " at " << Simulator::Now().As(Time::S));
+        if (found)
+        {
+            NS_TEST_EXPECT_MSG_EQ(rt.GetFlag(),
+                                  flag,
+                                  "Flag of " << dst << " at " << Simulator::Now().As(Time::S));
+            bool noPrecursor = (std::string(dst) != "1.1.1.1");
+            NS_TEST_EXPECT_MSG_EQ(rt.IsPrecursorListEmpty(), noPrecursor, "Precursors are kept");
+        }
+    }
+
+    /// Routing table
+    RoutingTable m_rtable;
+};
+
+/**
+ * \ingroup aodv-test
+ *
+ * \brief Alternate paths of the routing table entries
+ */
+class AodvRtableAlternateTest : public TestCase
+{
+  public:
+    AodvRtableAlternateTest()
+        : TestCase("Rtable alternate paths")
+    {
+    }
+
+    void DoRun() override
+    {
+        RoutingTable rtable(Seconds(2));
+        Ipv4InterfaceAddress iface;
+        RoutingTableEntry rt(/*output device*/ nullptr,
+                             /*dst*/ Ipv4Address("1.1.1.1"),
+                             /*validSeqNo*/ true,
+                             /*seqNo*/ 5,
+                             /*interface*/ iface,
+                             /*hop*/ 3,
+                             /*next hop*/ Ipv4Address("10.0.0.1"),
+                             /*lifetime*/ Seconds(10));
+        auto alternate = [&iface](const char* nextHop, uint16_t hops, double score, Time expire) {
+            return RouteAlternate{nullptr, iface, Ipv4Address(nextHop), hops, expire, 0.5, 0.5, score};
+        };
+        NS_TEST_EXPECT_MSG_EQ(rt.InsertAlternate(alternate("10.0.0.1", 3, 0.9, Seconds(10)), 2),
+                              false,
+                              "Same next hop as the route");
+        NS_TEST_EXPECT_MSG_EQ(rt.InsertAlternate(alternate("10.0.0.2", 4, 0.6, Seconds(10)), 2),
+                              true,
+                              "Inserted");
+        NS_TEST_EXPECT_MSG_EQ(rt.InsertAlternate(alternate("10.0.0.2", 2, 0.8, Seconds(10)), 2),
+                              false,
+                              "Same next hop as the other alternate");
+        NS_TEST_EXPECT_MSG_EQ(rt.InsertAlternate(alternate("10.0.0.3", 5, 0.4, Seconds(10)), 2),
+                              true,
+                              "Inserted");
+        NS_TEST_EXPECT_MSG_EQ(rt.InsertAlternate(alternate("10.0.0.4", 3, 0.3, Seconds(10)), 2),
+                              false,
+                              "Worse than a full list");
+        NS_TEST_EXPECT_MSG_EQ(rt.InsertAlternate(alternate("10.0.0.5", 4, 0.7, Seconds(7)), 2),
+                              true,
+                              "Better than the worst alternate");
+        NS_TEST_EXPECT_MSG_EQ(rt.GetAlternates().size(), 2, "Worst alternate dropped");
+        NS_TEST_EXPECT_MSG_EQ(rt.GetAlternates().front().m_nextHop,
+                              Ipv4Address("10.0.0.5"),
+                              "Best first");
+        NS_TEST_EXPECT_MSG_EQ(rtable.AddRoute(rt), true, "Route added");
+
+        // The link to the next hop of the route breaks
+        std::map<Ipv4Address, uint32_t> unreachable;
+        std::vector<Ipv4Address> switched;
+        rtable.GetListOfDestinationWithNextHop(Ipv4Address("10.0.0.1"), unreachable);
+        NS_TEST_EXPECT_MSG_EQ(unreachable.size(), 1, "Route through 10.0.0.1");
+        rtable.SwitchToAlternates(Ipv4Address("10.0.0.1"), unreachable, switched);
+        NS_TEST_EXPECT_MSG_EQ(unreachable.empty(), true, "Route switched");
+        NS_TEST_EXPECT_MSG_EQ(switched.size(), 1, "Route switched");
+        NS_TEST_EXPECT_MSG_EQ(rtable.LookupValidRoute(Ipv4Address("1.1.1.1"), rt), true, "Valid");
+        NS_TEST_EXPECT_MSG_EQ(rt.GetNextHop(), Ipv4Address("10.0.0.5"), "Best alternate");
+        NS_TEST_EXPECT_MSG_EQ(rt.GetHop(), 4, "Hop count of the alternate");
+        NS_TEST_EXPECT_MSG_EQ(rt.GetLifeTime(), Seconds(7), "Lifetime of the alternate");
+        NS_TEST_EXPECT_MSG_EQ(rt.GetSeqNo(), 5, "Sequence number kept");
+        NS_TEST_EXPECT_MSG_EQ(rt.GetAlternates().size(), 1, "One alternate left");
+
+        // An expired alternate is skipped, then the route has none left
+        rt.DeleteAlternates(Ipv4Address("10.0.0.2"));
+        rt.InsertAlternate(alternate("10.0.0.6", 2, 0.9, Seconds(-1)), 2);
+        NS_TEST_EXPECT_MSG_EQ(rt.SwitchToAlternate(), false, "Alternate expired");
+        rt.InsertAlternate(alternate("10.0.0.6", 2, 0.9, Seconds(10)), 2);
+        rt.Invalidate(Seconds(2));
+        NS_TEST_EXPECT_MSG_EQ(rt.GetAlternates().empty(), true, "Dropped with the route");
+        Simulator::Destroy();
+    }
+};
+
 /**
  * \ingroup aodv-test
  *
@@ -731,15 +1203,20 @@ class AodvTestSuite : public TestSuite
         : TestSuite("routing-aodv", Type::UNIT)
     {
         AddTestCase(new NeighborTest, TestCase::Duration::QUICK);
+        AddTestCase(new NeighborWheelTest, TestCase::Duration::QUICK);
         AddTestCase(new TypeHeaderTest, TestCase::Duration::QUICK);
         AddTestCase(new RreqHeaderTest, TestCase::Duration::QUICK);
         AddTestCase(new RrepHeaderTest, TestCase::Duration::QUICK);
+        AddTestCase(new EocwMetricEncodingTest, TestCase::Duration::QUICK);
         AddTestCase(new RrepAckHeaderTest, TestCase::Duration::QUICK);
         AddTestCase(new RerrHeaderTest, TestCase::Duration::QUICK);
         AddTestCase(new QueueEntryTest, TestCase::Duration::QUICK);
         AddTestCase(new AodvRqueueTest, TestCase::Duration::QUICK);
+        AddTestCase(new AodvRqueueBucketTest, TestCase::Duration::QUICK);
         AddTestCase(new AodvRtableEntryTest, TestCase::Duration::QUICK);
         AddTestCase(new AodvRtableTest, TestCase::Duration::QUICK);
+        AddTestCase(new AodvRtableExpiryTest, TestCase::Duration::QUICK);
+        AddTestCase(new AodvRtableAlternateTest, TestCase::Duration::QUICK);
     }
 } g_aodvTestSuite; ///< the test suite
 
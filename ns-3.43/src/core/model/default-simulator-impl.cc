@@ -9,6 +9,7 @@
 #include "default-simulator-impl.h"
 
 #include "assert.h"
+#include "fan-out-event.h"
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
@@ -261,6 +262,31 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
     }
 }
 
+void
+DefaultSimulatorImpl::ScheduleFanOut(const Ptr<FanOutEvent>& event)
+{
+    NS_ASSERT_MSG(m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::ScheduleFanOut Thread-unsafe invocation!");
+
+    if (!event->IsStarted())
+    {
+        if (event->GetN() == 0)
+        {
+            return;
+        }
+        // the targets take the uids they would have if each of them was scheduled as an
+        // event of its own, so that they run in the same order
+        event->Start(this, m_currentTs, m_uid);
+        m_uid += event->GetN();
+    }
+    // a single entry of the record is in the event list, for its next target
+    Scheduler::Event ev;
+    ev.impl = GetPointer(event);
+    ev.key = event->GetNextKey();
+    m_unscheduledEvents++;
+    m_events->Insert(ev);
+}
+
 EventId
 DefaultSimulatorImpl::ScheduleNow(EventImpl* event)
 {
@@ -53,6 +53,7 @@ class DefaultSimulatorImpl : public SimulatorImpl
     EventId Stop(const Time& delay) override;
     EventId Schedule(const Time& delay, EventImpl* event) override;
     void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    void ScheduleFanOut(const Ptr<FanOutEvent>& event) override;
     EventId ScheduleNow(EventImpl* event) override;
     EventId ScheduleDestroy(EventImpl* event) override;
     void Remove(const EventId& id) override;
@@ -8,8 +8,14 @@
 
 #include "event-impl.h"
 
+#include "boolean.h"
+#include "global-value.h"
 #include "log.h"
 
+#include <mutex>
+#include <new>
+#include <vector>
+
 /**
  * \file
  * \ingroup events
@@ -21,6 +27,156 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("EventImpl");
 
+/**
+ * \ingroup events
+ * \anchor GlobalValueEventPoolEnabled
+ * Whether the events are allocated from the slabs and free lists of the
+ * threads, rather than by the system allocator.
+ *
+ * Read once, when the first event is allocated.
+ */
+static GlobalValue g_eventPoolEnabled =
+    GlobalValue("EventPoolEnabled",
+                "Allocate the events from per-thread slabs and size-class free lists",
+                BooleanValue(true),
+                MakeBooleanChecker());
+
+namespace
+{
+
+/// Granularity of the size classes of the events, in bytes
+constexpr std::size_t EVENT_SIZE_STEP = 16;
+/// Number of size classes: the larger events are allocated by the system allocator
+constexpr std::size_t EVENT_SIZE_CLASSES = 16;
+/// Number of events carved from a slab
+constexpr std::size_t EVENTS_PER_SLAB = 64;
+
+/// A free event, in the free list of its size class
+struct FreeEvent
+{
+    FreeEvent* next; //!< Next free event of the size class
+};
+
+/// The slabs and free lists of the events of a thread
+struct EventPool
+{
+    FreeEvent* freeLists[EVENT_SIZE_CLASSES]{}; //!< Free events, by size class
+    std::vector<void*> slabs;                   //!< Slabs allocated
+    EventImpl::AllocationStats stats;           //!< Counters of the thread
+    EventPool* next{nullptr};                   //!< Pool of another thread
+};
+
+// An event may be freed by another thread than the one which allocated it, in
+// which case it joins the free lists of the thread which frees it: the pools
+// hence live until the end of the program, when their slabs are released, once
+// all the events are freed. The events still referenced by static variables
+// are freed during the destruction of these variables, possibly after the
+// end of the program was signalled: the pools are then released by the last
+// of these deallocations. The state below is trivially destructible, so as to
+// outlive the static variables of the other files.
+
+/// Mutex of the list of the pools
+std::mutex g_eventPoolsMutex;
+/// Pools of all the threads, linked through EventPool::next
+EventPool* g_eventPools = nullptr;
+/// Whether the end of the program was signalled
+bool g_eventPoolsClosing = false;
+/// Whether the pools were released
+bool g_eventPoolsReleased = false;
+/// Pool of the calling thread
+thread_local EventPool* t_eventPool = nullptr;
+
+/**
+ * Release the pools if no event allocated from them is alive.
+ */
+void
+ReleaseEventPools()
+{
+    std::lock_guard lock(g_eventPoolsMutex);
+    uint64_t alive = 0;
+    for (EventPool* pool = g_eventPools; pool != nullptr; pool = pool->next)
+    {
+        alive += pool->stats.allocations - pool->stats.deallocations;
+    }
+    if (alive != 0)
+    {
+        return;
+    }
+    while (g_eventPools != nullptr)
+    {
+        EventPool* pool = g_eventPools;
+        g_eventPools = pool->next;
+        for (auto slab : pool->slabs)
+        {
+            ::operator delete(slab);
+        }
+        delete pool;
+    }
+    g_eventPoolsReleased = true;
+    t_eventPool = nullptr;
+}
+
+/// Signals the end of the program to the pools, on its destruction
+struct EventPoolsCloser
+{
+    ~EventPoolsCloser()
+    {
+        g_eventPoolsClosing = true;
+        ReleaseEventPools();
+    }
+};
+
+/// Static variable signalling the end of the program
+EventPoolsCloser g_eventPoolsCloser;
+
+/**
+ * \returns the pool of the calling thread, or nullptr once the pools were
+ * released
+ */
+EventPool*
+GetEventPool()
+{
+    if (t_eventPool == nullptr)
+    {
+        std::lock_guard lock(g_eventPoolsMutex);
+        if (g_eventPoolsReleased)
+        {
+            return nullptr;
+        }
+        t_eventPool = new EventPool;
+        t_eventPool->next = g_eventPools;
+        g_eventPools = t_eventPool;
+    }
+    return t_eventPool;
+}
+
+/**
+ * \returns whether the events are allocated from the pools, latched on the
+ * first call so that the events are always freed the way they were allocated
+ */
+bool
+IsEventPoolEnabled()
+{
+    static const bool enabled = [] {
+        BooleanValue value;
+        g_eventPoolEnabled.GetValue(value);
+        return value.Get();
+    }();
+    return enabled;
+}
+
+/**
+ * \param [in] size The size of an event.
+ * \returns the size class of the event
+ */
+inline std::size_t
+GetSizeClass(std::size_t size)
+{
+    return (size - 1) / EVENT_SIZE_STEP;
+}
+
+} // namespace
+
 EventImpl::~EventImpl()
 {
     NS_LOG_FUNCTION(this);
@@ -56,4 +212,79 @@ EventImpl::IsCancelled()
     return m_cancel;
 }
 
+// Note: logging in the allocation functions is avoided, since they are called
+// for every event
+void*
+EventImpl::operator new(std::size_t size)
+{
+    std::size_t sizeClass = GetSizeClass(size);
+    EventPool* pool = GetEventPool();
+    if (pool == nullptr)
+    {
+        return ::operator new(size);
+    }
+    pool->stats.allocations++;
+    if (sizeClass >= EVENT_SIZE_CLASSES || !IsEventPoolEnabled())
+    {
+        pool->stats.systemAllocations++;
+        return ::operator new(size);
+    }
+    FreeEvent* event = pool->freeLists[sizeClass];
+    if (event == nullptr)
+    {
+        // carve a new slab into free events
+        std::size_t blockSize = (sizeClass + 1) * EVENT_SIZE_STEP;
+        auto slab = static_cast<char*>(::operator new(blockSize * EVENTS_PER_SLAB));
+        pool->slabs.push_back(slab);
+        pool->stats.systemAllocations++;
+        for (std::size_t i = EVENTS_PER_SLAB; i > 0; i--)
+        {
+            auto block = reinterpret_cast<FreeEvent*>(slab + (i - 1) * blockSize);
+            block->next = event;
+            event = block;
+        }
+    }
+    else
+    {
+        pool->stats.recycled++;
+    }
+    pool->freeLists[sizeClass] = event->next;
+    return event;
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size)
+{
+    std::size_t sizeClass = GetSizeClass(size);
+    EventPool* pool = GetEventPool();
+    if (pool == nullptr)
+    {
+        // the pools were released, once all the events allocated from them were freed
+        ::operator delete(p);
+        return;
+    }
+    pool->stats.deallocations++;
+    if (sizeClass >= EVENT_SIZE_CLASSES || !IsEventPoolEnabled())
+    {
+        ::operator delete(p);
+    }
+    else
+    {
+        auto event = static_cast<FreeEvent*>(p);
+        event->next = pool->freeLists[sizeClass];
+        pool->freeLists[sizeClass] = event;
+    }
+    if (g_eventPoolsClosing)
+    {
+        ReleaseEventPools();
+    }
+}
+
+EventImpl::AllocationStats
+EventImpl::GetAllocationStats()
+{
+    EventPool* pool = GetEventPool();
+    return pool != nullptr ? pool->stats : AllocationStats();
+}
+
 } // namespace ns3
@@ -10,6 +10,7 @@
 
 #include "simple-ref-count.h"
 
+#include <cstddef>
 #include <stdint.h>
 
 /**
@@ -30,10 +31,26 @@ namespace ns3
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * The events are allocated from slabs kept by each thread, with a free
+ * list per size class, unless the \ref GlobalValueEventPoolEnabled
+ * "EventPoolEnabled" GlobalValue is false. Since the MakeEvent() functions
+ * bind the arguments of the event within the event, most events of a
+ * simulation have one of a few sizes, and are recycled from the free lists
+ * of their size once the simulation reached its steady state.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
   public:
+    /** Counters of the allocations of the events by a thread. */
+    struct AllocationStats
+    {
+        uint64_t allocations{0};       //!< Events allocated
+        uint64_t deallocations{0};     //!< Events deallocated
+        uint64_t recycled{0};          //!< Events allocated from a free list
+        uint64_t systemAllocations{0}; //!< Slabs and events allocated by the system allocator
+    };
+
     /** Default constructor. */
     EventImpl();
     /** Destructor. */
@@ -56,6 +73,25 @@ class EventImpl : public SimpleRefCount<EventImpl>
      */
     bool IsCancelled();
 
+    /**
+     * Allocate an event, from the free list of its size class.
+     *
+     * \param [in] size The size of the event.
+     * \returns The memory of the event.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Return an event to the free list of its size class.
+     *
+     * \param [in] p The memory of the event.
+     * \param [in] size The size of the event.
+     */
+    static void operator delete(void* p, std::size_t size);
+    /**
+     * \returns the counters of the allocations of the events by the calling thread
+     */
+    static AllocationStats GetAllocationStats();
+
   protected:
     /**
      * Implementation for Invoke().
@@ -0,0 +1,125 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "fan-out-event.h"
+
+#include "assert.h"
+#include "log.h"
+#include "simulator-impl.h"
+
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::FanOutEvent implementation.
+ */
+
+namespace ns3
+{
+
+// Note: logging in this file is avoided, as in DefaultSimulatorImpl, since its functions are
+// called for every target of every event
+NS_LOG_COMPONENT_DEFINE("FanOutEvent");
+
+FanOutEvent::FanOutEvent()
+    : m_next(0),
+      m_uid(0),
+      m_simulator(nullptr)
+{
+}
+
+FanOutEvent::~FanOutEvent()
+{
+}
+
+uint32_t
+FanOutEvent::GetN() const
+{
+    return m_targets.size();
+}
+
+uint32_t
+FanOutEvent::GetContext(uint32_t i) const
+{
+    NS_ASSERT(i < m_targets.size());
+    return m_targets[i].context;
+}
+
+Time
+FanOutEvent::GetDelay(uint32_t i) const
+{
+    NS_ASSERT(i < m_targets.size() && !IsStarted());
+    return TimeStep(m_targets[i].ts);
+}
+
+void
+FanOutEvent::AddTarget(uint32_t context, const Time& delay)
+{
+    NS_ASSERT_MSG(!IsStarted(), "Target added to a fan-out event already scheduled");
+    NS_ASSERT_MSG(delay.IsPositive(), "Negative delay");
+    m_targets.push_back({delay.GetTimeStep(), context});
+}
+
+void
+FanOutEvent::InvokeTarget(uint32_t i)
+{
+    if (!IsCancelled())
+    {
+        DoInvoke(i);
+    }
+}
+
+void
+FanOutEvent::Start(SimulatorImpl* simulator, uint64_t now, uint32_t uid)
+{
+    NS_ASSERT(!IsStarted() && !m_targets.empty());
+    m_simulator = simulator;
+    m_uid = uid;
+    m_order.resize(m_targets.size());
+    for (uint32_t i = 0; i < m_targets.size(); i++)
+    {
+        m_targets[i].ts += now;
+        m_order[i] = i;
+    }
+    // the targets with the same time step run in the order of their uids, i.e., in the
+    // order they were added
+    std::stable_sort(m_order.begin(), m_order.end(), [this](uint32_t i, uint32_t j) {
+        return m_targets[i].ts < m_targets[j].ts;
+    });
+}
+
+bool
+FanOutEvent::IsStarted() const
+{
+    return m_simulator != nullptr;
+}
+
+Scheduler::EventKey
+FanOutEvent::GetNextKey() const
+{
+    NS_ASSERT(IsStarted() && m_next < m_order.size());
+    uint32_t i = m_order[m_next];
+    Scheduler::EventKey key;
+    key.m_ts = m_targets[i].ts;
+    key.m_uid = m_uid + i;
+    key.m_context = m_targets[i].context;
+    return key;
+}
+
+void
+FanOutEvent::Notify()
+{
+    NS_ASSERT(IsStarted());
+    DoInvoke(m_order[m_next]);
+    m_next++;
+    if (m_next < m_order.size())
+    {
+        m_simulator->ScheduleFanOut(this);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,212 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+#ifndef FAN_OUT_EVENT_H
+#define FAN_OUT_EVENT_H
+
+#include "event-impl.h"
+#include "make-event.h"
+#include "nstime.h"
+#include "ptr.h"
+#include "scheduler.h"
+
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::FanOutEvent and ns3::FanOutEventImpl declarations, and ns3::MakeFanOutEvent definitions.
+ */
+
+namespace ns3
+{
+
+class SimulatorImpl;
+
+/**
+ * \ingroup events
+ * \brief An event delivered to several targets, each with its own context and delay.
+ *
+ * A broadcast over a channel schedules one reception event per receiver, each of which is
+ * allocated and inserted in the event list on its own. A FanOutEvent rather gathers the
+ * targets of the broadcast in one record, scheduled once by Simulator::ScheduleFanOut: the
+ * simulator keeps a single entry of the record in its event list, for the earliest target not
+ * run yet, and inserts it again for the next target once a target ran.
+ *
+ * The targets run in the same order, with the same contexts, as if each of them had been
+ * scheduled by Simulator::ScheduleWithContext, in the order they were added to the record.
+ * Each target counts as an event in Simulator::GetEventCount. Cancelling the record cancels
+ * the targets which did not run yet.
+ *
+ * The simulators which do not expand the record lazily schedule each target as an event of
+ * its own, see SimulatorImpl::ScheduleFanOut.
+ */
+class FanOutEvent : public EventImpl
+{
+  public:
+    FanOutEvent();
+    ~FanOutEvent() override;
+
+    /**
+     * \returns the number of targets
+     */
+    uint32_t GetN() const;
+    /**
+     * \param i the index of a target, in the order the targets were added
+     * \returns the context of the target
+     */
+    uint32_t GetContext(uint32_t i) const;
+    /**
+     * \param i the index of a target, in the order the targets were added
+     * \returns the delay until the target runs, relative to when the record was scheduled
+     */
+    Time GetDelay(uint32_t i) const;
+    /**
+     * Run a target, unless the record was cancelled.
+     *
+     * Used by the simulators which schedule each target as an event of its own.
+     *
+     * \param i the index of the target, in the order the targets were added
+     */
+    void InvokeTarget(uint32_t i);
+
+    /**
+     * Start the lazy expansion of the record, by the simulator which schedules it.
+     *
+     * \param simulator the simulator, which the record schedules itself to again through
+     *        SimulatorImpl::ScheduleFanOut until all the targets ran
+     * \param now the current time step of the simulator
+     * \param uid the event uid of the first target, the next targets taking the uids which
+     *        follow it, in the order they were added
+     */
+    void Start(SimulatorImpl* simulator, uint64_t now, uint32_t uid);
+    /**
+     * \returns true once the simulator started the expansion of the record
+     */
+    bool IsStarted() const;
+    /**
+     * \returns the key of the next target to run, once started
+     */
+    Scheduler::EventKey GetNextKey() const;
+
+  protected:
+    /**
+     * Add a target.
+     *
+     * \param context the context of the target
+     * \param delay the delay until the target runs
+     */
+    void AddTarget(uint32_t context, const Time& delay);
+
+  private:
+    /**
+     * Run a target.
+     *
+     * \param i the index of the target, in the order the targets were added
+     */
+    virtual void DoInvoke(uint32_t i) = 0;
+    void Notify() override;
+
+    /// A target of the event
+    struct Target
+    {
+        int64_t ts;       //!< Delay of the target, then time step at which it runs once started
+        uint32_t context; //!< Context of the target
+    };
+
+    std::vector<Target> m_targets; //!< Targets, in the order they were added
+    std::vector<uint32_t> m_order; //!< Indices of the targets, in the order they run
+    uint32_t m_next;               //!< Position in m_order of the next target to run
+    uint32_t m_uid;                //!< Event uid of the first target
+    SimulatorImpl* m_simulator;    //!< Simulator expanding the record, once started
+};
+
+/**
+ * \ingroup events
+ * \brief A FanOutEvent calling the same function for each target, with the arguments of the
+ * target.
+ *
+ * \tparam Ts \deduced The argument types of the function.
+ */
+template <typename... Ts>
+class FanOutEventImpl : public FanOutEvent
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] f The function called for each target.
+     */
+    FanOutEventImpl(std::function<void(Ts...)> f)
+        : m_function(std::move(f))
+    {
+    }
+
+    /**
+     * Add a target.
+     *
+     * \tparam Us \deduced The types of the arguments.
+     * \param [in] context The context of the target.
+     * \param [in] delay The delay until the target runs.
+     * \param [in] args The arguments the function is called with for the target.
+     */
+    template <typename... Us>
+    void Add(uint32_t context, const Time& delay, Us&&... args)
+    {
+        AddTarget(context, delay);
+        m_args.emplace_back(std::forward<Us>(args)...);
+    }
+
+  private:
+    void DoInvoke(uint32_t i) override
+    {
+        std::apply(m_function, m_args[i]);
+    }
+
+    std::function<void(Ts...)> m_function;                      //!< Function called
+    std::vector<std::tuple<std::remove_cvref_t<Ts>...>> m_args; //!< Arguments of the targets
+};
+
+/**
+ * \ingroup events
+ * Make a FanOutEvent calling a function for each of its targets.
+ *
+ * \tparam Ts \deduced Formal function argument types.
+ * \param [in] f The function.
+ * \returns The event, to which the targets are added.
+ */
+template <typename... Ts>
+Ptr<FanOutEventImpl<Ts...>>
+MakeFanOutEvent(void (*f)(Ts...))
+{
+    return Create<FanOutEventImpl<Ts...>>(f);
+}
+
+/**
+ * \ingroup events
+ * Make a FanOutEvent calling a class method for each of its targets.
+ *
+ * \tparam C \deduced The class.
+ * \tparam OBJ \deduced The class type of the object, or a pointer to it.
+ * \tparam Ts \deduced Formal method argument types.
+ * \param [in] f The class method.
+ * \param [in] obj The object.
+ * \returns The event, to which the targets are added.
+ */
+template <typename C, typename OBJ, typename... Ts>
+Ptr<FanOutEventImpl<Ts...>>
+MakeFanOutEvent(void (C::*f)(Ts...), OBJ obj)
+{
+    return Create<FanOutEventImpl<Ts...>>([f, obj](Ts... args) {
+        (internal::EventMemberImplObjTraits<OBJ>::GetReference(obj).*f)(args...);
+    });
+}
+
+} // namespace ns3
+
+#endif /* FAN_OUT_EVENT_H */
@@ -0,0 +1,293 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "ladder-scheduler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(LadderScheduler);
+
+TypeId
+LadderScheduler::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::LadderScheduler")
+                            .SetParent<Scheduler>()
+                            .SetGroupName("Core")
+                            .AddConstructor<LadderScheduler>();
+    return tid;
+}
+
+LadderScheduler::LadderScheduler()
+    : m_topStart(0),
+      m_topMin(std::numeric_limits<uint64_t>::max()),
+      m_topMax(0),
+      m_nRungs(0),
+      m_bottomHead(0),
+      m_count(0)
+{
+    NS_LOG_FUNCTION(this);
+    // the rungs are never reallocated, so that a bucket can be spread over a new rung
+    m_rungs.reserve(MAX_RUNGS);
+}
+
+LadderScheduler::~LadderScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint64_t
+LadderScheduler::Rung::GetCurrentStart() const
+{
+    return start + current * width;
+}
+
+void
+LadderScheduler::Insert(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    m_count++;
+    uint64_t ts = ev.key.m_ts;
+    if (ts >= m_topStart)
+    {
+        m_top.push_back(ev);
+        m_topMin = std::min(m_topMin, ts);
+        m_topMax = std::max(m_topMax, ts);
+    }
+    else
+    {
+        // the coarsest rung whose current bucket starts before the event
+        std::size_t i = 0;
+        while (i < m_nRungs && ts < m_rungs[i].GetCurrentStart())
+        {
+            i++;
+        }
+        if (i < m_nRungs)
+        {
+            Rung& rung = m_rungs[i];
+            rung.buckets[(ts - rung.start) / rung.width].push_back(ev);
+            rung.count++;
+        }
+        else
+        {
+            InsertBottom(ev);
+        }
+    }
+    if (m_bottomHead == m_bottom.size())
+    {
+        FillBottom();
+    }
+}
+
+bool
+LadderScheduler::IsEmpty() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_count == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    return m_bottom[m_bottomHead];
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    Event ev = m_bottom[m_bottomHead];
+    m_bottomHead++;
+    m_count--;
+    if (m_bottomHead == m_bottom.size())
+    {
+        FillBottom();
+    }
+    else if (m_bottomHead >= THRESHOLD && 2 * m_bottomHead >= m_bottom.size())
+    {
+        // the events keep being inserted in the Bottom: drop the events dequeued
+        m_bottom.erase(m_bottom.begin(), m_bottom.begin() + m_bottomHead);
+        m_bottomHead = 0;
+    }
+    NS_LOG_DEBUG("dequeued " << ev.key.m_ts << " uid=" << ev.key.m_uid);
+    return ev;
+}
+
+void
+LadderScheduler::Remove(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << &ev);
+    NS_ASSERT(!IsEmpty());
+    m_count--;
+    uint64_t ts = ev.key.m_ts;
+    auto sameUid = [&ev](const Event& other) { return other.key.m_uid == ev.key.m_uid; };
+    std::vector<Event>* events = &m_top;
+    if (ts < m_topStart)
+    {
+        std::size_t i = 0;
+        while (i < m_nRungs && ts < m_rungs[i].GetCurrentStart())
+        {
+            i++;
+        }
+        if (i == m_nRungs)
+        {
+            auto it = std::lower_bound(m_bottom.begin() + m_bottomHead, m_bottom.end(), ev);
+            NS_ASSERT(it != m_bottom.end() && it->impl == ev.impl);
+            m_bottom.erase(it);
+            if (m_bottomHead == m_bottom.size())
+            {
+                FillBottom();
+            }
+            return;
+        }
+        Rung& rung = m_rungs[i];
+        events = &rung.buckets[(ts - rung.start) / rung.width];
+        rung.count--;
+    }
+    // the Top and the buckets are unsorted
+    auto it = std::find_if(events->begin(), events->end(), sameUid);
+    NS_ASSERT(it != events->end() && it->impl == ev.impl);
+    *it = events->back();
+    events->pop_back();
+}
+
+void
+LadderScheduler::SpawnRung(std::vector<Event>& events, uint64_t start, uint64_t end)
+{
+    NS_LOG_FUNCTION(this << events.size() << start << end);
+    NS_ASSERT(m_nRungs < MAX_RUNGS && !events.empty() && start < end);
+    if (m_rungs.size() == m_nRungs)
+    {
+        m_rungs.emplace_back();
+    }
+    Rung& rung = m_rungs[m_nRungs];
+    m_nRungs++;
+    // about one bucket per event
+    std::size_t n = events.size();
+    rung.start = start;
+    rung.width = (end - start + n - 1) / n;
+    rung.current = 0;
+    rung.count = n;
+    rung.buckets.resize((end - start + rung.width - 1) / rung.width);
+    for (const auto& ev : events)
+    {
+        rung.buckets[(ev.key.m_ts - start) / rung.width].push_back(ev);
+    }
+    events.clear();
+}
+
+void
+LadderScheduler::FillBottom()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_bottomHead == m_bottom.size());
+    m_bottom.clear();
+    m_bottomHead = 0;
+    if (m_count == 0)
+    {
+        Reset();
+        return;
+    }
+    while (true)
+    {
+        while (m_nRungs > 0 && m_rungs[m_nRungs - 1].count == 0)
+        {
+            m_nRungs--;
+        }
+        if (m_nRungs == 0)
+        {
+            // the Ladder is exhausted: transfer the Top to it
+            NS_ASSERT(!m_top.empty());
+            uint64_t start = m_topMin;
+            uint64_t end = m_topMax + 1;
+            m_topStart = end;
+            m_topMin = std::numeric_limits<uint64_t>::max();
+            m_topMax = 0;
+            if (m_top.size() <= THRESHOLD || start + 1 == end)
+            {
+                m_bottom.swap(m_top);
+                break;
+            }
+            SpawnRung(m_top, start, end);
+        }
+        Rung& rung = m_rungs[m_nRungs - 1];
+        while (rung.buckets[rung.current].empty())
+        {
+            rung.current++;
+        }
+        std::vector<Event>& bucket = rung.buckets[rung.current];
+        rung.current++;
+        rung.count -= bucket.size();
+        if (bucket.size() > THRESHOLD && m_nRungs < MAX_RUNGS)
+        {
+            auto [min, max] = std::minmax_element(bucket.begin(), bucket.end());
+            if (min->key.m_ts != max->key.m_ts)
+            {
+                SpawnRung(bucket, min->key.m_ts, rung.GetCurrentStart());
+                continue;
+            }
+        }
+        m_bottom.swap(bucket);
+        break;
+    }
+    std::sort(m_bottom.begin(), m_bottom.end());
+}
+
+uint64_t
+LadderScheduler::GetBottomEnd() const
+{
+    return m_nRungs > 0 ? m_rungs[m_nRungs - 1].GetCurrentStart() : m_topStart;
+}
+
+void
+LadderScheduler::InsertBottom(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << &ev);
+    m_bottom.insert(std::upper_bound(m_bottom.begin() + m_bottomHead, m_bottom.end(), ev), ev);
+    if (m_bottom.size() - m_bottomHead > THRESHOLD && m_nRungs < MAX_RUNGS &&
+        m_bottom[m_bottomHead].key.m_ts != m_bottom.back().key.m_ts)
+    {
+        // too many events to keep sorted: spread them over a new rung
+        uint64_t start = m_bottom[m_bottomHead].key.m_ts;
+        m_bottom.erase(m_bottom.begin(), m_bottom.begin() + m_bottomHead);
+        m_bottomHead = 0;
+        SpawnRung(m_bottom, start, GetBottomEnd());
+        FillBottom();
+    }
+}
+
+void
+LadderScheduler::Reset()
+{
+    NS_LOG_FUNCTION(this);
+    m_top.clear();
+    m_topStart = 0;
+    m_topMin = std::numeric_limits<uint64_t>::max();
+    m_topMax = 0;
+    m_nRungs = 0;
+    m_bottom.clear();
+    m_bottomHead = 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,151 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue of
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh and
+ * Ian Li-Jin Thng][Tang]. The events are kept in three tiers:
+ *
+ * - the Top, an unsorted `std::vector` of the events later than all the
+ *   events of the other tiers;
+ * - the Ladder, up to `MAX_RUNGS` rungs, each of which is a contiguous array
+ *   of buckets, themselves unsorted `std::vector`s of events. A bucket
+ *   of a rung holding more than `THRESHOLD` events, when it is reached, is
+ *   spread over a new, finer rung, rather than sorted;
+ * - the Bottom, a sorted `std::vector` of the earliest events, from which
+ *   the events are dequeued.
+ *
+ * When the Bottom is exhausted, it is filled with the next bucket of the
+ * finest rung, and the Ladder with the Top once its rungs are exhausted.
+ * Unlike the CalendarScheduler, the width of the buckets of a rung is
+ * computed from the span of the events it holds when it is created, so
+ * that skewed event distributions, such as bursts of closely spaced events
+ * mixed with far away timers, are spread over finer rungs rather than
+ * resizing the whole queue. The events are sorted only once they reach the
+ * Bottom, and only in buckets of at most `THRESHOLD` events, unless they
+ * all have the same time stamp.
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103325 "Tang"
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Append to the Top or a bucket; insertion in the Bottom
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | First event of the Bottom
+ * Remove()     | Linear          | Search of the Top or of a bucket
+ * RemoveNext() | ~Constant       | Buckets transferred and sorted once
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | 3 x `sizeof (*)`<br/>(24 bytes)  | `std::vector` per bucket, about one bucket per event
+ * Per Event | 0                                | Events stored in `std::vector` directly
+ */
+class LadderScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    LadderScheduler();
+    /** Destructor. */
+    ~LadderScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /** Largest number of events sorted in the Bottom before spawning a rung. */
+    static constexpr std::size_t THRESHOLD = 50;
+    /** Largest number of rungs. */
+    static constexpr std::size_t MAX_RUNGS = 8;
+
+    /** A rung of the Ladder. */
+    struct Rung
+    {
+        /**
+         * \returns the time stamp from which the current bucket starts
+         */
+        uint64_t GetCurrentStart() const;
+
+        std::vector<std::vector<Scheduler::Event>> buckets; //!< Buckets of the rung
+        uint64_t start;                                     //!< Time stamp of the first bucket
+        uint64_t width;                                     //!< Width of the buckets
+        std::size_t current;                                //!< Next bucket to transfer
+        std::size_t count;                                  //!< Number of events in the rung
+    };
+
+    /**
+     * Spread events over a new rung.
+     *
+     * \param [in,out] events The events, cleared on return.
+     * \param [in] start The earliest time stamp of the events.
+     * \param [in] end The time stamp before which the events of the rung are,
+     *        including those inserted later on.
+     */
+    void SpawnRung(std::vector<Scheduler::Event>& events, uint64_t start, uint64_t end);
+    /** Fill the empty Bottom with the next events, if any. */
+    void FillBottom();
+    /**
+     * \returns the time stamp before which the events are inserted in the Bottom
+     */
+    uint64_t GetBottomEnd() const;
+    /**
+     * Insert an event in the Bottom, keeping it sorted.
+     *
+     * \param [in] ev The event.
+     */
+    void InsertBottom(const Scheduler::Event& ev);
+    /** Reset the tiers, once the queue is empty. */
+    void Reset();
+
+    std::vector<Scheduler::Event> m_top; //!< Unsorted events of the Top
+    uint64_t m_topStart;                 //!< Time stamp from which the events go to the Top
+    uint64_t m_topMin;                   //!< Earliest time stamp of the Top
+    uint64_t m_topMax;                   //!< Latest time stamp of the Top
+    /** Rungs of the Ladder, the first m_nRungs of which are in use, from the coarsest. */
+    std::vector<Rung> m_rungs;
+    std::size_t m_nRungs;                   //!< Number of rungs in use
+    std::vector<Scheduler::Event> m_bottom; //!< Sorted events of the Bottom, from m_bottomHead
+    std::size_t m_bottomHead;               //!< Position of the first event of the Bottom
+    std::size_t m_count;                    //!< Number of events in the queue
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
@@ -7,7 +7,9 @@
 
 #include "simulator-impl.h"
 
+#include "fan-out-event.h"
 #include "log.h"
+#include "make-event.h"
 
 /**
  * \file
@@ -29,4 +31,16 @@ SimulatorImpl::GetTypeId()
     return tid;
 }
 
+void
+SimulatorImpl::ScheduleFanOut(const Ptr<FanOutEvent>& event)
+{
+    NS_LOG_FUNCTION(this << event);
+    for (uint32_t i = 0; i < event->GetN(); i++)
+    {
+        ScheduleWithContext(event->GetContext(i),
+                            event->GetDelay(i),
+                            MakeEvent(&FanOutEvent::InvokeTarget, event, i));
+    }
+}
+
 } // namespace ns3
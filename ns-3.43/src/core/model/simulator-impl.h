@@ -25,6 +25,7 @@
 namespace ns3
 {
 
+class FanOutEvent;
 class Scheduler;
 
 /**
@@ -55,6 +56,14 @@ class SimulatorImpl : public Object
     virtual EventId Schedule(const Time& delay, EventImpl* event) = 0;
     /** \copydoc Simulator::ScheduleWithContext(uint32_t,const Time&,EventImpl*) */
     virtual void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) = 0;
+    /**
+     * \copydoc Simulator::ScheduleFanOut
+     *
+     * The record is also scheduled again through this method by FanOutEvent::Notify, for each
+     * of its targets but the first, if the simulator started its lazy expansion. By default,
+     * each target is rather scheduled as an event of its own with ScheduleWithContext.
+     */
+    virtual void ScheduleFanOut(const Ptr<FanOutEvent>& event);
     /** \copydoc Simulator::ScheduleNow(const Ptr<EventImpl>&) */
     virtual EventId ScheduleNow(EventImpl* event) = 0;
     /** \copydoc Simulator::ScheduleDestroy(const Ptr<EventImpl>&) */
@@ -230,6 +230,19 @@ Simulator::ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* i
     return GetImpl()->ScheduleWithContext(context, delay, impl);
 }
 
+void
+Simulator::ScheduleFanOut(const Ptr<FanOutEvent>& event)
+{
+    NS_ASSERT_MSG(!event->IsStarted(), "Fan-out event already scheduled");
+#ifdef ENABLE_DES_METRICS
+    for (uint32_t i = 0; i < event->GetN(); i++)
+    {
+        DesMetrics::Get()->TraceWithContext(event->GetContext(i), Now(), event->GetDelay(i));
+    }
+#endif
+    GetImpl()->ScheduleFanOut(event);
+}
+
 EventId
 Simulator::ScheduleDestroy(const Ptr<EventImpl>& ev)
 {
@@ -11,6 +11,7 @@
 
 #include "event-id.h"
 #include "event-impl.h"
+#include "fan-out-event.h"
 #include "make-event.h"
 #include "nstime.h"
 #include "object-factory.h"
@@ -470,6 +471,18 @@ class Simulator
      */
     static void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event);
 
+    /**
+     * Schedule an event delivered to several targets, each with its own context and delay,
+     * as a single record: see FanOutEvent.
+     *
+     * The targets run as if each of them was scheduled by ScheduleWithContext, in the order
+     * they were added to the event. No target can be added once the event is scheduled.
+     * This method is not thread-safe.
+     *
+     * @param [in] event The event to schedule.
+     */
+    static void ScheduleFanOut(const Ptr<FanOutEvent>& event);
+
     /**
      * Schedule an event to run at the end of the simulation, after
      * the Stop() time or condition has been reached.
@@ -0,0 +1,229 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/event-impl.h"
+#include "ns3/global-value.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <array>
+#include <set>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup events
+ * \ingroup event-impl-tests
+ * EventImpl allocation test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup event-impl-tests EventImpl allocation test suite
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup event-impl-tests
+ * \returns whether the events are allocated from the pools
+ */
+static bool
+IsEventPoolEnabled()
+{
+    BooleanValue enabled;
+    GlobalValue::GetValueByName("EventPoolEnabled", enabled);
+    return enabled.Get();
+}
+
+/**
+ * \ingroup event-impl-tests
+ * Check that the events referenced by an EventId are not recycled, once
+ * cancelled or removed.
+ */
+class EventImplRecycleTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * \param remove whether the event is removed rather than cancelled
+     */
+    EventImplRecycleTestCase(bool remove);
+    void DoRun() override;
+
+  private:
+    /** Event, which schedules the next one until the last. */
+    void Hop();
+
+    bool m_remove;                          //!< Whether the event is removed rather than cancelled
+    EventId m_held;                         //!< Event cancelled or removed, and held
+    std::set<const EventImpl*> m_addresses; //!< Addresses of the events scheduled by Hop
+    int m_hops;                             //!< Number of events run
+};
+
+EventImplRecycleTestCase::EventImplRecycleTestCase(bool remove)
+    : TestCase(std::string("Check that an event ") + (remove ? "removed" : "cancelled") +
+               " is not recycled while an EventId references it"),
+      m_remove(remove),
+      m_hops(0)
+{
+}
+
+void
+EventImplRecycleTestCase::Hop()
+{
+    m_hops++;
+    if (m_hops < 200)
+    {
+        EventId id = Simulator::Schedule(MicroSeconds(1), &EventImplRecycleTestCase::Hop, this);
+        m_addresses.insert(id.PeekEventImpl());
+    }
+}
+
+void
+EventImplRecycleTestCase::DoRun()
+{
+    m_held = Simulator::Schedule(MicroSeconds(50), &EventImplRecycleTestCase::Hop, this);
+    const EventImpl* held = m_held.PeekEventImpl();
+    if (m_remove)
+    {
+        Simulator::Remove(m_held);
+    }
+    else
+    {
+        m_held.Cancel();
+    }
+    Simulator::Schedule(MicroSeconds(1), &EventImplRecycleTestCase::Hop, this);
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_hops, 200, "The event held did not run");
+    NS_TEST_EXPECT_MSG_EQ(m_addresses.count(held), 0, "Event held recycled");
+    NS_TEST_EXPECT_MSG_EQ(m_held.IsExpired(), true, "Event held expired");
+    NS_TEST_EXPECT_MSG_EQ(m_held.PeekEventImpl()->IsCancelled(), true, "Event held readable");
+    m_held.Cancel();
+    Simulator::Remove(m_held);
+
+    // once released, the event is the first one recycled
+    m_held = EventId();
+    EventId id = Simulator::Schedule(MicroSeconds(1), &EventImplRecycleTestCase::Hop, this);
+    if (IsEventPoolEnabled())
+    {
+        NS_TEST_EXPECT_MSG_EQ(id.PeekEventImpl(), held, "Event released and recycled");
+    }
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup event-impl-tests
+ * Check the counters of the allocations of the events.
+ */
+class EventImplAllocationStatsTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    EventImplAllocationStatsTestCase();
+    void DoRun() override;
+
+  private:
+    /** Event, which schedules the next one until the last. */
+    void Hop();
+    /** Event too large for the pools. */
+    static void Large(std::array<uint8_t, 1024> /* payload */);
+
+    int m_hops; //!< Number of events run
+};
+
+EventImplAllocationStatsTestCase::EventImplAllocationStatsTestCase()
+    : TestCase("Check the counters of the allocations of the events"),
+      m_hops(0)
+{
+}
+
+void
+EventImplAllocationStatsTestCase::Hop()
+{
+    m_hops++;
+    if (m_hops < 1000)
+    {
+        Simulator::Schedule(MicroSeconds(1), &EventImplAllocationStatsTestCase::Hop, this);
+    }
+}
+
+void
+EventImplAllocationStatsTestCase::Large(std::array<uint8_t, 1024> /* payload */)
+{
+}
+
+void
+EventImplAllocationStatsTestCase::DoRun()
+{
+    // the counters are kept in variables, the test macros evaluating their arguments twice
+    EventImpl::AllocationStats before = EventImpl::GetAllocationStats();
+    Simulator::Schedule(MicroSeconds(1), &EventImplAllocationStatsTestCase::Hop, this);
+    Simulator::Run();
+    EventImpl::AllocationStats after = EventImpl::GetAllocationStats();
+    uint64_t allocations = after.allocations - before.allocations;
+    uint64_t deallocations = after.deallocations - before.deallocations;
+    uint64_t recycled = after.recycled - before.recycled;
+    uint64_t systemAllocations = after.systemAllocations - before.systemAllocations;
+    NS_TEST_EXPECT_MSG_EQ(allocations, 1000, "One allocation per event");
+    NS_TEST_EXPECT_MSG_EQ(deallocations, 1000, "All the events run were freed");
+    if (IsEventPoolEnabled())
+    {
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(recycled, 999, "Events recycled");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(systemAllocations, 1, "At most one slab");
+    }
+    else
+    {
+        NS_TEST_EXPECT_MSG_EQ(recycled, 0, "No pool");
+        NS_TEST_EXPECT_MSG_EQ(systemAllocations, 1000, "No pool");
+    }
+
+    before = after;
+    Simulator::Schedule(MicroSeconds(1),
+                        &EventImplAllocationStatsTestCase::Large,
+                        std::array<uint8_t, 1024>());
+    Simulator::Run();
+    after = EventImpl::GetAllocationStats();
+    allocations = after.allocations - before.allocations;
+    recycled = after.recycled - before.recycled;
+    systemAllocations = after.systemAllocations - before.systemAllocations;
+    NS_TEST_EXPECT_MSG_EQ(allocations, 1, "Large event");
+    NS_TEST_EXPECT_MSG_EQ(recycled, 0, "Large event not pooled");
+    NS_TEST_EXPECT_MSG_EQ(systemAllocations, 1, "Large event allocated by the system");
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup event-impl-tests
+ * EventImpl allocation test suite.
+ */
+class EventImplTestSuite : public TestSuite
+{
+  public:
+    EventImplTestSuite()
+        : TestSuite("event-impl")
+    {
+        AddTestCase(new EventImplRecycleTestCase(false));
+        AddTestCase(new EventImplRecycleTestCase(true));
+        AddTestCase(new EventImplAllocationStatsTestCase());
+    }
+};
+
+/**
+ * \ingroup event-impl-tests
+ * EventImplTestSuite instance variable.
+ */
+static EventImplTestSuite g_eventImplTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
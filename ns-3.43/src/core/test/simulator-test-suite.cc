@@ -6,13 +6,19 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "ns3/calendar-scheduler.h"
+#include "ns3/config.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <random>
+#include <unordered_map>
+
 using namespace ns3;
 
 /**
@@ -696,6 +702,217 @@ SimulatorTemplateTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that the targets of a fan-out event run as events of their own would.
+ */
+class SimulatorFanOutTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * \param schedulerFactory Scheduler factory.
+     * \param simulatorType Simulator implementation, empty for the default one.
+     */
+    SimulatorFanOutTestCase(ObjectFactory schedulerFactory, std::string simulatorType = "");
+    void DoRun() override;
+    /**
+     * Record a target, or an event.
+     * \param name The name of the target or event.
+     */
+    void Record(char name);
+    /**
+     * Target which schedules an event for now, and cancels the rest of a fan-out event.
+     * \param name The name of the target.
+     */
+    void Nested(char name);
+
+    std::string m_trace;              //!< Names, contexts and times of the targets and events.
+    Ptr<FanOutEvent> m_cancelled;     //!< Fan-out event cancelled by Nested.
+    ObjectFactory m_schedulerFactory; //!< Scheduler factory.
+    std::string m_simulatorType;      //!< Simulator implementation.
+};
+
+SimulatorFanOutTestCase::SimulatorFanOutTestCase(ObjectFactory schedulerFactory,
+                                                 std::string simulatorType)
+    : TestCase("Check the fan-out events with " + schedulerFactory.GetTypeId().GetName() +
+               (simulatorType.empty() ? "" : " and " + simulatorType)),
+      m_schedulerFactory(schedulerFactory),
+      m_simulatorType(simulatorType)
+{
+}
+
+void
+SimulatorFanOutTestCase::Record(char name)
+{
+    m_trace += name;
+    m_trace += std::to_string(Simulator::GetContext()) + "@" +
+               std::to_string(Simulator::Now().GetMicroSeconds()) + " ";
+}
+
+void
+SimulatorFanOutTestCase::Nested(char name)
+{
+    Record(name);
+    Simulator::ScheduleNow(&SimulatorFanOutTestCase::Record, this, 'x');
+    if (m_cancelled)
+    {
+        m_cancelled->Cancel();
+    }
+}
+
+void
+SimulatorFanOutTestCase::DoRun()
+{
+    if (!m_simulatorType.empty())
+    {
+        Config::SetGlobal("SimulatorImplementationType", StringValue(m_simulatorType));
+    }
+    Simulator::SetScheduler(m_schedulerFactory);
+
+    Simulator::ScheduleWithContext(7, MicroSeconds(2), &SimulatorFanOutTestCase::Record, this, 'e');
+    auto fanOut = MakeFanOutEvent(&SimulatorFanOutTestCase::Nested, this);
+    fanOut->Add(3, MicroSeconds(5), 'a');
+    fanOut->Add(1, MicroSeconds(2), 'b');
+    fanOut->Add(2, MicroSeconds(5), 'c');
+    fanOut->Add(4, MicroSeconds(0), 'd');
+    NS_TEST_EXPECT_MSG_EQ(fanOut->GetN(), 4, "Targets of the event");
+    Simulator::ScheduleFanOut(fanOut);
+    Simulator::ScheduleWithContext(8, MicroSeconds(2), &SimulatorFanOutTestCase::Record, this, 'f');
+    Simulator::ScheduleWithContext(9, MicroSeconds(5), &SimulatorFanOutTestCase::Record, this, 'g');
+    Simulator::ScheduleFanOut(MakeFanOutEvent(&SimulatorFanOutTestCase::Nested, this));
+    // the real time simulator does not stop once there are no events left
+    Simulator::Stop(MicroSeconds(100));
+    Simulator::Run();
+    // the targets are interleaved with the events scheduled before and after them, in time
+    // and uid order, and the events scheduled by the targets come after them
+    NS_TEST_EXPECT_MSG_EQ(m_trace,
+                          "d4@0 x4@0 e7@2 b1@2 f8@2 x1@2 a3@5 c2@5 g9@5 x3@5 x2@5 ",
+                          "Order and contexts of the targets");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetEventCount(), 12, "Each target counts as an event");
+
+    // cancelling the event cancels the targets which did not run yet
+    m_trace.clear();
+    auto cancelled = MakeFanOutEvent(&SimulatorFanOutTestCase::Nested, this);
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        cancelled->Add(i, MicroSeconds(i + 1), 'a' + i);
+    }
+    m_cancelled = cancelled;
+    Simulator::ScheduleFanOut(cancelled);
+    Simulator::Stop(MicroSeconds(100));
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_trace, "a0@101 x0@101 ", "Targets cancelled");
+
+    m_cancelled = nullptr;
+    Simulator::Destroy();
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that a scheduler dequeues the same events as the MapScheduler, under a skewed
+ * mix of insertions, removals and dequeues.
+ *
+ * The delays of the events mix bursts of events a few nanoseconds apart, events at the same
+ * time stamp, and far away timers, as in wireless simulations.
+ */
+class SchedulerStressTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param schedulerFactory Scheduler factory.
+     */
+    SchedulerStressTestCase(ObjectFactory schedulerFactory);
+
+  private:
+    void DoRun() override;
+
+    ObjectFactory m_schedulerFactory; //!< Scheduler factory.
+};
+
+SchedulerStressTestCase::SchedulerStressTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check the order of the events dequeued by " +
+               schedulerFactory.GetTypeId().GetName() + " against ns3::MapScheduler"),
+      m_schedulerFactory(schedulerFactory)
+{
+}
+
+void
+SchedulerStressTestCase::DoRun()
+{
+    Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler>();
+    Ptr<Scheduler> reference = CreateObject<MapScheduler>();
+    std::mt19937 rng(1);
+    std::vector<Scheduler::Event> pending;
+    std::unordered_map<uint32_t, std::size_t> index; // position in pending of the uids
+    uint64_t now = 0;
+    uint32_t uid = 0;
+
+    auto forget = [&pending, &index](uint32_t uid) {
+        std::size_t i = index[uid];
+        index.erase(uid);
+        if (i + 1 != pending.size())
+        {
+            pending[i] = pending.back();
+            index[pending[i].key.m_uid] = i;
+        }
+        pending.pop_back();
+    };
+
+    for (uint32_t step = 0; step < 100000; step++)
+    {
+        uint32_t action = rng() % 10;
+        if (action < 5 || pending.empty())
+        {
+            uint32_t kind = rng() % 20;
+            uint64_t delay = kind == 0   ? 0
+                             : kind < 12 ? rng() % 10
+                             : kind < 18 ? rng() % 100000
+                                         : 1000000 + rng() % 1000000000;
+            Scheduler::Event ev = {nullptr, {now + delay, uid++, 0}};
+            scheduler->Insert(ev);
+            reference->Insert(ev);
+            index[ev.key.m_uid] = pending.size();
+            pending.push_back(ev);
+        }
+        else if (action < 9)
+        {
+            Scheduler::Event next = scheduler->RemoveNext();
+            Scheduler::Event expected = reference->RemoveNext();
+            NS_TEST_ASSERT_MSG_EQ(next.key.m_uid, expected.key.m_uid, "Event dequeued");
+            NS_TEST_ASSERT_MSG_EQ(next.key.m_ts, expected.key.m_ts, "Time stamp dequeued");
+            now = next.key.m_ts;
+            forget(next.key.m_uid);
+        }
+        else
+        {
+            Scheduler::Event ev = pending[rng() % pending.size()];
+            scheduler->Remove(ev);
+            reference->Remove(ev);
+            forget(ev.key.m_uid);
+        }
+        NS_TEST_ASSERT_MSG_EQ(scheduler->IsEmpty(), pending.empty(), "Empty queue");
+        if (!pending.empty())
+        {
+            NS_TEST_ASSERT_MSG_EQ(scheduler->PeekNext().key.m_uid,
+                                  reference->PeekNext().key.m_uid,
+                                  "Next event");
+        }
+    }
+    while (!reference->IsEmpty())
+    {
+        NS_TEST_ASSERT_MSG_EQ(scheduler->RemoveNext().key.m_uid,
+                              reference->RemoveNext().key.m_uid,
+                              "Event drained");
+    }
+    NS_TEST_EXPECT_MSG_EQ(scheduler->IsEmpty(), true, "Drained");
+}
+
 /**
  * \ingroup simulator-tests
  *
@@ -719,6 +936,25 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(LadderScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+
+        for (auto tid : {ListScheduler::GetTypeId(),
+                         MapScheduler::GetTypeId(),
+                         HeapScheduler::GetTypeId(),
+                         CalendarScheduler::GetTypeId(),
+                         PriorityQueueScheduler::GetTypeId(),
+                         LadderScheduler::GetTypeId()})
+        {
+            factory.SetTypeId(tid);
+            AddTestCase(new SimulatorFanOutTestCase(factory), TestCase::Duration::QUICK);
+        }
+        factory.SetTypeId(MapScheduler::GetTypeId());
+        AddTestCase(new SimulatorFanOutTestCase(factory, "ns3::RealtimeSimulatorImpl"),
+                    TestCase::Duration::QUICK);
+
+        factory.SetTypeId(LadderScheduler::GetTypeId());
+        AddTestCase(new SchedulerStressTestCase(factory), TestCase::Duration::QUICK);
     }
 };
 
@@ -0,0 +1,56 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "node-lifecycle-manager-helper.h"
+
+namespace ns3
+{
+
+NodeLifecycleManagerHelper::NodeLifecycleManagerHelper()
+{
+    m_manager.SetTypeId("ns3::energy::NodeLifecycleManager");
+}
+
+void
+NodeLifecycleManagerHelper::Set(std::string name, const AttributeValue& v)
+{
+    m_manager.Set(name, v);
+}
+
+void
+NodeLifecycleManagerHelper::AddShutdownCallback(
+    energy::NodeLifecycleManager::ShutdownCallback callback)
+{
+    m_callbacks.push_back(callback);
+}
+
+energy::DeviceEnergyModelContainer
+NodeLifecycleManagerHelper::Install(Ptr<energy::EnergySource> source) const
+{
+    return Install(energy::EnergySourceContainer(source));
+}
+
+energy::DeviceEnergyModelContainer
+NodeLifecycleManagerHelper::Install(energy::EnergySourceContainer sourceContainer) const
+{
+    energy::DeviceEnergyModelContainer container;
+    for (auto i = sourceContainer.Begin(); i != sourceContainer.End(); ++i)
+    {
+        NS_ASSERT((*i)->GetNode());
+        Ptr<energy::NodeLifecycleManager> manager =
+            m_manager.Create<energy::NodeLifecycleManager>();
+        for (const auto& callback : m_callbacks)
+        {
+            manager->AddShutdownCallback(callback);
+        }
+        manager->SetEnergySource(*i);
+        (*i)->AppendDeviceEnergyModel(manager);
+        container.Add(manager);
+    }
+    return container;
+}
+
+} // namespace ns3
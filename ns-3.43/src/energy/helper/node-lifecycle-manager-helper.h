@@ -0,0 +1,72 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#ifndef NODE_LIFECYCLE_MANAGER_HELPER_H
+#define NODE_LIFECYCLE_MANAGER_HELPER_H
+
+#include "energy-source-container.h"
+
+#include "ns3/attribute.h"
+#include "ns3/device-energy-model-container.h"
+#include "ns3/node-lifecycle-manager.h"
+#include "ns3/object-factory.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup energy
+ * \brief Creates NodeLifecycleManager objects.
+ *
+ * This class attaches a NodeLifecycleManager to each energy source, so that
+ * the node of the source is shut down when the source runs low.
+ */
+class NodeLifecycleManagerHelper
+{
+  public:
+    NodeLifecycleManagerHelper();
+
+    /**
+     * \param name Name of attribute to set.
+     * \param v Value of the attribute.
+     *
+     * Sets one of the attributes of the NodeLifecycleManagers.
+     */
+    void Set(std::string name, const AttributeValue& v);
+
+    /**
+     * \param callback Callback invoked by each NodeLifecycleManager on shutdown.
+     *
+     * Callbacks are invoked in the order they were added, before the
+     * applications of the node are stopped.
+     */
+    void AddShutdownCallback(energy::NodeLifecycleManager::ShutdownCallback callback);
+
+    /**
+     * \param source Pointer to the energy source to watch.
+     * \returns A DeviceEnergyModelContainer which contains the manager.
+     */
+    energy::DeviceEnergyModelContainer Install(Ptr<energy::EnergySource> source) const;
+
+    /**
+     * \param sourceContainer List of energy sources to watch.
+     * \returns A DeviceEnergyModelContainer which contains the managers.
+     */
+    energy::DeviceEnergyModelContainer Install(
+        energy::EnergySourceContainer sourceContainer) const;
+
+  private:
+    ObjectFactory m_manager; //!< NodeLifecycleManager factory
+    std::vector<energy::NodeLifecycleManager::ShutdownCallback>
+        m_callbacks; //!< Shutdown callbacks
+};
+
+} // namespace ns3
+
+#endif /* NODE_LIFECYCLE_MANAGER_HELPER_H */
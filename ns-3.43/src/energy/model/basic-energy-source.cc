@@ -9,11 +9,15 @@
 #include "basic-energy-source.h"
 
 #include "ns3/assert.h"
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace ns3
 {
 namespace energy
@@ -59,6 +63,13 @@ BasicEnergySource::GetTypeId()
                           MakeTimeAccessor(&BasicEnergySource::SetEnergyUpdateInterval,
                                            &BasicEnergySource::GetEnergyUpdateInterval),
                           MakeTimeChecker())
+            .AddAttribute("PredictiveUpdate",
+                          "Whether to replay the periodic energy updates at the updates requested "
+                          "by the device models, with a single event at the predicted crossing of "
+                          "a battery threshold, instead of scheduling them.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&BasicEnergySource::m_predictive),
+                          MakeBooleanChecker())
             .AddTraceSource("RemainingEnergy",
                             "Remaining energy at BasicEnergySource.",
                             MakeTraceSourceAccessor(&BasicEnergySource::m_remainingEnergyJ),
@@ -71,6 +82,8 @@ BasicEnergySource::BasicEnergySource()
     NS_LOG_FUNCTION(this);
     m_lastUpdateTime = Seconds(0.0);
     m_depleted = false;
+    m_predictive = false;
+    m_nextPeriodicUpdate = Time::Max();
 }
 
 BasicEnergySource::~BasicEnergySource()
@@ -166,7 +179,20 @@ BasicEnergySource::UpdateEnergySource()
         NotifyEnergyChanged();
     }
 
-    if (m_energyUpdateEvent.IsExpired())
+    if (m_predictive)
+    {
+        if (m_nextPeriodicUpdate == Time::Max())
+        {
+            // where the first periodic update would be scheduled
+            m_nextPeriodicUpdate = Simulator::Now() + m_energyUpdateInterval;
+        }
+        while (m_nextPeriodicUpdate <= Simulator::Now())
+        {
+            m_nextPeriodicUpdate += m_energyUpdateInterval;
+        }
+        ScheduleThresholdUpdate();
+    }
+    else if (m_energyUpdateEvent.IsExpired())
     {
         m_energyUpdateEvent = Simulator::Schedule(m_energyUpdateInterval,
                                                   &BasicEnergySource::UpdateEnergySource,
@@ -174,6 +200,22 @@ BasicEnergySource::UpdateEnergySource()
     }
 }
 
+void
+BasicEnergySource::UpdateCurrentDraw()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_predictive)
+    {
+        return;
+    }
+    if (m_lastUpdateTime != Simulator::Now() || m_nextPeriodicUpdate == Time::Max())
+    {
+        UpdateEnergySource();
+        return;
+    }
+    ScheduleThresholdUpdate();
+}
+
 /*
  * Private functions start here.
  */
@@ -221,12 +263,83 @@ BasicEnergySource::CalculateRemainingEnergy()
     }
     // ----------------
     // NS_ASSERT(duration.IsPositive());
-    // energy = current * voltage * time
-    double energyToDecreaseJ = (totalCurrentA * m_supplyVoltageV * duration).GetSeconds();
-    NS_ASSERT(m_remainingEnergyJ >= energyToDecreaseJ);
-    m_remainingEnergyJ -= energyToDecreaseJ;
+    double remainingEnergyJ = m_remainingEnergyJ;
+    if (m_predictive)
+    {
+        // replay the periodic updates since the last update, the draw did not change since
+        while (m_nextPeriodicUpdate < Simulator::Now())
+        {
+            remainingEnergyJ -=
+                CalculateEnergyDrawn(totalCurrentA, m_nextPeriodicUpdate - m_lastUpdateTime);
+            m_lastUpdateTime = m_nextPeriodicUpdate;
+            m_nextPeriodicUpdate += m_energyUpdateInterval;
+        }
+        duration = Simulator::Now() - m_lastUpdateTime;
+    }
+    remainingEnergyJ -= CalculateEnergyDrawn(totalCurrentA, duration);
+    NS_ASSERT(remainingEnergyJ >= 0);
+    m_remainingEnergyJ = remainingEnergyJ;
     NS_LOG_DEBUG("BasicEnergySource:Remaining energy = " << m_remainingEnergyJ);
 }
 
+double
+BasicEnergySource::CalculateEnergyDrawn(double totalCurrentA, Time duration) const
+{
+    // energy = current * voltage * time
+    return (totalCurrentA * m_supplyVoltageV * duration).GetSeconds();
+}
+
+void
+BasicEnergySource::ScheduleThresholdUpdate()
+{
+    NS_LOG_FUNCTION(this);
+    double totalCurrentA = CalculateTotalCurrent();
+    double thresholdJ;
+    if (!m_depleted && totalCurrentA > 0)
+    {
+        thresholdJ = m_lowBatteryTh * m_initialEnergyJ;
+    }
+    else if (m_depleted && totalCurrentA < 0)
+    {
+        thresholdJ = m_highBatteryTh * m_initialEnergyJ;
+    }
+    else
+    {
+        m_energyUpdateEvent.Cancel();
+        return;
+    }
+
+    // remaining energy at the next periodic update, and energy drawn between two of them
+    double remainingEnergyJ =
+        m_remainingEnergyJ -
+        CalculateEnergyDrawn(totalCurrentA, m_nextPeriodicUpdate - Simulator::Now());
+    double periodEnergyJ = CalculateEnergyDrawn(totalCurrentA, m_energyUpdateInterval);
+    double maxPeriods =
+        ((Simulator::GetMaximumSimulationTime() - m_nextPeriodicUpdate) / m_energyUpdateInterval)
+            .GetDouble();
+    double periods = (remainingEnergyJ - thresholdJ) / periodEnergyJ;
+    if (periodEnergyJ == 0 || periods >= maxPeriods)
+    {
+        m_energyUpdateEvent.Cancel();
+        return;
+    }
+    // periodic updates after the next one until the threshold is crossed, rounded down a
+    // little: if the threshold is not crossed yet, the update schedules the next one
+    periods = m_depleted ? std::floor(periods - 1e-9) + 1 : std::ceil(periods - 1e-9);
+    Time update = m_nextPeriodicUpdate +
+                  m_energyUpdateInterval * std::max(static_cast<int64_t>(periods), int64_t(0));
+
+    if (m_energyUpdateEvent.IsPending() &&
+        Simulator::Now() + Simulator::GetDelayLeft(m_energyUpdateEvent) == update)
+    {
+        return;
+    }
+    NS_LOG_DEBUG("BasicEnergySource:Threshold crossed at " << update.As(Time::S));
+    m_energyUpdateEvent.Cancel();
+    m_energyUpdateEvent = Simulator::Schedule(update - Simulator::Now(),
+                                              &BasicEnergySource::UpdateEnergySource,
+                                              this);
+}
+
 } // namespace energy
 } // namespace ns3
@@ -25,6 +25,19 @@ namespace energy
  * BasicEnergySource decreases/increases remaining energy stored in itself in
  * linearly.
  *
+ * By default, the remaining energy is updated every PeriodicEnergyUpdateInterval,
+ * besides the updates requested by the device models. With PredictiveUpdate, the
+ * periodic updates are not scheduled: at each requested update, the periodic
+ * updates that took place since the previous one are replayed with the current
+ * draw, with the same arithmetic, so that the remaining energy is the same as with
+ * the periodic updates. A single event is scheduled, at the periodic update where
+ * the low (or, when recharging, the high) battery threshold is crossed with the
+ * current draw, and rescheduled whenever the draw changes, see UpdateCurrentDraw.
+ * The results are the same as with the periodic updates as long as the device
+ * models change their draw only after they requested an update, as
+ * WifiRadioEnergyModel does; not as SimpleDeviceEnergyModel does. The
+ * RemainingEnergy trace and the HandleEnergyChanged notifications only take place
+ * at the requested updates.
  */
 class BasicEnergySource : public EnergySource
 {
@@ -70,6 +83,12 @@ class BasicEnergySource : public EnergySource
      */
     void UpdateEnergySource() override;
 
+    /**
+     * Implements UpdateCurrentDraw: reschedules the threshold event with
+     * PredictiveUpdate.
+     */
+    void UpdateCurrentDraw() override;
+
     /**
      * \param initialEnergyJ Initial energy, in Joules
      *
@@ -130,6 +149,19 @@ class BasicEnergySource : public EnergySource
      */
     void CalculateRemainingEnergy();
 
+    /**
+     * \param totalCurrentA Total current draw, in Amperes.
+     * \param duration Duration of the draw.
+     * \returns Energy drawn, in Joules.
+     */
+    double CalculateEnergyDrawn(double totalCurrentA, Time duration) const;
+
+    /**
+     * With PredictiveUpdate, schedules the update event at the first periodic
+     * update where a battery threshold is crossed with the current draw.
+     */
+    void ScheduleThresholdUpdate();
+
   private:
     double m_initialEnergyJ; //!< initial energy, in Joules
     double m_supplyVoltageV; //!< supply voltage, in Volts
@@ -144,6 +176,8 @@ class BasicEnergySource : public EnergySource
     EventId m_energyUpdateEvent;            //!< energy update event
     Time m_lastUpdateTime;                  //!< last update time
     Time m_energyUpdateInterval;            //!< energy update interval
+    bool m_predictive;                      //!< whether the periodic updates are replayed
+    Time m_nextPeriodicUpdate;              //!< time of the next (replayed) periodic update
 };
 
 } // namespace energy
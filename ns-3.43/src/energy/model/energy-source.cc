@@ -43,6 +43,12 @@ EnergySource::~EnergySource()
     NS_LOG_FUNCTION(this);
 }
 
+void
+EnergySource::UpdateCurrentDraw()
+{
+    NS_LOG_FUNCTION(this);
+}
+
 void
 EnergySource::SetNode(Ptr<Node> node)
 {
@@ -110,6 +116,10 @@ EnergySource::InitializeDeviceModels()
     {
         (*i)->Initialize();
     }
+    for (i = m_detachedModels.Begin(); i != m_detachedModels.End(); i++)
+    {
+        (*i)->Initialize();
+    }
 }
 
 void
@@ -125,6 +135,18 @@ EnergySource::DisposeDeviceModels()
     {
         (*i)->Dispose();
     }
+    for (i = m_detachedModels.Begin(); i != m_detachedModels.End(); i++)
+    {
+        (*i)->Dispose();
+    }
+}
+
+void
+EnergySource::DetachDeviceEnergyModels()
+{
+    NS_LOG_FUNCTION(this);
+    m_detachedModels.Add(m_models);
+    m_models.Clear();
 }
 
 void
@@ -226,6 +248,7 @@ EnergySource::BreakDeviceEnergyModelRefCycle()
 {
     NS_LOG_FUNCTION(this);
     m_models.Clear();
+    m_detachedModels.Clear();
     m_harvesters.clear();
     m_node = nullptr;
 }
@@ -119,6 +119,13 @@ class EnergySource : public Object
      */
     virtual void UpdateEnergySource() = 0;
 
+    /**
+     * Called by DeviceEnergyModels once they changed their current draw, after
+     * UpdateEnergySource accounted for the energy drawn until then. The default
+     * does nothing; sources predicting their depletion reschedule it.
+     */
+    virtual void UpdateCurrentDraw();
+
     /**
      * \brief Sets pointer to node containing this EnergySource.
      *
@@ -168,6 +175,13 @@ class EnergySource : public Object
      */
     void DisposeDeviceModels();
 
+    /**
+     * Detaches all device energy models, e.g. once the node is shut down. Their
+     * current no longer counts in the draw from the source, and they are no longer
+     * notified of its events. The source still initializes and disposes them.
+     */
+    void DetachDeviceEnergyModels();
+
     /**
      * \param energyHarvesterPtr Pointer to energy harvester.
      *
@@ -179,6 +193,12 @@ class EnergySource : public Object
      */
     void ConnectEnergyHarvester(Ptr<EnergyHarvester> energyHarvesterPtr);
 
+    /**
+     * \returns Total current draw from all DeviceEnergyModels, less the current
+     * provided by the energy harvesters.
+     */
+    double CalculateTotalCurrent();
+
   private:
     /**
      * All child's implementation must call BreakDeviceEnergyModelRefCycle to
@@ -194,6 +214,11 @@ class EnergySource : public Object
      */
     DeviceEnergyModelContainer m_models;
 
+    /**
+     * List of device energy models detached from the source.
+     */
+    DeviceEnergyModelContainer m_detachedModels;
+
     /**
      * Pointer to node containing this EnergySource. Used by helper class to make
      * sure device models are installed onto the corresponding node.
@@ -208,11 +233,6 @@ class EnergySource : public Object
     std::vector<Ptr<EnergyHarvester>> m_harvesters;
 
   protected:
-    /**
-     * \returns Total current draw from all DeviceEnergyModels.
-     */
-    double CalculateTotalCurrent();
-
     /**
      * This function notifies all DeviceEnergyModel of energy depletion event. It
      * is called by the child EnergySource class when energy depletion happens.
@@ -0,0 +1,259 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "node-lifecycle-manager.h"
+
+#include "ns3/application.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/trace-source-accessor.h"
+
+namespace ns3
+{
+namespace energy
+{
+
+NS_LOG_COMPONENT_DEFINE("NodeLifecycleManager");
+NS_OBJECT_ENSURE_REGISTERED(NodeLifecycleManager);
+
+TypeId
+NodeLifecycleManager::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::energy::NodeLifecycleManager")
+            .SetParent<DeviceEnergyModel>()
+            .SetGroupName("Energy")
+            .AddConstructor<NodeLifecycleManager>()
+            .AddAttribute("ShutdownThreshold",
+                          "Remaining energy at which the node is shut down, in Joules.",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&NodeLifecycleManager::m_thresholdJ),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("PredictionTolerance",
+                          "The threshold event is not moved for a prediction within this "
+                          "time of it.",
+                          TimeValue(MicroSeconds(1)),
+                          MakeTimeAccessor(&NodeLifecycleManager::m_tolerance),
+                          MakeTimeChecker(Time(0)))
+            .AddTraceSource("Shutdown",
+                            "The node was shut down.",
+                            MakeTraceSourceAccessor(&NodeLifecycleManager::m_shutdownTrace),
+                            "ns3::energy::NodeLifecycleManager::ShutdownTracedCallback");
+    return tid;
+}
+
+NodeLifecycleManager::NodeLifecycleManager()
+    : m_source(nullptr),
+      m_thresholdJ(0.0),
+      m_lastCurrentA(0.0),
+      m_shutdown(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NodeLifecycleManager::~NodeLifecycleManager()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+NodeLifecycleManager::SetEnergySource(Ptr<EnergySource> source)
+{
+    NS_LOG_FUNCTION(this << source);
+    NS_ASSERT(source);
+    m_source = source;
+}
+
+double
+NodeLifecycleManager::GetTotalEnergyConsumption() const
+{
+    NS_LOG_FUNCTION(this);
+    return 0.0;
+}
+
+void
+NodeLifecycleManager::ChangeState(int newState)
+{
+    NS_LOG_FUNCTION(this << newState);
+}
+
+void
+NodeLifecycleManager::HandleEnergyDepletion()
+{
+    NS_LOG_FUNCTION(this);
+    // not from within the update of the source, whose devices may change state on shutdown
+    if (!m_shutdown && !m_depletionEvent.IsPending())
+    {
+        m_depletionEvent = Simulator::ScheduleNow(&NodeLifecycleManager::Shutdown, this);
+    }
+}
+
+void
+NodeLifecycleManager::HandleEnergyRecharged()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+NodeLifecycleManager::HandleEnergyChanged()
+{
+    NS_LOG_FUNCTION(this);
+    Predict();
+}
+
+void
+NodeLifecycleManager::AddShutdownCallback(ShutdownCallback callback)
+{
+    NS_LOG_FUNCTION(this);
+    m_callbacks.push_back(callback);
+}
+
+void
+NodeLifecycleManager::Shutdown()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_shutdown)
+    {
+        return;
+    }
+    m_shutdown = true;
+    m_thresholdEvent.Cancel();
+    m_depletionEvent.Cancel();
+
+    Ptr<Node> node = m_source->GetNode();
+    NS_ASSERT_MSG(node, "Energy source not installed on a node");
+    NS_LOG_INFO("Node " << node->GetId() << " shut down, remaining energy "
+                        << m_source->GetRemainingEnergy() << " J");
+    for (const auto& callback : m_callbacks)
+    {
+        callback(node);
+    }
+    for (uint32_t i = 0; i < node->GetNApplications(); ++i)
+    {
+        node->GetApplication(i)->StopRightNow();
+    }
+    // the devices draw nothing more: account for their draw until now, then detach them
+    m_source->UpdateEnergySource();
+    m_source->DetachDeviceEnergyModels();
+    m_source->UpdateCurrentDraw();
+    m_shutdownTrace(node);
+}
+
+bool
+NodeLifecycleManager::IsShutdown() const
+{
+    return m_shutdown;
+}
+
+Time
+NodeLifecycleManager::GetPredictedShutdownTime() const
+{
+    if (!m_thresholdEvent.IsPending())
+    {
+        return Time::Max();
+    }
+    return Simulator::Now() + Simulator::GetDelayLeft(m_thresholdEvent);
+}
+
+/*
+ * Private functions start here.
+ */
+
+void
+NodeLifecycleManager::DoInitialize()
+{
+    NS_LOG_FUNCTION(this);
+    Predict();
+    DeviceEnergyModel::DoInitialize();
+}
+
+void
+NodeLifecycleManager::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_thresholdEvent.Cancel();
+    m_depletionEvent.Cancel();
+    m_callbacks.clear();
+    m_source = nullptr;
+    DeviceEnergyModel::DoDispose();
+}
+
+bool
+NodeLifecycleManager::TimeToThreshold(Time& delay)
+{
+    double remainingJ = m_source->GetRemainingEnergy();
+    double powerW = m_source->CalculateTotalCurrent() * m_source->GetSupplyVoltage();
+    double marginJ = remainingJ - m_thresholdJ;
+    // within one time step of draw of the threshold, the event could not fire any closer
+    if (marginJ <= 0 || marginJ <= powerW * TimeStep(1).GetSeconds())
+    {
+        delay = Time(0);
+        return true;
+    }
+    if (powerW <= 0)
+    {
+        return false;
+    }
+    double delayS = marginJ / powerW;
+    if (delayS >= (Simulator::GetMaximumSimulationTime() - Simulator::Now()).GetSeconds())
+    {
+        return false;
+    }
+    delay = Seconds(delayS);
+    return true;
+}
+
+void
+NodeLifecycleManager::Predict()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_shutdown || !m_source)
+    {
+        return;
+    }
+    // with the same draw, the remaining energy is on the line the event was scheduled from
+    double currentA = m_source->CalculateTotalCurrent();
+    if (m_thresholdEvent.IsPending() && currentA == m_lastCurrentA)
+    {
+        return;
+    }
+    m_lastCurrentA = currentA;
+    Time delay;
+    if (!TimeToThreshold(delay))
+    {
+        m_thresholdEvent.Cancel();
+        return;
+    }
+    if (m_thresholdEvent.IsPending() &&
+        Abs(Simulator::GetDelayLeft(m_thresholdEvent) - delay) <= m_tolerance)
+    {
+        return;
+    }
+    NS_LOG_DEBUG("Threshold reached in " << delay.As(Time::S));
+    m_thresholdEvent.Cancel();
+    m_thresholdEvent =
+        Simulator::Schedule(delay, &NodeLifecycleManager::ThresholdReached, this);
+}
+
+void
+NodeLifecycleManager::ThresholdReached()
+{
+    NS_LOG_FUNCTION(this);
+    // the draw may have changed since the prediction: check before shutting down
+    Time delay;
+    if (TimeToThreshold(delay) && delay.IsZero())
+    {
+        Shutdown();
+    }
+    else
+    {
+        Predict();
+    }
+}
+
+} // namespace energy
+} // namespace ns3
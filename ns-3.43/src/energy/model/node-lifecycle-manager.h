@@ -0,0 +1,162 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#ifndef NODE_LIFECYCLE_MANAGER_H
+#define NODE_LIFECYCLE_MANAGER_H
+
+#include "device-energy-model.h"
+#include "energy-source.h"
+
+#include "ns3/callback.h"
+#include "ns3/event-id.h"
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/traced-callback.h"
+
+#include <vector>
+
+namespace ns3
+{
+namespace energy
+{
+
+/**
+ * \ingroup energy
+ * \brief Shuts a node down when its energy source runs low.
+ *
+ * The manager is attached to an EnergySource as a DeviceEnergyModel drawing no
+ * current. Rather than comparing the remaining energy with the shutdown
+ * threshold at every update of the source, it schedules a single event at the
+ * time the threshold is reached with the current draw of the source, and moves
+ * it only when an update of the source changes that prediction. When the event
+ * expires, the remaining energy is read again: the node is shut down if the
+ * threshold is reached, otherwise the event is scheduled anew with the draw at
+ * that time. A crossing caused by a higher draw than predicted is detected at
+ * the next update of the source at the latest. The depletion of the source
+ * (see e.g. BasicEnergySource::BasicEnergyLowBatteryThreshold) also shuts the
+ * node down.
+ *
+ * The shutdown takes place once, in one step: the shutdown callbacks are
+ * invoked, in the order they were added, to silence the devices and the
+ * protocol stacks of the node, which this module knows nothing about; then the
+ * applications of the node are stopped, the device energy models are detached
+ * from the source so that the node draws nothing more, and the Shutdown trace
+ * is fired. The node stays down if the source is recharged.
+ */
+class NodeLifecycleManager : public DeviceEnergyModel
+{
+  public:
+    /**
+     * Callback invoked to shut down part of a node, e.g. the queues of its
+     * devices or its IP interfaces.
+     */
+    typedef Callback<void, Ptr<Node>> ShutdownCallback;
+
+    /**
+     * TracedCallback signature for the shutdown of a node.
+     *
+     * \param [in] node The node shut down.
+     */
+    typedef void (*ShutdownTracedCallback)(Ptr<Node> node);
+
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+    NodeLifecycleManager();
+    ~NodeLifecycleManager() override;
+
+    /**
+     * \param source Pointer to the energy source watched.
+     */
+    void SetEnergySource(Ptr<EnergySource> source) override;
+
+    /**
+     * \returns 0, the manager draws no current.
+     */
+    double GetTotalEnergyConsumption() const override;
+
+    /**
+     * \param newState Ignored, the manager has no state.
+     */
+    void ChangeState(int newState) override;
+
+    /**
+     * Shuts the node down when the energy source is depleted.
+     */
+    void HandleEnergyDepletion() override;
+
+    /**
+     * A node shut down stays down.
+     */
+    void HandleEnergyRecharged() override;
+
+    /**
+     * Reschedules the threshold event if the update of the source moved it.
+     */
+    void HandleEnergyChanged() override;
+
+    /**
+     * \param callback Callback to invoke on shutdown, before the applications
+     * are stopped.
+     */
+    void AddShutdownCallback(ShutdownCallback callback);
+
+    /**
+     * Shut the node down now, if it is not already.
+     */
+    void Shutdown();
+
+    /**
+     * \returns Whether the node was shut down.
+     */
+    bool IsShutdown() const;
+
+    /**
+     * \returns The time at which the threshold event expires, or Time::Max ()
+     * if none is scheduled.
+     */
+    Time GetPredictedShutdownTime() const;
+
+  private:
+    void DoInitialize() override;
+    void DoDispose() override;
+
+    /**
+     * Schedule the threshold event at the time the remaining energy reaches
+     * the threshold with the current draw, unless it is already scheduled with
+     * the same draw or within the prediction tolerance of that time.
+     */
+    void Predict();
+
+    /**
+     * \param [out] delay Time until the remaining energy reaches the threshold
+     * with the current draw, zero if it already did.
+     * \returns False if the threshold is never reached with the current draw.
+     */
+    bool TimeToThreshold(Time& delay);
+
+    /**
+     * Handle the expiry of the threshold event.
+     */
+    void ThresholdReached();
+
+    Ptr<EnergySource> m_source;                //!< Energy source watched
+    double m_thresholdJ;                       //!< Shutdown threshold, in Joules
+    Time m_tolerance;                          //!< Prediction tolerance
+    double m_lastCurrentA;                     //!< Draw the threshold event was scheduled with
+    std::vector<ShutdownCallback> m_callbacks; //!< Shutdown callbacks
+    EventId m_thresholdEvent;                  //!< Predicted threshold crossing
+    EventId m_depletionEvent;                  //!< Shutdown on depletion of the source
+    bool m_shutdown;                           //!< Whether the node was shut down
+    TracedCallback<Ptr<Node>> m_shutdownTrace; //!< Node shut down
+};
+
+} // namespace energy
+} // namespace ns3
+
+#endif /* NODE_LIFECYCLE_MANAGER_H */
@@ -0,0 +1,229 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "ns3/basic-energy-source.h"
+#include "ns3/boolean.h"
+#include "ns3/device-energy-model.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::energy;
+
+NS_LOG_COMPONENT_DEFINE("BasicEnergySourceTestSuite");
+
+/**
+ * \ingroup energy-tests
+ *
+ * \brief Device energy model notifying its source before it changes its draw,
+ * as WifiRadioEnergyModel does
+ */
+class SteppedDeviceEnergyModel : public DeviceEnergyModel
+{
+  public:
+    void SetEnergySource(Ptr<EnergySource> source) override
+    {
+        m_source = source;
+    }
+
+    double GetTotalEnergyConsumption() const override
+    {
+        return 0;
+    }
+
+    void ChangeState(int newState) override
+    {
+    }
+
+    /**
+     * Change the current draw, unless the source was depleted
+     * \param currentA the new current draw, in Amperes
+     */
+    void SetCurrentA(double currentA)
+    {
+        if (m_depleted)
+        {
+            return;
+        }
+        m_source->UpdateEnergySource();
+        m_remainingJ.push_back(m_source->GetRemainingEnergy());
+        if (m_depleted)
+        {
+            return; // by this update
+        }
+        m_currentA = currentA;
+        m_source->UpdateCurrentDraw();
+    }
+
+    void HandleEnergyDepletion() override
+    {
+        m_depletedAt = Simulator::Now();
+        m_source->UpdateEnergySource();
+        m_currentA = 0;
+        m_source->UpdateCurrentDraw();
+        m_depleted = true;
+    }
+
+    void HandleEnergyRecharged() override
+    {
+    }
+
+    void HandleEnergyChanged() override
+    {
+    }
+
+    std::vector<double> m_remainingJ; //!< Remaining energy at each change of the draw
+    Time m_depletedAt{Time::Max()};    //!< Time of the depletion
+
+  private:
+    double DoGetCurrentA() const override
+    {
+        return m_currentA;
+    }
+
+    Ptr<EnergySource> m_source; //!< Energy source
+    double m_currentA{0};       //!< Current draw, in Amperes
+    bool m_depleted{false};     //!< Whether the source was depleted
+};
+
+/**
+ * \ingroup energy-tests
+ *
+ * \brief Predictive updates of the basic energy source against the periodic ones
+ */
+class BasicEnergySourcePredictiveTestCase : public TestCase
+{
+  public:
+    BasicEnergySourcePredictiveTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// Outcome of a run
+    struct Outcome
+    {
+        std::vector<double> remainingJ; //!< Remaining energy at each change of the draw
+        double finalJ;                  //!< Remaining energy at the end
+        Time depletedAt;                //!< Time of the depletion
+        uint64_t events;                //!< Events executed
+    };
+
+    /**
+     * Run one source with a draw changing at random times
+     * \param predictive whether to use the predictive updates
+     * \param changes the number of changes of the draw
+     * \param maxGap the maximum time between two changes of the draw
+     * \returns the outcome of the run
+     */
+    Outcome Run(bool predictive, uint32_t changes, Time maxGap);
+};
+
+BasicEnergySourcePredictiveTestCase::BasicEnergySourcePredictiveTestCase()
+    : TestCase("Predictive updates of the basic energy source")
+{
+}
+
+BasicEnergySourcePredictiveTestCase::Outcome
+BasicEnergySourcePredictiveTestCase::Run(bool predictive, uint32_t changes, Time maxGap)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+
+    Ptr<Node> node = CreateObject<Node>();
+    Ptr<BasicEnergySource> source = CreateObject<BasicEnergySource>();
+    source->SetAttribute("BasicEnergySourceInitialEnergyJ", DoubleValue(10));
+    source->SetAttribute("PredictiveUpdate", BooleanValue(predictive));
+    source->SetNode(node);
+    node->AggregateObject(source);
+
+    Ptr<SteppedDeviceEnergyModel> device = CreateObject<SteppedDeviceEnergyModel>();
+    device->SetEnergySource(source);
+    source->AppendDeviceEnergyModel(device);
+
+    Time at;
+    for (uint32_t i = 0; i < changes; ++i)
+    {
+        at += NanoSeconds(rng->GetInteger(1, maxGap.GetNanoSeconds()));
+        Simulator::Schedule(at,
+                            &SteppedDeviceEnergyModel::SetCurrentA,
+                            device,
+                            rng->GetValue(0.005, 0.02));
+    }
+    Outcome outcome;
+    // long enough after the last change for the source to be depleted
+    Simulator::Schedule(at + Seconds(1000), [&outcome, source]() {
+        outcome.finalJ = source->GetRemainingEnergy();
+    });
+    Simulator::Stop(at + Seconds(1000));
+    Simulator::Run();
+    outcome.remainingJ = device->m_remainingJ;
+    outcome.depletedAt = device->m_depletedAt;
+    outcome.events = Simulator::GetEventCount();
+    Simulator::Destroy();
+    return outcome;
+}
+
+void
+BasicEnergySourcePredictiveTestCase::DoRun()
+{
+    // constant draw: depleted at the same periodic update, from a single event
+    Outcome periodic = Run(false, 1, Seconds(1));
+    Outcome predictive = Run(true, 1, Seconds(1));
+    NS_TEST_ASSERT_MSG_NE(periodic.depletedAt, Time::Max(), "Source depleted");
+    NS_TEST_EXPECT_MSG_EQ(predictive.depletedAt, periodic.depletedAt, "Depletion time");
+    NS_TEST_EXPECT_MSG_EQ(predictive.finalJ, periodic.finalJ, "Remaining energy at the end");
+    NS_TEST_EXPECT_MSG_LT(predictive.events, 10, "A single update event");
+
+    // random draw, changing several times per periodic update or seldom
+    for (Time maxGap : {MilliSeconds(300), Seconds(3), Seconds(20)})
+    {
+        periodic = Run(false, 500, maxGap);
+        predictive = Run(true, 500, maxGap);
+        NS_TEST_ASSERT_MSG_EQ(predictive.remainingJ.size(),
+                              periodic.remainingJ.size(),
+                              "Changes of the draw");
+        for (std::size_t i = 0; i < periodic.remainingJ.size(); ++i)
+        {
+            // bit for bit
+            NS_TEST_ASSERT_MSG_EQ(predictive.remainingJ[i],
+                                  periodic.remainingJ[i],
+                                  "Remaining energy at change " << i);
+        }
+        NS_TEST_EXPECT_MSG_NE(periodic.depletedAt, Time::Max(), "Source depleted");
+        NS_TEST_EXPECT_MSG_EQ(predictive.depletedAt, periodic.depletedAt, "Depletion time");
+        NS_TEST_EXPECT_MSG_EQ(predictive.finalJ, periodic.finalJ, "Remaining energy at the end");
+        NS_TEST_EXPECT_MSG_LT(predictive.events, periodic.events, "Fewer events");
+    }
+}
+
+/**
+ * \ingroup energy-tests
+ *
+ * \brief Basic energy source TestSuite
+ */
+class BasicEnergySourceTestSuite : public TestSuite
+{
+  public:
+    BasicEnergySourceTestSuite();
+};
+
+BasicEnergySourceTestSuite::BasicEnergySourceTestSuite()
+    : TestSuite("basic-energy-source", Type::UNIT)
+{
+    AddTestCase(new BasicEnergySourcePredictiveTestCase, TestCase::Duration::QUICK);
+}
+
+/// create an instance of the test suite
+static BasicEnergySourceTestSuite g_basicEnergySourceTestSuite;
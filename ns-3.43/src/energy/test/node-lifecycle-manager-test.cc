@@ -0,0 +1,228 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "ns3/application.h"
+#include "ns3/basic-energy-source-helper.h"
+#include "ns3/basic-energy-source.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/node-container.h"
+#include "ns3/node-lifecycle-manager-helper.h"
+#include "ns3/node-lifecycle-manager.h"
+#include "ns3/simple-device-energy-model.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+using namespace ns3::energy;
+
+NS_LOG_COMPONENT_DEFINE("NodeLifecycleManagerTestSuite");
+
+/**
+ * \ingroup energy-tests
+ *
+ * \brief Application recording its start and stop
+ */
+class LifecycleTestApplication : public Application
+{
+  public:
+    bool m_started{false}; //!< Whether the application was started
+    uint32_t m_stops{0};   //!< Number of times the application was stopped
+
+  private:
+    void StartApplication() override
+    {
+        m_started = true;
+    }
+
+    void StopApplication() override
+    {
+        m_stops++;
+    }
+};
+
+/**
+ * \ingroup energy-tests
+ *
+ * \brief Shutdown of a node by its NodeLifecycleManager
+ */
+class NodeLifecycleManagerTestCase : public TestCase
+{
+  public:
+    NodeLifecycleManagerTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run one node until it is shut down
+     * \param thresholdJ the shutdown threshold, in Joules
+     * \param lowBatteryTh the low battery threshold of the source
+     * \param currentA the current drawn from the start
+     * \param changeAt the time at which the current changes
+     * \param newCurrentA the current drawn after the change
+     */
+    void Run(double thresholdJ,
+             double lowBatteryTh,
+             double currentA,
+             Time changeAt,
+             double newCurrentA);
+
+    /**
+     * Trace sink for the shutdown of the node
+     * \param node the node
+     */
+    void NodeShutdown(Ptr<Node> node);
+
+    /**
+     * Shutdown callback
+     * \param node the node
+     */
+    void StackDown(Ptr<Node> node);
+
+    Ptr<BasicEnergySource> m_source;       //!< Energy source of the node
+    Ptr<LifecycleTestApplication> m_app;   //!< Application started at once
+    Ptr<LifecycleTestApplication> m_later; //!< Application starting late
+    Time m_predicted;                      //!< Shutdown time predicted at start
+    Time m_shutdownAt;                     //!< Time of the shutdown
+    double m_remainingJ;                   //!< Remaining energy at the shutdown
+    uint32_t m_shutdowns;                  //!< Shutdown traces fired
+    uint32_t m_callbacks;                  //!< Shutdown callbacks invoked
+    bool m_appsRunning;                    //!< Whether the app ran when the callback was invoked
+};
+
+NodeLifecycleManagerTestCase::NodeLifecycleManagerTestCase()
+    : TestCase("Node lifecycle manager test case")
+{
+}
+
+void
+NodeLifecycleManagerTestCase::NodeShutdown(Ptr<Node> node)
+{
+    m_shutdowns++;
+    m_shutdownAt = Simulator::Now();
+    m_remainingJ = m_source->GetRemainingEnergy();
+}
+
+void
+NodeLifecycleManagerTestCase::StackDown(Ptr<Node> node)
+{
+    m_callbacks++;
+    m_appsRunning = m_app->m_stops == 0;
+}
+
+void
+NodeLifecycleManagerTestCase::Run(double thresholdJ,
+                                  double lowBatteryTh,
+                                  double currentA,
+                                  Time changeAt,
+                                  double newCurrentA)
+{
+    m_shutdowns = 0;
+    m_callbacks = 0;
+    m_appsRunning = false;
+    m_shutdownAt = Time::Max();
+
+    NodeContainer nodes(1);
+    BasicEnergySourceHelper sourceHelper;
+    sourceHelper.Set("BasicEnergySourceInitialEnergyJ", DoubleValue(10));
+    sourceHelper.Set("BasicEnergySupplyVoltageV", DoubleValue(3));
+    sourceHelper.Set("BasicEnergyLowBatteryThreshold", DoubleValue(lowBatteryTh));
+    EnergySourceContainer sources = sourceHelper.Install(nodes);
+    m_source = DynamicCast<BasicEnergySource>(sources.Get(0));
+
+    Ptr<SimpleDeviceEnergyModel> device = CreateObject<SimpleDeviceEnergyModel>();
+    device->SetEnergySource(m_source);
+    device->SetNode(nodes.Get(0));
+    m_source->AppendDeviceEnergyModel(device);
+    device->SetCurrentA(currentA);
+    Simulator::Schedule(changeAt, &SimpleDeviceEnergyModel::SetCurrentA, device, newCurrentA);
+
+    m_app = CreateObject<LifecycleTestApplication>();
+    nodes.Get(0)->AddApplication(m_app);
+    m_later = CreateObject<LifecycleTestApplication>();
+    m_later->SetStartTime(Seconds(50));
+    nodes.Get(0)->AddApplication(m_later);
+
+    NodeLifecycleManagerHelper helper;
+    helper.Set("ShutdownThreshold", DoubleValue(thresholdJ));
+    helper.AddShutdownCallback(MakeCallback(&NodeLifecycleManagerTestCase::StackDown, this));
+    DeviceEnergyModelContainer managers = helper.Install(sources);
+    Ptr<NodeLifecycleManager> manager = DynamicCast<NodeLifecycleManager>(managers.Get(0));
+    manager->TraceConnectWithoutContext(
+        "Shutdown",
+        MakeCallback(&NodeLifecycleManagerTestCase::NodeShutdown, this));
+    Simulator::Schedule(NanoSeconds(1), [this, manager]() {
+        m_predicted = manager->GetPredictedShutdownTime();
+    });
+
+    Simulator::Stop(Seconds(100));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(manager->IsShutdown(), true, "Node shut down");
+    NS_TEST_EXPECT_MSG_EQ(m_shutdowns, 1, "Shutdown traced once");
+    NS_TEST_EXPECT_MSG_EQ(m_callbacks, 1, "Shutdown callback invoked once");
+    NS_TEST_EXPECT_MSG_EQ(m_appsRunning, true, "Callbacks before the applications stop");
+    NS_TEST_EXPECT_MSG_EQ(m_app->m_started, true, "Application started");
+    NS_TEST_EXPECT_MSG_EQ(m_app->m_stops, 1, "Application stopped once");
+    NS_TEST_EXPECT_MSG_EQ(m_later->m_started, false, "Application never started");
+    NS_TEST_EXPECT_MSG_EQ(m_later->m_stops, 0, "Application never stopped");
+    NS_TEST_EXPECT_MSG_EQ(manager->GetPredictedShutdownTime(), Time::Max(), "No event left");
+    m_source->UpdateEnergySource();
+    NS_TEST_EXPECT_MSG_EQ(m_source->GetRemainingEnergy(),
+                          m_remainingJ,
+                          "No draw after the shutdown");
+
+    Simulator::Destroy();
+}
+
+void
+NodeLifecycleManagerTestCase::DoRun()
+{
+    double tolerance = 1e-6;
+
+    // constant draw of 0.3 W: 9 J to the threshold, in 30 s
+    Run(1, 0, 0.1, Seconds(200), 0);
+    NS_TEST_EXPECT_MSG_EQ(m_predicted, Seconds(30), "Threshold event scheduled ahead");
+    NS_TEST_EXPECT_MSG_EQ(m_shutdownAt, Seconds(30), "Shut down at the predicted time");
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_remainingJ, 1, tolerance, "Shut down at the threshold");
+
+    // the draw doubles at 10.5 s: rescheduled earlier
+    Run(1, 0, 0.1, Seconds(10.5), 0.2);
+    NS_TEST_EXPECT_MSG_EQ(m_predicted, Seconds(30), "Threshold event scheduled ahead");
+    NS_TEST_EXPECT_MSG_LT(m_shutdownAt, Seconds(30), "Shut down earlier");
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_remainingJ, 1, tolerance, "Shut down at the threshold");
+
+    // the draw halves at 10.5 s: rescheduled later
+    Run(1, 0, 0.2, Seconds(10.5), 0.1);
+    NS_TEST_EXPECT_MSG_EQ(m_predicted, Seconds(15), "Threshold event scheduled ahead");
+    NS_TEST_EXPECT_MSG_GT(m_shutdownAt, Seconds(15), "Shut down later");
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_remainingJ, 1, tolerance, "Shut down at the threshold");
+
+    // the source is depleted at 50%, detected by its periodic update at 17 s
+    Run(0, 0.5, 0.1, Seconds(200), 0);
+    NS_TEST_EXPECT_MSG_EQ(m_shutdownAt, Seconds(17), "Shut down on depletion");
+}
+
+/**
+ * \ingroup energy-tests
+ *
+ * \brief Node lifecycle manager TestSuite
+ */
+class NodeLifecycleManagerTestSuite : public TestSuite
+{
+  public:
+    NodeLifecycleManagerTestSuite();
+};
+
+NodeLifecycleManagerTestSuite::NodeLifecycleManagerTestSuite()
+    : TestSuite("node-lifecycle-manager", Type::UNIT)
+{
+    AddTestCase(new NodeLifecycleManagerTestCase, TestCase::Duration::QUICK);
+}
+
+/// create an instance of the test suite
+static NodeLifecycleManagerTestSuite g_nodeLifecycleManagerTestSuite;
@@ -70,7 +70,19 @@ FlowMonitor::GetTypeId()
                 ("The minimum inter-arrival time that is considered a flow interruption."),
                 TimeValue(Seconds(0.5)),
                 MakeTimeAccessor(&FlowMonitor::m_flowInterruptionsMinTime),
-                MakeTimeChecker());
+                MakeTimeChecker())
+            .AddTraceSource("FirstTx",
+                            "A packet enters a monitored flow.",
+                            MakeTraceSourceAccessor(&FlowMonitor::m_firstTxTrace),
+                            "ns3::FlowMonitor::FirstTxTracedCallback")
+            .AddTraceSource("LastRx",
+                            "A packet of a monitored flow is received at its destination.",
+                            MakeTraceSourceAccessor(&FlowMonitor::m_lastRxTrace),
+                            "ns3::FlowMonitor::LastRxTracedCallback")
+            .AddTraceSource("Drop",
+                            "A packet of a monitored flow is dropped.",
+                            MakeTraceSourceAccessor(&FlowMonitor::m_dropTrace),
+                            "ns3::FlowMonitor::DropTracedCallback");
     return tid;
 }
 
@@ -165,6 +177,7 @@ FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
         stats.timeFirstTxPacket = now;
     }
     stats.timeLastTxPacket = now;
+    m_firstTxTrace(flowId, packetId, packetSize);
 }
 
 void
@@ -264,6 +277,7 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
     }
     stats.timeLastRxPacket = now;
     stats.timesForwarded += tracked->second.timesForwarded;
+    m_lastRxTrace(flowId, packetId, packetSize, delay);
 
     NS_LOG_DEBUG("ReportLastTx: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                   << packetId << ").");
@@ -286,6 +300,7 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
     }
 
     probe->AddPacketDropStats(flowId, packetSize, reasonCode);
+    m_dropTrace(flowId, packetId, packetSize, reasonCode);
 
     FlowStats& stats = GetStatsForFlow(flowId);
     stats.lostPackets++;
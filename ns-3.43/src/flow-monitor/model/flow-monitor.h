@@ -17,6 +17,7 @@
 #include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
 
 #include <map>
 #include <vector>
@@ -270,6 +271,34 @@ class FlowMonitor : public Object
     /// Reset all the statistics
     void ResetAllStats();
 
+    /// TracedCallback signature for the first transmission of a packet.
+    /// \param [in] flowId flow identification
+    /// \param [in] packetId Packet ID
+    /// \param [in] packetSize packet size
+    typedef void (*FirstTxTracedCallback)(FlowId flowId,
+                                          FlowPacketId packetId,
+                                          uint32_t packetSize);
+
+    /// TracedCallback signature for the reception of a packet at its destination.
+    /// \param [in] flowId flow identification
+    /// \param [in] packetId Packet ID
+    /// \param [in] packetSize packet size
+    /// \param [in] delay end-to-end delay of the packet
+    typedef void (*LastRxTracedCallback)(FlowId flowId,
+                                         FlowPacketId packetId,
+                                         uint32_t packetSize,
+                                         Time delay);
+
+    /// TracedCallback signature for the drop of a packet.
+    /// \param [in] flowId flow identification
+    /// \param [in] packetId Packet ID
+    /// \param [in] packetSize packet size
+    /// \param [in] reasonCode drop reason code
+    typedef void (*DropTracedCallback)(FlowId flowId,
+                                       FlowPacketId packetId,
+                                       uint32_t packetSize,
+                                       uint32_t reasonCode);
+
   protected:
     void NotifyConstructionCompleted() override;
     void DoDispose() override;
@@ -304,6 +333,13 @@ class FlowMonitor : public Object
     double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
     Time m_flowInterruptionsMinTime;    //!< Flow interruptions minimum time
 
+    /// Trace of the packets entering the monitored flows
+    TracedCallback<FlowId, FlowPacketId, uint32_t> m_firstTxTrace;
+    /// Trace of the packets received at the end of the monitored flows
+    TracedCallback<FlowId, FlowPacketId, uint32_t, Time> m_lastRxTrace;
+    /// Trace of the packets of the monitored flows dropped
+    TracedCallback<FlowId, FlowPacketId, uint32_t, uint32_t> m_dropTrace;
+
     /// Get the stats for a given flow
     /// \param flowId the Flow identification
     /// \returns the stats of the flow
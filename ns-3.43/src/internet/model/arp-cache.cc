@@ -68,7 +68,12 @@ ArpCache::GetTypeId()
                                             "Packet dropped due to ArpCache entry "
                                             "in WaitReply expiring.",
                                             MakeTraceSourceAccessor(&ArpCache::m_dropTrace),
-                                            "ns3::Packet::TracedCallback");
+                                            "ns3::Packet::TracedCallback")
+                            .AddTraceSource("Resolved",
+                                            "An entry of the ArpCache is resolved to a "
+                                            "MAC address.",
+                                            MakeTraceSourceAccessor(&ArpCache::m_resolvedTrace),
+                                            "ns3::ArpCache::ResolvedTracedCallback");
     return tid;
 }
 
@@ -429,6 +434,7 @@ ArpCache::Entry::MarkAlive(Address macAddress)
     m_state = ALIVE;
     ClearRetries();
     UpdateSeen();
+    m_arp->m_resolvedTrace(m_ipv4Address, m_macAddress);
 }
 
 void
@@ -440,6 +446,7 @@ ArpCache::Entry::MarkPermanent()
     m_state = PERMANENT;
     ClearRetries();
     UpdateSeen();
+    m_arp->m_resolvedTrace(m_ipv4Address, m_macAddress);
 }
 
 void
@@ -451,6 +458,7 @@ ArpCache::Entry::MarkAutoGenerated()
     m_state = STATIC_AUTOGENERATED;
     ClearRetries();
     UpdateSeen();
+    m_arp->m_resolvedTrace(m_ipv4Address, m_macAddress);
 }
 
 bool
@@ -161,6 +161,14 @@ class ArpCache : public Object
      */
     void RemoveAutoGeneratedEntries();
 
+    /**
+     * TracedCallback signature for the resolution of an address.
+     *
+     * \param [in] ipv4Address The resolved IPv4 address.
+     * \param [in] macAddress The MAC address it resolves to.
+     */
+    typedef void (*ResolvedTracedCallback)(Ipv4Address ipv4Address, const Address& macAddress);
+
     /**
      * \brief Pair of a packet and an Ipv4 header.
      */
@@ -338,6 +346,8 @@ class ArpCache : public Object
     Cache m_arpCache;            //!< the ARP cache
     TracedCallback<Ptr<const Packet>>
         m_dropTrace; //!< trace for packets dropped by the ARP cache queue
+    TracedCallback<Ipv4Address, const Address&>
+        m_resolvedTrace; //!< trace for the addresses resolved by the ARP cache
 };
 
 } // namespace ns3
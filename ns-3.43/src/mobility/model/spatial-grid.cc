@@ -0,0 +1,192 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "spatial-grid.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SpatialGrid");
+
+SpatialGrid::SpatialGrid()
+    : m_cellSize(100)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+SpatialGrid::~SpatialGrid()
+{
+    NS_LOG_FUNCTION(this);
+    Clear();
+}
+
+void
+SpatialGrid::SetCellSize(double cellSize)
+{
+    NS_LOG_FUNCTION(this << cellSize);
+    NS_ASSERT_MSG(m_items.empty(), "The cell size of a grid must be set before it is used");
+    NS_ASSERT(cellSize > 0);
+    m_cellSize = cellSize;
+}
+
+double
+SpatialGrid::GetCellSize() const
+{
+    return m_cellSize;
+}
+
+uint32_t
+SpatialGrid::Add(Ptr<MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    NS_ASSERT(mobility);
+    NS_ASSERT_MSG(m_byModel.find(PeekPointer(mobility)) == m_byModel.end(),
+                  "Mobility model already in the grid");
+    auto index = static_cast<uint32_t>(m_items.size());
+    Vector position = mobility->GetPosition();
+    uint64_t cell = GetKey(GetCellCoordinate(position.x), GetCellCoordinate(position.y));
+    m_items.push_back({mobility, cell, Time::Max()});
+    m_cells[cell].push_back(index);
+    m_byModel[PeekPointer(mobility)] = index;
+    mobility->TraceConnectWithoutContext("CourseChange",
+                                         MakeCallback(&SpatialGrid::CourseChanged, this));
+    File(index);
+    return index;
+}
+
+uint32_t
+SpatialGrid::GetN() const
+{
+    return m_items.size();
+}
+
+void
+SpatialGrid::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& item : m_items)
+    {
+        item.mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&SpatialGrid::CourseChanged, this));
+    }
+    m_items.clear();
+    m_byModel.clear();
+    m_cells.clear();
+    m_deadlines = {};
+}
+
+void
+SpatialGrid::Query(const Vector& position, double range, std::vector<uint32_t>& indices)
+{
+    NS_LOG_FUNCTION(this << position << range);
+    Refresh();
+    indices.clear();
+    double extent = range + m_cellSize / 2;
+    int64_t minX = GetCellCoordinate(position.x - extent);
+    int64_t maxX = GetCellCoordinate(position.x + extent);
+    int64_t minY = GetCellCoordinate(position.y - extent);
+    int64_t maxY = GetCellCoordinate(position.y + extent);
+    if (static_cast<double>(maxX - minX + 1) * (maxY - minY + 1) < m_cells.size())
+    {
+        for (int64_t x = minX; x <= maxX; x++)
+        {
+            for (int64_t y = minY; y <= maxY; y++)
+            {
+                auto it = m_cells.find(GetKey(x, y));
+                if (it != m_cells.end())
+                {
+                    indices.insert(indices.end(), it->second.begin(), it->second.end());
+                }
+            }
+        }
+    }
+    else
+    {
+        // fewer occupied cells than cells in range
+        for (const auto& [cell, items] : m_cells)
+        {
+            auto x = static_cast<int32_t>(cell >> 32);
+            auto y = static_cast<int32_t>(cell & 0xffffffff);
+            if (x >= minX && x <= maxX && y >= minY && y <= maxY)
+            {
+                indices.insert(indices.end(), items.begin(), items.end());
+            }
+        }
+    }
+    std::sort(indices.begin(), indices.end());
+}
+
+uint64_t
+SpatialGrid::GetKey(int64_t x, int64_t y)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+int64_t
+SpatialGrid::GetCellCoordinate(double coordinate) const
+{
+    return static_cast<int64_t>(std::floor(coordinate / m_cellSize));
+}
+
+void
+SpatialGrid::File(uint32_t index)
+{
+    Item& item = m_items[index];
+    Vector position = item.mobility->GetPosition();
+    double speed = item.mobility->GetVelocity().GetLength();
+    uint64_t cell = GetKey(GetCellCoordinate(position.x), GetCellCoordinate(position.y));
+    if (cell != item.cell)
+    {
+        NS_LOG_LOGIC("Model " << index << " moved to " << position);
+        auto& previous = m_cells[item.cell];
+        previous.erase(std::find(previous.begin(), previous.end(), index));
+        if (previous.empty())
+        {
+            m_cells.erase(item.cell);
+        }
+        m_cells[cell].push_back(index);
+        item.cell = cell;
+    }
+    item.deadline = Time::Max();
+    if (speed > 0)
+    {
+        item.deadline = Simulator::Now() + Seconds(m_cellSize / 2 / speed);
+        m_deadlines.emplace(item.deadline, index);
+    }
+}
+
+void
+SpatialGrid::Refresh()
+{
+    Time now = Simulator::Now();
+    while (!m_deadlines.empty() && m_deadlines.top().first <= now)
+    {
+        auto [deadline, index] = m_deadlines.top();
+        m_deadlines.pop();
+        if (m_items[index].deadline == deadline)
+        {
+            File(index);
+        }
+    }
+}
+
+void
+SpatialGrid::CourseChanged(Ptr<const MobilityModel> mobility)
+{
+    auto it = m_byModel.find(PeekPointer(mobility));
+    NS_ASSERT(it != m_byModel.end());
+    File(it->second);
+}
+
+} // namespace ns3
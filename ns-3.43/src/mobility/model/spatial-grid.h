@@ -0,0 +1,133 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include "mobility-model.h"
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup mobility
+ * \brief Uniform grid index of the positions of a set of mobility models
+ *
+ * The horizontal plane is divided into square cells, and each mobility model added to the
+ * grid is filed in the cell of its position. The grid follows the CourseChange trace of the
+ * models, so that a model moved to a new position, or given a new velocity, is filed again
+ * immediately. A model moving at constant velocity does not notify its course changes: it is
+ * filed again, when the grid is queried, once it may have moved by half a cell since it was
+ * last filed, and the queries are extended by half a cell to account for the distance it may
+ * have traveled meanwhile.
+ *
+ * This assumes that the models notify every change of their velocity, which is the case of
+ * the models of this module except the ConstantAccelerationMobilityModel and the
+ * WaypointMobilityModel in LazyNotify mode.
+ */
+class SpatialGrid
+{
+  public:
+    SpatialGrid();
+    ~SpatialGrid();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    SpatialGrid(const SpatialGrid&) = delete;
+    SpatialGrid& operator=(const SpatialGrid&) = delete;
+
+    /**
+     * Set the size of the cells; the grid must be empty
+     * \param cellSize the width of the square cells, in meters
+     */
+    void SetCellSize(double cellSize);
+    /**
+     * \returns the width of the square cells, in meters
+     */
+    double GetCellSize() const;
+
+    /**
+     * Add a mobility model to the grid
+     * \param mobility the mobility model
+     * \returns the index of the model, which is the number of models added before it
+     */
+    uint32_t Add(Ptr<MobilityModel> mobility);
+    /**
+     * \returns the number of mobility models in the grid
+     */
+    uint32_t GetN() const;
+    /**
+     * Remove all the mobility models from the grid
+     */
+    void Clear();
+
+    /**
+     * Collect the mobility models which may lie within range of a position, that is every
+     * model whose horizontal distance from the position is at most the range, and possibly
+     * others close to it
+     * \param position the position
+     * \param range the range, in meters
+     * \param [out] indices the indices of the models, in increasing order
+     */
+    void Query(const Vector& position, double range, std::vector<uint32_t>& indices);
+
+  private:
+    /// Mobility model filed in the grid
+    struct Item
+    {
+        Ptr<MobilityModel> mobility; //!< Mobility model
+        uint64_t cell;               //!< Key of the cell it is filed in
+        Time deadline;               //!< Time it must be filed again by, Time::Max () if static
+    };
+
+    /**
+     * \param x the horizontal coordinate of the cell
+     * \param y the vertical coordinate of the cell
+     * \returns the key of the cell
+     */
+    static uint64_t GetKey(int64_t x, int64_t y);
+    /**
+     * \param coordinate a coordinate of a position
+     * \returns the coordinate of its cell
+     */
+    int64_t GetCellCoordinate(double coordinate) const;
+    /**
+     * File a mobility model in the cell of its current position
+     * \param index the index of the model
+     */
+    void File(uint32_t index);
+    /**
+     * File again the moving models which may have left their cell
+     */
+    void Refresh();
+    /**
+     * CourseChange trace sink
+     * \param mobility the mobility model
+     */
+    void CourseChanged(Ptr<const MobilityModel> mobility);
+
+    /// Time a model must be filed again by, and its index
+    typedef std::pair<Time, uint32_t> Deadline;
+
+    double m_cellSize;                                            //!< Width of the cells
+    std::vector<Item> m_items;                                    //!< Models, by index
+    std::unordered_map<const MobilityModel*, uint32_t> m_byModel; //!< Index of each model
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells;  //!< Models in each cell
+    /// Deadlines of the moving models, earliest first; stale ones are skipped
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<>> m_deadlines;
+};
+
+} // namespace ns3
+
+#endif /* SPATIAL_GRID_H */
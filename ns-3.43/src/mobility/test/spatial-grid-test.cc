@@ -0,0 +1,152 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/spatial-grid.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+
+using namespace ns3;
+
+/**
+ * \ingroup mobility-test
+ *
+ * \brief The SpatialGrid queries return every model within range, static or moving
+ */
+class SpatialGridTestCase : public TestCase
+{
+  public:
+    SpatialGridTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * Query the grid around random positions and check the results against every model
+     * \param grid the grid
+     * \param models the models in the grid, by index
+     */
+    void Check(SpatialGrid* grid, std::vector<Ptr<MobilityModel>>* models);
+
+    Ptr<UniformRandomVariable> m_random; //!< Positions and ranges of the queries
+    uint32_t m_candidates;               //!< Models returned by the queries
+    uint32_t m_total;                    //!< Models examined by the queries
+};
+
+SpatialGridTestCase::SpatialGridTestCase()
+    : TestCase("Spatial grid queries of static and moving models"),
+      m_candidates(0),
+      m_total(0)
+{
+}
+
+void
+SpatialGridTestCase::Check(SpatialGrid* grid, std::vector<Ptr<MobilityModel>>* models)
+{
+    std::vector<uint32_t> indices;
+    for (uint32_t k = 0; k < 20; k++)
+    {
+        Vector position(m_random->GetValue(0, 1000), m_random->GetValue(0, 1000), 0);
+        double range = m_random->GetValue(0, 300);
+        grid->Query(position, range, indices);
+        NS_TEST_EXPECT_MSG_EQ(std::is_sorted(indices.begin(), indices.end()),
+                              true,
+                              "Indices in increasing order");
+        for (uint32_t i = 0; i < models->size(); i++)
+        {
+            Vector p = (*models)[i]->GetPosition();
+            double distance = CalculateDistance(Vector(p.x, p.y, 0), position);
+            if (distance <= range)
+            {
+                NS_TEST_EXPECT_MSG_EQ(std::binary_search(indices.begin(), indices.end(), i),
+                                      true,
+                                      "Model " << i << " at " << distance << " m of " << position
+                                               << " missed at " << Simulator::Now().As(Time::S));
+            }
+        }
+        m_candidates += indices.size();
+        m_total += models->size();
+    }
+}
+
+void
+SpatialGridTestCase::DoRun()
+{
+    m_random = CreateObject<UniformRandomVariable>();
+    m_random->SetStream(1);
+    SpatialGrid grid;
+    grid.SetCellSize(100);
+    std::vector<Ptr<MobilityModel>> models;
+
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        Ptr<MobilityModel> mobility;
+        if (i % 2)
+        {
+            mobility = CreateObject<ConstantPositionMobilityModel>();
+        }
+        else
+        {
+            Ptr<ConstantVelocityMobilityModel> moving =
+                CreateObject<ConstantVelocityMobilityModel>();
+            moving->SetVelocity(
+                Vector(m_random->GetValue(-20, 20), m_random->GetValue(-20, 20), 0));
+            mobility = moving;
+        }
+        mobility->SetPosition(Vector(m_random->GetValue(0, 1000), m_random->GetValue(0, 1000), 0));
+        NS_TEST_EXPECT_MSG_EQ(grid.Add(mobility), i, "Index of the model");
+        models.push_back(mobility);
+    }
+    NS_TEST_EXPECT_MSG_EQ(grid.GetN(), 100, "Models in the grid");
+
+    for (uint32_t t = 0; t < 40; t++)
+    {
+        Simulator::Schedule(Seconds(0.7 * t), &SpatialGridTestCase::Check, this, &grid, &models);
+    }
+    // jumps to new positions, and new velocities
+    Simulator::Schedule(Seconds(10), [&]() {
+        for (uint32_t i = 0; i < models.size(); i += 3)
+        {
+            models[i]->SetPosition(
+                Vector(m_random->GetValue(0, 1000), m_random->GetValue(0, 1000), 0));
+        }
+        for (uint32_t i = 0; i < models.size(); i += 4)
+        {
+            models[i]->GetObject<ConstantVelocityMobilityModel>()->SetVelocity(
+                Vector(m_random->GetValue(-20, 20), m_random->GetValue(-20, 20), 0));
+        }
+    });
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_LT(m_candidates, m_total / 2, "The queries examine few models");
+    grid.Clear();
+    NS_TEST_EXPECT_MSG_EQ(grid.GetN(), 0, "Empty grid");
+    models[1]->SetPosition(Vector(0, 0, 0));
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup mobility-test
+ *
+ * \brief Spatial grid test suite
+ */
+class SpatialGridTestSuite : public TestSuite
+{
+  public:
+    SpatialGridTestSuite();
+};
+
+SpatialGridTestSuite::SpatialGridTestSuite()
+    : TestSuite("spatial-grid", Type::UNIT)
+{
+    AddTestCase(new SpatialGridTestCase, TestCase::Duration::QUICK);
+}
+
+static SpatialGridTestSuite g_spatialGridTestSuite; //!< Static variable for test initialization
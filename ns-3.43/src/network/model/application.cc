@@ -47,6 +47,7 @@ Application::GetTypeId()
 
 // \brief Application Constructor
 Application::Application()
+    : m_stopped(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -69,6 +70,56 @@ Application::SetStopTime(Time stop)
 {
     NS_LOG_FUNCTION(this << stop);
     m_stopTime = stop;
+    if (!IsInitialized())
+    {
+        return;
+    }
+    if (m_stopped)
+    {
+        NS_LOG_LOGIC("Application already stopped");
+        return;
+    }
+    // DoInitialize already scheduled the events: move the stop event, or do not start at all
+    m_stopEvent.Cancel();
+    if (m_stopTime == TimeStep(0))
+    {
+        return;
+    }
+    if (m_startEvent.IsPending() && Simulator::GetDelayLeft(m_startEvent) >= stop)
+    {
+        m_startEvent.Cancel();
+        m_stopped = true;
+        return;
+    }
+    m_stopEvent = Simulator::Schedule(stop, &Application::HandleStop, this);
+}
+
+void
+Application::StopRightNow()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_stopped)
+    {
+        NS_LOG_LOGIC("Application already stopped");
+        return;
+    }
+    m_stopEvent.Cancel();
+    if (!IsInitialized() || m_startEvent.IsPending())
+    {
+        // not started yet
+        m_startEvent.Cancel();
+        m_stopped = true;
+        return;
+    }
+    HandleStop();
+}
+
+void
+Application::HandleStop()
+{
+    NS_LOG_FUNCTION(this);
+    m_stopped = true;
+    StopApplication();
 }
 
 void
@@ -85,10 +136,16 @@ void
 Application::DoInitialize()
 {
     NS_LOG_FUNCTION(this);
+    if (m_stopped)
+    {
+        // stopped before it was initialized
+        Object::DoInitialize();
+        return;
+    }
     m_startEvent = Simulator::Schedule(m_startTime, &Application::StartApplication, this);
     if (m_stopTime != TimeStep(0))
     {
-        m_stopEvent = Simulator::Schedule(m_stopTime, &Application::StopApplication, this);
+        m_stopEvent = Simulator::Schedule(m_stopTime, &Application::HandleStop, this);
     }
     Object::DoInitialize();
 }
@@ -81,9 +81,23 @@ class Application : public Object
      * application is to stop.  The application subclasses should override
      * the private StopApplication method, to be notified when that
      * time has come.
+     *
+     * Once the application is initialized, the stop is rescheduled
+     * \p stop after the current time, and a zero value cancels it, as it
+     * does before. An application stopped before it starts is never
+     * started. This has no effect once the application is stopped.
      */
     void SetStopTime(Time stop);
 
+    /**
+     * \brief Stop the application now
+     *
+     * The application is stopped once: this has no effect if it is
+     * already stopped. An application stopped before it starts is never
+     * started.
+     */
+    void StopRightNow();
+
     /**
      * \returns the Node to which this Application object is attached.
      */
@@ -140,6 +154,11 @@ class Application : public Object
      */
     virtual void StopApplication();
 
+    /**
+     * \brief Call StopApplication, and remember the application is stopped
+     */
+    void HandleStop();
+
   protected:
     void DoDispose() override;
     void DoInitialize() override;
@@ -149,6 +168,7 @@ class Application : public Object
     Time m_stopTime;      //!< The simulation time that the application will end
     EventId m_startEvent; //!< The event that will fire at m_startTime to start the application
     EventId m_stopEvent;  //!< The event that will fire at m_stopTime to end the application
+    bool m_stopped;       //!< True once the application is stopped
 };
 
 } // namespace ns3
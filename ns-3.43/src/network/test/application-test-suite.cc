@@ -0,0 +1,145 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "ns3/application.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+namespace
+{
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Application recording when it starts and stops
+ *
+ * \note Class internal to application-test-suite.cc
+ */
+class ApplicationTestApp : public Application
+{
+  public:
+    Time m_startedAt{Time::Max()}; //!< Time of the last start
+    Time m_stoppedAt{Time::Max()}; //!< Time of the last stop
+    uint32_t m_starts{0};          //!< Number of starts
+    uint32_t m_stops{0};           //!< Number of stops
+
+  private:
+    void StartApplication() override
+    {
+        m_startedAt = Simulator::Now();
+        m_starts++;
+    }
+
+    void StopApplication() override
+    {
+        m_stoppedAt = Simulator::Now();
+        m_stops++;
+    }
+};
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Changes of the stop time of applications already initialized
+ */
+class ApplicationStopTestCase : public TestCase
+{
+  public:
+    ApplicationStopTestCase()
+        : TestCase("Stop time set after the application is initialized")
+    {
+    }
+
+  private:
+    /**
+     * \param node the node to install the application on
+     * \param start the start time of the application
+     * \param stop the stop time of the application
+     * \returns the application
+     */
+    Ptr<ApplicationTestApp> Install(Ptr<Node> node, Time start, Time stop)
+    {
+        Ptr<ApplicationTestApp> app = CreateObject<ApplicationTestApp>();
+        app->SetStartTime(start);
+        app->SetStopTime(stop);
+        node->AddApplication(app);
+        return app;
+    }
+
+    void DoRun() override
+    {
+        Ptr<Node> node = CreateObject<Node>();
+
+        // the stop is moved relative to the time it is set
+        Ptr<ApplicationTestApp> moved = Install(node, Seconds(1), Seconds(10));
+        Simulator::Schedule(Seconds(2), &Application::SetStopTime, moved, Seconds(3));
+
+        // a zero stop time means no stop, as before the initialization
+        Ptr<ApplicationTestApp> never = Install(node, Seconds(1), Seconds(10));
+        Simulator::Schedule(Seconds(2), &Application::SetStopTime, never, Seconds(0));
+
+        // a stop before the start: the application never starts
+        Ptr<ApplicationTestApp> early = Install(node, Seconds(8), Seconds(0));
+        Simulator::Schedule(Seconds(2), &Application::SetStopTime, early, Seconds(1));
+
+        // stopped now, once: later stops have no effect
+        Ptr<ApplicationTestApp> now = Install(node, Seconds(1), Seconds(0));
+        Simulator::Schedule(Seconds(4), &Application::StopRightNow, now);
+        Simulator::Schedule(Seconds(5), &Application::StopRightNow, now);
+        Simulator::Schedule(Seconds(6), &Application::SetStopTime, now, Seconds(1));
+
+        // stopped now before it starts
+        Ptr<ApplicationTestApp> notStarted = Install(node, Seconds(8), Seconds(9));
+        Simulator::Schedule(Seconds(4), &Application::StopRightNow, notStarted);
+
+        Simulator::Stop(Seconds(20));
+        Simulator::Run();
+
+        NS_TEST_EXPECT_MSG_EQ(moved->m_startedAt, Seconds(1), "Started");
+        NS_TEST_EXPECT_MSG_EQ(moved->m_stops, 1, "Stopped once");
+        NS_TEST_EXPECT_MSG_EQ(moved->m_stoppedAt, Seconds(5), "Stop moved");
+
+        NS_TEST_EXPECT_MSG_EQ(never->m_starts, 1, "Started");
+        NS_TEST_EXPECT_MSG_EQ(never->m_stops, 0, "Stop cancelled");
+
+        NS_TEST_EXPECT_MSG_EQ(early->m_starts, 0, "Never started");
+        NS_TEST_EXPECT_MSG_EQ(early->m_stops, 0, "Never stopped");
+
+        NS_TEST_EXPECT_MSG_EQ(now->m_starts, 1, "Started");
+        NS_TEST_EXPECT_MSG_EQ(now->m_stops, 1, "Stopped once");
+        NS_TEST_EXPECT_MSG_EQ(now->m_stoppedAt, Seconds(4), "Stopped right now");
+
+        NS_TEST_EXPECT_MSG_EQ(notStarted->m_starts, 0, "Never started");
+        NS_TEST_EXPECT_MSG_EQ(notStarted->m_stops, 0, "Never stopped");
+
+        Simulator::Destroy();
+    }
+};
+
+} // namespace
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Application TestSuite
+ */
+class ApplicationTestSuite : public TestSuite
+{
+  public:
+    ApplicationTestSuite()
+        : TestSuite("application", Type::UNIT)
+    {
+        AddTestCase(new ApplicationStopTestCase(), TestCase::Duration::QUICK);
+    }
+};
+
+static ApplicationTestSuite g_applicationTestSuite; //!< Static variable for test initialization
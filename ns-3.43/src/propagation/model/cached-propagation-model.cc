@@ -0,0 +1,260 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "cached-propagation-model.h"
+
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("CachedPropagationModel");
+
+NS_OBJECT_ENSURE_REGISTERED(CachedPropagationLossModel);
+
+TypeId
+CachedPropagationLossModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::CachedPropagationLossModel")
+            .SetParent<PropagationLossModel>()
+            .SetGroupName("Propagation")
+            .AddConstructor<CachedPropagationLossModel>()
+            .AddAttribute("Model",
+                          "The propagation loss model memoized.",
+                          PointerValue(),
+                          MakePointerAccessor(&CachedPropagationLossModel::m_model),
+                          MakePointerChecker<PropagationLossModel>())
+            .AddAttribute("PositionTolerance",
+                          "The distance (m) an end of a link with a moving end may move by "
+                          "before the loss of the link is computed again.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&CachedPropagationLossModel::SetPositionTolerance),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("MaxEntries",
+                          "The number of links beyond which the cache is emptied.",
+                          UintegerValue(1000000),
+                          MakeUintegerAccessor(&CachedPropagationLossModel::SetMaxEntries),
+                          MakeUintegerChecker<uint32_t>(1));
+    return tid;
+}
+
+CachedPropagationLossModel::CachedPropagationLossModel()
+    : m_hits(0),
+      m_misses(0)
+{
+}
+
+CachedPropagationLossModel::~CachedPropagationLossModel()
+{
+}
+
+void
+CachedPropagationLossModel::DoDispose()
+{
+    m_cache.Clear();
+    m_model = nullptr;
+    PropagationLossModel::DoDispose();
+}
+
+bool
+CachedPropagationLossModel::IsDeterministic() const
+{
+    // the whole chain of the model is memoized, all its stages must be deterministic
+    for (Ptr<PropagationLossModel> stage = m_model; stage; stage = stage->GetNext())
+    {
+        if (!stage->IsDeterministic())
+        {
+            return false;
+        }
+    }
+    return bool(m_model);
+}
+
+void
+CachedPropagationLossModel::SetPositionTolerance(double tolerance)
+{
+    m_cache.SetPositionTolerance(tolerance);
+}
+
+void
+CachedPropagationLossModel::SetMaxEntries(uint32_t maxEntries)
+{
+    m_cache.SetMaxEntries(maxEntries);
+}
+
+void
+CachedPropagationLossModel::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    m_cache.Clear();
+}
+
+uint64_t
+CachedPropagationLossModel::GetHits() const
+{
+    return m_hits;
+}
+
+uint64_t
+CachedPropagationLossModel::GetMisses() const
+{
+    return m_misses;
+}
+
+double
+CachedPropagationLossModel::GetHitRate() const
+{
+    return (m_hits + m_misses) ? static_cast<double>(m_hits) / (m_hits + m_misses) : 0;
+}
+
+double
+CachedPropagationLossModel::DoCalcRxPower(double txPowerDbm,
+                                          Ptr<MobilityModel> a,
+                                          Ptr<MobilityModel> b) const
+{
+    NS_ASSERT_MSG(m_model, "No propagation loss model to memoize");
+    const RxPower* cached = m_cache.Lookup(a, b);
+    if (cached && cached->txPowerDbm == txPowerDbm)
+    {
+        m_hits++;
+        return cached->rxPowerDbm;
+    }
+    m_misses++;
+    double rxPowerDbm = m_model->CalcRxPower(txPowerDbm, a, b);
+    if (IsDeterministic())
+    {
+        m_cache.Store(a, b, {txPowerDbm, rxPowerDbm});
+    }
+    return rxPowerDbm;
+}
+
+int64_t
+CachedPropagationLossModel::DoAssignStreams(int64_t stream)
+{
+    return m_model ? m_model->AssignStreams(stream) : 0;
+}
+
+// ------------------------------------------------------------------------- //
+
+NS_OBJECT_ENSURE_REGISTERED(CachedPropagationDelayModel);
+
+TypeId
+CachedPropagationDelayModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::CachedPropagationDelayModel")
+            .SetParent<PropagationDelayModel>()
+            .SetGroupName("Propagation")
+            .AddConstructor<CachedPropagationDelayModel>()
+            .AddAttribute("Model",
+                          "The propagation delay model memoized.",
+                          PointerValue(),
+                          MakePointerAccessor(&CachedPropagationDelayModel::m_model),
+                          MakePointerChecker<PropagationDelayModel>())
+            .AddAttribute("PositionTolerance",
+                          "The distance (m) an end of a link with a moving end may move by "
+                          "before the delay of the link is computed again.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&CachedPropagationDelayModel::SetPositionTolerance),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("MaxEntries",
+                          "The number of links beyond which the cache is emptied.",
+                          UintegerValue(1000000),
+                          MakeUintegerAccessor(&CachedPropagationDelayModel::SetMaxEntries),
+                          MakeUintegerChecker<uint32_t>(1));
+    return tid;
+}
+
+CachedPropagationDelayModel::CachedPropagationDelayModel()
+    : m_hits(0),
+      m_misses(0)
+{
+}
+
+CachedPropagationDelayModel::~CachedPropagationDelayModel()
+{
+}
+
+void
+CachedPropagationDelayModel::DoDispose()
+{
+    m_cache.Clear();
+    m_model = nullptr;
+    PropagationDelayModel::DoDispose();
+}
+
+bool
+CachedPropagationDelayModel::IsDeterministic() const
+{
+    return m_model && m_model->IsDeterministic();
+}
+
+void
+CachedPropagationDelayModel::SetPositionTolerance(double tolerance)
+{
+    m_cache.SetPositionTolerance(tolerance);
+}
+
+void
+CachedPropagationDelayModel::SetMaxEntries(uint32_t maxEntries)
+{
+    m_cache.SetMaxEntries(maxEntries);
+}
+
+void
+CachedPropagationDelayModel::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    m_cache.Clear();
+}
+
+uint64_t
+CachedPropagationDelayModel::GetHits() const
+{
+    return m_hits;
+}
+
+uint64_t
+CachedPropagationDelayModel::GetMisses() const
+{
+    return m_misses;
+}
+
+double
+CachedPropagationDelayModel::GetHitRate() const
+{
+    return (m_hits + m_misses) ? static_cast<double>(m_hits) / (m_hits + m_misses) : 0;
+}
+
+Time
+CachedPropagationDelayModel::GetDelay(Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+{
+    NS_ASSERT_MSG(m_model, "No propagation delay model to memoize");
+    if (const Time* cached = m_cache.Lookup(a, b))
+    {
+        m_hits++;
+        return *cached;
+    }
+    m_misses++;
+    Time delay = m_model->GetDelay(a, b);
+    if (m_model->IsDeterministic())
+    {
+        m_cache.Store(a, b, delay);
+    }
+    return delay;
+}
+
+int64_t
+CachedPropagationDelayModel::DoAssignStreams(int64_t stream)
+{
+    return m_model ? m_model->AssignStreams(stream) : 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,377 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+#ifndef CACHED_PROPAGATION_MODEL_H
+#define CACHED_PROPAGATION_MODEL_H
+
+#include "propagation-delay-model.h"
+#include "propagation-loss-model.h"
+
+#include "ns3/mobility-model.h"
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+namespace ns3
+{
+
+/**
+ * \ingroup propagation
+ * \brief Values of a propagation model memoized per link, i.e., per (source, destination)
+ * pair of mobility models.
+ *
+ * The cache follows the CourseChange trace of the mobility models of the links: a value
+ * stored is stale once either end of its link changed course. The position of a model moving
+ * at constant velocity changes without notification, so that the value of a link with a
+ * moving end is only valid as long as both ends are within the position tolerance of where
+ * they were when the value was stored.
+ *
+ * \tparam T the type of the values
+ */
+template <class T>
+class PropagationLinkCache
+{
+  public:
+    PropagationLinkCache()
+        : m_tolerance(0),
+          m_maxEntries(1000000)
+    {
+    }
+
+    ~PropagationLinkCache()
+    {
+        Clear();
+    }
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    PropagationLinkCache(const PropagationLinkCache&) = delete;
+    PropagationLinkCache& operator=(const PropagationLinkCache&) = delete;
+
+    /**
+     * \param tolerance the distance, in meters, an end of a link with a moving end may move
+     * by before the value of the link is stale
+     */
+    void SetPositionTolerance(double tolerance)
+    {
+        m_tolerance = tolerance;
+    }
+
+    /**
+     * \param maxEntries the number of links beyond which the cache is emptied
+     */
+    void SetMaxEntries(uint32_t maxEntries)
+    {
+        m_maxEntries = maxEntries;
+    }
+
+    /**
+     * \param a the mobility model of the source
+     * \param b the mobility model of the destination
+     * \returns the value of the link, or nullptr if there is none or if it is stale
+     */
+    const T* Lookup(Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+    {
+        auto it = m_entries.find({PeekPointer(a), PeekPointer(b)});
+        if (it == m_entries.end())
+        {
+            return nullptr;
+        }
+        const Entry& entry = it->second;
+        if (entry.a->course != entry.courseA || entry.b->course != entry.courseB)
+        {
+            return nullptr;
+        }
+        if (entry.moving && (CalculateDistance(a->GetPosition(), entry.positionA) > m_tolerance ||
+                             CalculateDistance(b->GetPosition(), entry.positionB) > m_tolerance))
+        {
+            return nullptr;
+        }
+        return &entry.value;
+    }
+
+    /**
+     * Store the value of a link
+     * \param a the mobility model of the source
+     * \param b the mobility model of the destination
+     * \param value the value
+     */
+    void Store(Ptr<MobilityModel> a, Ptr<MobilityModel> b, const T& value)
+    {
+        if (m_entries.size() >= m_maxEntries)
+        {
+            m_entries.clear();
+        }
+        const Endpoint* endA = Track(a);
+        const Endpoint* endB = Track(b);
+        Entry& entry = m_entries[{PeekPointer(a), PeekPointer(b)}];
+        entry.a = endA;
+        entry.b = endB;
+        entry.courseA = endA->course;
+        entry.courseB = endB->course;
+        entry.moving = a->GetVelocity().GetLength() > 0 || b->GetVelocity().GetLength() > 0;
+        if (entry.moving)
+        {
+            entry.positionA = a->GetPosition();
+            entry.positionB = b->GetPosition();
+        }
+        entry.value = value;
+    }
+
+    /**
+     * \returns the number of links stored
+     */
+    std::size_t GetN() const
+    {
+        return m_entries.size();
+    }
+
+    /**
+     * Forget all the links, and stop following the mobility models
+     */
+    void Clear()
+    {
+        for (auto& [model, endpoint] : m_endpoints)
+        {
+            endpoint.mobility->TraceDisconnectWithoutContext(
+                "CourseChange",
+                MakeCallback(&PropagationLinkCache::CourseChanged, this));
+        }
+        m_endpoints.clear();
+        m_entries.clear();
+    }
+
+  private:
+    /// Mobility model at an end of the links stored
+    struct Endpoint
+    {
+        Ptr<MobilityModel> mobility; //!< Mobility model
+        uint32_t course{0};          //!< Number of course changes
+    };
+
+    /// Value of a link
+    struct Entry
+    {
+        const Endpoint* a; //!< Source
+        const Endpoint* b; //!< Destination
+        uint32_t courseA;  //!< Course changes of the source when stored
+        uint32_t courseB;  //!< Course changes of the destination when stored
+        bool moving;       //!< Whether an end was moving when stored
+        Vector positionA;  //!< Position of the source when stored, if moving
+        Vector positionB;  //!< Position of the destination when stored, if moving
+        T value;           //!< Value
+    };
+
+    /// Source and destination of a link
+    typedef std::pair<const MobilityModel*, const MobilityModel*> Link;
+
+    /// Hash of a link
+    struct LinkHash
+    {
+        /**
+         * \param link the link
+         * \returns the hash of the link
+         */
+        std::size_t operator()(const Link& link) const
+        {
+            std::size_t h = std::hash<const MobilityModel*>()(link.first);
+            return h ^ (std::hash<const MobilityModel*>()(link.second) + 0x9e3779b9 + (h << 6) +
+                        (h >> 2));
+        }
+    };
+
+    /**
+     * Follow the course changes of a mobility model, if not done yet
+     * \param mobility the mobility model
+     * \returns its endpoint
+     */
+    const Endpoint* Track(Ptr<MobilityModel> mobility)
+    {
+        auto [it, inserted] = m_endpoints.try_emplace(PeekPointer(mobility));
+        if (inserted)
+        {
+            it->second.mobility = mobility;
+            mobility->TraceConnectWithoutContext(
+                "CourseChange",
+                MakeCallback(&PropagationLinkCache::CourseChanged, this));
+        }
+        return &it->second;
+    }
+
+    /**
+     * CourseChange trace sink
+     * \param mobility the mobility model
+     */
+    void CourseChanged(Ptr<const MobilityModel> mobility)
+    {
+        auto it = m_endpoints.find(PeekPointer(mobility));
+        if (it != m_endpoints.end())
+        {
+            it->second.course++;
+        }
+    }
+
+    double m_tolerance;    //!< Position tolerance of the links with a moving end
+    uint32_t m_maxEntries; //!< Number of links beyond which the cache is emptied
+    /// Ends of the links, by mobility model; the map keeps their addresses stable
+    std::unordered_map<const MobilityModel*, Endpoint> m_endpoints;
+    std::unordered_map<Link, Entry, LinkHash> m_entries; //!< Values of the links
+};
+
+/**
+ * \ingroup propagation
+ *
+ * \brief Memoizes the propagation loss of a deterministic model per link
+ *
+ * Recomputing the loss of a model such as the LogDistancePropagationLossModel for every
+ * frame is wasted when the nodes did not move since the previous frame. This model
+ * decorates another one, set through its Model attribute, and stores the RX power computed
+ * by it for each (source, destination) link and TX power, until either end of the link
+ * changes course or, if moving, moves by more than the PositionTolerance.
+ *
+ * Only deterministic models can be memoized: if the model, or any model chained to it,
+ * is not deterministic (see PropagationLossModel::IsDeterministic), every call is passed
+ * through to it. Stochastic models such as the NakagamiPropagationLossModel must rather be
+ * chained to the decorator, so that they keep being evaluated for every frame:
+ *
+ * \code
+ *   Ptr<CachedPropagationLossModel> cached = CreateObject<CachedPropagationLossModel>();
+ *   cached->SetAttribute("Model", PointerValue(CreateObject<LogDistancePropagationLossModel>()));
+ *   cached->SetNext(CreateObject<NakagamiPropagationLossModel>());
+ * \endcode
+ *
+ * The values stored are not updated when the attributes of the model change: call Flush
+ * after changing them.
+ */
+class CachedPropagationLossModel : public PropagationLossModel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    CachedPropagationLossModel();
+    ~CachedPropagationLossModel() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    CachedPropagationLossModel(const CachedPropagationLossModel&) = delete;
+    CachedPropagationLossModel& operator=(const CachedPropagationLossModel&) = delete;
+
+    bool IsDeterministic() const override;
+
+    /**
+     * Forget the values stored
+     */
+    void Flush();
+    /**
+     * \returns the number of calls answered from the cache
+     */
+    uint64_t GetHits() const;
+    /**
+     * \returns the number of calls passed through to the model
+     */
+    uint64_t GetMisses() const;
+    /**
+     * \returns the fraction of the calls answered from the cache, 0 if none was made
+     */
+    double GetHitRate() const;
+
+  private:
+    void DoDispose() override;
+    double DoCalcRxPower(double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         Ptr<MobilityModel> b) const override;
+    int64_t DoAssignStreams(int64_t stream) override;
+
+    /**
+     * \param tolerance the position tolerance of the links with a moving end
+     */
+    void SetPositionTolerance(double tolerance);
+    /**
+     * \param maxEntries the number of links beyond which the cache is emptied
+     */
+    void SetMaxEntries(uint32_t maxEntries);
+
+    /// RX power of a link for a TX power
+    struct RxPower
+    {
+        double txPowerDbm; //!< TX power
+        double rxPowerDbm; //!< RX power
+    };
+
+    Ptr<PropagationLossModel> m_model;             //!< Model memoized
+    mutable PropagationLinkCache<RxPower> m_cache; //!< RX power of the links
+    mutable uint64_t m_hits;                       //!< Calls answered from the cache
+    mutable uint64_t m_misses;                     //!< Calls passed through to the model
+};
+
+/**
+ * \ingroup propagation
+ *
+ * \brief Memoizes the propagation delay of a deterministic model per link
+ *
+ * This model decorates another one, set through its Model attribute, and stores the delay
+ * computed by it for each (source, destination) link, until either end of the link changes
+ * course or, if moving, moves by more than the PositionTolerance. If the model is not
+ * deterministic (see PropagationDelayModel::IsDeterministic), every call is passed through to
+ * it.
+ */
+class CachedPropagationDelayModel : public PropagationDelayModel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    CachedPropagationDelayModel();
+    ~CachedPropagationDelayModel() override;
+
+    Time GetDelay(Ptr<MobilityModel> a, Ptr<MobilityModel> b) const override;
+    bool IsDeterministic() const override;
+
+    /**
+     * Forget the values stored
+     */
+    void Flush();
+    /**
+     * \returns the number of calls answered from the cache
+     */
+    uint64_t GetHits() const;
+    /**
+     * \returns the number of calls passed through to the model
+     */
+    uint64_t GetMisses() const;
+    /**
+     * \returns the fraction of the calls answered from the cache, 0 if none was made
+     */
+    double GetHitRate() const;
+
+  private:
+    void DoDispose() override;
+    int64_t DoAssignStreams(int64_t stream) override;
+
+    /**
+     * \param tolerance the position tolerance of the links with a moving end
+     */
+    void SetPositionTolerance(double tolerance);
+    /**
+     * \param maxEntries the number of links beyond which the cache is emptied
+     */
+    void SetMaxEntries(uint32_t maxEntries);
+
+    Ptr<PropagationDelayModel> m_model;         //!< Model memoized
+    mutable PropagationLinkCache<Time> m_cache; //!< Delay of the links
+    mutable uint64_t m_hits;                    //!< Calls answered from the cache
+    mutable uint64_t m_misses;                  //!< Calls passed through to the model
+};
+
+} // namespace ns3
+
+#endif /* CACHED_PROPAGATION_MODEL_H */
@@ -164,6 +164,12 @@ Cost231PropagationLossModel::GetLoss(Ptr<MobilityModel> a, Ptr<MobilityModel> b)
     return (0 - loss_in_db);
 }
 
+bool
+Cost231PropagationLossModel::IsDeterministic() const
+{
+    return true;
+}
+
 double
 Cost231PropagationLossModel::DoCalcRxPower(double txPowerDbm,
                                            Ptr<MobilityModel> a,
@@ -51,6 +51,8 @@ class Cost231PropagationLossModel : public PropagationLossModel
     Cost231PropagationLossModel(const Cost231PropagationLossModel&) = delete;
     Cost231PropagationLossModel& operator=(const Cost231PropagationLossModel&) = delete;
 
+    bool IsDeterministic() const override;
+
     /**
      * Get the propagation loss
      * \param a the mobility model of the source
@@ -85,6 +85,12 @@ ItuR1411LosPropagationLossModel::SetFrequency(double freq)
     m_lambda = 299792458.0 / freq;
 }
 
+bool
+ItuR1411LosPropagationLossModel::IsDeterministic() const
+{
+    return true;
+}
+
 double
 ItuR1411LosPropagationLossModel::DoCalcRxPower(double txPowerDbm,
                                                Ptr<MobilityModel> a,
@@ -43,6 +43,8 @@ class ItuR1411LosPropagationLossModel : public PropagationLossModel
     ItuR1411LosPropagationLossModel(const ItuR1411LosPropagationLossModel&) = delete;
     ItuR1411LosPropagationLossModel& operator=(const ItuR1411LosPropagationLossModel&) = delete;
 
+    bool IsDeterministic() const override;
+
     /**
      * Set the operating frequency
      *
@@ -216,6 +216,12 @@ ItuR1411NlosOverRooftopPropagationLossModel::SetFrequency(double freq)
     m_lambda = 299792458.0 / freq;
 }
 
+bool
+ItuR1411NlosOverRooftopPropagationLossModel::IsDeterministic() const
+{
+    return true;
+}
+
 double
 ItuR1411NlosOverRooftopPropagationLossModel::DoCalcRxPower(double txPowerDbm,
                                                            Ptr<MobilityModel> a,
@@ -46,6 +46,8 @@ class ItuR1411NlosOverRooftopPropagationLossModel : public PropagationLossModel
     ItuR1411NlosOverRooftopPropagationLossModel& operator=(
         const ItuR1411NlosOverRooftopPropagationLossModel&) = delete;
 
+    bool IsDeterministic() const override;
+
     /**
      * Set the operating frequency
      *
@@ -51,6 +51,12 @@ Kun2600MhzPropagationLossModel::GetLoss(Ptr<MobilityModel> a, Ptr<MobilityModel>
     return loss;
 }
 
+bool
+Kun2600MhzPropagationLossModel::IsDeterministic() const
+{
+    return true;
+}
+
 double
 Kun2600MhzPropagationLossModel::DoCalcRxPower(double txPowerDbm,
                                               Ptr<MobilityModel> a,
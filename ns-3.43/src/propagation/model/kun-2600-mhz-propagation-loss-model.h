@@ -42,6 +42,8 @@ class Kun2600MhzPropagationLossModel : public PropagationLossModel
     Kun2600MhzPropagationLossModel(const Kun2600MhzPropagationLossModel&) = delete;
     Kun2600MhzPropagationLossModel& operator=(const Kun2600MhzPropagationLossModel&) = delete;
 
+    bool IsDeterministic() const override;
+
     /**
      * \param a the first mobility model
      * \param b the second mobility model
@@ -146,6 +146,12 @@ OkumuraHataPropagationLossModel::GetLoss(Ptr<MobilityModel> a, Ptr<MobilityModel
     return loss;
 }
 
+bool
+OkumuraHataPropagationLossModel::IsDeterministic() const
+{
+    return true;
+}
+
 double
 OkumuraHataPropagationLossModel::DoCalcRxPower(double txPowerDbm,
                                                Ptr<MobilityModel> a,
@@ -44,6 +44,8 @@ class OkumuraHataPropagationLossModel : public PropagationLossModel
     OkumuraHataPropagationLossModel(const OkumuraHataPropagationLossModel&) = delete;
     OkumuraHataPropagationLossModel& operator=(const OkumuraHataPropagationLossModel&) = delete;
 
+    bool IsDeterministic() const override;
+
     /**
      * \param a the first mobility model
      * \param b the second mobility model
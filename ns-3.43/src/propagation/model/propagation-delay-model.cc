@@ -35,6 +35,12 @@ PropagationDelayModel::AssignStreams(int64_t stream)
     return DoAssignStreams(stream);
 }
 
+bool
+PropagationDelayModel::IsDeterministic() const
+{
+    return false;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED(RandomPropagationDelayModel);
@@ -107,6 +113,12 @@ ConstantSpeedPropagationDelayModel::GetDelay(Ptr<MobilityModel> a, Ptr<MobilityM
     return Seconds(seconds);
 }
 
+bool
+ConstantSpeedPropagationDelayModel::IsDeterministic() const
+{
+    return true;
+}
+
 void
 ConstantSpeedPropagationDelayModel::SetSpeed(double speed)
 {
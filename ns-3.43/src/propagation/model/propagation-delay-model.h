@@ -51,6 +51,14 @@ class PropagationDelayModel : public Object
      * \return the number of stream indices assigned by this model
      */
     int64_t AssignStreams(int64_t stream);
+    /**
+     * Whether the delay computed by this model depends only on the positions of the source
+     * and destination and the attributes of the model, so that it can be memoized by a
+     * CachedPropagationDelayModel. Models drawing random variables must return false.
+     *
+     * \returns true if the model is deterministic, false by default
+     */
+    virtual bool IsDeterministic() const;
 
   protected:
     /**
@@ -110,6 +118,7 @@ class ConstantSpeedPropagationDelayModel : public PropagationDelayModel
      */
     ConstantSpeedPropagationDelayModel();
     Time GetDelay(Ptr<MobilityModel> a, Ptr<MobilityModel> b) const override;
+    bool IsDeterministic() const override;
     /**
      * \param speed the new speed (m/s)
      */
@@ -83,6 +83,12 @@ PropagationLossModel::AssignStreams(int64_t stream)
     return (currentStream - stream);
 }
 
+bool
+PropagationLossModel::IsDeterministic() const
+{
+    return false;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED(RandomPropagationLossModel);
@@ -221,6 +227,12 @@ FriisPropagationLossModel::DbmFromW(double w) const
     return dbm;
 }
 
+bool
+FriisPropagationLossModel::IsDeterministic() const
+{
+    return true;
+}
+
 double
 FriisPropagationLossModel::DoCalcRxPower(double txPowerDbm,
                                          Ptr<MobilityModel> a,
@@ -382,6 +394,12 @@ TwoRayGroundPropagationLossModel::DbmFromW(double w) const
     return dbm;
 }
 
+bool
+TwoRayGroundPropagationLossModel::IsDeterministic() const
+{
+    return true;
+}
+
 double
 TwoRayGroundPropagationLossModel::DoCalcRxPower(double txPowerDbm,
                                                 Ptr<MobilityModel> a,
@@ -515,6 +533,12 @@ LogDistancePropagationLossModel::GetPathLossExponent() const
     return m_exponent;
 }
 
+bool
+LogDistancePropagationLossModel::IsDeterministic() const
+{
+    return true;
+}
+
 double
 LogDistancePropagationLossModel::DoCalcRxPower(double txPowerDbm,
                                                Ptr<MobilityModel> a,
@@ -610,6 +634,12 @@ ThreeLogDistancePropagationLossModel::ThreeLogDistancePropagationLossModel()
 {
 }
 
+bool
+ThreeLogDistancePropagationLossModel::IsDeterministic() const
+{
+    return true;
+}
+
 double
 ThreeLogDistancePropagationLossModel::DoCalcRxPower(double txPowerDbm,
                                                     Ptr<MobilityModel> a,
@@ -805,6 +835,12 @@ FixedRssLossModel::SetRss(double rss)
     m_rss = rss;
 }
 
+bool
+FixedRssLossModel::IsDeterministic() const
+{
+    return true;
+}
+
 double
 FixedRssLossModel::DoCalcRxPower(double txPowerDbm,
                                  Ptr<MobilityModel> a,
@@ -881,6 +917,12 @@ MatrixPropagationLossModel::SetLoss(Ptr<MobilityModel> ma,
     }
 }
 
+bool
+MatrixPropagationLossModel::IsDeterministic() const
+{
+    return true;
+}
+
 double
 MatrixPropagationLossModel::DoCalcRxPower(double txPowerDbm,
                                           Ptr<MobilityModel> a,
@@ -927,6 +969,12 @@ RangePropagationLossModel::RangePropagationLossModel()
 {
 }
 
+bool
+RangePropagationLossModel::IsDeterministic() const
+{
+    return true;
+}
+
 double
 RangePropagationLossModel::DoCalcRxPower(double txPowerDbm,
                                          Ptr<MobilityModel> a,
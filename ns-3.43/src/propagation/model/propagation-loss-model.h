@@ -103,6 +103,16 @@ class PropagationLossModel : public Object
      */
     int64_t AssignStreams(int64_t stream);
 
+    /**
+     * Whether the loss computed by this model, leaving aside the models chained to it,
+     * depends only on the transmission power, the positions of the source and destination
+     * and the attributes of the model, so that it can be memoized by a
+     * CachedPropagationLossModel. Models drawing random variables must return false.
+     *
+     * \returns true if the model is deterministic, false by default
+     */
+    virtual bool IsDeterministic() const;
+
   protected:
     /**
      * Assign a fixed random variable stream number to the random variables used by this model.
@@ -252,6 +262,8 @@ class FriisPropagationLossModel : public PropagationLossModel
     FriisPropagationLossModel(const FriisPropagationLossModel&) = delete;
     FriisPropagationLossModel& operator=(const FriisPropagationLossModel&) = delete;
 
+    bool IsDeterministic() const override;
+
     /**
      * \param frequency (Hz)
      *
@@ -358,6 +370,8 @@ class TwoRayGroundPropagationLossModel : public PropagationLossModel
     TwoRayGroundPropagationLossModel(const TwoRayGroundPropagationLossModel&) = delete;
     TwoRayGroundPropagationLossModel& operator=(const TwoRayGroundPropagationLossModel&) = delete;
 
+    bool IsDeterministic() const override;
+
     /**
      * \param frequency (Hz)
      *
@@ -463,6 +477,8 @@ class LogDistancePropagationLossModel : public PropagationLossModel
     LogDistancePropagationLossModel(const LogDistancePropagationLossModel&) = delete;
     LogDistancePropagationLossModel& operator=(const LogDistancePropagationLossModel&) = delete;
 
+    bool IsDeterministic() const override;
+
     /**
      * \param n the path loss exponent.
      * Set the path loss exponent.
@@ -554,6 +570,8 @@ class ThreeLogDistancePropagationLossModel : public PropagationLossModel
     ThreeLogDistancePropagationLossModel& operator=(const ThreeLogDistancePropagationLossModel&) =
         delete;
 
+    bool IsDeterministic() const override;
+
     // Parameters are all accessible via attributes.
 
   private:
@@ -666,6 +684,8 @@ class FixedRssLossModel : public PropagationLossModel
     FixedRssLossModel(const FixedRssLossModel&) = delete;
     FixedRssLossModel& operator=(const FixedRssLossModel&) = delete;
 
+    bool IsDeterministic() const override;
+
     /**
      * \param rss (dBm) the received signal strength
      *
@@ -708,6 +728,8 @@ class MatrixPropagationLossModel : public PropagationLossModel
     MatrixPropagationLossModel(const MatrixPropagationLossModel&) = delete;
     MatrixPropagationLossModel& operator=(const MatrixPropagationLossModel&) = delete;
 
+    bool IsDeterministic() const override;
+
     /**
      * \brief Set loss (in dB, positive) between pair of ns-3 objects
      * (typically, nodes).
@@ -785,6 +807,8 @@ class RangePropagationLossModel : public PropagationLossModel
     RangePropagationLossModel(const RangePropagationLossModel&) = delete;
     RangePropagationLossModel& operator=(const RangePropagationLossModel&) = delete;
 
+    bool IsDeterministic() const override;
+
   private:
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
@@ -0,0 +1,223 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+#include "ns3/cached-propagation-model.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/pointer.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief CachedPropagationLossModel Test
+ */
+class CachedPropagationLossModelTestCase : public TestCase
+{
+  public:
+    CachedPropagationLossModelTestCase();
+
+  private:
+    void DoRun() override;
+    /// Check the links of a static and of a moving node, at 1 s and 2 s
+    void CheckLinks();
+
+    Ptr<ConstantPositionMobilityModel> m_a;      //!< Static node
+    Ptr<ConstantPositionMobilityModel> m_b;      //!< Static node
+    Ptr<ConstantVelocityMobilityModel> m_moving; //!< Moving node
+    Ptr<PropagationLossModel> m_reference;       //!< Model without cache
+    Ptr<CachedPropagationLossModel> m_cached;    //!< Model memoized
+    Ptr<CachedPropagationLossModel> m_tolerant;  //!< Model memoized with a position tolerance
+};
+
+CachedPropagationLossModelTestCase::CachedPropagationLossModelTestCase()
+    : TestCase("Check that the CachedPropagationLossModel memoizes only the deterministic, "
+               "up to date losses")
+{
+}
+
+void
+CachedPropagationLossModelTestCase::CheckLinks()
+{
+    uint64_t hits = m_cached->GetHits();
+    double expected = m_reference->CalcRxPower(10, m_a, m_moving);
+    double rxPower = m_cached->CalcRxPower(10, m_a, m_moving);
+    NS_TEST_EXPECT_MSG_EQ_TOL(rxPower, expected, 1e-9, "Moved since the previous frame");
+    NS_TEST_EXPECT_MSG_EQ(m_cached->GetHits(), hits, "Moving node not cached across time");
+    rxPower = m_cached->CalcRxPower(10, m_a, m_moving);
+    NS_TEST_EXPECT_MSG_EQ_TOL(rxPower, expected, 1e-9, "Same position");
+    NS_TEST_EXPECT_MSG_EQ(m_cached->GetHits(), hits + 1, "Did not move since the first frame");
+    rxPower = m_cached->CalcRxPower(20, m_a, m_b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(rxPower, m_reference->CalcRxPower(20, m_a, m_b), 1e-9, "Static link");
+    NS_TEST_EXPECT_MSG_EQ(m_cached->GetHits(), hits + 2, "Static link cached");
+
+    // 10 m away from the first position, within the tolerance of 15 m
+    m_tolerant->CalcRxPower(10, m_a, m_moving);
+}
+
+void
+CachedPropagationLossModelTestCase::DoRun()
+{
+    m_a = CreateObject<ConstantPositionMobilityModel>();
+    m_a->SetPosition(Vector(0, 0, 0));
+    m_b = CreateObject<ConstantPositionMobilityModel>();
+    m_b->SetPosition(Vector(100, 0, 0));
+    m_moving = CreateObject<ConstantVelocityMobilityModel>();
+    m_moving->SetPosition(Vector(50, 0, 0));
+    m_moving->SetVelocity(Vector(10, 0, 0));
+
+    m_reference = CreateObject<LogDistancePropagationLossModel>();
+    m_cached = CreateObjectWithAttributes<CachedPropagationLossModel>(
+        "Model",
+        PointerValue(CreateObject<LogDistancePropagationLossModel>()));
+    NS_TEST_EXPECT_MSG_EQ(m_cached->IsDeterministic(), true, "Log distance is deterministic");
+
+    // the values are kept in variables, the test macros evaluating their arguments twice
+    double rxPower = m_cached->CalcRxPower(10, m_a, m_b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(rxPower, m_reference->CalcRxPower(10, m_a, m_b), 1e-9, "Loss");
+    NS_TEST_EXPECT_MSG_EQ(m_cached->GetMisses(), 1, "First frame");
+    double other = m_cached->CalcRxPower(10, m_a, m_b);
+    NS_TEST_EXPECT_MSG_EQ(other, rxPower, "Same loss");
+    NS_TEST_EXPECT_MSG_EQ(m_cached->GetHits(), 1, "Nothing moved");
+    other = m_cached->CalcRxPower(20, m_a, m_b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(other, rxPower + 10, 1e-9, "Other TX power");
+    NS_TEST_EXPECT_MSG_EQ(m_cached->GetMisses(), 2, "TX power changed");
+    other = m_cached->CalcRxPower(10, m_b, m_a);
+    NS_TEST_EXPECT_MSG_EQ_TOL(other, rxPower, 1e-9, "Reverse link");
+    NS_TEST_EXPECT_MSG_EQ(m_cached->GetMisses(), 3, "Links are directional");
+
+    m_b->SetPosition(Vector(200, 0, 0));
+    other = m_cached->CalcRxPower(20, m_a, m_b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(other,
+                              m_reference->CalcRxPower(20, m_a, m_b),
+                              1e-9,
+                              "Course changed");
+    NS_TEST_EXPECT_MSG_EQ(m_cached->GetMisses(), 4, "Course changed");
+    NS_TEST_EXPECT_MSG_EQ(m_cached->GetHits(), 1, "Course changed");
+
+    m_tolerant = CreateObjectWithAttributes<CachedPropagationLossModel>(
+        "Model",
+        PointerValue(CreateObject<LogDistancePropagationLossModel>()),
+        "PositionTolerance",
+        DoubleValue(15));
+    Simulator::Schedule(Seconds(1), &CachedPropagationLossModelTestCase::CheckLinks, this);
+    Simulator::Schedule(Seconds(2), &CachedPropagationLossModelTestCase::CheckLinks, this);
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_tolerant->GetHits(), 1, "Moved within the tolerance");
+    NS_TEST_EXPECT_MSG_EQ(m_tolerant->GetHitRate(), 0.5, "Hit rate");
+
+    // stochastic models are not memoized
+    Ptr<CachedPropagationLossModel> random = CreateObjectWithAttributes<CachedPropagationLossModel>(
+        "Model",
+        PointerValue(CreateObject<NakagamiPropagationLossModel>()));
+    NS_TEST_EXPECT_MSG_EQ(random->IsDeterministic(), false, "Nakagami is stochastic");
+    random->CalcRxPower(10, m_a, m_b);
+    random->CalcRxPower(10, m_a, m_b);
+    NS_TEST_EXPECT_MSG_EQ(random->GetHits(), 0, "Stochastic model");
+    Ptr<PropagationLossModel> chain = CreateObject<LogDistancePropagationLossModel>();
+    chain->SetNext(CreateObject<RandomPropagationLossModel>());
+    random->SetAttribute("Model", PointerValue(chain));
+    NS_TEST_EXPECT_MSG_EQ(random->IsDeterministic(), false, "Stochastic stage in the chain");
+    random->CalcRxPower(10, m_a, m_b);
+    random->CalcRxPower(10, m_a, m_b);
+    NS_TEST_EXPECT_MSG_EQ(random->GetHits(), 0, "Stochastic stage in the chain");
+
+    // the stochastic stages chained to the cache keep being evaluated
+    m_cached->SetNext(CreateObjectWithAttributes<RandomPropagationLossModel>(
+        "Variable",
+        StringValue("ns3::UniformRandomVariable[Min=1|Max=10]")));
+    uint64_t hits = m_cached->GetHits();
+    double first = m_cached->CalcRxPower(20, m_a, m_b);
+    double second = m_cached->CalcRxPower(20, m_a, m_b);
+    NS_TEST_EXPECT_MSG_EQ(m_cached->GetHits(), hits + 2, "Deterministic stage cached");
+    NS_TEST_EXPECT_MSG_NE(first, second, "Stochastic stage evaluated");
+
+    m_cached->Flush();
+    m_cached->CalcRxPower(20, m_a, m_b);
+    NS_TEST_EXPECT_MSG_EQ(m_cached->GetHits(), hits + 2, "Flushed");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief CachedPropagationDelayModel Test
+ */
+class CachedPropagationDelayModelTestCase : public TestCase
+{
+  public:
+    CachedPropagationDelayModelTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+CachedPropagationDelayModelTestCase::CachedPropagationDelayModelTestCase()
+    : TestCase("Check that the CachedPropagationDelayModel memoizes only the deterministic, "
+               "up to date delays")
+{
+}
+
+void
+CachedPropagationDelayModelTestCase::DoRun()
+{
+    Ptr<ConstantPositionMobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(0, 0, 0));
+    Ptr<ConstantPositionMobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+    b->SetPosition(Vector(300, 0, 0));
+
+    Ptr<CachedPropagationDelayModel> cached =
+        CreateObjectWithAttributes<CachedPropagationDelayModel>(
+            "Model",
+            PointerValue(CreateObject<ConstantSpeedPropagationDelayModel>()));
+    Ptr<PropagationDelayModel> reference = CreateObject<ConstantSpeedPropagationDelayModel>();
+    Time delay = cached->GetDelay(a, b);
+    NS_TEST_EXPECT_MSG_EQ(delay, reference->GetDelay(a, b), "Delay");
+    Time other = cached->GetDelay(a, b);
+    NS_TEST_EXPECT_MSG_EQ(other, delay, "Same delay");
+    NS_TEST_EXPECT_MSG_EQ(cached->GetHits(), 1, "Nothing moved");
+    b->SetPosition(Vector(600, 0, 0));
+    other = cached->GetDelay(a, b);
+    NS_TEST_EXPECT_MSG_EQ(other, reference->GetDelay(a, b), "Course changed");
+    NS_TEST_EXPECT_MSG_EQ(cached->GetMisses(), 2, "Course changed");
+
+    cached->SetAttribute("Model", PointerValue(CreateObject<RandomPropagationDelayModel>()));
+    cached->Flush();
+    cached->GetDelay(a, b);
+    cached->GetDelay(a, b);
+    NS_TEST_EXPECT_MSG_EQ(cached->GetHits(), 1, "Stochastic model");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief Cached propagation models TestSuite
+ */
+class CachedPropagationModelsTestSuite : public TestSuite
+{
+  public:
+    CachedPropagationModelsTestSuite();
+};
+
+CachedPropagationModelsTestSuite::CachedPropagationModelsTestSuite()
+    : TestSuite("cached-propagation-model", Type::UNIT)
+{
+    AddTestCase(new CachedPropagationLossModelTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new CachedPropagationDelayModelTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static CachedPropagationModelsTestSuite g_cachedPropagationModelsTestSuite;
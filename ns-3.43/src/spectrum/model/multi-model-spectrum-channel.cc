@@ -229,6 +229,8 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     auto txSpectrumModelUid = txParams->psd->GetSpectrumModelUid();
     NS_LOG_LOGIC("txSpectrumModelUid " << txSpectrumModelUid);
 
+    // the receptions are scheduled as a single event, expanded as each of them comes due
+    auto receptions = MakeFanOutEvent(&MultiModelSpectrumChannel::StartRx, this);
     for (auto rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
          rxInfoIterator != m_rxSpectrumModelInfoMap.end();
          ++rxInfoIterator)
@@ -332,30 +334,19 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                     }
                 }
 
+                // a receiver without NetDevice cannot be assumed to be attached to a node, its
+                // reception is scheduled in the current context
+                uint32_t context = Simulator::GetContext();
                 if (rxNetDevice)
                 {
                     // the receiver has a NetDevice, so we expect that it is attached to a Node
-                    auto dstNode = rxNetDevice->GetNode()->GetId();
-                    Simulator::ScheduleWithContext(dstNode,
-                                                   delay,
-                                                   &MultiModelSpectrumChannel::StartRx,
-                                                   this,
-                                                   rxParams,
-                                                   *rxPhyIterator);
-                }
-                else
-                {
-                    // the receiver is not attached to a NetDevice, so we cannot assume that it is
-                    // attached to a node
-                    Simulator::Schedule(delay,
-                                        &MultiModelSpectrumChannel::StartRx,
-                                        this,
-                                        rxParams,
-                                        *rxPhyIterator);
+                    context = rxNetDevice->GetNode()->GetId();
                 }
+                receptions->Add(context, delay, rxParams, *rxPhyIterator);
             }
         }
     }
+    Simulator::ScheduleFanOut(receptions);
 }
 
 void
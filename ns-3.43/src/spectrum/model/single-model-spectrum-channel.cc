@@ -113,6 +113,8 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
 
     Ptr<MobilityModel> senderMobility = txParams->txPhy->GetMobility();
 
+    // the receptions are scheduled as a single event, expanded as each of them comes due
+    auto receptions = MakeFanOutEvent(&SingleModelSpectrumChannel::StartRx, this);
     for (auto rxPhyIterator = m_phyList.begin(); rxPhyIterator != m_phyList.end(); ++rxPhyIterator)
     {
         Ptr<NetDevice> rxNetDevice = (*rxPhyIterator)->GetDevice();
@@ -195,29 +197,18 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                 }
             }
 
+            // a receiver without NetDevice cannot be assumed to be attached to a node, its
+            // reception is scheduled in the current context
+            uint32_t context = Simulator::GetContext();
             if (rxNetDevice)
             {
                 // the receiver has a NetDevice, so we expect that it is attached to a Node
-                uint32_t dstNode = rxNetDevice->GetNode()->GetId();
-                Simulator::ScheduleWithContext(dstNode,
-                                               delay,
-                                               &SingleModelSpectrumChannel::StartRx,
-                                               this,
-                                               rxParams,
-                                               *rxPhyIterator);
-            }
-            else
-            {
-                // the receiver is not attached to a NetDevice, so we cannot assume that it is
-                // attached to a node
-                Simulator::Schedule(delay,
-                                    &SingleModelSpectrumChannel::StartRx,
-                                    this,
-                                    rxParams,
-                                    *rxPhyIterator);
+                context = rxNetDevice->GetNode()->GetId();
             }
+            receptions->Add(context, delay, rxParams, *rxPhyIterator);
         }
     }
+    Simulator::ScheduleFanOut(receptions);
 }
 
 void
@@ -237,6 +237,7 @@ AcousticModemEnergyModel::ChangeState(int newState)
     {
         // update current state & last update time stamp
         SetMicroModemState(newState);
+        m_source->UpdateCurrentDraw();
     }
 
     // some debug message
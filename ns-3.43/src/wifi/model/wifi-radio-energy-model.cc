@@ -286,6 +286,7 @@ WifiRadioEnergyModel::ChangeState(int newState)
     if (m_nPendingChangeState > 1 && newPhyState == WifiPhyState::OFF)
     {
         SetWifiRadioState(newPhyState);
+        m_source->UpdateCurrentDraw();
         m_nPendingChangeState--;
         return;
     }
@@ -328,6 +329,7 @@ WifiRadioEnergyModel::ChangeState(int newState)
     {
         // update current state & last update time stamp
         SetWifiRadioState(newPhyState);
+        m_source->UpdateCurrentDraw();
 
         // some debug message
         NS_LOG_DEBUG("WifiRadioEnergyModel:Total energy consumption is " << m_totalEnergyConsumption
@@ -14,6 +14,7 @@
 #include "wifi-utils.h"
 #include "yans-wifi-phy.h"
 
+#include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
@@ -22,6 +23,8 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
 
+#include <limits>
+
 namespace ns3
 {
 
@@ -46,7 +49,23 @@ YansWifiChannel::GetTypeId()
                           "A pointer to the propagation delay model attached to this channel.",
                           PointerValue(),
                           MakePointerAccessor(&YansWifiChannel::m_delay),
-                          MakePointerChecker<PropagationDelayModel>());
+                          MakePointerChecker<PropagationDelayModel>())
+            .AddAttribute("MaxRange",
+                          "The maximum distance (in meters) between the sender and the "
+                          "receivers of a PPDU; the PHYs farther away are not delivered the "
+                          "PPDU. If positive, the PHYs are indexed in a grid of cells of this "
+                          "size, so that only the PHYs around the sender are evaluated. "
+                          "Zero delivers the PPDU to every PHY.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&YansWifiChannel::m_maxRange),
+                          MakeDoubleChecker<meter_u>(0))
+            .AddAttribute("MinRxPower",
+                          "The minimum RX power (in dBm), including the RX gain of the "
+                          "receiver, of the PPDUs delivered; the weaker receptions are not "
+                          "scheduled.",
+                          DoubleValue(std::numeric_limits<double>::lowest()),
+                          MakeDoubleAccessor(&YansWifiChannel::m_minRxPower),
+                          MakeDoubleChecker<dBm_u>());
     return tid;
 }
 
@@ -81,42 +100,79 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u t
     NS_LOG_FUNCTION(this << sender << ppdu << txPower);
     Ptr<MobilityModel> senderMobility = sender->GetMobility();
     NS_ASSERT(senderMobility);
-    for (auto i = m_phyList.begin(); i != m_phyList.end(); i++)
+    // the receptions are scheduled as a single event, expanded as each of them comes due
+    auto receptions = MakeFanOutEvent(&YansWifiChannel::Receive);
+    if (m_maxRange <= 0)
     {
-        if (sender != (*i))
+        for (const auto& phy : m_phyList)
         {
             // For now don't account for inter channel interference nor channel bonding
-            if ((*i)->GetChannelNumber() != sender->GetChannelNumber())
-            {
-                continue;
-            }
-
-            auto receiverMobility = (*i)->GetMobility()->GetObject<MobilityModel>();
-            const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
-            const auto rxPower = m_loss->CalcRxPower(txPower, senderMobility, receiverMobility);
-            NS_LOG_DEBUG("propagation: txPower="
-                         << txPower << "dBm, rxPower=" << rxPower << "dBm, "
-                         << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
-                         << "m, delay=" << delay);
-            auto dstNetDevice = (*i)->GetDevice();
-            uint32_t dstNode;
-            if (!dstNetDevice)
+            if (phy != sender && phy->GetChannelNumber() == sender->GetChannelNumber())
             {
-                dstNode = 0xffffffff;
-            }
-            else
-            {
-                dstNode = dstNetDevice->GetNode()->GetId();
+                SendTo(senderMobility, phy, ppdu, txPower, *receptions);
             }
+        }
+        Simulator::ScheduleFanOut(receptions);
+        return;
+    }
 
-            Simulator::ScheduleWithContext(dstNode,
-                                           delay,
-                                           &YansWifiChannel::Receive,
-                                           (*i),
-                                           ppdu,
-                                           rxPower);
+    if (m_grid.GetN() == 0)
+    {
+        m_grid.SetCellSize(m_maxRange);
+    }
+    while (m_grid.GetN() < m_phyList.size())
+    {
+        m_grid.Add(m_phyList[m_grid.GetN()]->GetMobility());
+    }
+    // the candidates are sorted, so that the receptions are scheduled in the order of the
+    // PHY list, as without the grid
+    m_grid.Query(senderMobility->GetPosition(), m_maxRange, m_candidates);
+    for (auto index : m_candidates)
+    {
+        const auto& phy = m_phyList[index];
+        if (phy != sender && phy->GetChannelNumber() == sender->GetChannelNumber())
+        {
+            SendTo(senderMobility, phy, ppdu, txPower, *receptions);
         }
     }
+    Simulator::ScheduleFanOut(receptions);
+}
+
+void
+YansWifiChannel::SendTo(Ptr<MobilityModel> senderMobility,
+                        Ptr<YansWifiPhy> receiver,
+                        Ptr<const WifiPpdu> ppdu,
+                        dBm_u txPower,
+                        Receptions& receptions) const
+{
+    auto receiverMobility = receiver->GetMobility()->GetObject<MobilityModel>();
+    if (m_maxRange > 0 && senderMobility->GetDistanceFrom(receiverMobility) > m_maxRange)
+    {
+        return;
+    }
+    const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
+    const auto rxPower = m_loss->CalcRxPower(txPower, senderMobility, receiverMobility);
+    NS_LOG_DEBUG("propagation: txPower="
+                 << txPower << "dBm, rxPower=" << rxPower << "dBm, "
+                 << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
+                 << "m, delay=" << delay);
+    if (rxPower + receiver->GetRxGain() < m_minRxPower)
+    {
+        NS_LOG_DEBUG("Reception below " << m_minRxPower << " dBm not scheduled");
+        return;
+    }
+    auto dstNetDevice = receiver->GetDevice();
+    uint32_t dstNode;
+    if (!dstNetDevice)
+    {
+        dstNode = 0xffffffff;
+    }
+    else
+    {
+        dstNode = dstNetDevice->GetNode()->GetId();
+    }
+
+    receptions.Add(dstNode, delay, receiver, ppdu, rxPower);
 }
 
 void
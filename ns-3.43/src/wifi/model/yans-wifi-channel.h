@@ -12,6 +12,8 @@
 #include "wifi-units.h"
 
 #include "ns3/channel.h"
+#include "ns3/fan-out-event.h"
+#include "ns3/spatial-grid.h"
 
 namespace ns3
 {
@@ -19,6 +21,7 @@ namespace ns3
 class NetDevice;
 class PropagationLossModel;
 class PropagationDelayModel;
+class MobilityModel;
 class YansWifiPhy;
 class Packet;
 class Time;
@@ -32,6 +35,17 @@ class WifiPpdu;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * By default, a PPDU is delivered to every other YansWifiPhy on the channel,
+ * however far from the sender, and discarded on arrival if it is too weak to
+ * be processed. Setting the MaxRange attribute limits the delivery to the
+ * PHYs within this distance of the sender: the PHYs are then indexed in a
+ * SpatialGrid of cells of this size, and Send only evaluates the PHYs of
+ * the cells around the sender. The MinRxPower attribute in turn skips the
+ * receptions weaker than this power. The PHYs skipped do not see the PPDU at
+ * all, not even through their SignalArrival trace; and since the propagation
+ * loss model is not evaluated for the PHYs beyond MaxRange, the random
+ * variables of a stochastic loss model are drawn fewer times.
  */
 class YansWifiChannel : public Channel
 {
@@ -94,7 +108,13 @@ class YansWifiChannel : public Channel
     typedef std::vector<Ptr<YansWifiPhy>> PhyList;
 
     /**
-     * This method is scheduled by Send for each associated YansWifiPhy.
+     * The receptions of a PPDU, scheduled as a single fan-out event.
+     */
+    typedef FanOutEventImpl<Ptr<YansWifiPhy>, Ptr<const WifiPpdu>, dBm_u> Receptions;
+
+    /**
+     * This method is scheduled by Send for each associated YansWifiPhy, as a target of the
+     * fan-out event of the PPDU.
      * The method then calls the corresponding YansWifiPhy that the first
      * bit of the PPDU has arrived.
      *
@@ -104,9 +124,30 @@ class YansWifiChannel : public Channel
      */
     static void Receive(Ptr<YansWifiPhy> receiver, Ptr<const WifiPpdu> ppdu, dBm_u txPower);
 
+    /**
+     * Add the arrival of a PPDU at a receiver to the receptions of the PPDU,
+     * unless it lies beyond MaxRange or would receive it below MinRxPower.
+     *
+     * \param senderMobility the mobility model of the sender
+     * \param receiver the receiver
+     * \param ppdu the PPDU to send
+     * \param txPower the TX power associated to the packet
+     * \param receptions the receptions of the PPDU
+     */
+    void SendTo(Ptr<MobilityModel> senderMobility,
+                Ptr<YansWifiPhy> receiver,
+                Ptr<const WifiPpdu> ppdu,
+                dBm_u txPower,
+                Receptions& receptions) const;
+
     PhyList m_phyList;                  //!< List of YansWifiPhys connected to this YansWifiChannel
     Ptr<PropagationLossModel> m_loss;   //!< Propagation loss model
     Ptr<PropagationDelayModel> m_delay; //!< Propagation delay model
+    meter_u m_maxRange;                 //!< Maximum distance of the receivers, 0 if unlimited
+    dBm_u m_minRxPower;                 //!< Minimum RX power of the receptions
+    mutable SpatialGrid m_grid;         //!< Grid of the PHYs, indexed as in the PHY list
+    /// Indices of the PHYs around the sender, as returned by the grid
+    mutable std::vector<uint32_t> m_candidates;
 };
 
 } // namespace ns3
@@ -13,7 +13,9 @@
 #include "ns3/ap-wifi-mac.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/constant-rate-wifi-manager.h"
+#include "ns3/double.h"
 #include "ns3/error-model.h"
 #include "ns3/fcfs-wifi-queue-scheduler.h"
 #include "ns3/he-frame-exchange-manager.h"
@@ -48,6 +50,7 @@
 #include "ns3/yans-wifi-helper.h"
 #include "ns3/yans-wifi-phy.h"
 
+#include <limits>
 #include <optional>
 
 using namespace ns3;
@@ -3956,6 +3959,138 @@ DsssModulationTest::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_received, 4, "Did not receive four DSSS packets");
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * Make sure that the YansWifiChannel delivers the PPDUs to the receivers within MaxRange
+ * of the sender, including a receiver moving into range at constant velocity, and only
+ * to the receptions above MinRxPower.
+ *
+ * A broadcast frame is sent at 1 s and 9 s by a node at the origin, to static receivers
+ * at 50 m, 150 m and 400 m and to a receiver moving from 1000 m towards the sender at
+ * 100 m/s, i.e., 900 m and 100 m away when the frames are sent. The number of PPDUs
+ * arriving at each receiver is counted through the SignalArrival trace.
+ */
+class YansWifiChannelRangeTest : public TestCase
+{
+  public:
+    YansWifiChannelRangeTest();
+
+    void DoRun() override;
+
+  private:
+    /**
+     * Run the scenario
+     * \param maxRange the MaxRange of the channel
+     * \param minRxPower the MinRxPower of the channel
+     * \returns the number of PPDUs arriving at each receiver
+     */
+    std::vector<uint32_t> Run(meter_u maxRange, dBm_u minRxPower);
+
+    /**
+     * SignalArrival trace sink
+     * \param context the index of the receiver
+     * \param ppdu the PPDU
+     * \param rxPowerDbm the RX power
+     * \param duration the duration of the PPDU
+     */
+    void SignalArrival(std::string context,
+                       Ptr<const WifiPpdu> ppdu,
+                       double rxPowerDbm,
+                       Time duration);
+
+    std::vector<uint32_t> m_arrivals; ///< number of PPDUs arriving at each receiver
+};
+
+YansWifiChannelRangeTest::YansWifiChannelRangeTest()
+    : TestCase("Test case for the MaxRange and MinRxPower of the YansWifiChannel")
+{
+}
+
+void
+YansWifiChannelRangeTest::SignalArrival(std::string context,
+                                        Ptr<const WifiPpdu> ppdu,
+                                        double rxPowerDbm,
+                                        Time duration)
+{
+    m_arrivals[std::stoi(context)]++;
+}
+
+std::vector<uint32_t>
+YansWifiChannelRangeTest::Run(meter_u maxRange, dBm_u minRxPower)
+{
+    NodeContainer nodes;
+    nodes.Create(5);
+    m_arrivals.assign(nodes.GetN(), 0);
+
+    MobilityHelper mobility;
+    Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator>();
+    for (double x : {0.0, 50.0, 150.0, 400.0, 1000.0})
+    {
+        positions->Add(Vector(x, 0, 0));
+    }
+    mobility.SetPositionAllocator(positions);
+    mobility.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
+    mobility.Install(nodes);
+    nodes.Get(4)->GetObject<ConstantVelocityMobilityModel>()->SetVelocity(Vector(-100, 0, 0));
+
+    Ptr<YansWifiChannel> channel = YansWifiChannelHelper::Default().Create();
+    channel->SetAttribute("MaxRange", DoubleValue(maxRange));
+    channel->SetAttribute("MinRxPower", DoubleValue(minRxPower));
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel);
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate6Mbps"));
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        DynamicCast<WifiNetDevice>(devices.Get(i))
+            ->GetPhy()
+            ->TraceConnect("SignalArrival",
+                           std::to_string(i),
+                           MakeCallback(&YansWifiChannelRangeTest::SignalArrival, this));
+    }
+
+    Ptr<NetDevice> sender = devices.Get(0);
+    for (auto at : {Seconds(1), Seconds(9)})
+    {
+        Simulator::Schedule(at, [sender]() {
+            sender->Send(Create<Packet>(100), sender->GetBroadcast(), 1);
+        });
+    }
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+    Simulator::Destroy();
+    return m_arrivals;
+}
+
+void
+YansWifiChannelRangeTest::DoRun()
+{
+    // the frames reach every receiver, if only to be discarded as too weak
+    std::vector<uint32_t> all{0, 2, 2, 2, 2};
+    NS_TEST_EXPECT_MSG_EQ((Run(0, std::numeric_limits<double>::lowest()) == all),
+                          true,
+                          "All the receivers should see the PPDUs");
+
+    std::vector<uint32_t> inRange{0, 2, 2, 0, 1};
+    NS_TEST_EXPECT_MSG_EQ((Run(200, std::numeric_limits<double>::lowest()) == inRange),
+                          true,
+                          "Only the receivers within 200 m should see the PPDUs");
+    NS_TEST_EXPECT_MSG_EQ((Run(5000, std::numeric_limits<double>::lowest()) == all),
+                          true,
+                          "All the receivers are within 5000 m");
+
+    // the receptions at 50 m, 150 m and 400 m are about -82 dBm, -96 dBm and -109 dBm
+    NS_TEST_EXPECT_MSG_EQ((Run(0, -100) == inRange),
+                          true,
+                          "Only the receptions above -100 dBm should be scheduled");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -3990,6 +4125,7 @@ WifiTestSuite::WifiTestSuite()
     AddTestCase(new HeRuMcsDataRateTestCase, TestCase::Duration::QUICK);
     AddTestCase(new WifiMgtHeaderTest, TestCase::Duration::QUICK);
     AddTestCase(new DsssModulationTest, TestCase::Duration::QUICK);
+    AddTestCase(new YansWifiChannelRangeTest, TestCase::Duration::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite
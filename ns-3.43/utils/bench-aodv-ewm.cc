@@ -0,0 +1,285 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+// This program benchmarks the EOCW path selection done by an AODV destination:
+// the per-selection Entropy Weight Method matrix against the streaming EwmAccumulator, for
+// 1 to 1024 candidate paths. The candidates are then also stored column by column, as in
+// an EocwCandidateBatch, to compare the scalar evaluation with the vectorized one.
+// Sample usage:  ./ns3 run 'bench-aodv-ewm --n=100000'
+
+#include "ns3/aodv-eocw-batch.h"
+#include "ns3/aodv-eocw-path-cache.h"
+#include "ns3/command-line.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::aodv;
+
+/// Candidate paths of one discovery
+static std::vector<EocwPath> g_paths;
+/// Congestion degree scores of the candidate paths
+static std::vector<double> g_cd;
+/// Residual energy scores of the candidate paths
+static std::vector<double> g_re;
+/// Hop count scores of the candidate paths
+static std::vector<double> g_rh;
+/// Scores of the candidate paths
+static std::vector<double> g_scores;
+/// Fuzzy weights used for scoring
+static const EocwWeights g_fuzzy{0.33, 0.34, 0.33};
+/// Sink for the selected scores, so the work is not optimized away
+static volatile double g_sink = 0;
+
+/**
+ * The entropy weights as computed before the streaming accumulator: build the
+ * decision matrix and make two passes of logarithms over it.
+ * \param paths the candidate paths
+ * \returns the entropy weights
+ */
+static std::vector<double>
+MatrixEwmWeights(const std::vector<EocwPath>& paths)
+{
+    int m = paths.size();
+    int n = 3;
+    if (m <= 1)
+    {
+        return {0.333, 0.333, 0.333};
+    }
+    std::vector<std::vector<double>> X(m, std::vector<double>(n));
+    for (int i = 0; i < m; ++i)
+    {
+        X[i][0] = paths[i].pathAvgCongestion;
+        X[i][1] = paths[i].pathMinEnergy;
+        X[i][2] = EocwHopCountScore(paths[i].hopCount);
+    }
+    std::vector<double> H(n, 0.0);
+    double k = 1.0 / std::log(m);
+    for (int j = 0; j < n; ++j)
+    {
+        double sumYij = 0.0;
+        for (int i = 0; i < m; ++i)
+        {
+            sumYij += X[i][j];
+        }
+        if (sumYij == 0)
+        {
+            continue;
+        }
+        double sumPijLnPij = 0.0;
+        for (int i = 0; i < m; ++i)
+        {
+            double pij = X[i][j] / sumYij;
+            if (pij > 0)
+            {
+                sumPijLnPij += pij * std::log(pij);
+            }
+        }
+        H[j] = -k * sumPijLnPij;
+    }
+    std::vector<double> d(n);
+    double sumD = 0.0;
+    for (int j = 0; j < n; ++j)
+    {
+        d[j] = 1.0 - H[j];
+        sumD += d[j];
+    }
+    std::vector<double> mu(n);
+    for (int j = 0; j < n; ++j)
+    {
+        mu[j] = (sumD == 0) ? 1.0 / n : d[j] / sumD;
+    }
+    return mu;
+}
+
+/**
+ * Select the best path by copying the candidate list, building the EWM matrix and
+ * rescoring every candidate.
+ * \param n the number of selections
+ */
+static void
+benchMatrix(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        std::vector<EocwPath> paths = g_paths;
+        std::vector<double> mu = MatrixEwmWeights(paths);
+        EocwWeights ewm{mu[0], mu[1], mu[2]};
+        double best = -1.0;
+        for (const auto& path : paths)
+        {
+            best = std::max(best,
+                            EocwScore(g_fuzzy,
+                                      ewm,
+                                      path.pathAvgCongestion,
+                                      path.pathMinEnergy,
+                                      EocwHopCountScore(path.hopCount)));
+        }
+        g_sink = g_sink + best;
+    }
+}
+
+/**
+ * Select the best path by accumulating the EWM statistics as each path arrives and
+ * scoring the candidates with the resulting weights.
+ * \param n the number of selections
+ */
+static void
+benchStreaming(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        EwmAccumulator acc;
+        for (const auto& path : g_paths)
+        {
+            acc.Add(path.pathAvgCongestion, path.pathMinEnergy, EocwHopCountScore(path.hopCount));
+        }
+        EocwWeights ewm = acc.GetWeights();
+        double best = -1.0;
+        for (const auto& path : g_paths)
+        {
+            best = std::max(best,
+                            EocwScore(g_fuzzy,
+                                      ewm,
+                                      path.pathAvgCongestion,
+                                      path.pathMinEnergy,
+                                      EocwHopCountScore(path.hopCount)));
+        }
+        g_sink = g_sink + best;
+    }
+}
+
+/**
+ * Score the candidates stored column by column, as the scalar reference of the batch
+ * evaluation: accumulate the EWM statistics row by row and score each row.
+ * \param n the number of selections
+ */
+static void
+benchScalarColumns(uint32_t n)
+{
+    std::size_t m = g_cd.size();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        EwmAccumulator acc;
+        for (std::size_t k = 0; k < m; k++)
+        {
+            acc.Add(g_cd[k], g_re[k], g_rh[k]);
+        }
+        EocwWeights ewm = acc.GetWeights();
+        for (std::size_t k = 0; k < m; k++)
+        {
+            g_scores[k] = EocwScore(g_fuzzy, ewm, g_cd[k], g_re[k], g_rh[k]);
+        }
+        g_sink = g_sink + g_scores[0];
+    }
+}
+
+/**
+ * Score the candidates stored column by column with the vectorized batch evaluation.
+ * \param n the number of selections
+ */
+static void
+benchBatchColumns(uint32_t n)
+{
+    std::size_t m = g_cd.size();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        EocwEvaluateBatch(g_cd.data(), g_re.data(), g_rh.data(), m, g_fuzzy, g_scores.data());
+        g_sink = g_sink + g_scores[0];
+    }
+}
+
+static void
+runBench(void (*bench)(uint32_t), uint32_t n, uint32_t minIterations, const char* name)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        SystemWallClockMs time;
+        time.Start();
+        (*bench)(n);
+        minDelay = std::min(minDelay, static_cast<uint64_t>(time.End()));
+    }
+    double ps = n;
+    ps *= 1000;
+    ps /= std::max<uint64_t>(minDelay, 1);
+    std::cout << ps << " selections/s"
+              << " (" << minDelay << " ms elapsed)\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 2000;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark EOCW entropy weight computation");
+    cmd.AddValue("n", "number of path selections per candidate count", n);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    for (uint32_t m : {1, 4, 16, 64, 256, 1024})
+    {
+        g_paths.clear();
+        for (uint32_t i = 0; i < m; i++)
+        {
+            g_paths.emplace_back(0.2 + 0.8 * ((i * 37) % 101) / 100.0,
+                                 0.1 + 0.9 * ((i * 53) % 97) / 96.0,
+                                 1 + (i % 9),
+                                 RoutingTableEntry());
+        }
+
+        EwmAccumulator acc;
+        for (const auto& path : g_paths)
+        {
+            acc.Add(path.pathAvgCongestion, path.pathMinEnergy, EocwHopCountScore(path.hopCount));
+        }
+        std::vector<double> reference = MatrixEwmWeights(g_paths);
+        EocwWeights streaming = acc.GetWeights();
+        double maxError = 0;
+        for (std::size_t j = 0; j < streaming.size(); j++)
+        {
+            maxError = std::max(maxError, std::abs(streaming[j] - reference[j]));
+        }
+
+        g_cd.clear();
+        g_re.clear();
+        g_rh.clear();
+        for (const auto& path : g_paths)
+        {
+            g_cd.push_back(path.pathAvgCongestion);
+            g_re.push_back(path.pathMinEnergy);
+            g_rh.push_back(EocwHopCountScore(path.hopCount));
+        }
+        g_scores.resize(m);
+        EocwWeights batched =
+            EocwEvaluateBatch(g_cd.data(), g_re.data(), g_rh.data(), m, g_fuzzy, g_scores.data());
+        double maxBatchError = 0;
+        for (std::size_t j = 0; j < batched.size(); j++)
+        {
+            maxBatchError = std::max(maxBatchError, std::abs(batched[j] - reference[j]));
+        }
+
+        std::cout << "Running bench-aodv-ewm with n=" << n << " and " << m
+                  << " candidates (max weight difference " << maxError << " streaming, "
+                  << maxBatchError << " batch)" << std::endl;
+        runBench(&benchMatrix, n, minIterations, "EWM matrix");
+        runBench(&benchStreaming, n, minIterations, "Streaming EWM");
+        runBench(&benchScalarColumns, n, minIterations, "Scalar EWM over columns");
+        runBench(&benchBatchColumns, n, minIterations, "Batch EWM over columns");
+    }
+    Simulator::Destroy();
+
+    return 0;
+}
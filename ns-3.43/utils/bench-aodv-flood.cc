@@ -0,0 +1,262 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+// This program benchmarks the cost of AODV-EOCW route discovery floods for each
+// encoding of the EOCW path metrics carried by RREQs. Static nodes are placed on a
+// square grid and a series of route discoveries is triggered between distant nodes;
+// for each network size and encoding it reports the RREQ size, the number of RREQ
+// transmissions and their total airtime per discovery, and the flood completion
+// time (from the first to the end of the last RREQ transmission of a discovery).
+// Sample usage:  ./ns3 run 'bench-aodv-flood --discoveries=20'
+
+#include "ns3/aodv-helper.h"
+#include "ns3/aodv-packet.h"
+#include "ns3/aodv-routing-protocol.h"
+#include "ns3/boolean.h"
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/llc-snap-header.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/packet.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/udp-header.h"
+#include "ns3/udp-l4-protocol.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-helper.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-ppdu.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::aodv;
+
+/// Time between two route discoveries
+static const Time g_discoveryInterval = Seconds(2);
+/// Start of the first route discovery
+static const Time g_firstDiscovery = Seconds(1);
+
+/// RREQ transmissions of one route discovery
+struct Flood
+{
+    uint32_t transmissions{0}; ///< Number of RREQ transmissions
+    uint32_t bytes{0};         ///< Size of the RREQ messages
+    Time airtime;              ///< Total airtime of the RREQ transmissions
+    Time first;                ///< Start of the first RREQ transmission
+    Time last;                 ///< End of the last RREQ transmission
+};
+
+/// Floods of the current run, indexed by discovery
+static std::vector<Flood> g_floods;
+
+/**
+ * Trace sink for the PSDUs sent by the PHYs: account for the ones carrying an RREQ
+ * \param psduMap the PSDUs
+ * \param txVector the TX vector
+ * \param txPowerW the transmit power
+ */
+static void
+PsduTxBegin(WifiConstPsduMap psduMap, WifiTxVector txVector, double txPowerW)
+{
+    for (const auto& [staId, psdu] : psduMap)
+    {
+        if (psdu->GetNMpdus() != 1 || !psdu->GetHeader(0).IsData())
+        {
+            continue;
+        }
+        Ptr<Packet> packet = psdu->GetPayload(0)->Copy();
+        LlcSnapHeader llc;
+        Ipv4Header ip;
+        UdpHeader udp;
+        TypeHeader type;
+        packet->RemoveHeader(llc);
+        if (llc.GetType() != Ipv4L3Protocol::PROT_NUMBER)
+        {
+            continue;
+        }
+        packet->RemoveHeader(ip);
+        if (ip.GetProtocol() != UdpL4Protocol::PROT_NUMBER)
+        {
+            continue;
+        }
+        packet->RemoveHeader(udp);
+        if (udp.GetDestinationPort() != RoutingProtocol::AODV_PORT)
+        {
+            continue;
+        }
+        packet->RemoveHeader(type);
+        if (type.Get() != AODVTYPE_RREQ)
+        {
+            continue;
+        }
+        Time now = Simulator::Now();
+        int64_t index = ((now - g_firstDiscovery) / g_discoveryInterval).GetHigh();
+        if (index < 0 || index >= static_cast<int64_t>(g_floods.size()))
+        {
+            continue;
+        }
+        Flood& flood = g_floods[index];
+        Time duration = WifiPhy::CalculateTxDuration(psdu, txVector, WIFI_PHY_BAND_5GHZ);
+        if (flood.transmissions == 0)
+        {
+            flood.first = now;
+        }
+        flood.transmissions++;
+        flood.bytes = packet->GetSize();
+        flood.airtime += duration;
+        flood.last = std::max(flood.last, now + duration);
+    }
+}
+
+/**
+ * Send one datagram, starting a route discovery
+ * \param socket the socket of the originator
+ * \param dst the destination
+ */
+static void
+Discover(Ptr<Socket> socket, Ipv4Address dst)
+{
+    socket->SendTo(Create<Packet>(64), 0, InetSocketAddress(dst, 9));
+}
+
+/**
+ * Run the route discoveries in a grid of nodes
+ * \param nNodes the number of nodes
+ * \param spacing the grid spacing, in meters
+ * \param encoding the encoding of the EOCW metrics
+ * \param discoveries the number of route discoveries
+ */
+static void
+RunFloods(uint32_t nNodes, double spacing, EocwMetricEncoding encoding, uint32_t discoveries)
+{
+    RngSeedManager::SetRun(1);
+    g_floods.assign(discoveries, Flood());
+
+    NodeContainer nodes;
+    nodes.Create(nNodes);
+    auto width = static_cast<uint32_t>(std::ceil(std::sqrt(nNodes)));
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                  "DeltaX",
+                                  DoubleValue(spacing),
+                                  "DeltaY",
+                                  DoubleValue(spacing),
+                                  "GridWidth",
+                                  UintegerValue(width));
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(nodes);
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate6Mbps"),
+                                 "ControlMode",
+                                 StringValue("OfdmRate6Mbps"));
+    YansWifiPhyHelper phy;
+    phy.SetChannel(YansWifiChannelHelper::Default().Create());
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+
+    AodvHelper aodv;
+    aodv.Set("EnableHello", BooleanValue(false));
+    aodv.Set("EocwMetricEncoding", EnumValue(encoding));
+    InternetStackHelper stack;
+    stack.SetRoutingHelper(aodv);
+    stack.Install(nodes);
+    Ipv4AddressHelper address;
+    address.SetBase("10.0.0.0", "255.255.0.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+    for (uint32_t i = 0; i < nNodes; i++)
+    {
+        Ptr<Socket> sink = Socket::CreateSocket(nodes.Get(i), UdpSocketFactory::GetTypeId());
+        sink->Bind(InetSocketAddress(Ipv4Address::GetAny(), 9));
+    }
+    for (uint32_t k = 0; k < discoveries; k++)
+    {
+        // Corner to corner, rotating the originator along the first row
+        uint32_t src = k % width;
+        uint32_t dst = nNodes - 1 - src;
+        Ptr<Socket> socket = Socket::CreateSocket(nodes.Get(src), UdpSocketFactory::GetTypeId());
+        Simulator::Schedule(g_firstDiscovery + k * g_discoveryInterval,
+                            &Discover,
+                            socket,
+                            interfaces.GetAddress(dst));
+    }
+
+    Config::ConnectWithoutContext(
+        "/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyTxPsduBegin",
+        MakeCallback(&PsduTxBegin));
+    Simulator::Stop(g_firstDiscovery + discoveries * g_discoveryInterval);
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t discoveries = 10;
+    double spacing = 100;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark RREQ flood airtime for each EOCW metric encoding");
+    cmd.AddValue("discoveries", "number of route discoveries per run", discoveries);
+    cmd.AddValue("spacing", "grid spacing, in meters", spacing);
+    cmd.Parse(argc, argv);
+
+    std::cout << "nodes\tencoding\trreq bytes\ttx/flood\tairtime ms/flood\tcompletion ms"
+              << std::endl;
+    for (uint32_t nNodes : {40, 60, 80, 100})
+    {
+        for (auto [encoding, name] : {std::pair{EOCW_FLOAT32, "Float32"},
+                                      std::pair{EOCW_FIXED8, "Fixed8"},
+                                      std::pair{EOCW_FIXED12, "Fixed12"}})
+        {
+            RunFloods(nNodes, spacing, encoding, discoveries);
+            uint32_t floods = 0;
+            uint32_t bytes = 0;
+            double transmissions = 0;
+            double airtime = 0;
+            double completion = 0;
+            for (const auto& flood : g_floods)
+            {
+                if (flood.transmissions == 0)
+                {
+                    continue;
+                }
+                floods++;
+                bytes = flood.bytes;
+                transmissions += flood.transmissions;
+                airtime += flood.airtime.GetSeconds() * 1000;
+                completion += (flood.last - flood.first).GetSeconds() * 1000;
+            }
+            floods = std::max<uint32_t>(floods, 1);
+            std::cout << nNodes << "\t" << name << "\t\t" << bytes << "\t\t" << std::fixed
+                      << std::setprecision(1) << transmissions / floods << "\t\t"
+                      << std::setprecision(3) << airtime / floods << "\t\t\t"
+                      << completion / floods << std::defaultfloat << std::endl;
+        }
+    }
+
+    return 0;
+}
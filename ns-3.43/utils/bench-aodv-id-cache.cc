@@ -0,0 +1,181 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+// This program benchmarks the AODV RREQ duplicate detection cache in steady state:
+// every 10 ms of simulated time a batch of new (origin, id) pairs is added and as many
+// duplicates are checked, with a lifetime such that the cache holds about 1k, 10k and
+// 100k entries. The hash set with timing wheel expiry is compared with the linear
+// vector scan it replaced.
+// Sample usage:  ./ns3 run 'bench-aodv-id-cache --linear-max=100000'
+
+#include "ns3/aodv-id-cache.h"
+#include "ns3/command-line.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::aodv;
+
+/// Interval between two batches
+static const Time g_batchInterval = MilliSeconds(10);
+/// Number of batches per lifetime
+static const uint32_t g_batchesPerLifetime = 50;
+
+/**
+ * The duplicate cache as implemented before the hash set: purge the whole vector and
+ * scan it on every check.
+ */
+class LinearIdCache
+{
+  public:
+    /**
+     * constructor
+     * \param lifetime the lifetime for added entries
+     */
+    LinearIdCache(Time lifetime)
+        : m_lifetime(lifetime)
+    {
+    }
+
+    /**
+     * Check that entry (addr, id) exists in cache. Add entry, if it doesn't exist.
+     * \param addr the IP address
+     * \param id the cache entry ID
+     * \returns true if the pair exists
+     */
+    bool IsDuplicate(Ipv4Address addr, uint32_t id)
+    {
+        Time now = Simulator::Now();
+        m_idCache.erase(std::remove_if(m_idCache.begin(),
+                                       m_idCache.end(),
+                                       [now](const UniqueId& u) { return u.m_expire < now; }),
+                        m_idCache.end());
+        for (const auto& u : m_idCache)
+        {
+            if (u.m_context == addr && u.m_id == id)
+            {
+                return true;
+            }
+        }
+        m_idCache.push_back({addr, id, m_lifetime + now});
+        return false;
+    }
+
+  private:
+    /// Unique packet ID
+    struct UniqueId
+    {
+        Ipv4Address m_context; ///< Sender address
+        uint32_t m_id;         ///< The id
+        Time m_expire;         ///< When record will expire
+    };
+
+    std::vector<UniqueId> m_idCache; ///< Already seen IDs
+    Time m_lifetime;                 ///< Lifetime for ID records
+};
+
+/// Sink for the check results, so the work is not optimized away
+static volatile uint32_t g_sink = 0;
+
+/**
+ * Add a batch of new pairs and check as many duplicates
+ * \tparam Cache the cache type
+ * \param cache the cache
+ * \param batch the batch number
+ * \param size the batch size
+ */
+template <class Cache>
+static void
+RunBatch(Cache* cache, uint32_t batch, uint32_t size)
+{
+    uint32_t duplicates = 0;
+    for (uint32_t i = 0; i < size; i++)
+    {
+        duplicates += cache->IsDuplicate(Ipv4Address(i % 97 + 1), batch * size + i);
+    }
+    for (uint32_t i = 0; i < size; i++)
+    {
+        // Duplicates of the batch added half a lifetime ago
+        uint32_t old = batch - std::min(batch, g_batchesPerLifetime / 2);
+        duplicates += cache->IsDuplicate(Ipv4Address(i % 97 + 1), old * size + i);
+    }
+    g_sink = g_sink + duplicates;
+}
+
+/**
+ * Run the batches of one benchmark
+ * \tparam Cache the cache type
+ * \param entries the number of entries the cache holds in steady state
+ * \param batches the number of batches
+ * \returns the wall clock time, in ms
+ */
+template <class Cache>
+static int64_t
+RunCache(uint32_t entries, uint32_t batches)
+{
+    uint32_t size = std::max<uint32_t>(entries / g_batchesPerLifetime, 1);
+    Cache cache(g_batchInterval * g_batchesPerLifetime);
+    for (uint32_t batch = 0; batch < batches; batch++)
+    {
+        Simulator::Schedule(g_batchInterval * batch, &RunBatch<Cache>, &cache, batch, size);
+    }
+    SystemWallClockMs time;
+    time.Start();
+    Simulator::Run();
+    int64_t elapsed = time.End();
+    Simulator::Destroy();
+    return elapsed;
+}
+
+template <class Cache>
+static void
+runBench(uint32_t entries, uint32_t batches, uint32_t minIterations, const char* name)
+{
+    int64_t minDelay = std::numeric_limits<int64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        minDelay = std::min(minDelay, RunCache<Cache>(entries, batches));
+    }
+    double checks = 2.0 * std::max<uint32_t>(entries / g_batchesPerLifetime, 1) * batches;
+    double ps = checks * 1000 / std::max<int64_t>(minDelay, 1);
+    std::cout << entries << " entries: " << ps << " checks/s"
+              << " (" << minDelay << " ms elapsed)\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t batches = 200;
+    uint32_t minIterations = 1;
+    uint32_t linearMax = 10000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the AODV RREQ duplicate detection cache");
+    cmd.AddValue("batches", "number of batches, 50 per entry lifetime", batches);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.AddValue("linear-max",
+                 "largest cache size benchmarked with the linear scan",
+                 linearMax);
+    cmd.Parse(argc, argv);
+
+    for (uint32_t entries : {1000, 10000, 100000})
+    {
+        runBench<IdCache>(entries, batches, minIterations, "hash set + timing wheel");
+        if (entries <= linearMax)
+        {
+            runBench<LinearIdCache>(entries, batches, minIterations, "linear scan");
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,203 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+// This program benchmarks the AODV neighbor table in steady state: every 10 ms of
+// simulated time a batch of hello messages refreshes the lifetime of the neighbors and
+// as many forwarded packets check that their next hop is a neighbor, while a fraction of
+// the neighbors goes silent and expires. Tables of 10, 100 and 1000 neighbors are
+// exercised. The hash map with timing wheel expiry is compared with the vector purged
+// in full on every access that it replaced.
+// Sample usage:  ./ns3 run 'bench-aodv-neighbor --batches=1000 --vector-max=1000'
+
+#include "ns3/aodv-neighbor.h"
+#include "ns3/command-line.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::aodv;
+
+/// Interval between two batches
+static const Time g_batchInterval = MilliSeconds(10);
+/// Lifetime given to a neighbor by a hello message
+static const Time g_neighborLifetime = Seconds(2);
+
+/**
+ * The neighbor table as implemented before the hash map: a vector scanned on every
+ * lookup and purged in full on every check and on every new neighbor.
+ */
+class VectorNeighbors
+{
+  public:
+    /**
+     * constructor
+     * \param delay the delay time for purging the list of neighbors
+     */
+    VectorNeighbors(Time delay)
+    {
+    }
+
+    /**
+     * Check that node with address addr is neighbor
+     * \param addr the IP address to check
+     * \returns true if the node with IP address is a neighbor
+     */
+    bool IsNeighbor(Ipv4Address addr)
+    {
+        Purge();
+        for (const auto& nb : m_nb)
+        {
+            if (nb.m_neighborAddress == addr)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Update expire time for entry with address addr, if it exists, else add new entry
+     * \param addr the IP address to check
+     * \param expire the expire time for the address
+     */
+    void Update(Ipv4Address addr, Time expire)
+    {
+        for (auto& nb : m_nb)
+        {
+            if (nb.m_neighborAddress == addr)
+            {
+                nb.m_expireTime = std::max(expire + Simulator::Now(), nb.m_expireTime);
+                return;
+            }
+        }
+        m_nb.push_back({addr, expire + Simulator::Now()});
+        Purge();
+    }
+
+  private:
+    /// Neighbor description
+    struct Neighbor
+    {
+        Ipv4Address m_neighborAddress; ///< Neighbor IPv4 address
+        Time m_expireTime;             ///< Neighbor expire time
+    };
+
+    /// Remove all expired entries
+    void Purge()
+    {
+        Time now = Simulator::Now();
+        m_nb.erase(std::remove_if(m_nb.begin(),
+                                  m_nb.end(),
+                                  [now](const Neighbor& nb) { return nb.m_expireTime < now; }),
+                   m_nb.end());
+    }
+
+    std::vector<Neighbor> m_nb; ///< The neighbors
+};
+
+/// Sink for the check results, so the work is not optimized away
+static volatile uint32_t g_sink = 0;
+
+/**
+ * Refresh the neighbors heard in a batch and check as many next hops
+ * \tparam Table the neighbor table type
+ * \param table the neighbor table
+ * \param neighbors the number of neighbors
+ * \param batch the batch number
+ */
+template <class Table>
+static void
+RunBatch(Table* table, uint32_t neighbors, uint32_t batch)
+{
+    uint32_t found = 0;
+    uint32_t x = batch * 2654435761U + 1;
+    for (uint32_t i = 0; i < neighbors; i++)
+    {
+        x = x * 1664525U + 1013904223U;
+        uint32_t n = (x >> 8) % neighbors;
+        // One neighbor in eight is silent for a while, long enough to expire
+        if (n % 8 != 0 || (batch / 400) % 2 == 0)
+        {
+            table->Update(Ipv4Address((10U << 24) + 1 + n), g_neighborLifetime);
+        }
+        x = x * 1664525U + 1013904223U;
+        found += table->IsNeighbor(Ipv4Address((10U << 24) + 1 + (x >> 8) % neighbors));
+    }
+    g_sink = g_sink + found;
+}
+
+/**
+ * Run the batches of one benchmark
+ * \tparam Table the neighbor table type
+ * \param neighbors the number of neighbors
+ * \param batches the number of batches
+ * \returns the wall clock time, in ms
+ */
+template <class Table>
+static int64_t
+RunTable(uint32_t neighbors, uint32_t batches)
+{
+    Table table(Seconds(1));
+    for (uint32_t batch = 0; batch < batches; batch++)
+    {
+        Simulator::Schedule(g_batchInterval * batch, &RunBatch<Table>, &table, neighbors, batch);
+    }
+    Simulator::Stop(g_batchInterval * batches);
+    SystemWallClockMs time;
+    time.Start();
+    Simulator::Run();
+    int64_t elapsed = time.End();
+    Simulator::Destroy();
+    return elapsed;
+}
+
+template <class Table>
+static void
+runBench(uint32_t neighbors, uint32_t batches, uint32_t minIterations, const char* name)
+{
+    int64_t minDelay = std::numeric_limits<int64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        minDelay = std::min(minDelay, RunTable<Table>(neighbors, batches));
+    }
+    double operations = 2.0 * neighbors * batches;
+    double ps = operations * 1000 / std::max<int64_t>(minDelay, 1);
+    std::cout << neighbors << " neighbors: " << ps << " updates and checks/s"
+              << " (" << minDelay << " ms elapsed)\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t batches = 1000;
+    uint32_t minIterations = 1;
+    uint32_t vectorMax = 1000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the AODV neighbor table");
+    cmd.AddValue("batches", "number of batches, 100 per second", batches);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.AddValue("vector-max", "largest table benchmarked with the vector scan", vectorMax);
+    cmd.Parse(argc, argv);
+
+    for (uint32_t neighbors : {10, 100, 1000})
+    {
+        runBench<Neighbors>(neighbors, batches, minIterations, "hash map + timing wheel");
+        if (neighbors <= vectorMax)
+        {
+            runBench<VectorNeighbors>(neighbors, batches, minIterations, "vector scan");
+        }
+    }
+
+    return 0;
+}
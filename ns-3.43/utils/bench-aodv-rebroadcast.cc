@@ -0,0 +1,297 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+// This program benchmarks the suppression of redundant RREQ rebroadcasts in dense
+// AODV-EOCW floods. Static nodes are placed on a square grid much denser than the radio
+// range and a series of route discoveries is triggered between distant nodes; for each
+// network size and RreqSuppression mode it reports the RREQ transmissions and their
+// airtime per discovery, the pending rebroadcasts cancelled per discovery, and the
+// fraction of discoveries whose datagram reached its destination.
+// Sample usage:  ./ns3 run 'bench-aodv-rebroadcast --discoveries=20 --threshold=3'
+
+#include "ns3/aodv-helper.h"
+#include "ns3/aodv-packet.h"
+#include "ns3/aodv-routing-protocol.h"
+#include "ns3/boolean.h"
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/llc-snap-header.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/packet.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/udp-header.h"
+#include "ns3/udp-l4-protocol.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-helper.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-ppdu.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::aodv;
+
+/// Time between two route discoveries
+static const Time g_discoveryInterval = Seconds(2);
+/// Start of the first route discovery
+static const Time g_firstDiscovery = Seconds(1);
+
+/// RREQ transmissions and outcome of one route discovery
+struct Discovery
+{
+    uint32_t transmissions{0}; ///< Number of RREQ transmissions
+    Time airtime;              ///< Total airtime of the RREQ transmissions
+    uint32_t cancelled{0};     ///< Pending rebroadcasts cancelled
+    bool delivered{false};     ///< Whether the datagram reached its destination
+};
+
+/// Discoveries of the current run
+static std::vector<Discovery> g_discoveries;
+
+/**
+ * \returns the discovery of the current time, or nullptr if there is none
+ */
+static Discovery*
+CurrentDiscovery()
+{
+    int64_t index = ((Simulator::Now() - g_firstDiscovery) / g_discoveryInterval).GetHigh();
+    if (index < 0 || index >= static_cast<int64_t>(g_discoveries.size()))
+    {
+        return nullptr;
+    }
+    return &g_discoveries[index];
+}
+
+/**
+ * Trace sink for the PSDUs sent by the PHYs: account for the ones carrying an RREQ
+ * \param psduMap the PSDUs
+ * \param txVector the TX vector
+ * \param txPowerW the transmit power
+ */
+static void
+PsduTxBegin(WifiConstPsduMap psduMap, WifiTxVector txVector, double txPowerW)
+{
+    for (const auto& [staId, psdu] : psduMap)
+    {
+        if (psdu->GetNMpdus() != 1 || !psdu->GetHeader(0).IsData())
+        {
+            continue;
+        }
+        Ptr<Packet> packet = psdu->GetPayload(0)->Copy();
+        LlcSnapHeader llc;
+        Ipv4Header ip;
+        UdpHeader udp;
+        TypeHeader type;
+        packet->RemoveHeader(llc);
+        if (llc.GetType() != Ipv4L3Protocol::PROT_NUMBER)
+        {
+            continue;
+        }
+        packet->RemoveHeader(ip);
+        if (ip.GetProtocol() != UdpL4Protocol::PROT_NUMBER)
+        {
+            continue;
+        }
+        packet->RemoveHeader(udp);
+        if (udp.GetDestinationPort() != RoutingProtocol::AODV_PORT)
+        {
+            continue;
+        }
+        packet->RemoveHeader(type);
+        Discovery* discovery = CurrentDiscovery();
+        if (type.Get() != AODVTYPE_RREQ || !discovery)
+        {
+            continue;
+        }
+        discovery->transmissions++;
+        discovery->airtime += WifiPhy::CalculateTxDuration(psdu, txVector, WIFI_PHY_BAND_5GHZ);
+    }
+}
+
+/**
+ * Trace sink for the pending rebroadcasts cancelled
+ * \param origin the RREQ originator
+ * \param id the RREQ ID
+ */
+static void
+RreqCancelled(Ipv4Address origin, uint32_t id)
+{
+    if (Discovery* discovery = CurrentDiscovery())
+    {
+        discovery->cancelled++;
+    }
+}
+
+/**
+ * Receive the datagram of a discovery
+ * \param socket the sink socket
+ */
+static void
+Receive(Ptr<Socket> socket)
+{
+    while (socket->Recv())
+    {
+        if (Discovery* discovery = CurrentDiscovery())
+        {
+            discovery->delivered = true;
+        }
+    }
+}
+
+/**
+ * Send one datagram, starting a route discovery
+ * \param socket the socket of the originator
+ * \param dst the destination
+ */
+static void
+Discover(Ptr<Socket> socket, Ipv4Address dst)
+{
+    socket->SendTo(Create<Packet>(64), 0, InetSocketAddress(dst, 9));
+}
+
+/**
+ * Run the route discoveries in a grid of nodes
+ * \param nNodes the number of nodes
+ * \param spacing the grid spacing, in meters
+ * \param mode the RREQ rebroadcast suppression mode
+ * \param threshold the number of copies that cancels a rebroadcast in counter mode
+ * \param discoveries the number of route discoveries
+ */
+static void
+RunFloods(uint32_t nNodes,
+          double spacing,
+          RebroadcastSuppression mode,
+          uint32_t threshold,
+          uint32_t discoveries)
+{
+    RngSeedManager::SetRun(1);
+    g_discoveries.assign(discoveries, Discovery());
+
+    NodeContainer nodes;
+    nodes.Create(nNodes);
+    auto width = static_cast<uint32_t>(std::ceil(std::sqrt(nNodes)));
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                  "DeltaX",
+                                  DoubleValue(spacing),
+                                  "DeltaY",
+                                  DoubleValue(spacing),
+                                  "GridWidth",
+                                  UintegerValue(width));
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(nodes);
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate6Mbps"),
+                                 "ControlMode",
+                                 StringValue("OfdmRate6Mbps"));
+    YansWifiPhyHelper phy;
+    phy.SetChannel(YansWifiChannelHelper::Default().Create());
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+
+    AodvHelper aodv;
+    aodv.Set("EnableHello", BooleanValue(false));
+    aodv.Set("RreqSuppression", EnumValue(mode));
+    aodv.Set("RreqSuppressionThreshold", UintegerValue(threshold));
+    InternetStackHelper stack;
+    stack.SetRoutingHelper(aodv);
+    stack.Install(nodes);
+    Ipv4AddressHelper address;
+    address.SetBase("10.0.0.0", "255.255.0.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+    for (uint32_t i = 0; i < nNodes; i++)
+    {
+        Ptr<Socket> sink = Socket::CreateSocket(nodes.Get(i), UdpSocketFactory::GetTypeId());
+        sink->Bind(InetSocketAddress(Ipv4Address::GetAny(), 9));
+        sink->SetRecvCallback(MakeCallback(&Receive));
+    }
+    for (uint32_t k = 0; k < discoveries; k++)
+    {
+        // Corner to corner, rotating the originator along the first row
+        uint32_t src = k % width;
+        uint32_t dst = nNodes - 1 - src;
+        Ptr<Socket> socket = Socket::CreateSocket(nodes.Get(src), UdpSocketFactory::GetTypeId());
+        Simulator::Schedule(g_firstDiscovery + k * g_discoveryInterval,
+                            &Discover,
+                            socket,
+                            interfaces.GetAddress(dst));
+    }
+
+    Config::ConnectWithoutContext(
+        "/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyTxPsduBegin",
+        MakeCallback(&PsduTxBegin));
+    Config::ConnectWithoutContext("/NodeList/*/$ns3::aodv::RoutingProtocol/RreqCancelled",
+                                  MakeCallback(&RreqCancelled));
+    Simulator::Stop(g_firstDiscovery + discoveries * g_discoveryInterval);
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t discoveries = 10;
+    double spacing = 40;
+    uint32_t threshold = 3;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the RREQ rebroadcasts per discovery for each suppression mode");
+    cmd.AddValue("discoveries", "number of route discoveries per run", discoveries);
+    cmd.AddValue("spacing", "grid spacing, in meters", spacing);
+    cmd.AddValue("threshold", "copies that cancel a rebroadcast in Counter mode", threshold);
+    cmd.Parse(argc, argv);
+
+    std::cout << "nodes\tmode\ttx/discovery\tairtime ms/discovery\tcancelled/discovery\tdelivered"
+              << std::endl;
+    for (uint32_t nNodes : {49, 100, 196})
+    {
+        for (auto [mode, name] : {std::pair{SUPPRESSION_NONE, "None"},
+                                  std::pair{SUPPRESSION_COUNTER, "Counter"},
+                                  std::pair{SUPPRESSION_SCORE, "Score"}})
+        {
+            RunFloods(nNodes, spacing, mode, threshold, discoveries);
+            double transmissions = 0;
+            double airtime = 0;
+            double cancelled = 0;
+            uint32_t delivered = 0;
+            for (const auto& discovery : g_discoveries)
+            {
+                transmissions += discovery.transmissions;
+                airtime += discovery.airtime.GetSeconds() * 1000;
+                cancelled += discovery.cancelled;
+                delivered += discovery.delivered;
+            }
+            std::cout << nNodes << "\t" << name << "\t" << std::fixed << std::setprecision(1)
+                      << transmissions / discoveries << "\t\t" << std::setprecision(3)
+                      << airtime / discoveries << "\t\t\t" << std::setprecision(1)
+                      << cancelled / discoveries << "\t\t\t" << delivered << "/" << discoveries
+                      << std::defaultfloat << std::endl;
+        }
+    }
+
+    return 0;
+}
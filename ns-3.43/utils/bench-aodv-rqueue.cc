@@ -0,0 +1,256 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+// This program benchmarks the AODV route request queue: for MaxQueueLen values of 64 to
+// 4096, the queue is filled with packets waiting for the routes to MaxQueueLen / 16
+// destinations, then the routes arrive one after the other and the packets for each
+// destination are flushed. The per destination buckets are compared with the single
+// vector scanned on every operation that they replaced.
+// Sample usage:  ./ns3 run 'bench-aodv-rqueue --packets=1000000 --vector-max=1024'
+
+#include "ns3/aodv-rqueue.h"
+#include "ns3/command-line.h"
+#include "ns3/packet.h"
+#include "ns3/socket.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::aodv;
+
+/**
+ * The request queue as implemented before the per destination buckets: a vector purged and
+ * scanned on every operation, drained one packet at a time.
+ */
+class VectorRequestQueue
+{
+  public:
+    /**
+     * constructor
+     * \param maxLen the maximum length
+     * \param routeToQueueTimeout the route to queue timeout
+     */
+    VectorRequestQueue(uint32_t maxLen, Time routeToQueueTimeout)
+        : m_maxLen(maxLen),
+          m_queueTimeout(routeToQueueTimeout)
+    {
+    }
+
+    /**
+     * Push entry in queue, if there is no entry with the same packet and destination address in
+     * queue.
+     * \param entry the queue entry
+     * \returns true if the entry is queued
+     */
+    bool Enqueue(QueueEntry& entry)
+    {
+        Purge();
+        for (const auto& e : m_queue)
+        {
+            if (e.GetPacket()->GetUid() == entry.GetPacket()->GetUid() &&
+                e.GetIpv4Header().GetDestination() == entry.GetIpv4Header().GetDestination())
+            {
+                return false;
+            }
+        }
+        entry.SetExpireTime(m_queueTimeout);
+        if (m_queue.size() == m_maxLen)
+        {
+            Drop(m_queue.front());
+            m_queue.erase(m_queue.begin());
+        }
+        m_queue.push_back(entry);
+        return true;
+    }
+
+    /**
+     * Remove all entries for given destination, one at a time
+     * \param dst the destination IP address
+     * \param entries the vector the entries are appended to
+     * \returns the number of entries dequeued
+     */
+    uint32_t DequeueAll(Ipv4Address dst, std::vector<QueueEntry>& entries)
+    {
+        uint32_t n = 0;
+        QueueEntry entry;
+        while (Dequeue(dst, entry))
+        {
+            entries.push_back(entry);
+            n++;
+        }
+        return n;
+    }
+
+  private:
+    /**
+     * Return first found (the earliest) entry for given destination
+     * \param dst the destination IP address
+     * \param entry the queue entry
+     * \returns true if the entry is dequeued
+     */
+    bool Dequeue(Ipv4Address dst, QueueEntry& entry)
+    {
+        Purge();
+        for (auto i = m_queue.begin(); i != m_queue.end(); ++i)
+        {
+            if (i->GetIpv4Header().GetDestination() == dst)
+            {
+                entry = *i;
+                m_queue.erase(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Remove all expired entries
+    void Purge()
+    {
+        auto expired = [](const QueueEntry& e) { return e.GetExpireTime() < Seconds(0); };
+        for (const auto& e : m_queue)
+        {
+            if (expired(e))
+            {
+                Drop(e);
+            }
+        }
+        m_queue.erase(std::remove_if(m_queue.begin(), m_queue.end(), expired), m_queue.end());
+    }
+
+    /**
+     * Drop an entry
+     * \param en the queue entry to drop
+     */
+    void Drop(QueueEntry en)
+    {
+        en.GetErrorCallback()(en.GetPacket(), en.GetIpv4Header(), Socket::ERROR_NOROUTETOHOST);
+    }
+
+    std::vector<QueueEntry> m_queue; ///< The queue
+    uint32_t m_maxLen;               ///< The maximum number of packets
+    Time m_queueTimeout;             ///< The maximum time a packet is queued for
+};
+
+/// Sink for the flushed packets, so the work is not optimized away
+static volatile uint32_t g_sink = 0;
+
+/**
+ * Error callback of the queued packets
+ * \param p the packet
+ * \param h the IPv4 header
+ * \param e the socket error
+ */
+static void
+Error(Ptr<const Packet> p, const Ipv4Header& h, Socket::SocketErrno e)
+{
+    g_sink = g_sink + 1;
+}
+
+/**
+ * Fill and flush a queue
+ * \tparam Queue the request queue type
+ * \param maxLen the maximum queue length
+ * \param rounds the number of times the queue is filled and flushed
+ * \param enqueueMs the time spent queueing, in ms
+ * \param flushMs the time spent flushing, in ms
+ */
+template <class Queue>
+static void
+RunQueue(uint32_t maxLen, uint32_t rounds, int64_t& enqueueMs, int64_t& flushMs)
+{
+    uint32_t destinations = std::max<uint32_t>(maxLen / 16, 1);
+    Queue queue(maxLen, Seconds(30));
+    std::vector<QueueEntry> entries;
+    std::vector<QueueEntry> flushed;
+    entries.reserve(maxLen);
+    flushed.reserve(maxLen);
+    for (uint32_t i = 0; i < maxLen; i++)
+    {
+        Ipv4Header h;
+        h.SetDestination(Ipv4Address((10U << 24) + 1 + i % destinations));
+        entries.emplace_back(Create<Packet>(),
+                             h,
+                             Ipv4RoutingProtocol::UnicastForwardCallback(),
+                             MakeCallback(&Error));
+    }
+
+    enqueueMs = 0;
+    flushMs = 0;
+    SystemWallClockMs time;
+    for (uint32_t round = 0; round < rounds; round++)
+    {
+        time.Start();
+        for (auto& entry : entries)
+        {
+            queue.Enqueue(entry);
+        }
+        enqueueMs += time.End();
+        time.Start();
+        for (uint32_t d = 0; d < destinations; d++)
+        {
+            flushed.clear();
+            queue.DequeueAll(Ipv4Address((10U << 24) + 1 + d), flushed);
+            g_sink = g_sink + flushed.size();
+        }
+        flushMs += time.End();
+    }
+}
+
+template <class Queue>
+static void
+runBench(uint32_t maxLen, uint32_t packets, uint32_t minIterations, const char* name)
+{
+    uint32_t rounds = std::max<uint32_t>(packets / maxLen, 1);
+    int64_t minEnqueue = std::numeric_limits<int64_t>::max();
+    int64_t minFlush = std::numeric_limits<int64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        int64_t enqueueMs;
+        int64_t flushMs;
+        RunQueue<Queue>(maxLen, rounds, enqueueMs, flushMs);
+        minEnqueue = std::min(minEnqueue, enqueueMs);
+        minFlush = std::min(minFlush, flushMs);
+    }
+    double queued = 1.0 * maxLen * rounds;
+    std::cout << "MaxQueueLen " << maxLen << ": "
+              << queued * 1000 / std::max<int64_t>(minEnqueue, 1) << " enqueues/s, "
+              << queued * 1000 / std::max<int64_t>(minFlush, 1) << " flushed packets/s"
+              << " (" << minEnqueue << " + " << minFlush << " ms elapsed)\t" << name
+              << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t packets = 1000000;
+    uint32_t minIterations = 1;
+    uint32_t vectorMax = 256;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the AODV route request queue");
+    cmd.AddValue("packets", "number of packets queued and flushed per queue length", packets);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.AddValue("vector-max", "largest queue length benchmarked with the vector scan", vectorMax);
+    cmd.Parse(argc, argv);
+
+    for (uint32_t maxLen : {64, 256, 1024, 4096})
+    {
+        runBench<RequestQueue>(maxLen, packets, minIterations, "per destination buckets");
+        if (maxLen <= vectorMax)
+        {
+            // The vector scan is orders of magnitude slower, run it on fewer packets
+            runBench<VectorRequestQueue>(maxLen, packets / 100, minIterations, "vector scan");
+        }
+    }
+
+    return 0;
+}
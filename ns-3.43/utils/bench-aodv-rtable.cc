@@ -0,0 +1,235 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+// This program benchmarks the AODV routing table on the per packet path of RouteInput
+// and RouteOutput: a route lookup followed by an update extending the route lifetime.
+// Tables of 100, 1k and 10k destinations are exercised over simulated time, so that
+// routes keep expiring, being invalidated, deleted and added again. The hash map with
+// expiry heap is compared with the ordered map purged in full on every access that it
+// replaced.
+// Sample usage:  ./ns3 run 'bench-aodv-rtable --packets=100000 --map-max=10000'
+
+#include "ns3/aodv-rtable.h"
+#include "ns3/command-line.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <map>
+
+using namespace ns3;
+using namespace ns3::aodv;
+
+/// Lifetime given to a route by a forwarded packet
+static const Time g_activeRouteTimeout = Seconds(3);
+/// Interval between two bursts of packets
+static const Time g_burstInterval = MilliSeconds(100);
+/// Number of bursts
+static const uint32_t g_bursts = 100;
+
+/**
+ * The lookup and update of the routing table as implemented before the expiry heap:
+ * every lookup purges the whole ordered map.
+ */
+class MapRoutingTable
+{
+  public:
+    /**
+     * constructor
+     * \param t the lifetime of invalid routes
+     */
+    MapRoutingTable(Time t)
+        : m_badLinkLifetime(t)
+    {
+    }
+
+    /**
+     * \param r routing table entry
+     * \return true in success
+     */
+    bool AddRoute(RoutingTableEntry& r)
+    {
+        Purge();
+        return m_ipv4AddressEntry.insert(std::make_pair(r.GetDestination(), r)).second;
+    }
+
+    /**
+     * \param dst destination address
+     * \param rt entry with destination address dst, if exists
+     * \return true on success
+     */
+    bool LookupRoute(Ipv4Address dst, RoutingTableEntry& rt)
+    {
+        Purge();
+        auto i = m_ipv4AddressEntry.find(dst);
+        if (i == m_ipv4AddressEntry.end())
+        {
+            return false;
+        }
+        rt = i->second;
+        return true;
+    }
+
+    /**
+     * \param rt entry with destination address dst, if exists
+     * \return true on success
+     */
+    bool Update(RoutingTableEntry& rt)
+    {
+        auto i = m_ipv4AddressEntry.find(rt.GetDestination());
+        if (i == m_ipv4AddressEntry.end())
+        {
+            return false;
+        }
+        i->second = rt;
+        return true;
+    }
+
+  private:
+    /// Delete all outdated entries and invalidate valid entry if Lifetime is expired
+    void Purge()
+    {
+        for (auto i = m_ipv4AddressEntry.begin(); i != m_ipv4AddressEntry.end();)
+        {
+            if (i->second.GetLifeTime() < Seconds(0) && i->second.GetFlag() == INVALID)
+            {
+                i = m_ipv4AddressEntry.erase(i);
+                continue;
+            }
+            if (i->second.GetLifeTime() < Seconds(0) && i->second.GetFlag() == VALID)
+            {
+                i->second.Invalidate(m_badLinkLifetime);
+            }
+            ++i;
+        }
+    }
+
+    std::map<Ipv4Address, RoutingTableEntry> m_ipv4AddressEntry; ///< The routing table
+    Time m_badLinkLifetime; ///< Deletion time for invalid routes
+};
+
+/// Sink for the lookup results, so the work is not optimized away
+static volatile uint32_t g_sink = 0;
+
+/**
+ * Forward a burst of packets to pseudo-random destinations: look the route up, add it
+ * if missing, and extend its lifetime when it is valid
+ * \tparam Table the routing table type
+ * \param table the routing table
+ * \param destinations the number of destinations
+ * \param packets the number of packets
+ * \param burst the burst number
+ */
+template <class Table>
+static void
+RunBurst(Table* table, uint32_t destinations, uint32_t packets, uint32_t burst)
+{
+    uint32_t valid = 0;
+    uint32_t x = burst * 2654435761U + 1;
+    for (uint32_t i = 0; i < packets; i++)
+    {
+        x = x * 1664525U + 1013904223U;
+        Ipv4Address dst((10U << 24) + 1 + (x >> 8) % destinations);
+        RoutingTableEntry rt;
+        if (!table->LookupRoute(dst, rt))
+        {
+            RoutingTableEntry newEntry(nullptr,
+                                       dst,
+                                       true,
+                                       1,
+                                       Ipv4InterfaceAddress(),
+                                       2,
+                                       Ipv4Address("10.255.0.1"),
+                                       g_activeRouteTimeout);
+            table->AddRoute(newEntry);
+            continue;
+        }
+        if (rt.GetFlag() == VALID)
+        {
+            valid++;
+            rt.SetLifeTime(std::max(g_activeRouteTimeout, rt.GetLifeTime()));
+            table->Update(rt);
+        }
+    }
+    g_sink = g_sink + valid;
+}
+
+/**
+ * Run the bursts of one benchmark
+ * \tparam Table the routing table type
+ * \param destinations the number of destinations
+ * \param packets the number of packets
+ * \returns the wall clock time, in ms
+ */
+template <class Table>
+static int64_t
+RunTable(uint32_t destinations, uint32_t packets)
+{
+    Table table(Seconds(3));
+    uint32_t perBurst = std::max<uint32_t>(packets / g_bursts, 1);
+    for (uint32_t burst = 0; burst < g_bursts; burst++)
+    {
+        Simulator::Schedule(g_burstInterval * burst,
+                            &RunBurst<Table>,
+                            &table,
+                            destinations,
+                            perBurst,
+                            burst);
+    }
+    SystemWallClockMs time;
+    time.Start();
+    Simulator::Run();
+    int64_t elapsed = time.End();
+    Simulator::Destroy();
+    return elapsed;
+}
+
+template <class Table>
+static void
+runBench(uint32_t destinations,
+         uint32_t packets,
+         uint32_t minIterations,
+         const char* name)
+{
+    int64_t minDelay = std::numeric_limits<int64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        minDelay = std::min(minDelay, RunTable<Table>(destinations, packets));
+    }
+    double ps = packets * 1000.0 / std::max<int64_t>(minDelay, 1);
+    std::cout << destinations << " destinations: " << ps << " packets/s"
+              << " (" << minDelay << " ms elapsed)\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t packets = 100000;
+    uint32_t minIterations = 1;
+    uint32_t mapMax = 1000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark AODV routing table lookups and updates");
+    cmd.AddValue("packets", "number of forwarded packets per table size", packets);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.AddValue("map-max", "largest table benchmarked with the full purge", mapMax);
+    cmd.Parse(argc, argv);
+
+    for (uint32_t destinations : {100, 1000, 10000})
+    {
+        runBench<RoutingTable>(destinations, packets, minIterations, "hash map + expiry heap");
+        if (destinations <= mapMax)
+        {
+            runBench<MapRoutingTable>(destinations, packets, minIterations, "map + full purge");
+        }
+    }
+
+    return 0;
+}
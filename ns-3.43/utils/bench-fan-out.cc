@@ -0,0 +1,161 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+// This program benchmarks the scheduling of the receptions of broadcasts, either as one
+// event per receiver, as the channels used to, or as a single fan-out event per broadcast
+// (see FanOutEvent). Nodes are placed at random in a square arena, and broadcast
+// periodically, with some jitter, like the hello messages of a routing protocol; each
+// reception is delayed by the propagation delay from the sender. For each network size and
+// mode, it reports the events executed, the wall-clock time of the run and the events per
+// second. Both modes execute the same events, in the same order.
+// Sample usage:  ./ns3 run 'bench-fan-out --scheduler=ns3::HeapScheduler'
+
+#include "ns3/core-module.h"
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/// Position of the nodes
+static std::vector<std::pair<double, double>> g_positions;
+/// Whether the receptions are scheduled as fan-out events
+static bool g_fanOut;
+/// Period of the broadcasts
+static Time g_interval;
+/// Jitter of the broadcasts
+static Ptr<UniformRandomVariable> g_jitter;
+/// Number of receptions
+static uint64_t g_receptions;
+
+/**
+ * Reception of a broadcast
+ * \param receiver the receiver
+ * \param sender the sender
+ */
+static void
+Receive(uint32_t receiver, uint32_t sender)
+{
+    g_receptions++;
+}
+
+/**
+ * Broadcast from a node, and schedule its next broadcast
+ * \param sender the sender
+ */
+static void
+Broadcast(uint32_t sender)
+{
+    Ptr<FanOutEventImpl<uint32_t, uint32_t>> receptions;
+    if (g_fanOut)
+    {
+        receptions = MakeFanOutEvent(&Receive);
+    }
+    for (uint32_t receiver = 0; receiver < g_positions.size(); receiver++)
+    {
+        if (receiver == sender)
+        {
+            continue;
+        }
+        double dx = g_positions[receiver].first - g_positions[sender].first;
+        double dy = g_positions[receiver].second - g_positions[sender].second;
+        Time delay = Seconds(std::sqrt(dx * dx + dy * dy) / 299792458.0);
+        if (g_fanOut)
+        {
+            receptions->Add(receiver, delay, receiver, sender);
+        }
+        else
+        {
+            Simulator::ScheduleWithContext(receiver, delay, &Receive, receiver, sender);
+        }
+    }
+    if (g_fanOut)
+    {
+        Simulator::ScheduleFanOut(receptions);
+    }
+    Simulator::Schedule(g_interval + MicroSeconds(g_jitter->GetInteger(0, 10000)),
+                        &Broadcast,
+                        sender);
+}
+
+/**
+ * Run the broadcasts of a network
+ * \param nNodes the number of nodes
+ * \param arena the side of the square arena, in meters
+ * \param duration the duration of the simulation
+ * \param scheduler the type of the scheduler
+ * \returns the wall-clock time of the run, in seconds
+ */
+static double
+RunBroadcasts(uint32_t nNodes, double arena, Time duration, const std::string& scheduler)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    ObjectFactory factory(scheduler);
+    Simulator::SetScheduler(factory);
+
+    Ptr<UniformRandomVariable> position = CreateObject<UniformRandomVariable>();
+    g_jitter = CreateObject<UniformRandomVariable>();
+    g_positions.clear();
+    g_receptions = 0;
+    for (uint32_t i = 0; i < nNodes; i++)
+    {
+        g_positions.emplace_back(position->GetValue(0, arena), position->GetValue(0, arena));
+        Simulator::ScheduleWithContext(i,
+                                       MicroSeconds(g_jitter->GetInteger(0, 100000)),
+                                       &Broadcast,
+                                       i);
+    }
+
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Stop(duration);
+    Simulator::Run();
+    return timer.End() / 1000.0;
+}
+
+int
+main(int argc, char* argv[])
+{
+    double arena = 1000;
+    double duration = 10;
+    double interval = 1;
+    uint32_t maxNodes = 1000;
+    std::string scheduler = "ns3::MapScheduler";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the scheduling of broadcast receptions as fan-out events");
+    cmd.AddValue("arena", "side of the square arena, in meters", arena);
+    cmd.AddValue("duration", "duration of the simulation, in seconds", duration);
+    cmd.AddValue("interval", "period of the broadcasts of each node, in seconds", interval);
+    cmd.AddValue("maxNodes", "largest number of nodes", maxNodes);
+    cmd.AddValue("scheduler", "type of the scheduler", scheduler);
+    cmd.Parse(argc, argv);
+    g_interval = Seconds(interval);
+
+    std::cout << "nodes\tmode\t\trx\t\tevents\t\tevents/s\twall-clock s" << std::endl;
+    for (uint32_t nNodes : {50, 100, 200, 500, 1000})
+    {
+        if (nNodes > maxNodes)
+        {
+            break;
+        }
+        for (auto [fanOut, name] : {std::pair{false, "events"}, std::pair{true, "fan-out"}})
+        {
+            g_fanOut = fanOut;
+            double seconds = RunBroadcasts(nNodes, arena, Seconds(duration), scheduler);
+            uint64_t events = Simulator::GetEventCount();
+            Simulator::Destroy();
+            std::cout << nNodes << "\t" << name << "\t\t" << g_receptions << "\t\t" << events
+                      << "\t\t" << std::fixed << std::setprecision(0) << events / seconds
+                      << "\t\t" << std::setprecision(3) << seconds << std::defaultfloat
+                      << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,188 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Author: User for AODV-EOCW Fuzzy Implementation
+ */
+
+// This program benchmarks the delivery of PPDUs by the YansWifiChannel, with and without
+// the spatial grid enabled by its MaxRange attribute. Nodes are placed at random in a
+// square arena, optionally moving in a random walk, and each of them broadcasts a few
+// frames at random times; for each network size and mode it reports the transmissions,
+// the events executed, the events per second and the wall-clock time of the run, and the
+// frames received, which are the same in both modes as long as MaxRange exceeds the
+// range at which the receptions fall below the RX sensitivity.
+// Sample usage:  ./ns3 run 'bench-wifi-channel --frames=2 --speed=5'
+
+#include "ns3/command-line.h"
+#include "ns3/double.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rectangle.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/wifi-helper.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/yans-wifi-channel.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+
+/// Outcome of a run
+struct Result
+{
+    uint32_t transmissions{0}; ///< Number of PPDUs sent
+    uint32_t receptions{0};    ///< Number of PSDUs received successfully
+    uint64_t events{0};        ///< Number of events executed
+    double seconds{0};         ///< Wall-clock time of the run, in seconds
+};
+
+/// Outcome of the current run
+static Result g_result;
+
+/**
+ * PhyTxBegin trace sink
+ * \param packet the packet
+ * \param txPowerW the TX power
+ */
+static void
+PhyTxBegin(Ptr<const Packet> packet, double txPowerW)
+{
+    g_result.transmissions++;
+}
+
+/**
+ * PhyRxEnd trace sink
+ * \param packet the packet
+ */
+static void
+PhyRxEnd(Ptr<const Packet> packet)
+{
+    g_result.receptions++;
+}
+
+/**
+ * Run the broadcasts of a network
+ * \param nNodes the number of nodes
+ * \param arena the side of the square arena, in meters
+ * \param speed the speed of the nodes, in m/s, zero for static nodes
+ * \param frames the number of frames broadcast by each node
+ * \param duration the period over which the frames are broadcast
+ * \param maxRange the MaxRange of the channel, zero to disable the grid
+ */
+static void
+RunBroadcasts(uint32_t nNodes,
+              double arena,
+              double speed,
+              uint32_t frames,
+              Time duration,
+              double maxRange)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    g_result = Result();
+
+    NodeContainer nodes;
+    nodes.Create(nNodes);
+    MobilityHelper mobility;
+    std::ostringstream position;
+    position << "ns3::UniformRandomVariable[Min=0|Max=" << arena << "]";
+    mobility.SetPositionAllocator("ns3::RandomRectanglePositionAllocator",
+                                  "X",
+                                  StringValue(position.str()),
+                                  "Y",
+                                  StringValue(position.str()));
+    if (speed > 0)
+    {
+        std::ostringstream velocity;
+        velocity << "ns3::ConstantRandomVariable[Constant=" << speed << "]";
+        mobility.SetMobilityModel("ns3::RandomWalk2dMobilityModel",
+                                  "Bounds",
+                                  RectangleValue(Rectangle(0, arena, 0, arena)),
+                                  "Speed",
+                                  StringValue(velocity.str()));
+    }
+    mobility.Install(nodes);
+
+    Ptr<YansWifiChannel> channel = YansWifiChannelHelper::Default().Create();
+    channel->SetAttribute("MaxRange", DoubleValue(maxRange));
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel);
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate6Mbps"));
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+
+    Ptr<UniformRandomVariable> start = CreateObject<UniformRandomVariable>();
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(devices.Get(i));
+        device->GetPhy()->TraceConnectWithoutContext("PhyTxBegin", MakeCallback(&PhyTxBegin));
+        device->GetPhy()->TraceConnectWithoutContext("PhyRxEnd", MakeCallback(&PhyRxEnd));
+        for (uint32_t k = 0; k < frames; k++)
+        {
+            Simulator::Schedule(Seconds(1) + Seconds(start->GetValue(0, duration.GetSeconds())),
+                                [device]() {
+                                    device->Send(Create<Packet>(200), device->GetBroadcast(), 1);
+                                });
+        }
+    }
+
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Stop(Seconds(2) + duration);
+    Simulator::Run();
+    g_result.seconds = timer.End() / 1000.0;
+    g_result.events = Simulator::GetEventCount();
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    double arena = 1000;
+    double speed = 0;
+    uint32_t frames = 1;
+    double duration = 10;
+    double maxRange = 250;
+    uint32_t maxNodes = 2000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the YansWifiChannel with and without its spatial grid");
+    cmd.AddValue("arena", "side of the square arena, in meters", arena);
+    cmd.AddValue("speed", "speed of the nodes, in m/s (0 for static nodes)", speed);
+    cmd.AddValue("frames", "number of frames broadcast by each node", frames);
+    cmd.AddValue("duration", "period over which the frames are broadcast, in seconds", duration);
+    cmd.AddValue("maxRange", "MaxRange of the channel when the grid is enabled", maxRange);
+    cmd.AddValue("maxNodes", "largest number of nodes", maxNodes);
+    cmd.Parse(argc, argv);
+
+    std::cout << "nodes\tmode\ttx\trx\t\tevents\t\tevents/s\twall-clock s" << std::endl;
+    for (uint32_t nNodes : {50, 100, 200, 500, 1000, 2000})
+    {
+        if (nNodes > maxNodes)
+        {
+            break;
+        }
+        for (auto [range, name] : {std::pair{0.0, "all"}, std::pair{maxRange, "grid"}})
+        {
+            RunBroadcasts(nNodes, arena, speed, frames, Seconds(duration), range);
+            std::cout << nNodes << "\t" << name << "\t" << g_result.transmissions << "\t"
+                      << g_result.receptions << "\t\t" << g_result.events << "\t\t" << std::fixed
+                      << std::setprecision(0) << g_result.events / g_result.seconds << "\t\t"
+                      << std::setprecision(3) << g_result.seconds << std::defaultfloat
+                      << std::endl;
+        }
+    }
+
+    return 0;
+}